@@ -0,0 +1,384 @@
+#include <dwl/solver/AStar.h>
+#include <dwl/solver/Dijkstrap.h>
+#include <dwl/solver/AnytimeRepairingAStar.h>
+#include <dwl/solver/DStarLite.h>
+#include <dwl/locomotion/ClusterBasedMotionPlanning.h>
+#include <ctime>
+#include <iostream>
+
+
+/**
+ * @class GridAdjacency
+ * @brief 8-connected grid with random cell costs, where the vertex of the cell (x,y) is
+ * y * size + x. The heuristic is the octile distance, which is admissible since the minimum cell
+ * cost is one
+ */
+class GridAdjacency : public dwl::model::AdjacencyModel
+{
+	public:
+		GridAdjacency(unsigned int size) : size_(size), costs_(size * size)
+		{
+			name_ = "Grid";
+			srand(1);
+			for (unsigned int i = 0; i < size * size; i++)
+				costs_[i] = 1. + 5. * rand() / (double) RAND_MAX;
+		}
+
+		void computeAdjacencyMap(dwl::AdjacencyMap& adjacency_map,
+								 dwl::Vertex,
+								 dwl::Vertex)
+		{
+			std::vector<dwl::Edge> successors;
+			for (dwl::Vertex vertex = 0; vertex < size_ * size_; vertex++) {
+				successors.clear();
+				getSuccessors(successors, vertex);
+				adjacency_map[vertex].assign(successors.begin(), successors.end());
+			}
+		}
+
+		void getSuccessors(std::vector<dwl::Edge>& successors,
+						   dwl::Vertex state_vertex)
+		{
+			int x = state_vertex % size_;
+			int y = state_vertex / size_;
+			for (int dx = -1; dx <= 1; dx++) {
+				for (int dy = -1; dy <= 1; dy++) {
+					int nx = x + dx, ny = y + dy;
+					if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 ||
+							nx >= (int) size_ || ny >= (int) size_)
+						continue;
+
+					dwl::Vertex neighbor = ny * size_ + nx;
+					double length = (dx != 0 && dy != 0) ? sqrt(2.) : 1.;
+					successors.push_back(dwl::Edge(neighbor, length * costs_[neighbor]));
+				}
+			}
+		}
+
+		void getPredecessors(std::vector<dwl::Edge>& predecessors,
+							 dwl::Vertex state_vertex)
+		{
+			// The cost of an edge depends on the cell that it reaches
+			int x = state_vertex % size_;
+			int y = state_vertex / size_;
+			for (int dx = -1; dx <= 1; dx++) {
+				for (int dy = -1; dy <= 1; dy++) {
+					int nx = x + dx, ny = y + dy;
+					if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 ||
+							nx >= (int) size_ || ny >= (int) size_)
+						continue;
+
+					double length = (dx != 0 && dy != 0) ? sqrt(2.) : 1.;
+					predecessors.push_back(dwl::Edge(ny * size_ + nx,
+													 length * costs_[state_vertex]));
+				}
+			}
+		}
+
+		void setCost(dwl::Vertex vertex,
+					 double cost)
+		{
+			costs_[vertex] = cost;
+		}
+
+		double heuristicCost(dwl::Vertex source,
+							 dwl::Vertex target)
+		{
+			double dx = fabs((double) (source % size_) - (double) (target % size_));
+			double dy = fabs((double) (source / size_) - (double) (target / size_));
+			return std::max(dx, dy) + (sqrt(2.) - 1.) * std::min(dx, dy);
+		}
+
+
+	private:
+		unsigned int size_;
+		std::vector<double> costs_;
+};
+
+
+/**
+ * @class TerrainGridAdjacency
+ * @brief 8-connected grid of the terrain cells, where an edge costs its length times the cost of
+ * the reached cell
+ */
+class TerrainGridAdjacency : public dwl::model::AdjacencyModel
+{
+	public:
+		TerrainGridAdjacency()
+		{
+			name_ = "Terrain grid";
+		}
+
+		void getSuccessors(std::vector<dwl::Edge>& successors,
+						   dwl::Vertex state_vertex)
+		{
+			const dwl::environment::SpaceDiscretization& space_model =
+					terrain_->getTerrainSpaceModel();
+			Eigen::Vector3d state;
+			space_model.vertexToState(state, state_vertex);
+			dwl::Key key;
+			space_model.coordToKey(key.x, (double) state(0), true);
+			space_model.coordToKey(key.y, (double) state(1), true);
+			double resolution = terrain_->getResolution(true);
+			for (int dx = -1; dx <= 1; dx++) {
+				for (int dy = -1; dy <= 1; dy++) {
+					dwl::Key neighbor_key(key.x + dx, key.y + dy, 0);
+					dwl::Vertex neighbor_cell;
+					space_model.keyToVertex(neighbor_cell, neighbor_key, true);
+					dwl::Weight cost;
+					if ((dx == 0 && dy == 0) || !terrain_->getTerrainCost(cost, neighbor_cell))
+						continue;
+
+					Eigen::Vector2d position;
+					space_model.vertexToCoord(position, neighbor_cell);
+					dwl::Vertex neighbor;
+					space_model.stateToVertex(neighbor,
+											  Eigen::Vector3d(position(0), position(1), 0.));
+					double length = (dx != 0 && dy != 0) ? sqrt(2.) : 1.;
+					successors.push_back(dwl::Edge(neighbor, length * resolution * cost));
+				}
+			}
+		}
+};
+
+
+void runSolver(dwl::solver::SearchTreeSolver& solver,
+			   unsigned int size)
+{
+	solver.setAdjacencyModel(new GridAdjacency(size));
+	solver.init();
+
+	std::clock_t startcputime = std::clock();
+	solver.compute(0, size * size - 1, 10.);
+	double cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+	std::cout << "  " << solver.getName() << ": cost " << solver.getMinimumCost() << ", "
+			<< solver.getNumberOfExpansions() << " expansions, " << cpu_duration
+			<< " (secs, CPU time), " << solver.getNumberOfExpansions() / cpu_duration
+			<< " expansions/sec" << std::endl;
+}
+
+
+void runReplanning(unsigned int size)
+{
+	// Planning with D* Lite, and then moving the source along the path while a block of cells
+	// in front of the robot becomes expensive, e.g. an obstacle that is perceived later
+	GridAdjacency* grid = new GridAdjacency(size);
+	dwl::solver::DStarLite dstar_lite;
+	dstar_lite.setAdjacencyModel(grid);
+	dstar_lite.init();
+
+	dwl::Vertex target = size * size - 1;
+	std::clock_t startcputime = std::clock();
+	dstar_lite.compute(0, target, 10.);
+	double cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+	std::cout << "  " << dstar_lite.getName() << " (initial): cost "
+			<< dstar_lite.getMinimumCost() << ", " << dstar_lite.getNumberOfExpansions()
+			<< " expansions, " << cpu_duration << " (secs, CPU time)" << std::endl;
+
+	std::list<dwl::Vertex> path = dstar_lite.getShortestPath(0, target);
+	std::list<dwl::Vertex>::iterator path_it = path.begin();
+	std::advance(path_it, path.size() / 4);
+	dwl::Vertex source = *path_it;
+	std::advance(path_it, path.size() / 4);
+	dwl::Vertex center = *path_it;
+
+	std::vector<dwl::Vertex> changed_vertices;
+	int cx = center % size, cy = center / size;
+	for (int x = cx - 5; x <= cx + 5; x++) {
+		for (int y = cy - 5; y <= cy + 5; y++) {
+			if (x < 0 || y < 0 || x >= (int) size || y >= (int) size)
+				continue;
+
+			grid->setCost(y * size + x, 50.);
+			changed_vertices.push_back(y * size + x);
+		}
+	}
+
+	startcputime = std::clock();
+	dstar_lite.updateVertices(changed_vertices);
+	dstar_lite.compute(source, target, 10.);
+	cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+	std::cout << "  " << dstar_lite.getName() << " (replanning): cost "
+			<< dstar_lite.getMinimumCost() << ", " << dstar_lite.getNumberOfExpansions()
+			<< " expansions, " << cpu_duration << " (secs, CPU time)" << std::endl;
+
+	// Replanning from scratch with A* for comparison
+	GridAdjacency* changed_grid = new GridAdjacency(size);
+	for (unsigned int i = 0; i < changed_vertices.size(); i++)
+		changed_grid->setCost(changed_vertices[i], 50.);
+
+	dwl::solver::AStar astar;
+	astar.setAdjacencyModel(changed_grid);
+	astar.init();
+	startcputime = std::clock();
+	astar.compute(source, target, 10.);
+	cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+	std::cout << "  " << astar.getName() << " (replanning): cost " << astar.getMinimumCost()
+			<< ", " << astar.getNumberOfExpansions() << " expansions, " << cpu_duration
+			<< " (secs, CPU time)" << std::endl;
+}
+
+
+void countSolution(unsigned int* num_solutions,
+				   const std::list<dwl::Vertex>&,
+				   double,
+				   double)
+{
+	(*num_solutions)++;
+}
+
+
+void runAnytimeReplanning(unsigned int size)
+{
+	// Planning with ARA*, and then continuing the search after the source moved along the path
+	dwl::solver::AnytimeRepairingAStar ara_star;
+	ara_star.setAdjacencyModel(new GridAdjacency(size));
+	ara_star.init();
+
+	unsigned int num_solutions = 0;
+	ara_star.setSolutionCallback(std::bind(countSolution, &num_solutions, std::placeholders::_1,
+										   std::placeholders::_2, std::placeholders::_3));
+
+	dwl::Vertex target = size * size - 1;
+	std::clock_t startcputime = std::clock();
+	ara_star.compute(0, target, 10.);
+	double cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+	std::cout << "  " << ara_star.getName() << " (initial): cost " << ara_star.getMinimumCost()
+			<< ", " << ara_star.getNumberOfExpansions() << " expansions, " << num_solutions
+			<< " solutions, " << cpu_duration << " (secs, CPU time)" << std::endl;
+
+	std::list<dwl::Vertex> path = ara_star.getShortestPath(0, target);
+	std::list<dwl::Vertex>::iterator path_it = path.begin();
+	std::advance(path_it, path.size() / 4);
+	dwl::Vertex source = *path_it;
+
+	num_solutions = 0;
+	startcputime = std::clock();
+	ara_star.compute(source, target, 10.);
+	cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+	std::cout << "  " << ara_star.getName() << " (moved source): cost "
+			<< ara_star.getMinimumCost() << ", " << ara_star.getNumberOfExpansions()
+			<< " expansions, " << num_solutions << " solutions, " << cpu_duration
+			<< " (secs, CPU time)" << std::endl;
+}
+
+
+void runHierarchicalPlanning(unsigned int size)
+{
+	// Building a terrain with random costs and an expensive wall with a gap at its end
+	dwl::environment::TerrainMap terrain;
+	double resolution = 0.04;
+	terrain.setResolution(resolution, true);
+	terrain.setStateResolution(resolution, M_PI / 16);
+	dwl::TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	unsigned short int min_key = 32768 - size / 2;
+	srand(1);
+	for (unsigned int x = 0; x < size; x++) {
+		for (unsigned int y = 0; y < size; y++) {
+			dwl::TerrainCell cell;
+			cell.key = dwl::Key(min_key + x, min_key + y, 32768);
+			cell.cost = 1. + 5. * rand() / (double) RAND_MAX;
+			if (x > size / 2 - 10 && x < size / 2 + 10 && y < 4 * size / 5)
+				cell.cost = 400.;
+			terrain_data.data.push_back(cell);
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+	dwl::robot::Robot robot;
+
+	dwl::Pose start_pose, goal_pose;
+	terrain.getTerrainSpaceModel().keyToCoord(start_pose.position(0), min_key + 5, true);
+	terrain.getTerrainSpaceModel().keyToCoord(start_pose.position(1), min_key + 5, true);
+	terrain.getTerrainSpaceModel().keyToCoord(goal_pose.position(0), min_key + size - 5, true);
+	terrain.getTerrainSpaceModel().keyToCoord(goal_pose.position(1), min_key + 5, true);
+	start_pose.position(2) = goal_pose.position(2) = 0.;
+	start_pose.orientation = goal_pose.orientation = Eigen::Quaterniond::Identity();
+
+	// Planning over the whole terrain with A*
+	TerrainGridAdjacency* grid = new TerrainGridAdjacency();
+	grid->setCostToGoHeuristic(true);
+	dwl::solver::AStar astar;
+	astar.setAdjacencyModel(grid);
+	astar.reset(&robot, &terrain);
+	astar.init();
+
+	dwl::Vertex source, target;
+	terrain.getTerrainSpaceModel().stateToVertex(source, start_pose.position);
+	terrain.getTerrainSpaceModel().stateToVertex(target, goal_pose.position);
+	std::clock_t startcputime = std::clock();
+	astar.compute(source, target, 10.);
+	double cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+	std::cout << "  " << astar.getName() << ": cost " << astar.getMinimumCost() << ", "
+			<< astar.getNumberOfExpansions() << " expansions, " << cpu_duration
+			<< " (secs, CPU time)" << std::endl;
+
+	// Planning with the clusters, and then replanning after the gap is closed
+	grid = new TerrainGridAdjacency();
+	grid->setCostToGoHeuristic(true);
+	dwl::locomotion::ClusterBasedMotionPlanning planner(grid);
+	dwl::solver::AStar* path_solver = new dwl::solver::AStar();
+	planner.reset(path_solver);
+	planner.reset(&robot, &terrain);
+	planner.setComputationTime(10., true);
+
+	std::vector<dwl::Pose> path;
+	std::string plans[3] = {"initial", "cached clusters", "closed gap"};
+	for (unsigned int i = 0; i < 3; i++) {
+		if (i == 2) {
+			std::vector<dwl::Vertex> changed_cells;
+			for (unsigned int x = size / 2 - 9; x < size / 2 + 10; x++) {
+				for (unsigned int y = 4 * size / 5; y < size; y++) {
+					dwl::TerrainCell cell;
+					cell.key = dwl::Key(min_key + x, min_key + y, 32768);
+					cell.cost = 400.;
+					terrain.addCellToTerrainMap(cell);
+
+					dwl::Vertex cell_vertex;
+					terrain.getTerrainSpaceModel().keyToVertex(cell_vertex, cell.key, true);
+					changed_cells.push_back(cell_vertex);
+				}
+			}
+			planner.updateTerrainCells(changed_cells);
+		}
+
+		startcputime = std::clock();
+		planner.computePath(path, start_pose, goal_pose);
+		cpu_duration = (std::clock() - startcputime) / (double) CLOCKS_PER_SEC;
+		std::cout << "  Cluster-based " << path_solver->getName() << " (" << plans[i]
+				<< "): cost " << path_solver->getMinimumCost() << ", "
+				<< path_solver->getNumberOfExpansions() << " expansions, " << cpu_duration
+				<< " (secs, CPU time)" << std::endl;
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned int size = 500;
+	if (argc > 1)
+		size = atoi(argv[1]);
+	std::cout << "Grid of " << size << "x" << size << " cells, corner to corner" << std::endl;
+
+	dwl::solver::Dijkstrap dijkstrap;
+	runSolver(dijkstrap, size);
+
+	dwl::solver::AStar astar;
+	runSolver(astar, size);
+
+	dwl::solver::AnytimeRepairingAStar ara_star;
+	runSolver(ara_star, size);
+
+	dwl::solver::DStarLite dstar_lite;
+	runSolver(dstar_lite, size);
+
+	std::cout << "Replanning after a change of the terrain" << std::endl;
+	runReplanning(size);
+	runAnytimeReplanning(size);
+
+	std::cout << "Hierarchical planning over the terrain" << std::endl;
+	runHierarchicalPlanning(size);
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+#include <dwl/solver/QuadProg++QP.h>
+#include <dwl/solver/FixedSizeQP.h>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+
+
+/**
+ * @brief Builds a random contact-force distribution QP, i.e. the forces of each foot have to
+ * generate a desired base wrench (equality), remain inside linearized friction cones (one-sided
+ * inequalities) and have bounded normal forces
+ */
+void buildContactForceProblem(Eigen::MatrixXd& hessian,
+							  Eigen::VectorXd& gradient,
+							  Eigen::MatrixXd& constraint_mat,
+							  Eigen::VectorXd& lower_bound,
+							  Eigen::VectorXd& upper_bound,
+							  Eigen::VectorXd& lower_constraint,
+							  Eigen::VectorXd& upper_constraint,
+							  unsigned int num_feet)
+{
+	unsigned int num_vars = 3 * num_feet;
+	unsigned int num_constraints = 6 + 4 * num_feet;
+	double infinity = std::numeric_limits<double>::infinity();
+	double friction = 0.7;
+
+	hessian = Eigen::MatrixXd::Identity(num_vars, num_vars);
+	gradient = Eigen::VectorXd::Zero(num_vars);
+	constraint_mat = Eigen::MatrixXd::Zero(num_constraints, num_vars);
+	lower_constraint = Eigen::VectorXd::Zero(num_constraints);
+	upper_constraint = Eigen::VectorXd::Constant(num_constraints, infinity);
+	lower_bound = Eigen::VectorXd::Constant(num_vars, -infinity);
+	upper_bound = Eigen::VectorXd::Constant(num_vars, infinity);
+
+	// Desired base wrench, i.e. the forces and the moments of random feet positions around the
+	// base
+	Eigen::VectorXd wrench(6);
+	wrench << 0., 0., 800., 0., 0., 0.;
+	for (unsigned int i = 0; i < num_feet; i++) {
+		double angle = 2 * M_PI * i / num_feet;
+		double radius = 0.4 + 0.1 * Eigen::VectorXd::Random(1)(0);
+		Eigen::Vector3d position(radius * cos(angle), radius * sin(angle), -0.5);
+		Eigen::Matrix3d skew;
+		skew << 0., -position(2), position(1),
+				position(2), 0., -position(0),
+				-position(1), position(0), 0.;
+		constraint_mat.block(0, 3 * i, 3, 3) = Eigen::Matrix3d::Identity();
+		constraint_mat.block(3, 3 * i, 3, 3) = skew;
+	}
+	lower_constraint.head(6) = wrench;
+	upper_constraint.head(6) = wrench;
+
+	// Linearized friction cones, i.e. mu fz -|fx| >= 0 and mu fz -|fy| >= 0, and normal forces
+	for (unsigned int i = 0; i < num_feet; i++) {
+		unsigned int row = 6 + 4 * i;
+		for (unsigned int j = 0; j < 2; j++) {
+			constraint_mat(row + 2 * j, 3 * i + j) = 1.;
+			constraint_mat(row + 2 * j, 3 * i + 2) = friction;
+			constraint_mat(row + 2 * j + 1, 3 * i + j) = -1.;
+			constraint_mat(row + 2 * j + 1, 3 * i + 2) = friction;
+		}
+		lower_bound(3 * i + 2) = 0.;
+		upper_bound(3 * i + 2) = 1000.;
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	// The number of QPs solved for each problem size
+	unsigned int N = 1000;
+	unsigned int feet[] = {4, 8, 16, 32, 64};
+
+	srand(0);
+	for (unsigned int f = 0; f < 5; f++) {
+		Eigen::MatrixXd hessian, constraint_mat;
+		Eigen::VectorXd gradient, lower_bound, upper_bound, lower_constraint, upper_constraint;
+		buildContactForceProblem(hessian, gradient, constraint_mat,
+								 lower_bound, upper_bound,
+								 lower_constraint, upper_constraint,
+								 feet[f]);
+		std::cout << "Contact forces of " << feet[f] << " feet (" << hessian.rows()
+				<< " variables, " << constraint_mat.rows() << " constraints)" << std::endl;
+
+		// Solving the sequence of QPs with the generic interface, where only the first call
+		// builds the structure of the converted problem
+		dwl::solver::QuadProgQP quadprog;
+		quadprog.init(hessian.rows(), constraint_mat.rows());
+		std::clock_t startcputime = std::clock();
+		for (unsigned int i = 0; i < N; i++) {
+			gradient(0) = 0.001 * i;
+			quadprog.compute(hessian, gradient,
+							 constraint_mat,
+							 lower_bound, upper_bound,
+							 lower_constraint, upper_constraint,
+							 0.);
+		}
+		double cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+		std::cout << "  QuadProg++ (compute): " << cpu_duration / N << " (microsecs, CPU time)"
+				<< std::endl;
+
+		// Solving the sequence of QPs with the setup/update path, where the constraint matrix is
+		// converted only once
+		startcputime = std::clock();
+		quadprog.setup(hessian, constraint_mat);
+		for (unsigned int i = 0; i < N; i++) {
+			gradient(0) = 0.001 * i;
+			quadprog.update(gradient,
+							lower_bound, upper_bound,
+							lower_constraint, upper_constraint,
+							0.);
+		}
+		cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+		std::cout << "  QuadProg++ (setup/update): " << cpu_duration / N
+				<< " (microsecs, CPU time)" << std::endl;
+	}
+
+	// Solving a batch of 4-feet problems with the fixed-size solver, where each sample has
+	// different feet positions and gradient
+	typedef dwl::solver::FixedSizeQP<12,22> ContactForceQP;
+	std::vector<ContactForceQP::Problem, Eigen::aligned_allocator<ContactForceQP::Problem> > problems(N);
+	std::vector<Eigen::MatrixXd> hessians(N), constraint_mats(N);
+	std::vector<Eigen::VectorXd> gradients(N), lower_bounds(N), upper_bounds(N);
+	std::vector<Eigen::VectorXd> lower_constraints(N), upper_constraints(N);
+	for (unsigned int i = 0; i < N; i++) {
+		buildContactForceProblem(hessians[i], gradients[i], constraint_mats[i],
+								 lower_bounds[i], upper_bounds[i],
+								 lower_constraints[i], upper_constraints[i],
+								 4);
+		gradients[i] = 10. * Eigen::VectorXd::Random(12);
+		problems[i].hessian = hessians[i];
+		problems[i].gradient = gradients[i];
+		problems[i].constraint_mat = constraint_mats[i];
+		problems[i].lower_bound = lower_bounds[i];
+		problems[i].upper_bound = upper_bounds[i];
+		problems[i].lower_constraint = lower_constraints[i];
+		problems[i].upper_constraint = upper_constraints[i];
+	}
+	std::cout << "Batch of " << N << " contact forces of 4 feet" << std::endl;
+
+	dwl::solver::QuadProgQP quadprog;
+	quadprog.init(12, 22);
+	std::clock_t startcputime = std::clock();
+	for (unsigned int i = 0; i < N; i++) {
+		quadprog.compute(hessians[i], gradients[i],
+						 constraint_mats[i],
+						 lower_bounds[i], upper_bounds[i],
+						 lower_constraints[i], upper_constraints[i],
+						 0.);
+	}
+	double cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+	std::cout << "  QuadProg++ (compute): " << cpu_duration / N << " (microsecs, CPU time)"
+			<< std::endl;
+
+	ContactForceQP fixed_size_qp;
+	std::vector<ContactForceQP::VariableVector,
+			Eigen::aligned_allocator<ContactForceQP::VariableVector> > solutions(N);
+	std::vector<bool> success;
+	startcputime = std::clock();
+	for (unsigned int i = 0; i < N; i++)
+		fixed_size_qp.solve(solutions[i], problems[i]);
+	cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+	std::cout << "  Fixed-size (solve): " << cpu_duration / N << " (microsecs, CPU time)"
+			<< std::endl;
+
+	startcputime = std::clock();
+	unsigned int num_solved = fixed_size_qp.solveBatch(solutions, success, problems);
+	cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+	std::cout << "  Fixed-size (batch, shared Hessian): " << cpu_duration / N
+			<< " (microsecs, CPU time), " << num_solved << " solved" << std::endl;
+
+	dwl::utils::ThreadPool pool;
+	std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+	num_solved = fixed_size_qp.solveBatch(solutions, success, problems, &pool);
+	double wall_duration = std::chrono::duration<double, std::micro>(
+			std::chrono::steady_clock::now() - start_time).count();
+	std::cout << "  Fixed-size (batch, " << pool.getNumberOfThreads() << " threads): "
+			<< wall_duration / N << " (microsecs, wall time), " << num_solved << " solved"
+			<< std::endl;
+
+	return 0;
+}
@@ -0,0 +1,225 @@
+#include <dwl/solver/OperatorSplittingQP.h>
+#include <dwl/solver/QuadProg++QP.h>
+#ifdef DWL_WITH_QPOASES
+#include <dwl/solver/qpOASES.h>
+#endif
+#include <ctime>
+#include <iostream>
+
+
+/**
+ * @brief Random MPC-shaped QP, i.e. a linear system with input and state bounds that is
+ * described in sparse (non-condensed) and dense (condensed) forms
+ */
+struct MPCProblem
+{
+	unsigned int states;
+	unsigned int inputs;
+	unsigned int horizon;
+	Eigen::MatrixXd A, B;
+	Eigen::VectorXd x0;
+
+	// Sparse formulation with variables [u_0, x_1, u_1, ..., u_{N-1}, x_N]
+	Eigen::SparseMatrix<double> sparse_hessian, sparse_constraint_mat;
+	Eigen::VectorXd sparse_gradient, sparse_lb, sparse_ub, sparse_lbG, sparse_ubG;
+
+	// Condensed formulation with variables [u_0, ..., u_{N-1}]
+	Eigen::MatrixXd dense_hessian, dense_constraint_mat;
+	Eigen::VectorXd dense_gradient, dense_lb, dense_ub, dense_lbG, dense_ubG;
+	Eigen::MatrixXd A_bar, B_bar;
+};
+
+
+void buildProblem(MPCProblem& problem,
+				  unsigned int states,
+				  unsigned int inputs,
+				  unsigned int horizon)
+{
+	problem.states = states;
+	problem.inputs = inputs;
+	problem.horizon = horizon;
+
+	// Generating a random and marginally stable system
+	Eigen::MatrixXd random = Eigen::MatrixXd::Random(states, states);
+	problem.A = Eigen::MatrixXd::Identity(states, states) + 0.1 * random;
+	problem.A /= problem.A.jacobiSvd().singularValues()(0);
+	problem.B = Eigen::MatrixXd::Random(states, inputs);
+	problem.x0 = Eigen::VectorXd::Random(states);
+	double state_limit = 5.;
+	double input_limit = 1.;
+
+	// Building the sparse formulation with unit weights in states and 0.1 in inputs
+	unsigned int knot_size = states + inputs;
+	unsigned int num_vars = horizon * knot_size;
+	std::vector<Eigen::Triplet<double> > hessian_triplets, constraint_triplets;
+	for (unsigned int k = 0; k < horizon; k++) {
+		unsigned int input_idx = k * knot_size;
+		unsigned int state_idx = input_idx + inputs;
+		for (unsigned int i = 0; i < inputs; i++)
+			hessian_triplets.push_back(Eigen::Triplet<double>(input_idx + i, input_idx + i, 0.1));
+		for (unsigned int i = 0; i < states; i++)
+			hessian_triplets.push_back(Eigen::Triplet<double>(state_idx + i, state_idx + i, 1.));
+
+		for (unsigned int i = 0; i < states; i++) {
+			unsigned int row = k * states + i;
+			constraint_triplets.push_back(Eigen::Triplet<double>(row, state_idx + i, 1.));
+			for (unsigned int j = 0; j < inputs; j++)
+				constraint_triplets.push_back(
+						Eigen::Triplet<double>(row, input_idx + j, -problem.B(i,j)));
+			if (k > 0)
+				for (unsigned int j = 0; j < states; j++)
+					constraint_triplets.push_back(
+							Eigen::Triplet<double>(row, input_idx - states + j, -problem.A(i,j)));
+		}
+	}
+	problem.sparse_hessian.resize(num_vars, num_vars);
+	problem.sparse_hessian.setFromTriplets(hessian_triplets.begin(), hessian_triplets.end());
+	problem.sparse_constraint_mat.resize(horizon * states, num_vars);
+	problem.sparse_constraint_mat.setFromTriplets(constraint_triplets.begin(),
+												  constraint_triplets.end());
+	problem.sparse_gradient = Eigen::VectorXd::Zero(num_vars);
+	problem.sparse_lb = Eigen::VectorXd::Constant(num_vars, -state_limit);
+	problem.sparse_ub = Eigen::VectorXd::Constant(num_vars, state_limit);
+	for (unsigned int k = 0; k < horizon; k++) {
+		problem.sparse_lb.segment(k * knot_size, inputs).setConstant(-input_limit);
+		problem.sparse_ub.segment(k * knot_size, inputs).setConstant(input_limit);
+	}
+	problem.sparse_lbG = Eigen::VectorXd::Zero(horizon * states);
+	problem.sparse_lbG.head(states) = problem.A * problem.x0;
+	problem.sparse_ubG = problem.sparse_lbG;
+
+	// Building the condensed formulation, where the state bounds are constraints
+	problem.A_bar = Eigen::MatrixXd::Zero(horizon * states, states);
+	problem.B_bar = Eigen::MatrixXd::Zero(horizon * states, horizon * inputs);
+	Eigen::MatrixXd A_pow = problem.A;
+	for (unsigned int i = 0; i < horizon; i++) {
+		problem.A_bar.block(i * states, 0, states, states) = A_pow;
+		A_pow = problem.A * A_pow;
+	}
+	for (unsigned int i = 0; i < horizon; i++) {
+		Eigen::MatrixXd A_pow_B = problem.B;
+		for (unsigned int j = i + 1; j-- > 0;) {
+			problem.B_bar.block(i * states, j * inputs, states, inputs) = A_pow_B;
+			A_pow_B = problem.A * A_pow_B;
+		}
+	}
+	problem.dense_hessian = problem.B_bar.transpose() * problem.B_bar +
+			0.1 * Eigen::MatrixXd::Identity(horizon * inputs, horizon * inputs);
+	problem.dense_gradient = problem.B_bar.transpose() * problem.A_bar * problem.x0;
+	problem.dense_constraint_mat = problem.B_bar;
+	problem.dense_lb = Eigen::VectorXd::Constant(horizon * inputs, -input_limit);
+	problem.dense_ub = Eigen::VectorXd::Constant(horizon * inputs, input_limit);
+	problem.dense_lbG = Eigen::VectorXd::Constant(horizon * states, -state_limit) -
+			problem.A_bar * problem.x0;
+	problem.dense_ubG = Eigen::VectorXd::Constant(horizon * states, state_limit) -
+			problem.A_bar * problem.x0;
+}
+
+
+void updateInitialState(MPCProblem& problem,
+						const Eigen::VectorXd& x0)
+{
+	problem.x0 = x0;
+	problem.sparse_lbG.head(problem.states) = problem.A * x0;
+	problem.sparse_ubG.head(problem.states) = problem.A * x0;
+	problem.dense_gradient = problem.B_bar.transpose() * problem.A_bar * x0;
+	problem.dense_lbG = -5. * Eigen::VectorXd::Ones(problem.horizon * problem.states) -
+			problem.A_bar * x0;
+	problem.dense_ubG = 5. * Eigen::VectorXd::Ones(problem.horizon * problem.states) -
+			problem.A_bar * x0;
+}
+
+
+int main(int argc, char **argv)
+{
+	// The number of MPC ticks of each problem
+	unsigned int N = 50;
+	unsigned int states = 12;
+	unsigned int inputs = 4;
+	unsigned int horizons[] = {10, 25, 50, 100};
+
+	srand(0);
+	for (unsigned int h = 0; h < 4; h++) {
+		MPCProblem problem;
+		buildProblem(problem, states, inputs, horizons[h]);
+		std::cout << "Horizon " << horizons[h] << " (sparse: " << problem.sparse_hessian.rows()
+				<< " variables, condensed: " << problem.dense_hessian.rows() << " variables)"
+				<< std::endl;
+
+		// Generating the sequence of initial states
+		std::vector<Eigen::VectorXd> initial_states;
+		for (unsigned int i = 0; i < N; i++)
+			initial_states.push_back(problem.x0 + 0.05 * i * Eigen::VectorXd::Ones(states));
+
+		// Sparse ADMM with the setup/update path
+		dwl::solver::OperatorSplittingQP sparse_admm;
+		sparse_admm.init(problem.sparse_hessian.rows(), problem.sparse_constraint_mat.rows());
+		std::clock_t startcputime = std::clock();
+		sparse_admm.setupSparse(problem.sparse_hessian, problem.sparse_constraint_mat);
+		unsigned int iterations = 0;
+		for (unsigned int i = 0; i < N; i++) {
+			updateInitialState(problem, initial_states[i]);
+			sparse_admm.update(problem.sparse_gradient,
+							   problem.sparse_lb, problem.sparse_ub,
+							   problem.sparse_lbG, problem.sparse_ubG,
+							   0.);
+			iterations += sparse_admm.getStatistics().num_iterations;
+		}
+		double cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+		std::cout << "  Sparse ADMM (setup/update): " << cpu_duration / N
+				<< " (microsecs, CPU time), " << iterations / N << " iterations" << std::endl;
+
+		// Condensed ADMM, i.e. dense matrices on each tick
+		dwl::solver::OperatorSplittingQP dense_admm;
+		dense_admm.init(problem.dense_hessian.rows(), problem.dense_constraint_mat.rows());
+		startcputime = std::clock();
+		for (unsigned int i = 0; i < N; i++) {
+			updateInitialState(problem, initial_states[i]);
+			dense_admm.compute(problem.dense_hessian, problem.dense_gradient,
+							   problem.dense_constraint_mat,
+							   problem.dense_lb, problem.dense_ub,
+							   problem.dense_lbG, problem.dense_ubG,
+							   0.);
+		}
+		cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+		std::cout << "  Condensed ADMM: " << cpu_duration / N << " (microsecs, CPU time)"
+				<< std::endl;
+
+		// Condensed QuadProg++ with the setup/update path
+		dwl::solver::QuadProgQP dual_active_set;
+		dual_active_set.init(problem.dense_hessian.rows(), problem.dense_constraint_mat.rows());
+		startcputime = std::clock();
+		dual_active_set.setup(problem.dense_hessian, problem.dense_constraint_mat);
+		for (unsigned int i = 0; i < N; i++) {
+			updateInitialState(problem, initial_states[i]);
+			dual_active_set.update(problem.dense_gradient,
+								   problem.dense_lb, problem.dense_ub,
+								   problem.dense_lbG, problem.dense_ubG,
+								   0.);
+		}
+		cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+		std::cout << "  Condensed QuadProg++ (setup/update): " << cpu_duration / N
+				<< " (microsecs, CPU time)" << std::endl;
+
+#ifdef DWL_WITH_QPOASES
+		// Condensed qpOASES with the setup/update path
+		dwl::solver::qpOASES active_set;
+		active_set.init(problem.dense_hessian.rows(), problem.dense_constraint_mat.rows());
+		active_set.setNumberOfWorkingSetRecalculations(1000);
+		startcputime = std::clock();
+		active_set.setup(problem.dense_hessian, problem.dense_constraint_mat);
+		for (unsigned int i = 0; i < N; i++) {
+			updateInitialState(problem, initial_states[i]);
+			active_set.update(problem.dense_gradient,
+							  problem.dense_lb, problem.dense_ub,
+							  problem.dense_lbG, problem.dense_ubG,
+							  1.);
+		}
+		cpu_duration = (std::clock() - startcputime) * 1000000 / (double) CLOCKS_PER_SEC;
+		std::cout << "  Condensed qpOASES (setup/update): " << cpu_duration / N
+				<< " (microsecs, CPU time)" << std::endl;
+#endif
+	}
+
+	return 0;
+}
@@ -4,6 +4,34 @@
 namespace dwl
 {
 
+/**
+ * @brief Copies the contact states reusing the memory of the vectors when both states have the
+ * same contact names
+ */
+template <typename TContactMap>
+static void copyContactStates(TContactMap& to,
+							  const TContactMap& from)
+{
+	if (to.size() == from.size()) {
+		typename TContactMap::iterator to_it = to.begin();
+		typename TContactMap::const_iterator from_it = from.begin();
+		for (; from_it != from.end(); ++from_it, ++to_it) {
+			if (to_it->first != from_it->first)
+				break;
+		}
+
+		if (from_it == from.end()) {
+			for (to_it = to.begin(), from_it = from.begin();
+					from_it != from.end(); ++from_it, ++to_it)
+				to_it->second = from_it->second;
+			return;
+		}
+	}
+
+	to = from;
+}
+
+
 WholeBodyState::WholeBodyState(unsigned int num_joints) :
 		time(0.), duration(0.), num_joints_(num_joints), default_joint_value_(0.)
 {
@@ -24,12 +52,56 @@ WholeBodyState::WholeBodyState(unsigned int num_joints) :
 }
 
 
+WholeBodyState::WholeBodyState(const WholeBodyState& other) :
+		time(other.time), duration(other.duration), base_pos(other.base_pos),
+		base_vel(other.base_vel), base_acc(other.base_acc), base_eff(other.base_eff),
+		joint_pos(other.joint_pos), joint_vel(other.joint_vel), joint_acc(other.joint_acc),
+		joint_eff(other.joint_eff), contact_pos(other.contact_pos),
+		contact_vel(other.contact_vel), contact_acc(other.contact_acc),
+		contact_eff(other.contact_eff), num_joints_(other.num_joints_),
+		frame_tf_(other.frame_tf_), default_joint_value_(other.default_joint_value_),
+		null_3dvector_(other.null_3dvector_), null_6dvector_(other.null_6dvector_)
+{
+
+}
+
+
 WholeBodyState::~WholeBodyState()
 {
 
 }
 
 
+WholeBodyState& WholeBodyState::operator=(const WholeBodyState& other)
+{
+	if (this == &other)
+		return *this;
+
+	time = other.time;
+	duration = other.duration;
+	base_pos = other.base_pos;
+	base_vel = other.base_vel;
+	base_acc = other.base_acc;
+	base_eff = other.base_eff;
+	joint_pos = other.joint_pos;
+	joint_vel = other.joint_vel;
+	joint_acc = other.joint_acc;
+	joint_eff = other.joint_eff;
+	copyContactStates(contact_pos, other.contact_pos);
+	copyContactStates(contact_vel, other.contact_vel);
+	copyContactStates(contact_acc, other.contact_acc);
+	copyContactStates(contact_eff, other.contact_eff);
+
+	num_joints_ = other.num_joints_;
+	frame_tf_ = other.frame_tf_;
+	default_joint_value_ = other.default_joint_value_;
+	null_3dvector_ = other.null_3dvector_;
+	null_6dvector_ = other.null_6dvector_;
+
+	return *this;
+}
+
+
 const double& WholeBodyState::getTime() const
 {
 	return time;
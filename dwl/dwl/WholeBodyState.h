@@ -77,9 +77,24 @@ class WholeBodyState
 		/** @brief Constructor function */
 		WholeBodyState(unsigned int num_joints = 0);
 
+		/**
+		 * @brief Copy constructor function
+		 * @param const WholeBodyState& Whole-body state to copy
+		 */
+		WholeBodyState(const WholeBodyState& other);
+
 		/** @brief Destructor function */
 		~WholeBodyState();
 
+		/**
+		 * @brief Copies a whole-body state. The memory of the joint and contact states is reused
+		 * if the dimensions and contact names are the same, so updating a preallocated state
+		 * doesn't allocate memory
+		 * @param const WholeBodyState& Whole-body state to copy
+		 * @return WholeBodyState& This whole-body state
+		 */
+		WholeBodyState& operator=(const WholeBodyState& other);
+
 		// Time getter function
 		/** @brief Gets the time value
 		 * @return The time value
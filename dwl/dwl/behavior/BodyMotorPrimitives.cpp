@@ -39,6 +39,8 @@ void BodyMotorPrimitives::read(std::string filename)
 			actions_.push_back(body_action);
 	}
 
+	// The lattice is computed again with the new motor primitives
+	lattice_.clear();
 	is_defined_motor_primitives_ = true;
 }
 
@@ -67,5 +69,48 @@ void BodyMotorPrimitives::generateActions(std::vector<Action3d>& actions,
 	}
 }
 
+void BodyMotorPrimitives::computeLattice(const environment::SpaceDiscretization& space_discretization)
+{
+	double position_resolution = space_discretization.getStateResolution(true);
+	double angular_resolution = space_discretization.getStateResolution(false);
+	if (!lattice_.empty() && position_resolution == lattice_position_resolution_ &&
+			angular_resolution == lattice_angular_resolution_)
+		return;
+
+	lattice_position_resolution_ = position_resolution;
+	lattice_angular_resolution_ = angular_resolution;
+
+	// Computing the actions of every yaw key, i.e. the keys of the yaw in [0, 2pi)
+	unsigned int num_yaw_keys = ceil(2 * M_PI / angular_resolution);
+	lattice_.assign(num_yaw_keys, std::vector<LatticeAction3d>());
+	for (unsigned int key_yaw = 0; key_yaw < num_yaw_keys; key_yaw++) {
+		double yaw;
+		space_discretization.keyToState(yaw, key_yaw, false);
+
+		for (unsigned int i = 0; i < actions_.size(); i++) {
+			// Rotating the motor action by the yaw
+			double delta_x = actions_[i].action(rbd::X);
+			double delta_y = actions_[i].action(rbd::Y);
+			double delta_th = actions_[i].action(rbd::Z);
+
+			LatticeAction3d lattice_action;
+			lattice_action.action(rbd::X) = delta_x * cos(yaw) - delta_y * sin(yaw);
+			lattice_action.action(rbd::Y) = delta_x * sin(yaw) + delta_y * cos(yaw);
+			lattice_action.action(rbd::Z) = delta_th;
+			lattice_action.cost = actions_[i].cost;
+
+			// Discretizing the action, where the states are the centers of their cells, so the
+			// offset is the rounded displacement
+			lattice_action.delta_key_x =
+					(int) floor(lattice_action.action(rbd::X) / position_resolution + 0.5);
+			lattice_action.delta_key_y =
+					(int) floor(lattice_action.action(rbd::Y) / position_resolution + 0.5);
+			space_discretization.stateToKey(lattice_action.key_yaw, yaw + delta_th, false);
+
+			lattice_[key_yaw].push_back(lattice_action);
+		}
+	}
+}
+
 } //@namespace behavior
 } //@namespace dwl
@@ -45,6 +45,15 @@ class BodyMotorPrimitives : public MotorPrimitives
 		void generateActions(std::vector<Action3d>& actions,
 							 Pose3d state);
 
+		/**
+		 * @brief Computes the lattice of the body motor primitives. For every yaw key, the
+		 * actions are rotated by its yaw, and they are stored as key offsets of the position and
+		 * the key of the reached yaw. So a successor is obtained by adding integer keys, instead
+		 * of rotating and discretizing the action
+		 * @param const environment::SpaceDiscretization& Space discretization of the states
+		 */
+		void computeLattice(const environment::SpaceDiscretization& space_discretization);
+
 	private:
 		/** @brief Vector of body actions */
 		std::vector<BodyMotorPrimitive> actions_;
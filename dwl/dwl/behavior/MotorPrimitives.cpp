@@ -7,7 +7,8 @@ namespace dwl
 namespace behavior
 {
 
-MotorPrimitives::MotorPrimitives() : is_defined_motor_primitives_(false)
+MotorPrimitives::MotorPrimitives() : is_defined_motor_primitives_(false),
+		lattice_position_resolution_(0.), lattice_angular_resolution_(0.)
 {
 
 }
@@ -25,6 +26,24 @@ void MotorPrimitives::generateActions(std::vector<Action3d>& actions, Pose3d sta
 			" primitives\n" COLOR_RESET);
 }
 
+
+void MotorPrimitives::computeLattice(const environment::SpaceDiscretization& space_discretization)
+{
+	printf(YELLOW "Could not compute the lattice because it is required to define the motor"
+			" primitives\n" COLOR_RESET);
+}
+
+
+const std::vector<LatticeAction3d>& MotorPrimitives::getLatticeActions(unsigned short int key_yaw) const
+{
+	if (key_yaw >= lattice_.size()) {
+		static const std::vector<LatticeAction3d> no_actions;
+		return no_actions;
+	}
+
+	return lattice_[key_yaw];
+}
+
 } //@namespace behavior
 
 } //@namespace dwl
@@ -1,6 +1,7 @@
 #ifndef DWL__BEHAVIOR__MOTOR_PRIMITIVES__H
 #define DWL__BEHAVIOR__MOTOR_PRIMITIVES__H
 
+#include <dwl/environment/SpaceDiscretization.h>
 #include <dwl/utils/utils.h>
 
 
@@ -36,9 +37,31 @@ class MotorPrimitives
 		 */
 		virtual void generateActions(std::vector<Action3d>& actions, Pose3d state);
 
+		/**
+		 * @brief Abstract method for computing the lattice of the motor primitives, i.e. the
+		 * actions of every yaw key of the state space. It's only recomputed if the state
+		 * resolution changed
+		 * @param const environment::SpaceDiscretization& Space discretization of the states
+		 */
+		virtual void computeLattice(const environment::SpaceDiscretization& space_discretization);
+
+		/**
+		 * @brief Gets the lattice actions of a yaw key
+		 * @param unsigned short int Key of the yaw
+		 * @return const std::vector<LatticeAction3d>& Lattice actions
+		 */
+		const std::vector<LatticeAction3d>& getLatticeActions(unsigned short int key_yaw) const;
+
 
 	protected:
 		bool is_defined_motor_primitives_;
+
+		/** @brief Lattice actions per yaw key */
+		std::vector<std::vector<LatticeAction3d> > lattice_;
+
+		/** @brief State resolutions (position and angular) of the lattice */
+		double lattice_position_resolution_;
+		double lattice_angular_resolution_;
 };
 
 } //@namespace behavior
@@ -37,18 +37,20 @@ std::string Feature::getName()
 
 
 void Feature::computeCost(double& cost_value,
-						  const Terrain& terrain_info)
+						  const Terrain& terrain_info) const
 {
 	printf(YELLOW "Could not computed the cost value of the terrain because"
-			" was not defined\n" COLOR_RESET);
+			" was not defined, note that the %s feature has to override the const"
+			" computeCost()\n" COLOR_RESET, name_.c_str());
 }
 
 
 void Feature::computeCost(double& cost_value,
-						  const RobotAndTerrain& info)
+						  const RobotAndTerrain& info) const
 {
 	printf(YELLOW "Could not computed the cost value of the robot because was"
-			" not defined\n" COLOR_RESET);
+			" not defined, note that the %s feature has to override the const"
+			" computeCost()\n" COLOR_RESET, name_.c_str());
 }
 
 
@@ -58,7 +60,7 @@ void Feature::setWeight(double weight)
 }
 
 
-void Feature::getWeight(double& weight)
+void Feature::getWeight(double& weight) const
 {
 	weight = weight_;
 }
@@ -33,22 +33,24 @@ class Feature
 
 		/**
 		 * @brief Abstract method to compute the cost value according some
-		 * terrain information
+		 * terrain information. It can be called concurrently, so it can't
+		 * modify the feature
 		 * @param double& Reference of the cost variable
 		 * @param const Terrain& Information about the terrain, i.e. position,
 		 * surface and curvature
 		 */
 		virtual void computeCost(double& cost_value,
-								 const Terrain& terrain_info);
+								 const Terrain& terrain_info) const;
 
 		/**
 		 * @brief Abstract method to compute the cost value according some robot
-		 * and terrain information
+		 * and terrain information. It can be called concurrently (e.g. for the
+		 * successors of an expansion), so it can't modify the feature
 		 * @param double& Reference of the reward variable
 		 * @param const RobotAndTerrain& Information of the robot and terrain
 		 */
 		virtual void computeCost(double& cost_value,
-								 const RobotAndTerrain& info);
+								 const RobotAndTerrain& info) const;
 
 		/**
 		 * @brief Sets the weight of the feature
@@ -60,7 +62,7 @@ class Feature
 		 * @brief Gets the weight of the feature
 		 * @param double& Weight of the feature
 		 */
-		void getWeight(double& weight);
+		void getWeight(double& weight) const;
 
 		/**
 		 * @brief Sets the neighboring area for computing some feature
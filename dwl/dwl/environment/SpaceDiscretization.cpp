@@ -259,8 +259,7 @@ void SpaceDiscretization::stateToVertex(Vertex& vertex,
 	stateToKey(key_y, (double) state(rbd::Y), true);
 	stateToKey(key_yaw, (double) state(rbd::Z), false);
 
-	vertex = (unsigned long int) key_yaw + max_angular_count_ * key_y +
-			max_angular_count_ * max_position_count_ * key_x;
+	stateKeyToVertex(vertex, key_x, key_y, key_yaw);
 }
 
 
@@ -283,10 +282,8 @@ void SpaceDiscretization::vertexToState(Eigen::Vector2d& state,
 void SpaceDiscretization::vertexToState(Eigen::Vector3d& state,
 										const Vertex& vertex) const
 {
-	unsigned short int key_x = floor(vertex / (max_position_count_ * max_angular_count_));
-	unsigned short int key_y = floor(vertex / max_angular_count_) - max_position_count_ * key_x;
-	unsigned short int key_yaw = vertex - max_angular_count_ * key_y -
-			max_angular_count_ * max_position_count_ * key_x;
+	unsigned short int key_x, key_y, key_yaw;
+	vertexToStateKey(key_x, key_y, key_yaw, vertex);
 
 	double x, y, yaw;
 	keyToState(x, key_x, true);
@@ -299,6 +296,27 @@ void SpaceDiscretization::vertexToState(Eigen::Vector3d& state,
 }
 
 
+void SpaceDiscretization::stateKeyToVertex(Vertex& vertex,
+										   unsigned short int key_x,
+										   unsigned short int key_y,
+										   unsigned short int key_yaw) const
+{
+	vertex = (unsigned long int) key_yaw + max_angular_count_ * key_y +
+			max_angular_count_ * max_position_count_ * key_x;
+}
+
+
+void SpaceDiscretization::vertexToStateKey(unsigned short int& key_x,
+										   unsigned short int& key_y,
+										   unsigned short int& key_yaw,
+										   const Vertex& vertex) const
+{
+	key_x = floor(vertex / (max_position_count_ * max_angular_count_));
+	key_y = floor(vertex / max_angular_count_) - max_position_count_ * key_x;
+	key_yaw = vertex - max_angular_count_ * key_y - max_angular_count_ * max_position_count_ * key_x;
+}
+
+
 void SpaceDiscretization::stateVertexToEnvironmentVertex(Vertex& environment_vertex,
 														 const Vertex& state_vertex,
 														 TypeOfState state) const
@@ -190,6 +190,30 @@ class SpaceDiscretization
 		void vertexToState(Eigen::Vector3d& state,
 						   const Vertex& vertex) const;
 
+		/**
+		 * @brief Converts the keys of a 3d state (x,y,yaw) to a vertex
+		 * @param Vertex& Vertex id
+		 * @param unsigned short int Key of the x position
+		 * @param unsigned short int Key of the y position
+		 * @param unsigned short int Key of the yaw
+		 */
+		void stateKeyToVertex(Vertex& vertex,
+							  unsigned short int key_x,
+							  unsigned short int key_y,
+							  unsigned short int key_yaw) const;
+
+		/**
+		 * @brief Converts a vertex to the keys of a 3d state (x,y,yaw)
+		 * @param unsigned short int& Key of the x position
+		 * @param unsigned short int& Key of the y position
+		 * @param unsigned short int& Key of the yaw
+		 * @param const Vertex& Vertex id
+		 */
+		void vertexToStateKey(unsigned short int& key_x,
+							  unsigned short int& key_y,
+							  unsigned short int& key_yaw,
+							  const Vertex& vertex) const;
+
 		/**
 		 * @brief Converts a state vertex to an environment vertex
 		 * @param Vertex& Environment vertex (x,y)
@@ -0,0 +1,161 @@
+#include <dwl/environment/SpatialIndex.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+SpatialIndex::SpatialIndex(unsigned short int bucket_size) : bucket_size_(bucket_size),
+		min_bucket_x_(std::numeric_limits<int>::max()),
+		min_bucket_y_(std::numeric_limits<int>::max()),
+		max_bucket_x_(std::numeric_limits<int>::min()),
+		max_bucket_y_(std::numeric_limits<int>::min()), size_(0)
+{
+	if (bucket_size_ == 0) {
+		printf(YELLOW "Warning: the bucket size has to be positive, setting it to 1\n"
+				COLOR_RESET);
+		bucket_size_ = 1;
+	}
+}
+
+
+SpatialIndex::~SpatialIndex()
+{
+
+}
+
+
+void SpatialIndex::insert(const Key& key,
+						  Vertex vertex)
+{
+	int bucket_x = key.x / bucket_size_;
+	int bucket_y = key.y / bucket_size_;
+
+	Entry entry;
+	entry.x = key.x;
+	entry.y = key.y;
+	entry.vertex = vertex;
+	buckets_[getBucketId(bucket_x, bucket_y)].push_back(entry);
+	size_++;
+
+	// Updating the bounds of the buckets. Note that they aren't shrunk when a cell is removed,
+	// so they are conservative
+	min_bucket_x_ = std::min(min_bucket_x_, bucket_x);
+	min_bucket_y_ = std::min(min_bucket_y_, bucket_y);
+	max_bucket_x_ = std::max(max_bucket_x_, bucket_x);
+	max_bucket_y_ = std::max(max_bucket_y_, bucket_y);
+}
+
+
+void SpatialIndex::remove(const Key& key,
+						  Vertex vertex)
+{
+	std::unordered_map<unsigned long int, std::vector<Entry> >::iterator bucket_it =
+			buckets_.find(getBucketId(key.x / bucket_size_, key.y / bucket_size_));
+	if (bucket_it == buckets_.end())
+		return;
+
+	std::vector<Entry>& bucket = bucket_it->second;
+	for (unsigned int i = 0; i < bucket.size(); i++) {
+		if (bucket[i].vertex == vertex) {
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			size_--;
+			break;
+		}
+	}
+
+	if (bucket.empty())
+		buckets_.erase(bucket_it);
+}
+
+
+void SpatialIndex::clear()
+{
+	buckets_.clear();
+	min_bucket_x_ = min_bucket_y_ = std::numeric_limits<int>::max();
+	max_bucket_x_ = max_bucket_y_ = std::numeric_limits<int>::min();
+	size_ = 0;
+}
+
+
+bool SpatialIndex::getClosestVertex(Vertex& vertex,
+									double key_x,
+									double key_y) const
+{
+	if (size_ == 0)
+		return false;
+
+	// Visiting the rings of buckets around the bucket of the point, until the closest cell
+	// found is nearer than any cell of the next ring
+	int bucket_x = (int) floor(key_x / bucket_size_);
+	int bucket_y = (int) floor(key_y / bucket_size_);
+	double closest_distance = std::numeric_limits<double>::max();
+
+	// Starting from the first ring that reaches the bounds of the buckets
+	int first_ring = std::max(std::max(min_bucket_x_ - bucket_x, bucket_x - max_bucket_x_),
+							  std::max(min_bucket_y_ - bucket_y, bucket_y - max_bucket_y_));
+	for (int ring = std::max(first_ring, 0); ; ring++) {
+		int first_bx = std::max(bucket_x - ring, min_bucket_x_);
+		int last_bx = std::min(bucket_x + ring, max_bucket_x_);
+		for (int bx = first_bx; bx <= last_bx; bx++) {
+			// The end columns of the ring are visited entirely, and the inner columns only at
+			// their first and last rows
+			int step = (bx == bucket_x - ring || bx == bucket_x + ring) ? 1 : 2 * ring;
+			for (int by = bucket_y - ring; by <= bucket_y + ring; by += step) {
+				if (by < min_bucket_y_ || by > max_bucket_y_)
+					continue;
+
+				std::unordered_map<unsigned long int, std::vector<Entry> >::const_iterator
+						bucket_it = buckets_.find(getBucketId(bx, by));
+				if (bucket_it == buckets_.end())
+					continue;
+
+				const std::vector<Entry>& bucket = bucket_it->second;
+				for (unsigned int i = 0; i < bucket.size(); i++) {
+					double dx = bucket[i].x + 0.5 - key_x;
+					double dy = bucket[i].y + 0.5 - key_y;
+					double distance = dx * dx + dy * dy;
+					if (distance < closest_distance) {
+						closest_distance = distance;
+						vertex = bucket[i].vertex;
+					}
+				}
+			}
+		}
+
+		// Checking if the rings covered all the buckets
+		if (bucket_x - ring <= min_bucket_x_ && bucket_x + ring >= max_bucket_x_ &&
+				bucket_y - ring <= min_bucket_y_ && bucket_y + ring >= max_bucket_y_)
+			break;
+
+		// Computing the distance from the point to the next ring
+		double ring_distance =
+				std::min(std::min(key_x - (bucket_x - ring) * bucket_size_,
+								  (bucket_x + ring + 1) * bucket_size_ - key_x),
+						 std::min(key_y - (bucket_y - ring) * bucket_size_,
+								  (bucket_y + ring + 1) * bucket_size_ - key_y));
+		if (closest_distance <= ring_distance * ring_distance)
+			break;
+	}
+
+	return true;
+}
+
+
+unsigned int SpatialIndex::size() const
+{
+	return size_;
+}
+
+
+unsigned long int SpatialIndex::getBucketId(int bucket_x,
+											int bucket_y) const
+{
+	return ((unsigned long int) bucket_x << 16) | (unsigned long int) bucket_y;
+}
+
+} //@namespace environment
+} //@namespace dwl
@@ -0,0 +1,98 @@
+#ifndef DWL__ENVIRONMENT__SPATIAL_INDEX__H
+#define DWL__ENVIRONMENT__SPATIAL_INDEX__H
+
+#include <dwl/utils/utils.h>
+#include <unordered_map>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class SpatialIndex
+ * @brief Bucket grid over the plane keys of the terrain cells. The cells are grouped in square
+ * buckets of keys, so a nearest-cell query only visits the buckets around the query point (i.e.
+ * O(1) on average for dense terrain maps), and the cells are inserted and removed in constant
+ * time as the terrain map is updated
+ */
+class SpatialIndex
+{
+	public:
+		/**
+		 * @brief Constructor function
+		 * @param unsigned short int Number of keys per side of a bucket
+		 */
+		SpatialIndex(unsigned short int bucket_size = 16);
+
+		/** @brief Destructor function */
+		~SpatialIndex();
+
+		/**
+		 * @brief Inserts a cell
+		 * @param const Key& Plane key of the cell
+		 * @param Vertex Vertex of the cell
+		 */
+		void insert(const Key& key,
+					Vertex vertex);
+
+		/**
+		 * @brief Removes a cell
+		 * @param const Key& Plane key of the cell
+		 * @param Vertex Vertex of the cell
+		 */
+		void remove(const Key& key,
+					Vertex vertex);
+
+		/** @brief Removes all the cells */
+		void clear();
+
+		/**
+		 * @brief Gets the closest cell to a point, where the distance is computed between the
+		 * point and the center of the cells
+		 * @param Vertex& Vertex of the closest cell
+		 * @param double Point in the x key units, i.e. the cell x spans [x, x + 1)
+		 * @param double Point in the y key units, i.e. the cell y spans [y, y + 1)
+		 * @return bool Returns false if there isn't any cell
+		 */
+		bool getClosestVertex(Vertex& vertex,
+							  double key_x,
+							  double key_y) const;
+
+		/** @brief Gets the number of cells */
+		unsigned int size() const;
+
+
+	private:
+		/** @brief Defines a cell of a bucket */
+		struct Entry
+		{
+			unsigned short int x;
+			unsigned short int y;
+			Vertex vertex;
+		};
+
+		/** @brief Gets the id of the bucket (bx,by) */
+		unsigned long int getBucketId(int bucket_x,
+									  int bucket_y) const;
+
+		/** @brief Cells grouped by bucket */
+		std::unordered_map<unsigned long int, std::vector<Entry> > buckets_;
+
+		/** @brief Number of keys per side of a bucket */
+		unsigned short int bucket_size_;
+
+		/** @brief Bounds of the buckets that were used */
+		int min_bucket_x_, min_bucket_y_;
+		int max_bucket_x_, max_bucket_y_;
+
+		/** @brief Number of cells */
+		unsigned int size_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
@@ -12,7 +12,7 @@ TerrainMap::TerrainMap() :
 		obstacle_discretization_(0.04, 0.04, M_PI / 200),
 		average_cost_(0.), max_cost_(0.),
 		min_height_(std::numeric_limits<double>::max()),
-		terrain_information_(false), obstacle_information_(false),
+		terrain_information_(false), terrain_version_(0), obstacle_information_(false),
 		obstacle_resolution_(0.04)
 {
 	// Setting up the default values of the cell
@@ -32,7 +32,9 @@ TerrainMap::~TerrainMap()
 void TerrainMap::reset()
 {
 	terrain_map_.clear();
+	terrain_index_.clear();
 	terrain_heightmap_.clear();
+	terrain_version_++;
 }
 
 
@@ -41,7 +43,9 @@ void TerrainMap::setTerrainMap(const TerrainData& terrain_map)
 	// Cleaning the old information
 	TerrainDataMap empty_terrain_cost_map;
 	terrain_map_.swap(empty_terrain_cost_map);
+	terrain_index_.clear();
 	average_cost_ = 0.;
+	terrain_version_++;
 
 	// Storing the terrain data according the vertex id
 	Vertex vertex_2d;
@@ -55,6 +59,8 @@ void TerrainMap::setTerrainMap(const TerrainData& terrain_map)
 			// Building a cost-map for a every 3d vertex
 			space_discretization_.keyToVertex(vertex_2d, terrain_map.data[i].key, true);
 			double cost_value = terrain_map.data[i].cost;
+			if (terrain_map_.count(vertex_2d) == 0)
+				terrain_index_.insert(terrain_map.data[i].key, vertex_2d);
 			terrain_map_[vertex_2d] = terrain_map.data[i];
 
 			// Setting up the maximum cost value
@@ -81,6 +87,16 @@ void TerrainMap::setTerrainMap(const TerrainData& terrain_map)
 void TerrainMap::setTerrainMap(const TerrainDataMap& map)
 {
 	terrain_map_ = map;
+	terrain_version_++;
+
+	// Building the spatial index of the cells
+	terrain_index_.clear();
+	for (TerrainDataMap::const_iterator cell_it = terrain_map_.begin();
+			cell_it != terrain_map_.end(); cell_it++) {
+		Key key;
+		space_discretization_.vertexToKey(key, cell_it->first, true);
+		terrain_index_.insert(key, cell_it->first);
+	}
 }
 
 
@@ -106,6 +122,7 @@ void TerrainMap::setObstacleMap(const std::vector<Cell>& obstacle_map)
 
 		obstacle_information_ = true;
 	}
+	terrain_version_++;
 }
 
 
@@ -125,13 +142,21 @@ void TerrainMap::addCellToTerrainMap(const TerrainCell& cell)
 {
 	Vertex vertex_id;
 	space_discretization_.keyToVertex(vertex_id, cell.key, true);
+	if (terrain_map_.count(vertex_id) == 0)
+		terrain_index_.insert(cell.key, vertex_id);
 	terrain_map_[vertex_id] = cell;
+	terrain_version_++;
 }
 
 
 void TerrainMap::removeCellToTerrainMap(const Vertex& cell_vertex)
 {
-	terrain_map_.erase(cell_vertex);
+	if (terrain_map_.erase(cell_vertex) > 0) {
+		Key key;
+		space_discretization_.vertexToKey(key, cell_vertex, true);
+		terrain_index_.remove(key, cell_vertex);
+	}
+	terrain_version_++;
 }
 
 
@@ -167,6 +192,7 @@ void TerrainMap::setResolution(double resolution,
 							   bool plane)
 {
 	space_discretization_.setEnvironmentResolution(resolution, plane);
+	terrain_version_++;
 }
 
 
@@ -174,6 +200,7 @@ void TerrainMap::setObstacleResolution(double resolution,
 									   bool plane)
 {
 	obstacle_discretization_.setEnvironmentResolution(resolution, plane);
+	terrain_version_++;
 }
 
 
@@ -184,6 +211,7 @@ void TerrainMap::setStateResolution(double position_resolution,
 											   angular_resolution);
 	obstacle_discretization_.setStateResolution(position_resolution,
 												angular_resolution);
+	terrain_version_++;
 }
 
 
@@ -371,6 +399,24 @@ bool TerrainMap::getTerrainNormal(Eigen::Vector3d& normal,
 }
 
 
+bool TerrainMap::getClosestTerrainVertex(Vertex& closest_vertex,
+										 const Eigen::Vector2d& position) const
+{
+	// Computing the position in key units, i.e. the key and the offset inside the cell
+	unsigned short int key_x, key_y;
+	double center_x, center_y;
+	double resolution = space_discretization_.getEnvironmentResolution(true);
+	space_discretization_.coordToKey(key_x, (double) position(rbd::X), true);
+	space_discretization_.coordToKey(key_y, (double) position(rbd::Y), true);
+	space_discretization_.keyToCoord(center_x, key_x, true);
+	space_discretization_.keyToCoord(center_y, key_y, true);
+
+	return terrain_index_.getClosestVertex(closest_vertex,
+			key_x + 0.5 + (position(rbd::X) - center_x) / resolution,
+			key_y + 0.5 + (position(rbd::Y) - center_y) / resolution);
+}
+
+
 const SpaceDiscretization& TerrainMap::getTerrainSpaceModel() const
 {
 	return space_discretization_;
@@ -389,6 +435,12 @@ double TerrainMap::getAverageCostOfTerrain()
 }
 
 
+unsigned long int TerrainMap::getTerrainVersion() const
+{
+	return terrain_version_;
+}
+
+
 bool TerrainMap::isTerrainInformation()
 {
 	return terrain_information_;
@@ -2,6 +2,7 @@
 #define DWL__ENVIRONMENT__TERRAIN_MAP__H
 
 #include <dwl/environment/SpaceDiscretization.h>
+#include <dwl/environment/SpatialIndex.h>
 #include <dwl/utils/utils.h>
 
 
@@ -162,6 +163,16 @@ class TerrainMap
 		bool getTerrainNormal(Eigen::Vector3d& normal,
 							  const Eigen::Vector2d& position) const;
 
+		/**
+		 * @brief Gets the closest terrain cell to a position. It uses a spatial index of the
+		 * cells, which is updated every time that a cell is added or removed
+		 * @param Vertex& Vertex of the closest terrain cell
+		 * @param const Eigen::Vector2d& Position
+		 * @return bool Returns false if there isn't any terrain cell
+		 */
+		bool getClosestTerrainVertex(Vertex& closest_vertex,
+									 const Eigen::Vector2d& position) const;
+
 		/**
 		 * @brief Gets the terrain discrete model of the space according
 		 * the resolution of the terrain
@@ -182,6 +193,14 @@ class TerrainMap
 		 */
 		double getAverageCostOfTerrain();
 
+		/**
+		 * @brief Gets the version of the terrain information, which increases every time the
+		 * terrain cells, the obstacles or their resolutions change. It allows to update the data
+		 * that are derived from the terrain (e.g. cost fields) only when it's needed
+		 * @return The terrain version
+		 */
+		unsigned long int getTerrainVersion() const;
+
 		/**
 		 * @brief Indicates if it was defined terrain information
 		 * @return True if it was defined terrain cost information, otherwise false
@@ -208,6 +227,9 @@ class TerrainMap
 		/** @brief Terrain values mapped using vertex id */
 		TerrainDataMap terrain_map_;
 
+		/** @brief Spatial index of the terrain cells */
+		SpatialIndex terrain_index_;
+
 		/** @brief Terrain height map */
 		HeightMap terrain_heightmap_;
 
@@ -229,6 +251,9 @@ class TerrainMap
 		/** @brief Indicates if it was defined terrain information */
 		bool terrain_information_;
 
+		/** @brief Version of the terrain information */
+		unsigned long int terrain_version_;
+
 		/** @brief Indicates if it was defined obstacle information */
 		bool obstacle_information_;
 
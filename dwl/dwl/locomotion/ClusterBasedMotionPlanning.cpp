@@ -0,0 +1,110 @@
+#include <dwl/locomotion/ClusterBasedMotionPlanning.h>
+#include <dwl/utils/Orientation.h>
+
+
+namespace dwl
+{
+
+namespace locomotion
+{
+
+ClusterBasedMotionPlanning::ClusterBasedMotionPlanning(model::AdjacencyModel* body_model,
+													   unsigned int cluster_size,
+													   unsigned int corridor_margin) :
+		corridor_margin_(corridor_margin)
+{
+	name_ = "Cluster-based";
+
+	cluster_model_ = new model::ClusterAdjacency(cluster_size);
+	abstract_solver_ = new solver::AStar();
+	abstract_solver_->setAdjacencyModel(cluster_model_);
+	abstract_solver_->init();
+
+	corridor_model_ = new model::CorridorAdjacency(body_model, cluster_model_);
+}
+
+
+ClusterBasedMotionPlanning::~ClusterBasedMotionPlanning()
+{
+	// The corridor model is owned by the path solver once it's defined
+	if (path_solver_ == NULL)
+		delete corridor_model_;
+	delete abstract_solver_;
+}
+
+
+void ClusterBasedMotionPlanning::reset(robot::Robot* robot,
+									   environment::TerrainMap* environment)
+{
+	MotionPlanning::reset(robot, environment);
+	abstract_solver_->reset(robot, environment);
+}
+
+
+void ClusterBasedMotionPlanning::reset(solver::SearchTreeSolver* solver)
+{
+	MotionPlanning::reset(solver);
+	path_solver_->setAdjacencyModel(corridor_model_);
+}
+
+
+bool ClusterBasedMotionPlanning::computePath(std::vector<Pose>& path,
+											 Pose start_pose,
+											 Pose goal_pose)
+{
+	if (path_solver_ == NULL) {
+		printf(RED "Could not compute the path because it was not defined a path solver\n"
+				COLOR_RESET);
+		return false;
+	}
+
+	// Getting the start and goal states, i.e. the position and yaw
+	Eigen::Vector3d start_state, goal_state;
+	start_state << start_pose.position.head(2), math::getRPY(start_pose.orientation)(2);
+	goal_state << goal_pose.position.head(2), math::getRPY(goal_pose.orientation)(2);
+
+	// Computing the abstract path between the start and goal cells
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	Vertex start_cell, goal_cell;
+	space_model.coordToVertex(start_cell, (Eigen::Vector2d) start_state.head(2));
+	space_model.coordToVertex(goal_cell, (Eigen::Vector2d) goal_state.head(2));
+	cluster_model_->clearCorridor();
+	if (!cluster_model_->setEndpoints(start_cell, goal_cell) ||
+			!abstract_solver_->compute(start_cell, goal_cell, path_computation_time_)) {
+		printf(YELLOW "Could not compute the abstract path, so the whole terrain is searched\n"
+				COLOR_RESET);
+	} else
+		cluster_model_->setCorridor(abstract_solver_->getShortestPath(start_cell, goal_cell),
+									corridor_margin_);
+
+	// Refining the path inside of the corridor
+	Vertex start_vertex, goal_vertex;
+	space_model.stateToVertex(start_vertex, start_state);
+	space_model.stateToVertex(goal_vertex, goal_state);
+	if (!path_solver_->compute(start_vertex, goal_vertex, path_computation_time_))
+		return false;
+
+	std::list<Vertex> shortest_path = path_solver_->getShortestPath(start_vertex, goal_vertex);
+	path.clear();
+	for (std::list<Vertex>::iterator vertex_it = shortest_path.begin();
+			vertex_it != shortest_path.end(); vertex_it++) {
+		Eigen::Vector3d state;
+		space_model.vertexToState(state, *vertex_it);
+
+		Pose pose;
+		pose.position << state.head(2), start_pose.position(2);
+		pose.orientation = math::getQuaternion(Eigen::Vector3d(0., 0., state(2)));
+		path.push_back(pose);
+	}
+
+	return true;
+}
+
+
+void ClusterBasedMotionPlanning::updateTerrainCells(const std::vector<Vertex>& cells)
+{
+	cluster_model_->updateCells(cells);
+}
+
+} //@namespace locomotion
+} //@namespace dwl
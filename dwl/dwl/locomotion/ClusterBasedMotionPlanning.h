@@ -0,0 +1,91 @@
+#ifndef DWL__LOCOMOTION__CLUSTER_BASED_MOTION_PLANNING__H
+#define DWL__LOCOMOTION__CLUSTER_BASED_MOTION_PLANNING__H
+
+#include <dwl/locomotion/MotionPlanning.h>
+#include <dwl/model/CorridorAdjacency.h>
+#include <dwl/solver/AStar.h>
+
+
+namespace dwl
+{
+
+namespace locomotion
+{
+
+/**
+ * @class ClusterBasedMotionPlanning
+ * @brief Class for planning long-range body paths hierarchically. First, it plans an abstract
+ * path over clusters of the terrain grid (see ClusterAdjacency), whose intra-cluster costs are
+ * precomputed and only recomputed for the clusters that change. Then, the path solver refines it
+ * at full resolution inside a corridor of clusters around the abstract path, so the number of
+ * expansions doesn't grow with the size of the terrain. This class derives from MotionPlanning
+ * class
+ */
+class ClusterBasedMotionPlanning : public MotionPlanning
+{
+	public:
+		/**
+		 * @brief Constructor function
+		 * @param model::AdjacencyModel* Body adjacency model of the path solver, which is owned by
+		 * the planner
+		 * @param unsigned int Size of the clusters (number of cells per side)
+		 * @param unsigned int Margin of the corridor (number of clusters)
+		 */
+		ClusterBasedMotionPlanning(model::AdjacencyModel* body_model,
+								   unsigned int cluster_size = 25,
+								   unsigned int corridor_margin = 1);
+
+		/** @brief Destructor function */
+		~ClusterBasedMotionPlanning();
+
+		/**
+		 * @brief Defines the robot and environment information of the path and abstract solvers
+		 * @param robot::Robot* Encapsulates all the properties of the robot
+		 * @param environment::TerrainMap* Encapsulates all the terrain information
+		 */
+		void reset(robot::Robot* robot,
+				   environment::TerrainMap* environment);
+
+		/**
+		 * @brief Defines the path solver, whose adjacency model is set to the body model
+		 * restricted to the corridor
+		 * @param solver::SearchTreeSolver* Path solver
+		 */
+		void reset(solver::SearchTreeSolver* solver);
+
+		/**
+		 * @brief Computes a path from start pose to goal pose, i.e. the abstract path and its
+		 * refinement inside of the corridor
+		 * @param std::vector<Pose>& Planned path
+		 * @param Pose Start pose
+		 * @param Pose Goal pose
+		 */
+		bool computePath(std::vector<Pose>& path,
+						 Pose start_pose,
+						 Pose goal_pose);
+
+		/**
+		 * @brief Reports the terrain cells that changed, so only their clusters are recomputed
+		 * @param const std::vector<Vertex>& Changed terrain vertices
+		 */
+		void updateTerrainCells(const std::vector<Vertex>& cells);
+
+
+	private:
+		/** @brief Solver of the abstract path, which owns the cluster model */
+		solver::AStar* abstract_solver_;
+
+		/** @brief Cluster model of the terrain */
+		model::ClusterAdjacency* cluster_model_;
+
+		/** @brief Body model restricted to the corridor, which is owned by the path solver */
+		model::CorridorAdjacency* corridor_model_;
+
+		/** @brief Margin of the corridor (number of clusters) */
+		unsigned int corridor_margin_;
+};
+
+} //@namespace locomotion
+} //@namespace dwl
+
+#endif
@@ -1,16 +1,17 @@
 #include <dwl/locomotion/ModelPredictiveControl.h>
 
 
-
 namespace dwl
 {
 
 namespace locomotion
 {
 
-ModelPredictiveControl::ModelPredictiveControl() : model_(NULL), optimizer_(NULL)
+ModelPredictiveControl::ModelPredictiveControl() : formulation_(Condensed), model_(NULL),
+		optimizer_(NULL), states_(0), inputs_(0), horizon_(30), variables_(0), constraints_(0),
+		infeasibility_counter_(0)
 {
-	enable_record_ = true;
+
 }
 
 
@@ -20,216 +21,234 @@ ModelPredictiveControl::~ModelPredictiveControl()
 }
 
 
-bool ModelPredictiveControl::reset(model::LinearDynamicalSystem* model,
+bool ModelPredictiveControl::reset(ocp::LinearDynamicalSystem* model,
 								   solver::QuadraticProgram* optimizer)
 {
 	// Setting of the pointer of the model and optimizer classes
 	model_ = model;
 	optimizer_ = optimizer;
+	if (model_ == NULL || optimizer_ == NULL) {
+		printf(RED "FATAL: the model and optimizer of the MPC were not defined\n" COLOR_RESET);
+		return false;
+	}
 
-	time_index_ = 0;
-	
-	// Reading of the horizon value of the model predictive control algorithm
-	nh_.param<int>("horizon", horizon_, 30);
-	ROS_INFO("Got param: horizon = %d", horizon_);
-	
-	nh_.param<int>("infeasibility_hack_counter_max", infeasibility_hack_counter_max_, 1);
-	ROS_INFO("Got param: infeasibility_hack_counter_max = %d", infeasibility_hack_counter_max_);
-
-	
 	// Reading of the problem variables
 	states_ = model_->getStatesNumber();
 	inputs_ = model_->getInputsNumber();
-	outputs_ = model_->getOutputsNumber();
-	
-	variables_ = horizon_ * inputs_;
-	constraints_ = optimizer_->getConstraintNumber();
+
+	return true;
+}
 
 
-	// Initializing the QP solver
-	if (!optimizer_->init(inputs_ * horizon_, constraints_ * horizon_))
-		return false;
+void ModelPredictiveControl::setFormulation(MPCFormulation formulation)
+{
+	formulation_ = formulation;
+}
 
-	printf("Reset successful. States = %d \n Inputs = %d \n Outputs = %d \n Constraints = %d \n",
-			states_, inputs_, outputs_, constraints_);
-	return true;
+
+void ModelPredictiveControl::setHorizon(unsigned int horizon)
+{
+	horizon_ = horizon;
+}
+
+
+void ModelPredictiveControl::setWeights(const Eigen::MatrixXd& Q,
+										const Eigen::MatrixXd& P,
+										const Eigen::MatrixXd& R)
+{
+	Q_ = Q;
+	P_ = P;
+	R_ = R;
 }
 
 
+void ModelPredictiveControl::setStateConstraints(const Eigen::MatrixXd& M,
+												 const Eigen::VectorXd& lower_bound,
+												 const Eigen::VectorXd& upper_bound)
+{
+	M_ = M;
+	lbG_ = lower_bound;
+	ubG_ = upper_bound;
+}
+
+
+void ModelPredictiveControl::setInputBounds(const Eigen::VectorXd& lower_bound,
+											const Eigen::VectorXd& upper_bound)
+{
+	lb_ = lower_bound;
+	ub_ = upper_bound;
+}
+
 
 bool ModelPredictiveControl::init()
 {
-	// Initialization of MPC solution
-	operation_states_ = new double[states_];
-	operation_inputs_ = new double[inputs_];
-	
-	
-	u_reference_ = Eigen::MatrixXd::Zero(inputs_, 1);
-	infeasibility_counter_ = 0;
-	x_.resize(states_);
-	xref_.resize(states_);
-	u_.resize(inputs_);
-	
-	
-	// Initialization of state space matrices
-	A_ = Eigen::MatrixXd::Zero(states_, states_);
-	B_ = Eigen::MatrixXd::Zero(states_, inputs_);
-	C_ = Eigen::MatrixXd::Zero(outputs_, states_);
-	
-	// Obtention of the model parameters
-	if (model_->computeLinearSystem(A_, B_)) {
-		ROS_INFO("Model calculated successfully.");
-		std::cout << "A\n" << A_ << std::endl;
-		std::cout << "B\n" << B_ << std::endl;
-	}
-	
-	// Reading the weight matrices of the cost function
-	Q_ = Eigen::MatrixXd::Zero(states_, states_);
-	P_ = Eigen::MatrixXd::Zero(states_, states_);
-	R_ = Eigen::MatrixXd::Zero(inputs_, inputs_);
-	XmlRpc::XmlRpcValue Q_list, P_list, R_list;
-	nh_.getParam("optimizer/states_error_weight_matrix/data", Q_list);
-	ROS_ASSERT(Q_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	ROS_ASSERT(Q_list.size() == states_ * states_);
-
-	nh_.getParam("optimizer/terminal_state_weight_matrix/data", P_list);
-	ROS_ASSERT(P_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	ROS_ASSERT(P_list.size() == states_ * states_);
-	
-	int z = 0;
-	for (int i = 0; i < states_; i++) {
-		for (int j = 0; j < states_; j++) {
-			ROS_ASSERT(Q_list[z].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			Q_(i, j) = static_cast<double>(Q_list[z]);
-			
-			ROS_ASSERT(P_list[z].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			P_(i, j) = static_cast<double>(P_list[z]);
-			z++;
-		}
+	if (model_ == NULL || optimizer_ == NULL) {
+		printf(RED "FATAL: the MPC has to be reset before initializing it\n" COLOR_RESET);
+		return false;
 	}
-	
-	nh_.getParam("optimizer/input_error_weight_matrix/data", R_list);
-	ROS_ASSERT(R_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	ROS_ASSERT(R_list.size() == inputs_ * inputs_);
-	z = 0;
-	for (int i = 0; i < inputs_; i++) {
-		for (int j = 0; j < inputs_; j++) {
-			ROS_ASSERT(R_list[z].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			R_(i, j) = static_cast<double>(R_list[z]);
-			z++;
-		}
+
+	// Checking the dimensions of the weight matrices. Note that the constraints and bounds are
+	// optional, and they are unbounded by default
+	if (Q_.rows() != states_ || Q_.cols() != states_ ||
+			P_.rows() != states_ || P_.cols() != states_ ||
+			R_.rows() != inputs_ || R_.cols() != inputs_) {
+		printf(RED "FATAL: the weight matrices of the MPC don't match the model dimensions\n"
+				COLOR_RESET);
+		return false;
 	}
-	
-	
-	// Creation of the states and inputs weight matrices for the quadratic program
-	Q_bar_ = Eigen::MatrixXd::Zero((horizon_ + 1) * states_, (horizon_ + 1) * states_);
-	R_bar_ = Eigen::MatrixXd::Zero(horizon_ * inputs_, horizon_ * inputs_);
-	for (int i = 0; i < horizon_; i++) {
-		Q_bar_.block(i * states_, i * states_, states_, states_) = Q_;
-		R_bar_.block(i * inputs_, i * inputs_, inputs_, inputs_) = R_;
+	double infinity = std::numeric_limits<double>::infinity();
+	if (M_.size() == 0)
+		M_.resize(0, states_);
+	if (lb_.size() == 0) {
+		lb_ = Eigen::VectorXd::Constant(inputs_, -infinity);
+		ub_ = Eigen::VectorXd::Constant(inputs_, infinity);
 	}
-	Q_bar_.block(horizon_ * states_, horizon_ * states_, states_, states_) = P_;
-	
-	
-	// Reading the constraint vectors
-	Eigen::VectorXd lbG = Eigen::VectorXd::Zero(constraints_);
-	Eigen::VectorXd ubG = Eigen::VectorXd::Zero(constraints_);
-	XmlRpc::XmlRpcValue lbG_list, ubG_list;
-	nh_.getParam("optimizer/constraints/constraint_vector_low", lbG_list);
-	ROS_ASSERT(lbG_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	nh_.getParam("optimizer/constraints/constraint_vector_upp", ubG_list);
-	ROS_ASSERT(ubG_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	if (ubG_list.size() == lbG_list.size()) {
-		for (int i = 0; i < ubG_list.size(); ++i) {
-			ROS_ASSERT(lbG_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			lbG(i) = static_cast<double>(lbG_list[i]);
-			
-			ROS_ASSERT(ubG_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			ubG(i) = static_cast<double>(ubG_list[i]);
-		}
-	
+	constraints_ = M_.rows();
+	if (M_.cols() != states_ || lbG_.size() != constraints_ || ubG_.size() != constraints_ ||
+			lb_.size() != inputs_ || ub_.size() != inputs_) {
+		printf(RED "FATAL: the constraints of the MPC don't match the model dimensions\n"
+				COLOR_RESET);
+		return false;
 	}
-	
-	// Reading the bound vectors
-	Eigen::VectorXd lb = Eigen::VectorXd::Zero(inputs_);
-	Eigen::VectorXd ub = Eigen::VectorXd::Zero(inputs_);
-	XmlRpc::XmlRpcValue lb_list, ub_list;
-	nh_.getParam("optimizer/constraints/bound_vector_low", lb_list);
-	ROS_ASSERT(lb_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	nh_.getParam("optimizer/constraints/bound_vector_upp", ub_list);
-	ROS_ASSERT(ub_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	if (ub_list.size() == lb_list.size()) {
-		for (int i = 0; i < ub_list.size(); ++i) {
-			ROS_ASSERT(lb_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			lb(i) = static_cast<double>(lb_list[i]);                              
-			
-			ROS_ASSERT(ub_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			ub(i) = static_cast<double>(ub_list[i]);
-		}
+
+	// Initializing the QP solver. The sparse formulation adds the states as variables and the
+	// dynamics as equality constraints
+	if (formulation_ == Sparse) {
+		variables_ = horizon_ * (states_ + inputs_);
+		if (!optimizer_->init(variables_, horizon_ * (states_ + constraints_)))
+			return false;
+	} else {
+		variables_ = horizon_ * inputs_;
+		if (!optimizer_->init(variables_, constraints_ * horizon_))
+			return false;
 	}
-	
-	// Reading the state bound matrix
-	Eigen::MatrixXd M = Eigen::MatrixXd::Zero(constraints_, states_);
-	XmlRpc::XmlRpcValue M_list;
-	nh_.getParam("optimizer/constraints/constraint_matrix_M", M_list);
-	ROS_ASSERT(M_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-	ROS_ASSERT(M_list.size() == constraints_ * states_);
-	
-	z = 0;
-	for (int i = 0; i < constraints_; ++i) {
-		for (int j = 0; j < states_; j++) {
-			ROS_ASSERT(M_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-			M(i, j) = static_cast<double>(M_list[z]);
-			z++;
+	infeasibility_counter_ = 0;
+	mpc_solution_ = Eigen::VectorXd::Zero(variables_);
+
+	// Obtention of the model parameters
+	A_ = Eigen::MatrixXd::Zero(states_, states_);
+	B_ = Eigen::MatrixXd::Zero(states_, inputs_);
+	model_->computeLinearSystem(A_, B_);
+
+	// Creation of the states and inputs weight matrices for the quadratic program. The sparse
+	// formulation uses directly the weight matrices of each knot
+	if (formulation_ == Condensed) {
+		Q_bar_ = Eigen::MatrixXd::Zero((horizon_ + 1) * states_, (horizon_ + 1) * states_);
+		R_bar_ = Eigen::MatrixXd::Zero(horizon_ * inputs_, horizon_ * inputs_);
+		for (int i = 0; i < horizon_; i++) {
+			Q_bar_.block(i * states_, i * states_, states_, states_) = Q_;
+			R_bar_.block(i * inputs_, i * inputs_, inputs_, inputs_) = R_;
 		}
+		Q_bar_.block(horizon_ * states_, horizon_ * states_, states_, states_) = P_;
 	}
-	
-	
+
 	// Creation of the extended constraint and bound vector
 	lbG_bar_ = Eigen::VectorXd::Zero(constraints_ * horizon_);
 	ubG_bar_ = Eigen::VectorXd::Zero(constraints_ * horizon_);
 	lb_bar_ = Eigen::VectorXd::Zero(inputs_ * horizon_);
 	ub_bar_ = Eigen::VectorXd::Zero(inputs_ * horizon_);
 	for (int i = 0; i < horizon_; i++) {
-		lbG_bar_.block(i * constraints_, 0, constraints_, 1) = lbG;
-		ubG_bar_.block(i * constraints_, 0, constraints_, 1) = ubG;
-		lb_bar_.block(i * inputs_, 0, inputs_, 1) = lb;
-		ub_bar_.block(i * inputs_, 0, inputs_, 1) = ub;
+		lbG_bar_.segment(i * constraints_, constraints_) = lbG_;
+		ubG_bar_.segment(i * constraints_, constraints_) = ubG_;
+		lb_bar_.segment(i * inputs_, inputs_) = lb_;
+		ub_bar_.segment(i * inputs_, inputs_) = ub_;
 	}
-	
-	// Creation of the extended constraint matrix G_bar_
-	M_bar_ = Eigen::MatrixXd::Zero(constraints_ * horizon_, (horizon_ + 1) * states_);
-	for (int i = 0; i < horizon_; i++) {
-		for (int j = 0; j < horizon_ + 1; j++) {
-			if (i == j) {
-				M_bar_.block(i * constraints_, j * states_, constraints_, states_) = M;
-			}
-		}
+
+	// Creation of the extended constraint matrix of the states x_0, ..., x_{N-1}
+	if (formulation_ == Condensed) {
+		M_bar_ = Eigen::MatrixXd::Zero(constraints_ * horizon_, (horizon_ + 1) * states_);
+		for (int i = 0; i < horizon_; i++)
+			M_bar_.block(i * constraints_, i * states_, constraints_, states_) = M_;
 	}
-	
-	
-	printf("STDMPC class successfully initialized.");
+
+	// Setting up the constant matrices of the QP
+	if (formulation_ == Sparse)
+		setupSparseProblem(A_, B_);
+	else
+		setupCondensedProblem(A_, B_);
+
 	return true;
 }
 
 
-
-void ModelPredictiveControl::update(WholeBodyState& current_state,
-									WholeBodyState& reference_state)
+bool ModelPredictiveControl::update(const Eigen::VectorXd& measured_state,
+									const Eigen::VectorXd& reference_state)
 {
-	Eigen::Map<Eigen::VectorXd> x_measured_eigen(x_measured, states_, 1);// current_state
-	Eigen::Map<Eigen::VectorXd> x_reference_eigen(x_reference, states_, 1);// reference state
-
-	// Update of the model parameters
-	Eigen::MatrixXd A, B;
+	// Update of the model parameters. The QP matrices only change for time-varying models
 	if (model_->getModelType()) {
-		model_->computeLinearSystem(A, B);
+		model_->setLinearizationPoints(measured_state);
+		model_->computeLinearSystem(A_, B_);
+		if (formulation_ == Sparse)
+			setupSparseProblem(A_, B_);
+		else
+			setupCondensedProblem(A_, B_);
+	}
+
+	Eigen::VectorXd gradient, lb, ub, lbG, ubG;
+	if (formulation_ == Sparse) {
+		// Computing the gradient vector of the tracking cost and the bounds of the inputs. The
+		// states are unbounded
+		unsigned int knot_size = states_ + inputs_;
+		double infinity = std::numeric_limits<double>::infinity();
+		gradient = Eigen::VectorXd::Zero(variables_);
+		lb = Eigen::VectorXd::Constant(variables_, -infinity);
+		ub = Eigen::VectorXd::Constant(variables_, infinity);
+		for (int k = 0; k < horizon_; k++) {
+			const Eigen::MatrixXd& weight = (k == horizon_ - 1) ? P_ : Q_;
+			gradient.segment(k * knot_size + inputs_, states_) = -weight * reference_state;
+			lb.segment(k * knot_size, inputs_) = lb_bar_.segment(k * inputs_, inputs_);
+			ub.segment(k * knot_size, inputs_) = ub_bar_.segment(k * inputs_, inputs_);
+		}
+
+		// Computing the bounds of the dynamics, i.e. x_1 - B u_0 = A x_0 and
+		// x_{k+1} - A x_k - B u_k = 0, and of the state constraints. Note that the constraints
+		// of the first knot only depend on the measured state
+		unsigned int dynamics_size = horizon_ * states_;
+		lbG = Eigen::VectorXd::Zero(dynamics_size + horizon_ * constraints_);
+		lbG.head(states_) = A_ * measured_state;
+		lbG.tail(horizon_ * constraints_) = lbG_bar_;
+		ubG = lbG;
+		ubG.tail(horizon_ * constraints_) = ubG_bar_;
+		Eigen::VectorXd initial_constraint = M_ * measured_state;
+		lbG.segment(dynamics_size, constraints_) -= initial_constraint;
+		ubG.segment(dynamics_size, constraints_) -= initial_constraint;
+	} else {
+		// Computing the reference states for the predefined horizon
+		Eigen::VectorXd x_ref_bar((horizon_ + 1) * states_);
+		for (int i = 0; i < horizon_ + 1; i++)
+			x_ref_bar.segment(i * states_, states_) = reference_state;
+
+		// Computing the gradient vector, which is the only term of the cost that changes
+		gradient = B_bar_.transpose() * Q_bar_ * (A_bar_ * measured_state - x_ref_bar);
+
+		// Computing the constraint bounds given the measured state
+		Eigen::VectorXd free_constraint = M_bar_ * A_bar_ * measured_state;
+		lb = lb_bar_;
+		ub = ub_bar_;
+		lbG = lbG_bar_ - free_constraint;
+		ubG = ubG_bar_ - free_constraint;
+	}
+
+	// Solving the QP problem
+	double cputime = 0.008;
+	if (optimizer_->update(gradient,
+						   lb, ub,
+						   lbG, ubG,
+						   cputime)) {
+		mpc_solution_ = optimizer_->getOptimalSolution();
+		infeasibility_counter_ = 0;
+		return true;
+	} else {
+		infeasibility_counter_++;
+		printf(YELLOW "Warning: an optimal solution could not be obtained\n" COLOR_RESET);
+		return false;
 	}
-	
-	// Compute steady state control based on updated system matrices
-	Eigen::JacobiSVD<Eigen::MatrixXd> SVD_B(B, Eigen::ComputeThinU | Eigen::ComputeThinV);
-	u_reference_ = SVD_B.solve(x_reference_eigen - A * x_reference_eigen);
-	
+}
+
+
+void ModelPredictiveControl::setupCondensedProblem(const Eigen::MatrixXd& A,
+												   const Eigen::MatrixXd& B)
+{
 	// Creation of the base vector
 	std::vector<Eigen::MatrixXd> A_pow;
 	A_pow.push_back(Eigen::MatrixXd::Identity(states_, states_));
@@ -239,78 +258,82 @@ void ModelPredictiveControl::update(WholeBodyState& current_state,
 	}
 
 	// Computing the extended state and input matrixes for the predefined horizon
-	Eigen::MatrixXd A_bar = Eigen::MatrixXd::Zero((horizon_ + 1) * states_, states_);
-	Eigen::MatrixXd B_bar = Eigen::MatrixXd::Zero((horizon_ + 1) * states_, horizon_ * inputs_);
-	Eigen::MatrixXd x_ref_bar = Eigen::MatrixXd::Zero((horizon_ + 1) * states_, 1);
+	A_bar_ = Eigen::MatrixXd::Zero((horizon_ + 1) * states_, states_);
+	B_bar_ = Eigen::MatrixXd::Zero((horizon_ + 1) * states_, horizon_ * inputs_);
 	for (int i = 0; i < horizon_ + 1; i++) {
-		for (int j = 0; j < horizon_; j++) {
-			if (i == horizon_) {
-				if (j == 0) {
-					A_bar.block(i * states_, 0, states_, states_) = A_pow[i];
-					x_ref_bar.block(i * states_, 0, states_, 1) = x_reference_eigen;
-				}
-				if (i > j)
-					B_bar.block(i * states_, j * inputs_, states_, inputs_) = A_pow[i-j-1] * B;
-			} else {
-				if (j == 0) {
-					A_bar.block(i * states_, 0, states_, states_) = A_pow[i];
-					x_ref_bar.block(i * states_, 0, states_, 1) = x_reference_eigen;
-				}
-				if (i > j)
-					B_bar.block(i * states_, j * inputs_, states_, inputs_) = A_pow[i-j-1] * B;
+		A_bar_.block(i * states_, 0, states_, states_) = A_pow[i];
+		for (int j = 0; j < i && j < horizon_; j++)
+			B_bar_.block(i * states_, j * inputs_, states_, inputs_) = A_pow[i-j-1] * B;
+	}
+
+	// Computing the Hessian and the extended constraint matrix, which are constant for
+	// time-invariant models
+	hessian_ = B_bar_.transpose() * Q_bar_ * B_bar_ + R_bar_;
+	constraint_matrix_ = M_bar_ * B_bar_;
+	optimizer_->setup(hessian_, constraint_matrix_);
+}
+
+
+void ModelPredictiveControl::setupSparseProblem(const Eigen::MatrixXd& A,
+												const Eigen::MatrixXd& B)
+{
+	// Getting the position of the variables of each knot, i.e. [u_k, x_{k+1}]
+	unsigned int knot_size = states_ + inputs_;
+	unsigned int dynamics_size = horizon_ * states_;
+
+	std::vector<Eigen::Triplet<double> > hessian_triplets, constraint_triplets;
+	for (int k = 0; k < horizon_; k++) {
+		unsigned int input_idx = k * knot_size;
+		unsigned int state_idx = input_idx + inputs_;
+
+		// Adding the input and state weights. The last state is weighted by the terminal matrix
+		const Eigen::MatrixXd& weight = (k == horizon_ - 1) ? P_ : Q_;
+		for (int i = 0; i < inputs_; i++)
+			for (int j = 0; j < inputs_; j++)
+				if (R_(i,j) != 0.)
+					hessian_triplets.push_back(
+							Eigen::Triplet<double>(input_idx + i, input_idx + j, R_(i,j)));
+		for (int i = 0; i < states_; i++)
+			for (int j = 0; j < states_; j++)
+				if (weight(i,j) != 0.)
+					hessian_triplets.push_back(
+							Eigen::Triplet<double>(state_idx + i, state_idx + j, weight(i,j)));
+
+		// Adding the dynamics constraint x_{k+1} - A x_k - B u_k = 0
+		unsigned int row = k * states_;
+		for (int i = 0; i < states_; i++) {
+			constraint_triplets.push_back(Eigen::Triplet<double>(row + i, state_idx + i, 1.));
+			for (int j = 0; j < inputs_; j++)
+				if (B(i,j) != 0.)
+					constraint_triplets.push_back(
+							Eigen::Triplet<double>(row + i, input_idx + j, -B(i,j)));
+			if (k > 0) {
+				unsigned int last_state_idx = input_idx - states_;
+				for (int j = 0; j < states_; j++)
+					if (A(i,j) != 0.)
+						constraint_triplets.push_back(
+								Eigen::Triplet<double>(row + i, last_state_idx + j, -A(i,j)));
 			}
 		}
-	}
-	
-	// Computing the values of the Hessian matrix and Gradient vector
-	Eigen::MatrixXd hessian = Eigen::Matrix::Zero(horizon_ * inputs_, horizon_ * inputs_);
-	Eigen::VectorXd gradient = Eigen::VectorXd::Zero(horizon_ * inputs_);
-	hessian = B_bar.transpose() * Q_bar_ * B_bar + R_bar_;
-	gradient = B_bar.transpose() * Q_bar_ * (A_bar * x_measured_eigen - x_ref_bar);
-	
-	// Computing the constraint and state bounds for the predefined horizon;
-	Eigen::VectorXd lbG_bar = Eigen::VectorXd::Zero(horizon_ * constraints_);
-	Eigen::VectorXd ubG_bar = Eigen::VectorXd::Zero(horizon_ * constraints_);
-	Eigen::VectorXd lb_bar = Eigen::VectorXd::Zero(horizon_ * inputs_);
-	Eigen::VectorXd ub_bar = Eigen::VectorXd::Zero(horizon_ * inputs_);
-	model_->getConstraintsBounds(lbG_bar, ubG_bar);
-	model_->getStateBounds(lb_bar, ub_bar);
-	lbG_bar = lbG_bar - M_bar_ * A_bar * x_measured_eigen;
-	ubG_bar = ubG_bar - M_bar_ * A_bar * x_measured_eigen;
-
-	// Computing the extended constraint matrix
-	Eigen::MatrixXd constraint_matrix = Eigen::MatrixXd::Zero(horizon_ * constraints_,
-															  horizon_ * inputs_);
-	constraint_matrix = M_bar_ * B_bar;
-	
-	// Solving the QP problem
-	double cputime = 0.008;//1.0;//NULL;
-	bool success = false;
-	success = optimizer_->compute(hessian, gradient,
-								  constraint_matrix,
-								  lb_bar, ub_bar,
-								  lbG_bar, ubG_bar,
-								  cputime);
-	if (success) {
-		mpc_solution_ = optimizer_->getOptimalSolution();
-		infeasibility_counter_ = 0;
-	} else {
-		infeasibility_counter_++;
-		printf("Warning: an optimal solution could not be obtained.");
-	}
 
-	// Save the data of the MPC
-	for (int i = 0; i < states_; i++) {
-		x_[i].push_back(x_measured[i]);
-		xref_[i].push_back(x_reference[i]);
+		// Adding the state constraints of the next knot, i.e. M x_{k+1}. Note that the ones of
+		// the first knot only depend on the measured state, and so they are bounds of zero rows
+		if (k < horizon_ - 1) {
+			unsigned int constraint_row = dynamics_size + (k + 1) * constraints_;
+			for (int i = 0; i < constraints_; i++)
+				for (int j = 0; j < states_; j++)
+					if (M_(i,j) != 0.)
+						constraint_triplets.push_back(
+								Eigen::Triplet<double>(constraint_row + i, state_idx + j, M_(i,j)));
+		}
 	}
-	t_.push_back(time_index_);
-	time_index_++;
 
-	double *u = getControlSignal();
-	for (int i = 0; i < inputs_; i++) {
-		u_[i].push_back(u[i]);
-	}
+	sparse_hessian_.resize(variables_, variables_);
+	sparse_hessian_.setFromTriplets(hessian_triplets.begin(), hessian_triplets.end());
+	sparse_constraint_matrix_.resize(dynamics_size + horizon_ * constraints_, variables_);
+	sparse_constraint_matrix_.setFromTriplets(constraint_triplets.begin(),
+											  constraint_triplets.end());
+	optimizer_->setupSparse(sparse_hessian_, sparse_constraint_matrix_);
 }
 
 } //@namespace locomotion
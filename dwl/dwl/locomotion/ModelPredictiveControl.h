@@ -1,12 +1,13 @@
 #ifndef DWL__LOCOMOTION__MODEL_PREDICTIVE_CONTROL__H
 #define DWL__LOCOMOTION__MODEL_PREDICTIVE_CONTROL__H
 
-#include <dwl/model/LinearDynamicalSystem.h>
+#include <dwl/ocp/LinearDynamicalSystem.h>
 #include <dwl/solver/QuadraticProgram.h>
+#include <dwl/utils/Macros.h>
 
 #include <Eigen/Dense>
-
-#include <fstream>
+#include <Eigen/Sparse>
+#include <limits>
 
 
 namespace dwl
@@ -15,6 +16,14 @@ namespace dwl
 namespace locomotion
 {
 
+/**
+ * @brief Defines the formulation of the MPC problem. The condensed formulation eliminates the
+ * states, so the QP has dense matrices of O((horizon·inputs)^2). The sparse formulation keeps the
+ * states and inputs as decision variables with the dynamics as block-banded equality constraints,
+ * so the size of the QP matrices grows linearly with the horizon
+ */
+enum MPCFormulation {Condensed, Sparse};
+
 /**
  * @class ModelPredictiveControl
  * @brief This class serves as a base class in order to expand the functionality of the library and
@@ -33,51 +42,125 @@ class ModelPredictiveControl
 		/**
 		 @brief Function to specify and set the settings of all the components within the MPC
 		 problem. The dwl::locomotion::ModelPredictiveControl class can change individual parts of
-		 the MPC problem; such as the model (dwl::model::LinearDynamicalSystem and derived classes)
+		 the MPC problem; such as the model (dwl::ocp::LinearDynamicalSystem and derived classes)
 		 and the optimizer (dwl::solver::QuadracticProgram and derived classes)
-		 @param dwl::model::LinearDynamicalSystem Pointer to the model of the plant to be used in
+		 @param dwl::ocp::LinearDynamicalSystem Pointer to the model of the plant to be used in
 		 the algorithm
 		 @param dwl::solver::QuadraticProgram Pointer to the optimization library to be used in the
 		 algorithm
+		 @return bool Label that indicates if the components are valid
+		 */
+		virtual bool reset(ocp::LinearDynamicalSystem* model,
+						   solver::QuadraticProgram* optimizer);
+
+		/**
+		 * @brief Sets the formulation of the MPC problem, i.e. condensed or sparse. It has to be
+		 * called before init(). The sparse formulation should be used with a sparse QP solver
+		 * for long horizons
+		 * @param MPCFormulation Formulation of the MPC problem
+		 */
+		void setFormulation(MPCFormulation formulation);
+
+		/**
+		 * @brief Sets the horizon of prediction. It has to be called before init()
+		 * @param unsigned int Number of knots of the horizon
+		 */
+		void setHorizon(unsigned int horizon);
+
+		/**
+		 * @brief Sets the weight matrices of the tracking cost. It has to be called before init()
+		 * @param const Eigen::MatrixXd& States error weight matrix
+		 * @param const Eigen::MatrixXd& Terminal states error weight matrix
+		 * @param const Eigen::MatrixXd& Inputs weight matrix
+		 */
+		void setWeights(const Eigen::MatrixXd& Q,
+						const Eigen::MatrixXd& P,
+						const Eigen::MatrixXd& R);
+
+		/**
+		 * @brief Sets the state constraints of each knot, i.e. lbG <= M x_k <= ubG. It has to be
+		 * called before init()
+		 * @param const Eigen::MatrixXd& Constraint matrix of the states
+		 * @param const Eigen::VectorXd& Lower bounds of the constraints
+		 * @param const Eigen::VectorXd& Upper bounds of the constraints
+		 */
+		void setStateConstraints(const Eigen::MatrixXd& M,
+								 const Eigen::VectorXd& lower_bound,
+								 const Eigen::VectorXd& upper_bound);
+
+		/**
+		 * @brief Sets the bounds of the inputs of each knot. It has to be called before init()
+		 * @param const Eigen::VectorXd& Lower bounds of the inputs
+		 * @param const Eigen::VectorXd& Upper bounds of the inputs
 		 */
-		virtual bool reset(model::LinearDynamicalSystem* model,
-						   solver::QuadraticProgram* optimizer) = 0;
+		void setInputBounds(const Eigen::VectorXd& lower_bound,
+							const Eigen::VectorXd& upper_bound);
 
 		/**
-		 @brief Function to initialize the calculation of the MPC algorithm. The function reads
-		 all required parameters from ROS' parameter server that has been previously loaded from
-		 a configuration YAML file, and performs all the initial calculations of variables to be
-		 used in the optimization problem.
+		 @brief Function to initialize the calculation of the MPC algorithm. It initializes the
+		 optimizer, and performs all the initial calculations of variables to be used in the
+		 optimization problem, i.e. the weight and constraint matrices of the horizon and the
+		 constant QP matrices.
 		 @return Label that indicates if the MPC is initialized with success
 		 */
-		virtual bool init() = 0;
+		virtual bool init();
 
 		/**
 		  @brief Function to update the MPC algorithm for the next iteration. The parameters
-		  defined and calculated in dwl::solver::ModelPredictiveControl::init() are used together
-		  with the methods taken from the MPC class components (dwl::model::LinearDynamicalSystem,
-		  and dwl::solver::QuadraticProgram) to find a solution to the optimization problem.
-		  This is where the different variants of MPC algorithms can be implemented in a source
-		  file from a derived class.
-		  @param WholeBodyState Current state
-		  @param WholeBodyState Reference state
+		  defined and calculated in dwl::locomotion::ModelPredictiveControl::init() are used
+		  together with the methods taken from the MPC class components
+		  (dwl::ocp::LinearDynamicalSystem, and dwl::solver::QuadraticProgram) to find a solution
+		  to the optimization problem. This is where the different variants of MPC algorithms
+		  can be implemented in a source file from a derived class.
+		  @param const Eigen::VectorXd& Measured state
+		  @param const Eigen::VectorXd& Reference state
+		  @return bool Label that indicates if an optimal solution was found
 		 */
-		virtual void update(WholeBodyState& measured_state,
-							WholeBodyState& current_state) = 0;
+		virtual bool update(const Eigen::VectorXd& measured_state,
+							const Eigen::VectorXd& reference_state);
 
 		/**
 		 @brief Function to get the control signal generated for the MPC. As the MPC algorithm
 		 states, the optimization process yields the control signals for a range of times defined
 		 by the prediction horizon, but only the current control signal is applied to the plant.
 		 This function returns the control signal for the current time.
-		 @return double* Control signal for the current MPC iteration.
+		 @return Eigen::VectorXd Control signal for the current MPC iteration.
 		 */
-		virtual double* getControlSignal() const;
+		virtual Eigen::VectorXd getControlSignal() const;
+
+		/**
+		 * @brief Gets the solution of the last QP. The condensed solution is [u_0, ..., u_{N-1}],
+		 * and the sparse one is [u_0, x_1, u_1, x_2, ..., u_{N-1}, x_N]
+		 * @return const Eigen::VectorXd& Solution of the QP
+		 */
+		const Eigen::VectorXd& getSolution() const;
 
 			
 	protected:
+		/**
+		 * @brief Computes the condensed prediction matrices, and sets up the constant Hessian
+		 * and constraint matrix of the QP. They are recomputed only if the model is time-varying
+		 * @param const Eigen::MatrixXd& State matrix
+		 * @param const Eigen::MatrixXd& Input matrix
+		 */
+		void setupCondensedProblem(const Eigen::MatrixXd& A,
+								   const Eigen::MatrixXd& B);
+
+		/**
+		 * @brief Computes the sparse banded matrices of the non-condensed problem, whose decision
+		 * variables are ordered as [u_0, x_1, u_1, x_2, ..., u_{N-1}, x_N], and sets up them
+		 * in the QP. They are recomputed only if the model is time-varying
+		 * @param const Eigen::MatrixXd& State matrix
+		 * @param const Eigen::MatrixXd& Input matrix
+		 */
+		void setupSparseProblem(const Eigen::MatrixXd& A,
+								const Eigen::MatrixXd& B);
+
+		/** @brief Formulation of the MPC problem */
+		MPCFormulation formulation_;
+
 		/** @brief Pointer of linear dynamical model of the system */
-		model::LinearDynamicalSystem* model_;
+		ocp::LinearDynamicalSystem* model_;
 
 		/** @brief Pointer of the optimizer of the MPC */
 		solver::QuadraticProgram* optimizer_;
@@ -88,33 +171,21 @@ class ModelPredictiveControl
 		/** @brief Number of inputs of the dynamic model */
 		int inputs_;
 
-		/** @brief Number of outputs of the dynamic model */
-		int outputs_;
-
 		/** @brief Horizon of prediction of the dynamic model */
 		int horizon_;
 
-		/** @brief Number of variables, i.e inputs * horizon */
+		/** @brief Number of variables of the QP */
 		int variables_;
 
-		/** @brief Number of constraints */
+		/** @brief Number of state constraints of a knot */
 		int constraints_;
 
 		/** @brief MPC solution */
 		Eigen::VectorXd mpc_solution_;
 
-		/** @brief Vector of the operation points for the states in case of a LTI model */
-		double* operation_states_;
-
-		/** @brief Vector of the operation points for the inputs in case of a LTI model */
-		double* operation_inputs_;
-
 		/** @brief Infeasibility counter in the solution */
 		int infeasibility_counter_;
 
-		/** @brief Maximun value of the infeasibility counter */
-		int infeasibility_hack_counter_max_;
-
 		/** @brief States error weight matrix */
 		Eigen::MatrixXd Q_;
 
@@ -124,17 +195,56 @@ class ModelPredictiveControl
 		/** @brief Input error weight matrix */
 		Eigen::MatrixXd R_;
 
-		/** @brief Stationary control signal for the reference state vector */
-		Eigen::MatrixXd u_reference_;
+		/** @brief State and input matrices of the linear model */
+		Eigen::MatrixXd A_;
+		Eigen::MatrixXd B_;
+
+		/** @brief States and inputs weight matrices of the horizon */
+		Eigen::MatrixXd Q_bar_;
+		Eigen::MatrixXd R_bar_;
+
+		/** @brief Constraint matrix of the states of a knot and of the horizon */
+		Eigen::MatrixXd M_;
+		Eigen::MatrixXd M_bar_;
+
+		/** @brief Bounds of the state constraints and inputs of a knot */
+		Eigen::VectorXd lbG_;
+		Eigen::VectorXd ubG_;
+		Eigen::VectorXd lb_;
+		Eigen::VectorXd ub_;
+
+		/** @brief Bounds of the state constraints and inputs of the horizon */
+		Eigen::VectorXd lbG_bar_;
+		Eigen::VectorXd ubG_bar_;
+		Eigen::VectorXd lb_bar_;
+		Eigen::VectorXd ub_bar_;
+
+		/** @brief Condensed state and input prediction matrices */
+		Eigen::MatrixXd A_bar_;
+		Eigen::MatrixXd B_bar_;
+
+		/** @brief Constant Hessian and constraint matrix of the condensed QP */
+		Eigen::MatrixXd hessian_;
+		Eigen::MatrixXd constraint_matrix_;
+
+		/** @brief Constant Hessian and constraint matrix of the sparse QP */
+		Eigen::SparseMatrix<double> sparse_hessian_;
+		Eigen::SparseMatrix<double> sparse_constraint_matrix_;
 };
 
 } //@namespace locomotion
 } //@namespace dwl
 
 
-inline double* dwl::locomotion::ModelPredictiveControl::getControlSignal() const
+inline Eigen::VectorXd dwl::locomotion::ModelPredictiveControl::getControlSignal() const
+{
+	// The inputs of the first knot are the first variables in both formulations
+	return mpc_solution_.head(inputs_);
+}
+
+inline const Eigen::VectorXd& dwl::locomotion::ModelPredictiveControl::getSolution() const
 {
-	return control_signal_;
+	return mpc_solution_;
 }
 
 #endif
@@ -32,14 +32,14 @@ class MotionPlanning
 		 * @param robot::Robot* Encapsulates all the properties of the robot
 		 * @param environment::TerrainMap* Encapsulates all the terrain information
 		 */
-		void reset(robot::Robot* robot,
-				   environment::TerrainMap* environment);
+		virtual void reset(robot::Robot* robot,
+						   environment::TerrainMap* environment);
 
 		/**
 		 * @brief Defines the motion planning solver
 		 * @param solver::SearchTreeSolver* Motion planning solver
 		 */
-		void reset(solver::SearchTreeSolver* solver);
+		virtual void reset(solver::SearchTreeSolver* solver);
 
 		/**
 		 * @brief Computes a path from start pose to goal pose
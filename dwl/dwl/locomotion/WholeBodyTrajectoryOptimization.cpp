@@ -7,7 +7,8 @@ namespace dwl
 namespace locomotion
 {
 
-WholeBodyTrajectoryOptimization::WholeBodyTrajectoryOptimization() : solver_(NULL)
+WholeBodyTrajectoryOptimization::WholeBodyTrajectoryOptimization() : solver_(NULL),
+		solved_(false)
 {
 
 }
@@ -102,6 +103,21 @@ bool WholeBodyTrajectoryOptimization::compute(const WholeBodyState& current_stat
 }
 
 
+bool WholeBodyTrajectoryOptimization::computeRecedingHorizon(const WholeBodyState& current_state,
+															 const WholeBodyState& desired_state,
+															 double computation_time,
+															 unsigned int num_shifted_knots)
+{
+	// Shifting the last solution, if there is one, for warm-starting the optimization
+	if (solved_)
+		oc_model_.shiftHorizon(num_shifted_knots);
+
+	solved_ = compute(current_state, desired_state, computation_time);
+
+	return solved_;
+}
+
+
 ocp::DynamicalSystem* WholeBodyTrajectoryOptimization::getDynamicalSystem()
 {
 	return oc_model_.getDynamicalSystem();
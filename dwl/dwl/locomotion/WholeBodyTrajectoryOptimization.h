@@ -95,6 +95,21 @@ class WholeBodyTrajectoryOptimization
 					 const WholeBodyState& desired_state,
 					 double computation_time);
 
+		/**
+		 * @brief Computes a whole-body trajectory in a receding-horizon fashion, i.e. the last
+		 * solution is shifted by a number of knots and used as starting point. The first call
+		 * solves from scratch. Note that the solver should enable its warm start for reusing the
+		 * multipliers as well (e.g. IpoptNLP::setWarmStart)
+		 * @param const WholeBodyState& Current whole-body state
+		 * @param const WholeBodyState& Desired whole-body state
+		 * @param double Allowed computation time
+		 * @param unsigned int Number of knots elapsed since the last computation
+		 */
+		bool computeRecedingHorizon(const WholeBodyState& current_state,
+									const WholeBodyState& desired_state,
+									double computation_time,
+									unsigned int num_shifted_knots = 1);
+
 		/** @brief Gets the dynamical system constraint */
 		ocp::DynamicalSystem* getDynamicalSystem();
 
@@ -121,6 +136,9 @@ class WholeBodyTrajectoryOptimization
 
 		/** @brief Interpolated whole-body trajectory */
 		WholeBodyTrajectory interpolated_trajectory_;
+
+		/** @brief Indicates if the last receding-horizon computation was solved */
+		bool solved_;
 };
 
 } //@namespace locomotion
@@ -8,7 +8,11 @@ namespace model
 {
 
 AdjacencyModel::AdjacencyModel() :	robot_(NULL), terrain_(NULL), is_lattice_(false),
-		is_added_feature_(false), uncertainty_factor_(1.15)
+		is_added_feature_(false), uncertainty_factor_(1.15), thread_pool_(NULL),
+		is_cost_to_go_heuristic_(false), cost_to_go_gain_(1.),
+		cost_to_go_version_(std::numeric_limits<unsigned long int>::max()),
+		terrain_bounds_version_(std::numeric_limits<unsigned long int>::max()),
+		cost_to_go_cols_(0), cost_to_go_rows_(0), cost_to_go_min_cost_(0.)
 {
 
 }
@@ -16,7 +20,7 @@ AdjacencyModel::AdjacencyModel() :	robot_(NULL), terrain_(NULL), is_lattice_(fal
 
 AdjacencyModel::~AdjacencyModel()
 {
-
+	delete thread_pool_;
 }
 
 
@@ -45,6 +49,28 @@ void AdjacencyModel::computeAdjacencyMap(AdjacencyMap& adjacency_map,
 }
 
 
+void AdjacencyModel::getPredecessors(std::vector<Edge>& predecessors,
+									 Vertex state_vertex)
+{
+	// Getting the neighbors of the vertex
+	std::vector<Edge> neighbors;
+	getSuccessors(neighbors, state_vertex);
+
+	// Keeping the neighbors that reach the vertex
+	std::vector<Edge> successors;
+	for (unsigned int i = 0; i < neighbors.size(); i++) {
+		successors.clear();
+		getSuccessors(successors, neighbors[i].target);
+		for (unsigned int j = 0; j < successors.size(); j++) {
+			if (successors[j].target == state_vertex) {
+				predecessors.push_back(Edge(neighbors[i].target, successors[j].weight));
+				break;
+			}
+		}
+	}
+}
+
+
 void AdjacencyModel::getTheClosestStartAndGoalVertex(Vertex& closest_source,
 													 Vertex& closest_target,
 													 Vertex source,
@@ -54,8 +80,8 @@ void AdjacencyModel::getTheClosestStartAndGoalVertex(Vertex& closest_source,
 	bool is_there_start_vertex, is_there_goal_vertex = false;
 	std::vector<Vertex> vertex_map;
 	if (terrain_->isTerrainInformation()) {
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-		for (TerrainDataMap::iterator vertex_iter = terrain_map.begin();
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+		for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
 				vertex_iter != terrain_map.end(); vertex_iter++) {
 			Vertex current_vertex = vertex_iter->first;
 			if (source == current_vertex) {
@@ -156,19 +182,12 @@ void AdjacencyModel::getTheClosestVertex(Vertex& closest_vertex,
 										 Vertex vertex)
 {
 	// Checking if the  vertex is part of the terrain information
-	std::vector<Vertex> vertex_map;
 	if (terrain_->isTerrainInformation()) {
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-		for (TerrainDataMap::iterator vertex_iter = terrain_map.begin();
-				vertex_iter != terrain_map.end(); vertex_iter++) {
-			Vertex current_vertex = vertex_iter->first;
-			if (vertex == current_vertex) {
-				closest_vertex = current_vertex;
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+		if (terrain_map.find(vertex) != terrain_map.end()) {
+			closest_vertex = vertex;
 
-				return;
-			}
-
-			vertex_map.push_back(vertex_iter->first);
+			return;
 		}
 	} else {
 		printf(RED "Could not get the closest start and goal vertex because"
@@ -180,23 +199,8 @@ void AdjacencyModel::getTheClosestVertex(Vertex& closest_vertex,
 	Eigen::Vector3d state_vertex;
 	terrain_->getTerrainSpaceModel().vertexToState(state_vertex, vertex);
 
-	double closest_distant = std::numeric_limits<double>::max();
-	Eigen::Vector3d current_state_vertex;
-	for (unsigned int i = 0; i < vertex_map.size(); i++) {
-		// Calculating the vertex position
-		terrain_->getTerrainSpaceModel().vertexToState(current_state_vertex,
-				vertex_map[i]);
-
-		// Calculating the distant to the current vertex
-		double start_distant = (state_vertex.head(2)
-				- current_state_vertex.head(2)).norm();
-
-		// Recording the closest vertex from the start position
-		if (start_distant < closest_distant) {
-			closest_vertex = vertex_map[i];
-			closest_distant = start_distant;
-		}
-	}
+	// Getting the closest terrain cell from the spatial index of the terrain
+	terrain_->getClosestTerrainVertex(closest_vertex, (Eigen::Vector2d) state_vertex.head(2));
 }
 
 
@@ -207,6 +211,27 @@ double AdjacencyModel::heuristicCost(Vertex source,
 	terrain_->getTerrainSpaceModel().vertexToState(source_state, source);
 	terrain_->getTerrainSpaceModel().vertexToState(target_state, target);
 
+	if (is_cost_to_go_heuristic_ && terrain_->isTerrainInformation()) {
+		// Getting the terrain keys of the source and target positions
+		const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+		Key source_key, target_key;
+		space_model.coordToKey(source_key.x, (double) source_state(0), true);
+		space_model.coordToKey(source_key.y, (double) source_state(1), true);
+		space_model.coordToKey(target_key.x, (double) target_state(0), true);
+		space_model.coordToKey(target_key.y, (double) target_state(1), true);
+		updateCostToGo(target_key);
+
+		// Reading the cost-to-go of the source cell
+		int col = (int) source_key.x - cost_to_go_min_key_.x;
+		int row = (int) source_key.y - cost_to_go_min_key_.y;
+		if (col >= 0 && row >= 0 && col < cost_to_go_cols_ && row < cost_to_go_rows_)
+			return cost_to_go_gain_ * cost_to_go_[row * cost_to_go_cols_ + col];
+
+		// Bounding the cost-to-go outside the table with the lowest terrain cost
+		return cost_to_go_gain_ * cost_to_go_min_cost_ *
+				(target_state.head(2) - source_state.head(2)).norm();
+	}
+
 	// Normalizing the angles for a range of [-pi,pi]
 	double current_angle = source_state(2), target_angle = target_state(2);
 	math::normalizeAngle(current_angle, MinusPiToPi);
@@ -226,6 +251,31 @@ double AdjacencyModel::heuristicCost(Vertex source,
 }
 
 
+double AdjacencyModel::targetFreeHeuristicCost(Vertex source,
+											   Vertex target)
+{
+	if (!is_cost_to_go_heuristic_ || !terrain_->isTerrainInformation())
+		return heuristicCost(source, target);
+
+	// Bounding the cost-to-go with the lowest terrain cost, which is consistent for any target
+	Eigen::Vector3d source_state, target_state;
+	terrain_->getTerrainSpaceModel().vertexToState(source_state, source);
+	terrain_->getTerrainSpaceModel().vertexToState(target_state, target);
+	updateTerrainBounds();
+
+	return cost_to_go_gain_ * cost_to_go_min_cost_ *
+			(target_state.head(2) - source_state.head(2)).norm();
+}
+
+
+void AdjacencyModel::setCostToGoHeuristic(bool enable,
+										  double gain)
+{
+	is_cost_to_go_heuristic_ = enable;
+	cost_to_go_gain_ = gain;
+}
+
+
 bool AdjacencyModel::isReachedGoal(Vertex target,
 								   Vertex current)
 {
@@ -282,6 +332,190 @@ void AdjacencyModel::addFeature(environment::Feature* feature)
 }
 
 
+void AdjacencyModel::setNumberOfThreads(unsigned int num_threads)
+{
+	delete thread_pool_;
+	thread_pool_ = NULL;
+	if (num_threads > 1)
+		thread_pool_ = new utils::ThreadPool(num_threads);
+}
+
+
+void AdjacencyModel::evaluateSuccessors(unsigned int num_successors,
+										const utils::ThreadPool::Task& task)
+{
+	if (thread_pool_ != NULL && num_successors > 1)
+		thread_pool_->parallelFor(num_successors, task);
+	else {
+		for (unsigned int i = 0; i < num_successors; i++)
+			task(i, 0);
+	}
+}
+
+
+void AdjacencyModel::updateTerrainBounds()
+{
+	unsigned long int version = terrain_->getTerrainVersion();
+	if (version == terrain_bounds_version_)
+		return;
+
+	terrain_bounds_version_ = version;
+
+	// Computing the bounding box of the terrain keys
+	const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	if (terrain_map.empty()) {
+		cost_to_go_min_key_ = Key();
+		cost_to_go_cols_ = cost_to_go_rows_ = 0;
+		cost_to_go_min_cost_ = 0.;
+		return;
+	}
+
+	Key min_key(std::numeric_limits<unsigned short int>::max(),
+				std::numeric_limits<unsigned short int>::max(), 0);
+	Key max_key(0, 0, 0);
+	double min_cost = std::numeric_limits<double>::max();
+	for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
+			vertex_iter != terrain_map.end(); vertex_iter++) {
+		Key key;
+		space_model.vertexToKey(key, vertex_iter->first, true);
+		min_key.x = std::min(min_key.x, key.x);
+		min_key.y = std::min(min_key.y, key.y);
+		max_key.x = std::max(max_key.x, key.x);
+		max_key.y = std::max(max_key.y, key.y);
+		min_cost = std::min(min_cost, (double) vertex_iter->second.cost);
+	}
+	cost_to_go_min_key_ = min_key;
+	cost_to_go_cols_ = max_key.x - min_key.x + 1;
+	cost_to_go_rows_ = max_key.y - min_key.y + 1;
+
+	// The unknown cells of the bounding box have the uncertain cost
+	unsigned int grid_size = cost_to_go_cols_ * cost_to_go_rows_;
+	double uncertain_cost = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+	cost_to_go_min_cost_ = terrain_map.size() < grid_size ?
+			std::min(min_cost, uncertain_cost) : min_cost;
+}
+
+
+void AdjacencyModel::updateCostToGo(const Key& target_key)
+{
+	unsigned long int version = terrain_->getTerrainVersion();
+	if (version == cost_to_go_version_ && target_key.x == cost_to_go_target_.x &&
+			target_key.y == cost_to_go_target_.y)
+		return;
+
+	cost_to_go_version_ = version;
+	cost_to_go_target_ = target_key;
+
+	// Computing the bounding box of the terrain keys and its lowest cost
+	updateTerrainBounds();
+	if (cost_to_go_cols_ == 0) {
+		cost_to_go_.clear();
+		return;
+	}
+
+	// Filling the grid of terrain costs, where the unknown cells have the uncertain cost
+	const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	const Key& min_key = cost_to_go_min_key_;
+	unsigned int grid_size = cost_to_go_cols_ * cost_to_go_rows_;
+	double uncertain_cost = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+	std::vector<double> cell_costs(grid_size, uncertain_cost);
+	for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
+			vertex_iter != terrain_map.end(); vertex_iter++) {
+		Key key;
+		space_model.vertexToKey(key, vertex_iter->first, true);
+		cell_costs[(key.y - min_key.y) * cost_to_go_cols_ + (key.x - min_key.x)] =
+				vertex_iter->second.cost;
+	}
+
+	// Bounding the body cost of each cell with the lowest terrain cost around it, since the feet
+	// could step on any cell of the default stance areas. It's a separable minimum filter over
+	// the square that contains the stance areas for every yaw
+	double resolution = terrain_->getResolution(true);
+	if (robot_ != NULL) {
+		double footprint_radius = 0.;
+		SearchAreaMap stance_areas = robot_->getFootstepSearchAreas();
+		for (SearchAreaMap::iterator area_it = stance_areas.begin();
+				area_it != stance_areas.end(); area_it++) {
+			const SearchArea& area = area_it->second;
+			double max_x = std::max(std::abs(area.min_x), std::abs(area.max_x));
+			double max_y = std::max(std::abs(area.min_y), std::abs(area.max_y));
+			footprint_radius = std::max(footprint_radius, sqrt(max_x * max_x + max_y * max_y));
+		}
+
+		int radius = (int) ceil(footprint_radius / resolution);
+		std::vector<double> row_costs(grid_size);
+		for (int row = 0; row < cost_to_go_rows_; row++) {
+			for (int col = 0; col < cost_to_go_cols_; col++) {
+				double cost = std::numeric_limits<double>::max();
+				for (int c = std::max(col - radius, 0);
+						c <= std::min(col + radius, cost_to_go_cols_ - 1); c++)
+					cost = std::min(cost, cell_costs[row * cost_to_go_cols_ + c]);
+				row_costs[row * cost_to_go_cols_ + col] = cost;
+			}
+		}
+		for (int row = 0; row < cost_to_go_rows_; row++) {
+			for (int col = 0; col < cost_to_go_cols_; col++) {
+				double cost = std::numeric_limits<double>::max();
+				for (int r = std::max(row - radius, 0);
+						r <= std::min(row + radius, cost_to_go_rows_ - 1); r++)
+					cost = std::min(cost, row_costs[r * cost_to_go_cols_ + col]);
+				cell_costs[row * cost_to_go_cols_ + col] = cost;
+			}
+		}
+	}
+
+	// Initializing the backward Dijkstra from the target cell. If the target is outside the
+	// grid, every cell starts with the lower bound given by the lowest terrain cost
+	int target_col = (int) target_key.x - min_key.x;
+	int target_row = (int) target_key.y - min_key.y;
+	cost_to_go_.assign(grid_size, std::numeric_limits<double>::infinity());
+	cost_to_go_queue_.clear();
+	if (target_col >= 0 && target_row >= 0 &&
+			target_col < cost_to_go_cols_ && target_row < cost_to_go_rows_) {
+		unsigned int target_cell = target_row * cost_to_go_cols_ + target_col;
+		cost_to_go_[target_cell] = 0.;
+		cost_to_go_queue_.push(target_cell, solver::SearchKey(0.));
+	} else {
+		for (unsigned int cell = 0; cell < grid_size; cell++) {
+			int delta_col = (int) (cell % cost_to_go_cols_) - target_col;
+			int delta_row = (int) (cell / cost_to_go_cols_) - target_row;
+			cost_to_go_[cell] = cost_to_go_min_cost_ * resolution *
+					sqrt(delta_col * delta_col + delta_row * delta_row);
+			cost_to_go_queue_.push(cell, solver::SearchKey(cost_to_go_[cell]));
+		}
+	}
+
+	// Expanding the 8-connected cells backward, where a step costs its length times the cost of
+	// the reached cell
+	while (!cost_to_go_queue_.empty()) {
+		unsigned int current = cost_to_go_queue_.pop();
+		int col = current % cost_to_go_cols_;
+		int row = current / cost_to_go_cols_;
+		double current_cost = cost_to_go_[current];
+		for (int delta_row = -1; delta_row <= 1; delta_row++) {
+			for (int delta_col = -1; delta_col <= 1; delta_col++) {
+				int neighbor_col = col + delta_col;
+				int neighbor_row = row + delta_row;
+				if ((delta_col == 0 && delta_row == 0) ||
+						neighbor_col < 0 || neighbor_row < 0 ||
+						neighbor_col >= cost_to_go_cols_ || neighbor_row >= cost_to_go_rows_)
+					continue;
+
+				unsigned int neighbor = neighbor_row * cost_to_go_cols_ + neighbor_col;
+				double step_length = (delta_col != 0 && delta_row != 0) ? M_SQRT2 : 1.;
+				double cost = current_cost + step_length * resolution * cell_costs[current];
+				if (cost < cost_to_go_[neighbor]) {
+					cost_to_go_[neighbor] = cost;
+					cost_to_go_queue_.push(neighbor, solver::SearchKey(cost));
+				}
+			}
+		}
+	}
+}
+
+
 bool AdjacencyModel::isLatticeRepresentation()
 {
 	return is_lattice_;
@@ -4,6 +4,8 @@
 #include <dwl/environment/TerrainMap.h>
 #include <dwl/environment/Feature.h>
 #include <dwl/robot/Robot.h>
+#include <dwl/solver/SearchQueue.h>
+#include <dwl/utils/ThreadPool.h>
 #include <dwl/utils/utils.h>
 
 
@@ -33,8 +35,8 @@ class AdjacencyModel
 		 * @param environment::TerrainMap* Pointer to object that describes the
 		 * terrain environment
 		 */
-		void reset(robot::Robot* robot,
-				   environment::TerrainMap* environment);
+		virtual void reset(robot::Robot* robot,
+						   environment::TerrainMap* environment);
 
 		/**
 		 * @brief Abstract method that computes the whole adjacency map, which
@@ -48,13 +50,28 @@ class AdjacencyModel
 										 Vertex target);
 
 		/**
-		 * @brief Abstract method that gets the successors of a certain vertex
-		 * @param std::list<Edge>& The successors of a certain vertex
+		 * @brief Abstract method that gets the successors of a certain vertex. The successors are
+		 * appended to a buffer owned by the caller, which is reused between expansions, so
+		 * the implementations shouldn't clear it
+		 * @param std::vector<Edge>& The successors of a certain vertex
 		 * @param Vertex Current state vertex
 		 */
-		virtual void getSuccessors(std::list<Edge>& successors,
+		virtual void getSuccessors(std::vector<Edge>& successors,
 								   Vertex state_vertex) = 0;
 
+		/**
+		 * @brief Gets the predecessors of a certain vertex, where the target of each edge is the
+		 * predecessor and its weight is the cost from the predecessor to the vertex. It's required
+		 * by backward searches such as D* Lite. The default implementation assumes a symmetric
+		 * neighboring relation (i.e. the predecessors are among the successors), and it keeps the
+		 * successors whose edges reach the vertex. The predecessors are appended to a buffer owned
+		 * by the caller
+		 * @param std::vector<Edge>& The predecessors of a certain vertex
+		 * @param Vertex Current state vertex
+		 */
+		virtual void getPredecessors(std::vector<Edge>& predecessors,
+									 Vertex state_vertex);
+
 		/**
 		 * @brief Gets the closest start and goal vertex if it is not belong to
 		 * the terrain information
@@ -77,13 +94,42 @@ class AdjacencyModel
 								 Vertex vertex);
 
 		/**
-		 * @brief Estimates the heuristic cost from a source to a target vertex
+		 * @brief Estimates the heuristic cost from a source to a target vertex. If it was set the
+		 * cost-to-go heuristic, it's read from the cost-to-go table of the target
 		 * @param Vertex Source vertex
 		 * @param Vertex Target vertex
 		 */
 		virtual double heuristicCost(Vertex source,
 									 Vertex target);
 
+		/**
+		 * @brief Estimates the heuristic cost from a source to a target vertex without the
+		 * cost-to-go table, which is computed per target. It's required by the searches whose
+		 * queries change the target, e.g. D* Lite estimates the cost from its source to each
+		 * expanded vertex. If it was set the cost-to-go heuristic, it's the distance times the
+		 * lowest terrain cost (i.e. the bound of the table), otherwise it's the heuristic cost
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		virtual double targetFreeHeuristicCost(Vertex source,
+											   Vertex target);
+
+		/**
+		 * @brief Sets the cost-to-go heuristic, which is computed by a backward 2D Dijkstra from
+		 * the target cell over the terrain cost grid. The table is computed once per target and
+		 * terrain version, and then each heuristic is an O(1) lookup of the cell of the source.
+		 * A step between neighboring cells costs its length times the cost of the reached cell,
+		 * i.e. the lowest terrain cost under the stance areas around it (the unknown cells have
+		 * the uncertain cost). The heuristic is admissible if the gain isn't higher than the
+		 * inverse of the longest body displacement of an edge (in meters), and the edge costs
+		 * aren't lower than this cell cost. Note that the table depends on the target of the
+		 * query, so backward searches (e.g. D* Lite) read targetFreeHeuristicCost instead
+		 * @param bool Indicates if it's used the cost-to-go heuristic
+		 * @param double Gain of the cost-to-go
+		 */
+		void setCostToGoHeuristic(bool enable,
+								  double gain = 1.);
+
 		/**
 		 * @brief Indicates if it is reached the goal
 		 * @param Vertex Goal vertex
@@ -110,6 +156,13 @@ class AdjacencyModel
 		 */
 		void addFeature(environment::Feature* feature);
 
+		/**
+		 * @brief Sets the number of threads that evaluate the successor costs of an expansion.
+		 * Note that the features have to be thread-safe, i.e. computeCost can't modify them
+		 * @param unsigned int Number of threads (one evaluates them sequentially)
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
 		/**
 		 * @brief Indicates if it is a lattice representation of the environment
 		 * @return True if it is a lattice representation and false otherwise
@@ -124,6 +177,27 @@ class AdjacencyModel
 
 
 	protected:
+		/**
+		 * @brief Computes a task per successor, in parallel if it was set more than one thread
+		 * @param unsigned int Number of successors
+		 * @param const utils::ThreadPool::Task& Task to compute per successor
+		 */
+		void evaluateSuccessors(unsigned int num_successors,
+								const utils::ThreadPool::Task& task);
+
+		/**
+		 * @brief Computes the bounding box of the terrain keys and the lowest terrain cost if the
+		 * terrain changed
+		 */
+		void updateTerrainBounds();
+
+		/**
+		 * @brief Computes the cost-to-go table of the terrain cells if the target cell or the
+		 * terrain changed
+		 * @param const Key& Terrain key of the target
+		 */
+		void updateCostToGo(const Key& target_key);
+
 		/** @brief Name of the adjacency model */
 		std::string name_;
 
@@ -144,6 +218,34 @@ class AdjacencyModel
 
 		/** @brief Uncertainty factor which is applied in unperceived environment */
 		double uncertainty_factor_; // For unknown (non-perceive) areas
+
+		/** @brief Thread pool for evaluating the successors (NULL for sequential evaluation) */
+		utils::ThreadPool* thread_pool_;
+
+		/** @brief Indicates if the heuristic is read from the cost-to-go table */
+		bool is_cost_to_go_heuristic_;
+
+		/** @brief Gain of the cost-to-go */
+		double cost_to_go_gain_;
+
+		/** @brief Terrain version and target key of the cost-to-go table */
+		unsigned long int cost_to_go_version_;
+		Key cost_to_go_target_;
+
+		/** @brief Terrain version of the bounding box and lowest cost, and the minimum key and
+		 * size of the bounding box */
+		unsigned long int terrain_bounds_version_;
+		Key cost_to_go_min_key_;
+		int cost_to_go_cols_, cost_to_go_rows_;
+
+		/** @brief Lowest terrain cost, which bounds the cost-to-go outside the table */
+		double cost_to_go_min_cost_;
+
+		/** @brief Cost-to-go of the terrain cells in row-major order (meters times cost) */
+		std::vector<double> cost_to_go_;
+
+		/** @brief Queue of the backward Dijkstra, which keeps its memory between tables */
+		solver::SearchQueue cost_to_go_queue_;
 };
 
 } //@namespace model
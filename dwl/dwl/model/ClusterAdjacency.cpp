@@ -0,0 +1,472 @@
+#include <dwl/model/ClusterAdjacency.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+ClusterAdjacency::ClusterAdjacency(unsigned int cluster_size) :
+		cluster_size_(std::max(cluster_size, (unsigned int) 2)),
+		terrain_version_(std::numeric_limits<unsigned long int>::max()),
+		reported_version_(std::numeric_limits<unsigned long int>::max()), source_(0), target_(0),
+		target_cluster_(0), min_cost_(0.)
+{
+	name_ = "Cluster";
+}
+
+
+ClusterAdjacency::~ClusterAdjacency()
+{
+
+}
+
+
+void ClusterAdjacency::getSuccessors(std::vector<Edge>& successors,
+									 Vertex state_vertex)
+{
+	if (state_vertex == target_)
+		return;
+
+	// Connecting the source to the entrances of its cluster
+	if (state_vertex == source_)
+		successors.insert(successors.end(), source_edges_.begin(), source_edges_.end());
+
+	// Getting the entrance of the vertex
+	Key key;
+	terrain_->getTerrainSpaceModel().vertexToKey(key, state_vertex, true);
+	unsigned long int cluster_id = getClusterId(key);
+	Cluster* cluster = getCluster(cluster_id);
+	if (cluster == NULL)
+		return;
+
+	unsigned int num_entrances = cluster->entrances.size();
+	unsigned int entrance = 0;
+	while (entrance < num_entrances && cluster->entrances[entrance] != state_vertex)
+		entrance++;
+	if (entrance == num_entrances)
+		return;
+
+	// Adding the entrances of the same cluster, the neighboring clusters and the target
+	for (unsigned int i = 0; i < num_entrances; i++) {
+		Weight cost = cluster->costs[entrance * num_entrances + i];
+		if (i != entrance && cost != std::numeric_limits<double>::infinity())
+			successors.push_back(Edge(cluster->entrances[i], cost));
+	}
+	successors.insert(successors.end(), cluster->transitions[entrance].begin(),
+					  cluster->transitions[entrance].end());
+
+	if (cluster_id == target_cluster_ && entrance < target_costs_.size() &&
+			target_costs_[entrance] != std::numeric_limits<double>::infinity())
+		successors.push_back(Edge(target_, target_costs_[entrance]));
+}
+
+
+double ClusterAdjacency::heuristicCost(Vertex source,
+									   Vertex target)
+{
+	Eigen::Vector2d source_position, target_position;
+	terrain_->getTerrainSpaceModel().vertexToCoord(source_position, source);
+	terrain_->getTerrainSpaceModel().vertexToCoord(target_position, target);
+
+	return min_cost_ * (target_position - source_position).norm();
+}
+
+
+bool ClusterAdjacency::setEndpoints(Vertex source,
+									Vertex target)
+{
+	source_ = source;
+	target_ = target;
+	source_edges_.clear();
+	target_costs_.clear();
+
+	// Building the clusters again if the terrain changed without reporting its cells
+	unsigned long int version = terrain_->getTerrainVersion();
+	if (clusters_.empty() || (version != terrain_version_ && version != reported_version_)) {
+		clusters_.clear();
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+		const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+		min_cost_ = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+		min_key_ = Key(std::numeric_limits<unsigned short int>::max(),
+					   std::numeric_limits<unsigned short int>::max(), 0);
+		max_key_ = Key(0, 0, 0);
+		for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
+				vertex_iter != terrain_map.end(); vertex_iter++) {
+			Key key;
+			space_model.vertexToKey(key, vertex_iter->first, true);
+			clusters_[getClusterId(key)];
+			min_cost_ = std::min(min_cost_, (double) vertex_iter->second.cost);
+			min_key_.x = std::min(min_key_.x, key.x);
+			min_key_.y = std::min(min_key_.y, key.y);
+			max_key_.x = std::max(max_key_.x, key.x);
+			max_key_.y = std::max(max_key_.y, key.y);
+		}
+	}
+	terrain_version_ = version;
+
+	// Getting the clusters of the source and target
+	Key source_key, target_key;
+	terrain_->getTerrainSpaceModel().vertexToKey(source_key, source, true);
+	terrain_->getTerrainSpaceModel().vertexToKey(target_key, target, true);
+	unsigned long int source_cluster = getClusterId(source_key);
+	target_cluster_ = getClusterId(target_key);
+	Cluster* source_cluster_ptr = getCluster(source_cluster);
+	Cluster* target_cluster_ptr = getCluster(target_cluster_);
+	if (source_cluster_ptr == NULL || target_cluster_ptr == NULL)
+		return false;
+
+	unsigned int source_cell = getCellIndex(source_key);
+	unsigned int target_cell = getCellIndex(target_key);
+	if (source_cluster_ptr->cell_costs[source_cell] == std::numeric_limits<double>::infinity() ||
+			target_cluster_ptr->cell_costs[target_cell] == std::numeric_limits<double>::infinity())
+		return false;
+
+	// Computing the costs from the entrances of the target cluster to the target
+	std::vector<Weight> costs;
+	searchCluster(costs, *target_cluster_ptr, target_cell, true);
+	unsigned int num_entrances = target_cluster_ptr->entrances.size();
+	target_costs_.resize(num_entrances);
+	for (unsigned int i = 0; i < num_entrances; i++) {
+		Key key;
+		terrain_->getTerrainSpaceModel().vertexToKey(key, target_cluster_ptr->entrances[i], true);
+		target_costs_[i] = costs[getCellIndex(key)];
+	}
+
+	// Computing the edges from the source to the entrances of its cluster, and to the target if
+	// it's in the same cluster
+	searchCluster(costs, *source_cluster_ptr, source_cell, false);
+	for (unsigned int i = 0; i < source_cluster_ptr->entrances.size(); i++) {
+		Key key;
+		terrain_->getTerrainSpaceModel().vertexToKey(key, source_cluster_ptr->entrances[i], true);
+		Weight cost = costs[getCellIndex(key)];
+		if (cost != std::numeric_limits<double>::infinity() &&
+				source_cluster_ptr->entrances[i] != source)
+			source_edges_.push_back(Edge(source_cluster_ptr->entrances[i], cost));
+	}
+	if (source_cluster == target_cluster_ &&
+			costs[target_cell] != std::numeric_limits<double>::infinity())
+		source_edges_.push_back(Edge(target, costs[target_cell]));
+
+	return true;
+}
+
+
+void ClusterAdjacency::updateCells(const std::vector<Vertex>& cells)
+{
+	reported_version_ = terrain_->getTerrainVersion();
+	if (clusters_.empty())
+		return;
+
+	// Marking the clusters of the cells as outdated, and also their neighbors if the cells are on
+	// the borders, since they share the entrances
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	for (unsigned int i = 0; i < cells.size(); i++) {
+		Key key;
+		space_model.vertexToKey(key, cells[i], true);
+		unsigned long int cluster_id = getClusterId(key);
+		bool is_new = clusters_.count(cluster_id) == 0;
+		clusters_[cluster_id].is_updated = false;
+
+		// Growing the bounding box of the terrain, where all the clusters are recomputed since
+		// their borders could change
+		if (key.x < min_key_.x || key.y < min_key_.y || key.x > max_key_.x || key.y > max_key_.y) {
+			min_key_.x = std::min(min_key_.x, key.x);
+			min_key_.y = std::min(min_key_.y, key.y);
+			max_key_.x = std::max(max_key_.x, key.x);
+			max_key_.y = std::max(max_key_.y, key.y);
+			for (std::unordered_map<unsigned long int, Cluster>::iterator cluster_it =
+					clusters_.begin(); cluster_it != clusters_.end(); cluster_it++)
+				cluster_it->second.is_updated = false;
+		}
+
+		// A new cluster adds borders to all its neighbors
+		unsigned int col = key.x % cluster_size_;
+		unsigned int row = key.y % cluster_size_;
+		unsigned long int neighbors[4] = {cluster_id - (1ul << 16), cluster_id + (1ul << 16),
+										  cluster_id - 1, cluster_id + 1};
+		bool is_border[4] = {col == 0, col == cluster_size_ - 1,
+							 row == 0, row == cluster_size_ - 1};
+		for (unsigned int j = 0; j < 4; j++) {
+			std::unordered_map<unsigned long int, Cluster>::iterator cluster_it =
+					clusters_.find(neighbors[j]);
+			if ((is_new || is_border[j]) && cluster_it != clusters_.end())
+				cluster_it->second.is_updated = false;
+		}
+
+		// Updating the lowest cost, which keeps the heuristic admissible
+		Weight cost;
+		if (terrain_->getTerrainCost(cost, cells[i]))
+			min_cost_ = std::min(min_cost_, (double) cost);
+	}
+}
+
+
+void ClusterAdjacency::setCorridor(const std::list<Vertex>& path,
+								   unsigned int margin)
+{
+	corridor_.clear();
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	for (std::list<Vertex>::const_iterator vertex_it = path.begin();
+			vertex_it != path.end(); vertex_it++) {
+		Key key;
+		space_model.vertexToKey(key, *vertex_it, true);
+		long int cluster_x = key.x / cluster_size_;
+		long int cluster_y = key.y / cluster_size_;
+		for (long int x = cluster_x - margin; x <= cluster_x + (long int) margin; x++) {
+			for (long int y = cluster_y - margin; y <= cluster_y + (long int) margin; y++) {
+				if (x >= 0 && y >= 0)
+					corridor_.insert(((unsigned long int) x << 16) | y);
+			}
+		}
+	}
+}
+
+
+void ClusterAdjacency::clearCorridor()
+{
+	corridor_.clear();
+}
+
+
+bool ClusterAdjacency::isInCorridor(const Eigen::Vector2d& position) const
+{
+	if (corridor_.empty())
+		return true;
+
+	Key key;
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	space_model.coordToKey(key.x, (double) position(0), true);
+	space_model.coordToKey(key.y, (double) position(1), true);
+
+	return corridor_.count(getClusterId(key)) > 0;
+}
+
+
+unsigned long int ClusterAdjacency::getClusterId(const Key& key) const
+{
+	return ((unsigned long int) (key.x / cluster_size_) << 16) | (key.y / cluster_size_);
+}
+
+
+ClusterAdjacency::Cluster* ClusterAdjacency::getCluster(unsigned long int cluster_id)
+{
+	std::unordered_map<unsigned long int, Cluster>::iterator cluster_it =
+			clusters_.find(cluster_id);
+	if (cluster_it == clusters_.end())
+		return NULL;
+
+	if (!cluster_it->second.is_updated)
+		computeCluster(cluster_id, cluster_it->second);
+
+	return &cluster_it->second;
+}
+
+
+void ClusterAdjacency::computeCluster(unsigned long int cluster_id,
+									  Cluster& cluster)
+{
+	// Reading the costs of the cells
+	unsigned int num_cells = cluster_size_ * cluster_size_;
+	cluster.cell_costs.resize(num_cells);
+	for (unsigned int cell = 0; cell < num_cells; cell++)
+		cluster.cell_costs[cell] = getCellCost(getCellKey(cluster_id, cell));
+
+	// Computing the entrances with the neighboring clusters, where the borders with the previous
+	// clusters are computed from them, so both sides have the same entrances
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	double resolution = terrain_->getResolution(true);
+	cluster.entrances.clear();
+	cluster.transitions.clear();
+	std::vector<std::pair<Key,Key> > border;
+	for (unsigned int side = 0; side < 4; side++) {
+		bool x_direction = side < 2;
+		bool is_next = side % 2 == 0;
+		unsigned long int neighbor_id = x_direction ?
+				(is_next ? cluster_id + (1ul << 16) : cluster_id - (1ul << 16)) :
+				(is_next ? cluster_id + 1 : cluster_id - 1);
+		if (clusters_.count(neighbor_id) == 0)
+			continue;
+
+		border.clear();
+		if (is_next)
+			computeBorderEntrances(border, cluster_id, x_direction);
+		else {
+			computeBorderEntrances(border, neighbor_id, x_direction);
+			for (unsigned int i = 0; i < border.size(); i++)
+				std::swap(border[i].first, border[i].second);
+		}
+
+		for (unsigned int i = 0; i < border.size(); i++) {
+			Vertex entrance, neighbor_entrance;
+			space_model.keyToVertex(entrance, border[i].first, true);
+			space_model.keyToVertex(neighbor_entrance, border[i].second, true);
+
+			// Corner cells could be entrances of two borders
+			unsigned int index = 0;
+			while (index < cluster.entrances.size() && cluster.entrances[index] != entrance)
+				index++;
+			if (index == cluster.entrances.size()) {
+				cluster.entrances.push_back(entrance);
+				cluster.transitions.push_back(std::vector<Edge>());
+			}
+
+			Weight cost = resolution * getCellCost(border[i].second);
+			cluster.transitions[index].push_back(Edge(neighbor_entrance, cost));
+		}
+	}
+
+	// Computing the costs between the entrances
+	unsigned int num_entrances = cluster.entrances.size();
+	cluster.costs.assign(num_entrances * num_entrances, std::numeric_limits<double>::infinity());
+	std::vector<unsigned int> entrance_cells(num_entrances);
+	for (unsigned int i = 0; i < num_entrances; i++) {
+		Key key;
+		space_model.vertexToKey(key, cluster.entrances[i], true);
+		entrance_cells[i] = getCellIndex(key);
+	}
+
+	std::vector<Weight> costs;
+	for (unsigned int i = 0; i < num_entrances; i++) {
+		searchCluster(costs, cluster, entrance_cells[i], false);
+		for (unsigned int j = 0; j < num_entrances; j++)
+			cluster.costs[i * num_entrances + j] = costs[entrance_cells[j]];
+	}
+
+	cluster.is_updated = true;
+}
+
+
+void ClusterAdjacency::computeBorderEntrances(std::vector<std::pair<Key,Key> >& entrances,
+											  unsigned long int cluster_id,
+											  bool x_direction)
+{
+	// Cells of the border and of the next cluster
+	unsigned int last = cluster_size_ - 1;
+	std::vector<std::pair<Key,Key> > pairs(cluster_size_);
+	for (unsigned int i = 0; i < cluster_size_; i++) {
+		unsigned int cell = x_direction ? i * cluster_size_ + last : last * cluster_size_ + i;
+		pairs[i].first = getCellKey(cluster_id, cell);
+		pairs[i].second = pairs[i].first;
+		if (x_direction)
+			pairs[i].second.x++;
+		else
+			pairs[i].second.y++;
+	}
+
+	// Adding an entrance per run of free pairs, or two entrances (at its ends) if it's long
+	const unsigned int long_run = 6;
+	unsigned int start = 0;
+	for (unsigned int i = 0; i <= cluster_size_; i++) {
+		bool is_free = i < cluster_size_ &&
+				getCellCost(pairs[i].first) != std::numeric_limits<double>::infinity() &&
+				getCellCost(pairs[i].second) != std::numeric_limits<double>::infinity();
+		if (is_free)
+			continue;
+
+		if (i > start) {
+			unsigned int end = i - 1;
+			if (end - start + 1 < long_run)
+				entrances.push_back(pairs[(start + end) / 2]);
+			else {
+				entrances.push_back(pairs[start]);
+				entrances.push_back(pairs[end]);
+			}
+		}
+		start = i + 1;
+	}
+}
+
+
+void ClusterAdjacency::searchCluster(std::vector<Weight>& costs,
+									 const Cluster& cluster,
+									 unsigned int origin,
+									 bool backward)
+{
+	// Searching the 8-connected cells, where a step costs its length times the cost of the
+	// reached cell
+	double resolution = terrain_->getResolution(true);
+	int size = cluster_size_;
+	costs.assign(size * size, std::numeric_limits<double>::infinity());
+	costs[origin] = 0.;
+	queue_.clear();
+	queue_.push(origin, solver::SearchKey(0.));
+	while (!queue_.empty()) {
+		unsigned int current = queue_.pop();
+		int col = current % size;
+		int row = current / size;
+		for (int delta_row = -1; delta_row <= 1; delta_row++) {
+			for (int delta_col = -1; delta_col <= 1; delta_col++) {
+				int neighbor_col = col + delta_col;
+				int neighbor_row = row + delta_row;
+				if ((delta_col == 0 && delta_row == 0) || neighbor_col < 0 || neighbor_row < 0 ||
+						neighbor_col >= size || neighbor_row >= size)
+					continue;
+
+				unsigned int neighbor = neighbor_row * size + neighbor_col;
+				if (cluster.cell_costs[neighbor] == std::numeric_limits<double>::infinity())
+					continue;
+
+				double step_length = (delta_col != 0 && delta_row != 0) ? M_SQRT2 : 1.;
+				Weight cell_cost = backward ? cluster.cell_costs[current] :
+						cluster.cell_costs[neighbor];
+				Weight cost = costs[current] + step_length * resolution * cell_cost;
+				if (cost < costs[neighbor]) {
+					costs[neighbor] = cost;
+					queue_.push(neighbor, solver::SearchKey(cost));
+				}
+			}
+		}
+	}
+}
+
+
+Weight ClusterAdjacency::getCellCost(const Key& key)
+{
+	if (key.x < min_key_.x || key.y < min_key_.y || key.x > max_key_.x || key.y > max_key_.y)
+		return std::numeric_limits<double>::infinity();
+
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	if (terrain_->isObstacleInformation()) {
+		Eigen::Vector2d position;
+		space_model.keyToCoord(position(0), key.x, true);
+		space_model.keyToCoord(position(1), key.y, true);
+
+		Vertex obstacle_vertex;
+		terrain_->getObstacleSpaceModel().coordToVertex(obstacle_vertex, position);
+		const ObstacleMap& obstacle_map = terrain_->getObstacleMap();
+		ObstacleMap::const_iterator obstacle_it = obstacle_map.find(obstacle_vertex);
+		if (obstacle_it != obstacle_map.end() && obstacle_it->second)
+			return std::numeric_limits<double>::infinity();
+	}
+
+	Vertex vertex;
+	space_model.keyToVertex(vertex, key, true);
+	Weight cost;
+	if (terrain_->getTerrainCost(cost, vertex))
+		return cost;
+
+	return uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+}
+
+
+Key ClusterAdjacency::getCellKey(unsigned long int cluster_id,
+								 unsigned int cell) const
+{
+	Key key;
+	key.x = (cluster_id >> 16) * cluster_size_ + cell % cluster_size_;
+	key.y = (cluster_id & 0xffff) * cluster_size_ + cell / cluster_size_;
+	key.z = 0;
+
+	return key;
+}
+
+
+unsigned int ClusterAdjacency::getCellIndex(const Key& key) const
+{
+	return (key.y % cluster_size_) * cluster_size_ + key.x % cluster_size_;
+}
+
+} //@namespace model
+} //@namespace dwl
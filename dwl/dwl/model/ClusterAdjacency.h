@@ -0,0 +1,225 @@
+#ifndef DWL__MODEL__CLUSTER_ADJACENCY__H
+#define DWL__MODEL__CLUSTER_ADJACENCY__H
+
+#include <dwl/model/AdjacencyModel.h>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @class ClusterAdjacency
+ * @brief Class for building an abstract graph of the terrain in the style of HPA*. The terrain
+ * grid is divided in square clusters, and the entrances between neighboring clusters are the
+ * vertices of the graph. The costs between the entrances of a cluster are precomputed with a
+ * Dijkstra search inside the cluster, where a step costs its length times the terrain cost of the
+ * reached cell (the unknown cells inside the bounding box of the terrain have the uncertain cost,
+ * and the cells outside it are blocked). The clusters are only recomputed when
+ * their cells change. The vertices are terrain (2D) vertices. This class derives from
+ * AdjacencyModel class
+ */
+class ClusterAdjacency : public AdjacencyModel
+{
+	public:
+		/**
+		 * @brief Constructor function
+		 * @param unsigned int Size of the clusters (number of cells per side)
+		 */
+		ClusterAdjacency(unsigned int cluster_size = 25);
+
+		/** @brief Destructor function */
+		~ClusterAdjacency();
+
+		/**
+		 * @brief Gets the successors of an entrance, i.e. the entrances of its cluster, the
+		 * entrances of the neighboring clusters and the target if it's in the same cluster
+		 * @param std::vector<Edge>& Successors, which are appended to the buffer
+		 * @param Vertex Current terrain vertex
+		 */
+		void getSuccessors(std::vector<Edge>& successors,
+						   Vertex state_vertex);
+
+		/**
+		 * @brief Estimates the cost between two terrain vertices, i.e. their distance times the
+		 * lowest terrain cost
+		 * @param Vertex Source terrain vertex
+		 * @param Vertex Target terrain vertex
+		 */
+		double heuristicCost(Vertex source,
+							 Vertex target);
+
+		/**
+		 * @brief Inserts the source and target of the abstract search, i.e. it connects them to
+		 * the entrances of their clusters. The clusters are recomputed before if the terrain
+		 * changed
+		 * @param Vertex Source terrain vertex
+		 * @param Vertex Target terrain vertex
+		 * @return True if the source and target are inside of the clusters
+		 */
+		bool setEndpoints(Vertex source,
+						  Vertex target);
+
+		/**
+		 * @brief Reports the terrain cells that changed, so only their clusters (and the
+		 * neighbors that share their borders) are recomputed. If the terrain changes without
+		 * reporting its cells, all the clusters are recomputed
+		 * @param const std::vector<Vertex>& Changed terrain vertices
+		 */
+		void updateCells(const std::vector<Vertex>& cells);
+
+		/**
+		 * @brief Sets the corridor of an abstract path, i.e. the clusters of its vertices and
+		 * their neighbors up to a margin
+		 * @param const std::list<Vertex>& Abstract path
+		 * @param unsigned int Margin of the corridor (number of clusters)
+		 */
+		void setCorridor(const std::list<Vertex>& path,
+						 unsigned int margin);
+
+		/** @brief Removes the corridor, i.e. every position is inside of it */
+		void clearCorridor();
+
+		/**
+		 * @brief Indicates if a position is inside of the corridor
+		 * @param const Eigen::Vector2d& Position
+		 * @return True if it's inside of the corridor or there isn't a corridor
+		 */
+		bool isInCorridor(const Eigen::Vector2d& position) const;
+
+
+	private:
+		/** @brief Defines a cluster, i.e. its cell costs, its entrances and their costs */
+		struct Cluster
+		{
+			Cluster() : is_updated(false) {}
+
+			/** @brief Costs of the cells in row-major order (infinite for obstacles) */
+			std::vector<Weight> cell_costs;
+
+			/** @brief Entrances, i.e. terrain vertices on the borders */
+			std::vector<Vertex> entrances;
+
+			/** @brief Edges of each entrance to the neighboring clusters */
+			std::vector<std::vector<Edge> > transitions;
+
+			/** @brief Costs between the entrances in row-major order (infinite if unreachable) */
+			std::vector<Weight> costs;
+
+			/** @brief Indicates if the cluster is computed with the current cells */
+			bool is_updated;
+		};
+
+		/**
+		 * @brief Gets the id of the cluster of a terrain key
+		 * @param const Key& Terrain key
+		 * @return unsigned long int Cluster id
+		 */
+		unsigned long int getClusterId(const Key& key) const;
+
+		/**
+		 * @brief Gets a cluster, which is recomputed if its cells changed
+		 * @param unsigned long int Cluster id
+		 * @return Cluster* The cluster, or NULL if there isn't a cluster with this id
+		 */
+		Cluster* getCluster(unsigned long int cluster_id);
+
+		/**
+		 * @brief Computes the cell costs, the entrances and their costs of a cluster
+		 * @param unsigned long int Cluster id
+		 * @param Cluster& Cluster
+		 */
+		void computeCluster(unsigned long int cluster_id,
+							Cluster& cluster);
+
+		/**
+		 * @brief Computes the entrances of the border between a cluster and its next one, where
+		 * each run of free cell pairs gives an entrance at its middle, or at its ends if it's long
+		 * @param std::vector<std::pair<Key,Key> >& Entrances (cell of the cluster and cell of the
+		 * next one)
+		 * @param unsigned long int Cluster id
+		 * @param bool Indicates if the next cluster is in the x (true) or y (false) direction
+		 */
+		void computeBorderEntrances(std::vector<std::pair<Key,Key> >& entrances,
+									unsigned long int cluster_id,
+									bool x_direction);
+
+		/**
+		 * @brief Searches the costs from (or to) a cell of a cluster to the rest of its cells
+		 * @param std::vector<Weight>& Costs of the cells in row-major order
+		 * @param const Cluster& Cluster
+		 * @param unsigned int Index of the origin cell
+		 * @param bool Indicates if it's searched the cost to the origin
+		 */
+		void searchCluster(std::vector<Weight>& costs,
+						   const Cluster& cluster,
+						   unsigned int origin,
+						   bool backward);
+
+		/**
+		 * @brief Gets the cost of a terrain cell, which is infinite if there is an obstacle or
+		 * it's outside of the terrain
+		 * @param const Key& Terrain key
+		 * @return Weight Cost of the cell
+		 */
+		Weight getCellCost(const Key& key);
+
+		/**
+		 * @brief Gets the key of a cell of a cluster
+		 * @param unsigned long int Cluster id
+		 * @param unsigned int Index of the cell
+		 * @return Key Terrain key
+		 */
+		Key getCellKey(unsigned long int cluster_id,
+					   unsigned int cell) const;
+
+		/**
+		 * @brief Gets the index of a cell in its cluster
+		 * @param const Key& Terrain key
+		 * @return unsigned int Index of the cell
+		 */
+		unsigned int getCellIndex(const Key& key) const;
+
+		/** @brief Number of cells per side of the clusters */
+		unsigned int cluster_size_;
+
+		/** @brief Clusters of the terrain */
+		std::unordered_map<unsigned long int, Cluster> clusters_;
+
+		/** @brief Terrain version of the clusters, and the version whose changes were reported */
+		unsigned long int terrain_version_;
+		unsigned long int reported_version_;
+
+		/** @brief Bounding box of the terrain keys */
+		Key min_key_;
+		Key max_key_;
+
+		/** @brief Source and target of the abstract search, and the cluster of the target */
+		Vertex source_;
+		Vertex target_;
+		unsigned long int target_cluster_;
+
+		/** @brief Edges from the source to the entrances of its cluster (and the target) */
+		std::vector<Edge> source_edges_;
+
+		/** @brief Costs from the entrances of the target cluster to the target */
+		std::vector<Weight> target_costs_;
+
+		/** @brief Clusters of the corridor */
+		std::unordered_set<unsigned long int> corridor_;
+
+		/** @brief Lowest cost of the cells, which is used by the heuristic */
+		double min_cost_;
+
+		/** @brief Queue of the searches inside the clusters */
+		solver::SearchQueue queue_;
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,87 @@
+#include <dwl/model/CorridorAdjacency.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+CorridorAdjacency::CorridorAdjacency(AdjacencyModel* model,
+									 ClusterAdjacency* clusters) : model_(model),
+		clusters_(clusters)
+{
+	name_ = "Corridor " + model_->getName();
+	is_lattice_ = model_->isLatticeRepresentation();
+}
+
+
+CorridorAdjacency::~CorridorAdjacency()
+{
+	delete model_;
+}
+
+
+void CorridorAdjacency::reset(robot::Robot* robot,
+							  environment::TerrainMap* environment)
+{
+	AdjacencyModel::reset(robot, environment);
+	model_->reset(robot, environment);
+}
+
+
+void CorridorAdjacency::getSuccessors(std::vector<Edge>& successors,
+									  Vertex state_vertex)
+{
+	unsigned int first = successors.size();
+	model_->getSuccessors(successors, state_vertex);
+	filterEdges(successors, first);
+}
+
+
+void CorridorAdjacency::getPredecessors(std::vector<Edge>& predecessors,
+										Vertex state_vertex)
+{
+	unsigned int first = predecessors.size();
+	model_->getPredecessors(predecessors, state_vertex);
+	filterEdges(predecessors, first);
+}
+
+
+double CorridorAdjacency::heuristicCost(Vertex source,
+										Vertex target)
+{
+	return model_->heuristicCost(source, target);
+}
+
+
+double CorridorAdjacency::targetFreeHeuristicCost(Vertex source,
+												  Vertex target)
+{
+	return model_->targetFreeHeuristicCost(source, target);
+}
+
+
+bool CorridorAdjacency::isFreeOfObstacle(Vertex state_vertex,
+										 TypeOfState state_representation,
+										 bool body)
+{
+	return model_->isFreeOfObstacle(state_vertex, state_representation, body);
+}
+
+
+void CorridorAdjacency::filterEdges(std::vector<Edge>& edges,
+									unsigned int first)
+{
+	unsigned int last = first;
+	for (unsigned int i = first; i < edges.size(); i++) {
+		Eigen::Vector3d state;
+		terrain_->getTerrainSpaceModel().vertexToState(state, edges[i].target);
+		if (clusters_->isInCorridor((Eigen::Vector2d) state.head(2)))
+			edges[last++] = edges[i];
+	}
+	edges.resize(last);
+}
+
+} //@namespace model
+} //@namespace dwl
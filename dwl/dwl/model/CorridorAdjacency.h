@@ -0,0 +1,104 @@
+#ifndef DWL__MODEL__CORRIDOR_ADJACENCY__H
+#define DWL__MODEL__CORRIDOR_ADJACENCY__H
+
+#include <dwl/model/ClusterAdjacency.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @class CorridorAdjacency
+ * @brief Class for restricting an adjacency model to the corridor of the clusters of an abstract
+ * path, so the full resolution search only expands the states inside of it. It owns the
+ * restricted model. This class derives from AdjacencyModel class
+ */
+class CorridorAdjacency : public AdjacencyModel
+{
+	public:
+		/**
+		 * @brief Constructor function
+		 * @param AdjacencyModel* Restricted adjacency model
+		 * @param ClusterAdjacency* Cluster model that defines the corridor
+		 */
+		CorridorAdjacency(AdjacencyModel* model,
+						  ClusterAdjacency* clusters);
+
+		/** @brief Destructor function */
+		~CorridorAdjacency();
+
+		/**
+		 * @brief Defines the robot and terrain of the restricted model
+		 * @param robot::Robot* The robot defines all the properties of the robot
+		 * @param environment::TerrainMap* Pointer to object that describes the terrain
+		 */
+		void reset(robot::Robot* robot,
+				   environment::TerrainMap* environment);
+
+		/**
+		 * @brief Gets the successors of the restricted model that are inside of the corridor
+		 * @param std::vector<Edge>& Successors, which are appended to the buffer
+		 * @param Vertex Current state vertex
+		 */
+		void getSuccessors(std::vector<Edge>& successors,
+						   Vertex state_vertex);
+
+		/**
+		 * @brief Gets the predecessors of the restricted model that are inside of the corridor
+		 * @param std::vector<Edge>& Predecessors, which are appended to the buffer
+		 * @param Vertex Current state vertex
+		 */
+		void getPredecessors(std::vector<Edge>& predecessors,
+							 Vertex state_vertex);
+
+		/**
+		 * @brief Estimates the heuristic cost with the restricted model
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		double heuristicCost(Vertex source,
+							 Vertex target);
+
+		/**
+		 * @brief Estimates the heuristic cost without the cost-to-go table of the restricted model
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		double targetFreeHeuristicCost(Vertex source,
+									   Vertex target);
+
+		/**
+		 * @brief Indicates if the state is free of obstacle according to the restricted model
+		 * @param Vertex State vertex
+		 * @param TypeOfState State representation
+		 * @param bool Indicates it is desired to use the body space definition
+		 * @return True if it is free of obstacle, and false otherwise
+		 */
+		bool isFreeOfObstacle(Vertex state_vertex,
+							  TypeOfState state_representation,
+							  bool body = false);
+
+
+	private:
+		/**
+		 * @brief Removes the edges that leave the corridor
+		 * @param std::vector<Edge>& Edges
+		 * @param unsigned int Index of the first edge to check
+		 */
+		void filterEdges(std::vector<Edge>& edges,
+						 unsigned int first);
+
+		/** @brief Restricted adjacency model */
+		AdjacencyModel* model_;
+
+		/** @brief Cluster model that defines the corridor */
+		ClusterAdjacency* clusters_;
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
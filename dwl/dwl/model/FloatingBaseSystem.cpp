@@ -642,21 +642,21 @@ const Eigen::VectorXd& FloatingBaseSystem::toGeneralizedJointState(const rbd::Ve
 	} else if (getTypeOfDynamicSystem() == VirtualFloatingBase) {
 		unsigned int base_dof = getFloatingBaseDoF();
 
-		Eigen::VectorXd virtual_base(base_dof);
+		// Writing directly in the generalized state for avoiding temporary vectors
+		full_state_.resize(base_dof + getJointDoF());
 		if (floating_ax_.active)
-			virtual_base(floating_ax_.id) = base_state(rbd::AX);
+			full_state_(floating_ax_.id) = base_state(rbd::AX);
 		if (floating_ay_.active)
-			virtual_base(floating_ay_.id) = base_state(rbd::AY);
+			full_state_(floating_ay_.id) = base_state(rbd::AY);
 		if (floating_az_.active)
-			virtual_base(floating_az_.id) = base_state(rbd::AZ);
+			full_state_(floating_az_.id) = base_state(rbd::AZ);
 		if (floating_lx_.active)
-			virtual_base(floating_lx_.id) = base_state(rbd::LX);
+			full_state_(floating_lx_.id) = base_state(rbd::LX);
 		if (floating_ly_.active)
-			virtual_base(floating_ly_.id) = base_state(rbd::LY);
+			full_state_(floating_ly_.id) = base_state(rbd::LY);
 		if (floating_lz_.active)
-			virtual_base(floating_lz_.id) = base_state(rbd::LZ);
-
-		full_state_ << virtual_base, joint_state;
+			full_state_(floating_lz_.id) = base_state(rbd::LZ);
+		full_state_.tail(getJointDoF()) = joint_state;
 	} else {
 		full_state_ = joint_state;
 	}
@@ -8,7 +8,8 @@ namespace model
 {
 
 GridBasedBodyAdjacency::GridBasedBodyAdjacency() : is_stance_adjacency_(true),
-		neighboring_definition_(3), number_top_cost_(5), uncertainty_factor_(1.15)
+		neighboring_definition_(3), number_top_cost_(5), uncertainty_factor_(1.15),
+		grid_version_(std::numeric_limits<unsigned long int>::max()), grid_cols_(0), grid_rows_(0)
 {
 	name_ = "Grid-based Body";
 	is_lattice_ = false;
@@ -49,8 +50,8 @@ void GridBasedBodyAdjacency::computeAdjacencyMap(AdjacencyMap& adjacency_map,
 		}
 
 		// Computing the adjacency map given the terrain information
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-		for (TerrainDataMap::iterator vertex_iter = terrain_map.begin();
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+		for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
 				vertex_iter != terrain_map.end();
 				vertex_iter++)
 		{
@@ -89,33 +90,47 @@ void GridBasedBodyAdjacency::computeAdjacencyMap(AdjacencyMap& adjacency_map,
 }
 
 
-void GridBasedBodyAdjacency::getSuccessors(std::list<Edge>& successors,
+void GridBasedBodyAdjacency::getSuccessors(std::vector<Edge>& successors,
 										   Vertex state_vertex)
 {
-	Eigen::Vector3d state;
-	terrain_->getTerrainSpaceModel().vertexToState(state, state_vertex);
-
 	std::vector<Vertex> neighbor_actions;
 	searchNeighbors(neighbor_actions, state_vertex);
 	if (terrain_->isTerrainInformation()) {
-		// Getting the terrain map
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-
 		unsigned int action_size = neighbor_actions.size();
-		for (unsigned int i = 0; i < action_size; i++) {
-			// Converting the state vertex (x,y,yaw) to a terrain vertex (x,y)
-			Vertex terrain_vertex;
-			terrain_->getTerrainSpaceModel().stateVertexToEnvironmentVertex(
-					terrain_vertex,	neighbor_actions[i], XY_Y);
+		if (!isStanceAdjacency()) {
+			for (unsigned int i = 0; i < action_size; i++) {
+				// Converting the state vertex (x,y,yaw) to a terrain vertex (x,y)
+				Vertex terrain_vertex;
+				terrain_->getTerrainSpaceModel().stateVertexToEnvironmentVertex(
+						terrain_vertex,	neighbor_actions[i], XY_Y);
 
-			if (!isStanceAdjacency()) {
 				double terrain_cost = terrain_->getTerrainCost(terrain_vertex);
 				successors.push_back(Edge(neighbor_actions[i], terrain_cost));
-			} else {
-				// Computing the body cost
-				double body_cost;
-				computeBodyCost(body_cost, neighbor_actions[i]);
-				successors.push_back(Edge(neighbor_actions[i], body_cost));
+			}
+		} else {
+			// Querying the memoized footprint costs. It's done sequentially because it could
+			// rasterize the stance areas of a new yaw
+			std::vector<Eigen::Vector3d> states(action_size);
+			std::vector<FootprintQuery> queries(action_size);
+			std::vector<double> body_costs(action_size);
+			for (unsigned int i = 0; i < action_size; i++) {
+				terrain_->getTerrainSpaceModel().vertexToState(states[i], neighbor_actions[i]);
+				queryFootprint(queries[i], states[i]);
+			}
+
+			// Computing the body costs, i.e. the missing footprint costs and the feature costs
+			evaluateSuccessors(action_size, [&](unsigned int i, unsigned int thread_id) {
+				if (std::isnan(queries[i].cost))
+					queries[i].cost = computeFootprintCost(*queries[i].area_offsets,
+														   queries[i].col, queries[i].row);
+				body_costs[i] = queries[i].cost + computeFeatureCost(states[i]);
+			});
+
+			// Memoizing the new footprint costs
+			for (unsigned int i = 0; i < action_size; i++) {
+				if (queries[i].cell != NULL)
+					*queries[i].cell = queries[i].cost;
+				successors.push_back(Edge(neighbor_actions[i], body_costs[i]));
 			}
 		}
 	} else
@@ -146,7 +161,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 	bool is_found_neighbor_positive_yx = false, is_found_neighbor_negative_yx = false;
 	if (terrain_->isTerrainInformation()) {
 		// Getting the terrain map
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
 
 		double x, y, yaw;
 
@@ -296,64 +311,22 @@ void GridBasedBodyAdjacency::computeBodyCost(double& cost,
 	Eigen::Vector3d state;
 	terrain_->getTerrainSpaceModel().vertexToState(state, state_vertex);
 
-	// Getting the terrain map
-	TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-
 	// Computing the terrain cost
-	double terrain_cost = 0;
-	unsigned int area_size = stance_areas_.size();
-	for (unsigned int n = 0; n < area_size; n++) {
-		// Computing the boundary of stance area
-		Eigen::Vector2d boundary_min, boundary_max;
-		boundary_min(0) = stance_areas_[n].min_x + state(0);
-		boundary_min(1) = stance_areas_[n].min_y + state(1);
-		boundary_max(0) = stance_areas_[n].max_x + state(0);
-		boundary_max(1) = stance_areas_[n].max_y + state(1);
-
-		// Computing the stance cost
-		std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > stance_cost_queue;
-		double stance_cost = 0;
-		double resolution = stance_areas_[n].resolution;
-		for (double y = boundary_min(1); y <= boundary_max(1); y += resolution ) {
-			for (double x = boundary_min(0); x <= boundary_max(0); x += resolution) {
-				// Computing the rotated coordinate according to the orientation of the body
-				Eigen::Vector2d point_position;
-				point_position(0) = (x - state(0)) * cos((double) state(2)) -
-						(y - state(1)) * sin((double) state(2)) + state(0);
-				point_position(1) = (x - state(0)) * sin((double) state(2)) +
-						(y - state(1)) * cos((double) state(2)) + state(1);
-
-				Vertex current_2d_vertex;
-				terrain_->getTerrainSpaceModel().coordToVertex(current_2d_vertex, point_position);
-
-				// Inserts the element in an organized vertex queue, according to the maximum value
-				if (terrain_map.count(current_2d_vertex) > 0)
-					stance_cost_queue.insert(std::pair<Weight, Vertex>(
-							terrain_->getTerrainCost(current_2d_vertex),
-							current_2d_vertex));
-			}
-		}
-
-		// Averaging the 5-best (lowest) cost
-		unsigned int number_top_cost = number_top_cost_;
-		if (stance_cost_queue.size() < number_top_cost)
-			number_top_cost = stance_cost_queue.size();
-
-		if (number_top_cost == 0) {
-			stance_cost += uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
-		} else {
-			for (unsigned int i = 0; i < number_top_cost; i++) {
-				stance_cost += stance_cost_queue.begin()->first;
-				stance_cost_queue.erase(stance_cost_queue.begin());
-			}
+	FootprintQuery query;
+	queryFootprint(query, state);
+	if (std::isnan(query.cost)) {
+		query.cost = computeFootprintCost(*query.area_offsets, query.col, query.row);
+		if (query.cell != NULL)
+			*query.cell = query.cost;
+	}
 
-			stance_cost /= number_top_cost;
-		}
+	// Computing the cost of the body features
+	cost = query.cost + computeFeatureCost(state);
+}
 
-		terrain_cost += stance_cost;
-	}
-	terrain_cost /= stance_areas_.size();
 
+double GridBasedBodyAdjacency::computeFeatureCost(const Eigen::Vector3d& state) const
+{
 	// Getting robot and terrain information
 	RobotAndTerrain info;
 	Eigen::Vector3d default_action;
@@ -361,11 +334,11 @@ void GridBasedBodyAdjacency::computeBodyCost(double& cost,
 	info.body_action = default_action;
 	info.pose.position = (Eigen::Vector2d) state.head(2);
 	info.pose.orientation = (double) state(2);
-	info.height_map = terrain_->getTerrainHeightMap();
+	info.height_map = &terrain_->getTerrainHeightMap();
 	info.resolution = terrain_->getResolution(true);
 
 	// Computing the cost of the body features
-	cost = terrain_cost;
+	double cost = 0.;
 	unsigned int feature_size = features_.size();
 	for (unsigned int i = 0; i < feature_size; i++) {
 		// Computing the cost associated with body path features
@@ -376,6 +349,182 @@ void GridBasedBodyAdjacency::computeBodyCost(double& cost,
 		// Computing the cost of the body feature
 		cost += weight * feature_cost;
 	}
+
+	return cost;
+}
+
+
+void GridBasedBodyAdjacency::queryFootprint(FootprintQuery& query,
+											const Eigen::Vector3d& state)
+{
+	updateTerrainGrid();
+
+	// Getting the terrain key of the body position and the key of its yaw
+	Key body_key;
+	unsigned short int key_yaw;
+	terrain_->getTerrainSpaceModel().coordToKey(body_key.x, (double) state(0), true);
+	terrain_->getTerrainSpaceModel().coordToKey(body_key.y, (double) state(1), true);
+	terrain_->getTerrainSpaceModel().stateToKey(key_yaw, (double) state(2), false);
+
+	// Rasterizing the stance areas rotated by the yaw, which gives the cell offsets of each
+	// stance area w.r.t. the body cell
+	std::vector<std::vector<int> >& area_offsets = footprint_offsets_[key_yaw];
+	if (area_offsets.empty()) {
+		const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+		double yaw, ref_x, ref_y;
+		space_model.keyToState(yaw, key_yaw, false);
+		space_model.keyToCoord(ref_x, grid_min_key_.x, true);
+		space_model.keyToCoord(ref_y, grid_min_key_.y, true);
+		for (SearchAreaMap::iterator area_it = stance_areas_.begin();
+				area_it != stance_areas_.end(); area_it++) {
+			const SearchArea& area = area_it->second;
+			std::vector<std::pair<int,int> > cells;
+			for (double y = area.min_y; y <= area.max_y; y += area.resolution) {
+				for (double x = area.min_x; x <= area.max_x; x += area.resolution) {
+					double point_x = x * cos(yaw) - y * sin(yaw);
+					double point_y = x * sin(yaw) + y * cos(yaw);
+
+					unsigned short int key_x, key_y;
+					space_model.coordToKey(key_x, ref_x + point_x, true);
+					space_model.coordToKey(key_y, ref_y + point_y, true);
+					cells.push_back(std::pair<int,int>((int) key_x - grid_min_key_.x,
+													   (int) key_y - grid_min_key_.y));
+				}
+			}
+
+			// Removing the cells that are sampled more than once
+			std::sort(cells.begin(), cells.end());
+			cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+			std::vector<int> offsets;
+			for (unsigned int i = 0; i < cells.size(); i++) {
+				offsets.push_back(cells[i].first);
+				offsets.push_back(cells[i].second);
+			}
+			area_offsets.push_back(offsets);
+		}
+	}
+
+	// Reading the footprint cost from the field, where the cells outside of the grid aren't
+	// memoized
+	query.area_offsets = &area_offsets;
+	query.col = (int) body_key.x - grid_min_key_.x;
+	query.row = (int) body_key.y - grid_min_key_.y;
+	query.cell = NULL;
+	query.cost = std::numeric_limits<double>::quiet_NaN();
+	if (query.col < 0 || query.row < 0 || query.col >= grid_cols_ || query.row >= grid_rows_)
+		return;
+
+	std::vector<double>& field = footprint_costs_[key_yaw];
+	if (field.empty())
+		field.assign(grid_costs_.size(), std::numeric_limits<double>::quiet_NaN());
+
+	query.cell = &field[query.row * grid_cols_ + query.col];
+	query.cost = *query.cell;
+}
+
+
+double GridBasedBodyAdjacency::computeFootprintCost(const std::vector<std::vector<int> >& area_offsets,
+													int col,
+													int row) const
+{
+	if (area_offsets.empty())
+		return 0.;
+
+	double terrain_cost = 0;
+	std::vector<double> lowest_costs;
+	for (unsigned int n = 0; n < area_offsets.size(); n++) {
+		// Keeping the lowest costs of the stance area in ascending order
+		lowest_costs.clear();
+		const std::vector<int>& offsets = area_offsets[n];
+		for (unsigned int i = 0; i < offsets.size(); i += 2) {
+			int cell_col = col + offsets[i];
+			int cell_row = row + offsets[i + 1];
+			if (cell_col < 0 || cell_row < 0 || cell_col >= grid_cols_ || cell_row >= grid_rows_)
+				continue;
+
+			double cell_cost = grid_costs_[cell_row * grid_cols_ + cell_col];
+			if (std::isnan(cell_cost))
+				continue;
+
+			if ((int) lowest_costs.size() < number_top_cost_)
+				lowest_costs.push_back(cell_cost);
+			else if (cell_cost < lowest_costs.back())
+				lowest_costs.back() = cell_cost;
+			else
+				continue;
+
+			for (unsigned int k = lowest_costs.size() - 1;
+					k > 0 && lowest_costs[k] < lowest_costs[k - 1]; k--)
+				std::swap(lowest_costs[k], lowest_costs[k - 1]);
+		}
+
+		// Averaging the 5-best (lowest) cost
+		double stance_cost = 0;
+		if (lowest_costs.empty())
+			stance_cost = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+		else {
+			for (unsigned int k = 0; k < lowest_costs.size(); k++)
+				stance_cost += lowest_costs[k];
+			stance_cost /= lowest_costs.size();
+		}
+
+		terrain_cost += stance_cost;
+	}
+
+	return terrain_cost / area_offsets.size();
+}
+
+
+void GridBasedBodyAdjacency::updateTerrainGrid()
+{
+	unsigned long int version = terrain_->getTerrainVersion();
+	if (version == grid_version_)
+		return;
+
+	grid_version_ = version;
+	footprint_costs_.clear();
+	footprint_offsets_.clear();
+
+	// Computing the default stance areas
+	Eigen::Vector3d full_action = Eigen::Vector3d::Zero();
+	stance_areas_ = robot_->getFootstepSearchAreas(full_action);
+
+	// Computing the bounding box of the terrain keys
+	const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	Key min_key(std::numeric_limits<unsigned short int>::max(),
+				std::numeric_limits<unsigned short int>::max(), 0);
+	Key max_key(0, 0, 0);
+	for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
+			vertex_iter != terrain_map.end(); vertex_iter++) {
+		Key key;
+		space_model.vertexToKey(key, vertex_iter->first, true);
+		min_key.x = std::min(min_key.x, key.x);
+		min_key.y = std::min(min_key.y, key.y);
+		max_key.x = std::max(max_key.x, key.x);
+		max_key.y = std::max(max_key.y, key.y);
+	}
+
+	if (terrain_map.empty()) {
+		grid_min_key_ = Key();
+		grid_cols_ = grid_rows_ = 0;
+		grid_costs_.clear();
+		return;
+	}
+
+	// Filling the dense grid of terrain costs
+	grid_min_key_ = min_key;
+	grid_cols_ = max_key.x - min_key.x + 1;
+	grid_rows_ = max_key.y - min_key.y + 1;
+	grid_costs_.assign(grid_cols_ * grid_rows_, std::numeric_limits<double>::quiet_NaN());
+	for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
+			vertex_iter != terrain_map.end(); vertex_iter++) {
+		Key key;
+		space_model.vertexToKey(key, vertex_iter->first, true);
+		grid_costs_[(key.y - min_key.y) * grid_cols_ + (key.x - min_key.x)] =
+				vertex_iter->second.cost;
+	}
 }
 
 
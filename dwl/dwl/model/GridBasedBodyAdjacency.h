@@ -36,14 +36,27 @@ class GridBasedBodyAdjacency : public AdjacencyModel
 
 		/**
 		 * @brief Gets the successors of the current vertex
-		 * @param std::list<Edge>& List of successors
+		 * @param std::vector<Edge>& Successors, which are appended to the buffer
 		 * @param Vertex Current state vertex
 		 */
-		void getSuccessors(std::list<Edge>& successors,
+		void getSuccessors(std::vector<Edge>& successors,
 						   Vertex state_vertex);
 
 
 	private:
+		/**
+		 * @brief Defines the footprint cost of a body state, whose cell (if it's inside the grid)
+		 * memoizes it
+		 */
+		struct FootprintQuery
+		{
+			const std::vector<std::vector<int> >* area_offsets;
+			int col;
+			int row;
+			double* cell;
+			double cost; // NaN if it isn't computed yet
+		};
+
 		/**
 		 * @brief Searches the neighbors of a current vertex
 		 * @param std::vector<Vertex>& The set of states neighbors
@@ -59,6 +72,42 @@ class GridBasedBodyAdjacency : public AdjacencyModel
 		void computeBodyCost(double& cost,
 							 Vertex state_vertex);
 
+		/**
+		 * @brief Computes the cost of the body features. This function is thread-safe
+		 * @param const Eigen::Vector3d& Body state (x,y,yaw)
+		 * @return double Weighted cost of the features
+		 */
+		double computeFeatureCost(const Eigen::Vector3d& state) const;
+
+		/**
+		 * @brief Queries the footprint (terrain) cost of the body, i.e. the average of the stance
+		 * costs, where each stance cost is the mean of the lowest terrain costs inside the
+		 * rotated stance area. It reads a dense cost field per yaw bin, whose cells are computed
+		 * once per terrain version. The cost is NaN if the cell isn't computed yet, which is
+		 * done by computeFootprintCost
+		 * @param FootprintQuery& Footprint query
+		 * @param const Eigen::Vector3d& Body state (x,y,yaw)
+		 */
+		void queryFootprint(FootprintQuery& query,
+							const Eigen::Vector3d& state);
+
+		/**
+		 * @brief Computes the footprint cost of a cell of the dense grid
+		 * @param const std::vector<std::vector<int> >& Cell offsets of each stance area
+		 * @param int Column of the cell
+		 * @param int Row of the cell
+		 * @return double Footprint cost
+		 */
+		double computeFootprintCost(const std::vector<std::vector<int> >& area_offsets,
+									int col,
+									int row) const;
+
+		/**
+		 * @brief Rebuilds the dense grid of terrain costs, and discards the footprint cost
+		 * fields, if the terrain changed
+		 */
+		void updateTerrainGrid();
+
 		/** @brief Asks if it is requested a stance adjacency */
 		bool isStanceAdjacency();
 
@@ -76,6 +125,23 @@ class GridBasedBodyAdjacency : public AdjacencyModel
 
 		/** @brief Uncertainty factor which is applied in non-perceived environment */
 		double uncertainty_factor_; // For unknown (non-perceive) areas
+
+		/** @brief Terrain version of the dense grid, and its minimum key and size */
+		unsigned long int grid_version_;
+		Key grid_min_key_;
+		int grid_cols_, grid_rows_;
+
+		/** @brief Dense grid of terrain costs in row-major order (NaN for unknown cells) */
+		std::vector<double> grid_costs_;
+
+		/**
+		 * @brief Footprint cost fields per yaw key, with the same layout than the grid. The cells
+		 * are computed on demand, where NaN means that it isn't computed yet
+		 */
+		std::map<unsigned short int, std::vector<double> > footprint_costs_;
+
+		/** @brief Cell offsets (column and row) of the rasterized stance areas per yaw key */
+		std::map<unsigned short int, std::vector<std::vector<int> > > footprint_offsets_;
 };
 
 } //@namespace model
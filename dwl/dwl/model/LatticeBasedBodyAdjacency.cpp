@@ -21,57 +21,67 @@ LatticeBasedBodyAdjacency::~LatticeBasedBodyAdjacency()
 }
 
 
-void LatticeBasedBodyAdjacency::getSuccessors(std::list<Edge>& successors,
+void LatticeBasedBodyAdjacency::getSuccessors(std::vector<Edge>& successors,
 											  Vertex state_vertex)
 {
-	// Getting the 3d pose for generating the actions
-	std::vector<Action3d> actions;
+	// Getting the keys of the current state for generating the actions
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	unsigned short int key_x, key_y, key_yaw;
+	space_model.vertexToStateKey(key_x, key_y, key_yaw, state_vertex);
 	Eigen::Vector3d current_state;
-	terrain_->getTerrainSpaceModel().vertexToState(current_state, state_vertex);
+	space_model.vertexToState(current_state, state_vertex);
 
-	// Converting state to pose
-	Pose3d current_pose;
-	current_pose.position = current_state.head(2);
-	current_pose.orientation = current_state(2);
-
-	// Gets actions according the defined body motor primitives
-	robot_->getBodyMotorPrimitive().generateActions(actions, current_pose);
+	// Gets actions according the lattice of the body motor primitives, which is computed once per
+	// state resolution
+	behavior::MotorPrimitives& body_primitives = robot_->getBodyMotorPrimitive();
+	body_primitives.computeLattice(space_model);
+	const std::vector<LatticeAction3d>& actions = body_primitives.getLatticeActions(key_yaw);
 
 	// Evaluating every action (body motor primitives)
 	if (terrain_->isTerrainInformation()) {
+		// Getting the vertex and stance areas of each action. It's done sequentially since it
+		// queries the robot properties
 		unsigned int action_size = actions.size();
+		std::vector<Eigen::Vector3d> action_states(action_size);
+		std::vector<Vertex> action_vertices(action_size);
+		std::vector<SearchAreaMap> stance_areas(action_size);
 		for (unsigned int i = 0; i < action_size; i++) {
-			// Converting the action to current vertex
-			Eigen::Vector3d action_state;
-			action_state << actions[i].pose.position, actions[i].pose.orientation;
-			Vertex current_action_vertex, terrain_vertex;
-			terrain_->getTerrainSpaceModel().stateToVertex(current_action_vertex, action_state);
+			action_states[i] = current_state + actions[i].action;
+			space_model.stateKeyToVertex(action_vertices[i], key_x + actions[i].delta_key_x,
+										 key_y + actions[i].delta_key_y, actions[i].key_yaw);
+			if (isStanceAdjacency())
+				stance_areas[i] = robot_->getFootstepSearchAreas(actions[i].action);
+		}
 
+		// Computing the cost of every action that is free of obstacles
+		std::vector<double> action_costs(action_size);
+		std::vector<char> is_free(action_size);
+		evaluateSuccessors(action_size, [&](unsigned int i, unsigned int thread_id) {
 			// Converting state vertex to environment vertex
-			terrain_->getTerrainSpaceModel().stateVertexToEnvironmentVertex(terrain_vertex,
-					current_action_vertex, XY_Y);
-
-			// Computing the current action
-			current_action_ = action_state - current_state;
+			Vertex terrain_vertex;
+			space_model.stateVertexToEnvironmentVertex(terrain_vertex, action_vertices[i], XY_Y);
 
 			// Checks if there is an obstacle
-			if (isFreeOfObstacle(current_action_vertex, XY_Y, true)) {
-				if (!isStanceAdjacency()) {
-					double terrain_cost;
-					if (terrain_->getTerrainDataMap().count(terrain_vertex) == 0)
-						terrain_cost = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
-					else
-						terrain_cost = terrain_->getTerrainCost(terrain_vertex);
-
-					successors.push_back(Edge(current_action_vertex, terrain_cost));
-				} else {
-					// Computing the body cost
-					double body_cost;
-					computeBodyCost(body_cost, action_state);
-					body_cost += actions[i].cost;
-					successors.push_back(Edge(current_action_vertex, body_cost));
-				}
+			is_free[i] = isFreeOfObstacle(action_vertices[i], XY_Y, true);
+			if (!is_free[i])
+				return;
+
+			if (!isStanceAdjacency()) {
+				if (terrain_->getTerrainDataMap().count(terrain_vertex) == 0)
+					action_costs[i] = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+				else
+					action_costs[i] = terrain_->getTerrainCost(terrain_vertex);
+			} else {
+				// Computing the body cost
+				computeBodyCost(action_costs[i], action_states[i], actions[i].action,
+								stance_areas[i]);
+				action_costs[i] += actions[i].cost;
 			}
+		});
+
+		for (unsigned int i = 0; i < action_size; i++) {
+			if (is_free[i])
+				successors.push_back(Edge(action_vertices[i], action_costs[i]));
 		}
 	} else
 		printf(RED "Could not computed the successors because there is not terrain information \n"
@@ -80,26 +90,26 @@ void LatticeBasedBodyAdjacency::getSuccessors(std::list<Edge>& successors,
 
 
 void LatticeBasedBodyAdjacency::computeBodyCost(double& cost,
-												Eigen::Vector3d state)
+												const Eigen::Vector3d& state,
+												const Eigen::Vector3d& action,
+												const SearchAreaMap& stance_areas) const
 {
-	// Getting the stance areas according to the action
-	stance_areas_ = robot_->getFootstepSearchAreas(current_action_);
-
 	// Computing the terrain cost
 	double terrain_cost = 0;
-	unsigned int area_size = stance_areas_.size();
-	for (unsigned int n = 0; n < area_size; n++) {
+	for (SearchAreaMap::const_iterator area_it = stance_areas.begin();
+			area_it != stance_areas.end(); area_it++) {
 		// Computing the boundary of stance area
+		const SearchArea& stance_area = area_it->second;
 		Eigen::Vector2d boundary_min, boundary_max;
-		boundary_min(0) = stance_areas_[n].min_x + state(0);
-		boundary_min(1) = stance_areas_[n].min_y + state(1);
-		boundary_max(0) = stance_areas_[n].max_x + state(0);
-		boundary_max(1) = stance_areas_[n].max_y + state(1);
+		boundary_min(0) = stance_area.min_x + state(0);
+		boundary_min(1) = stance_area.min_y + state(1);
+		boundary_max(0) = stance_area.max_x + state(0);
+		boundary_max(1) = stance_area.max_y + state(1);
 
 		// Computing the stance cost
 		std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > stance_cost_queue;
 		double stance_cost = 0;
-		double resolution = stance_areas_[n].resolution;
+		double resolution = stance_area.resolution;
 		for (double y = boundary_min(1); y <= boundary_max(1); y += resolution) {
 			for (double x = boundary_min(0); x <= boundary_max(0); x += resolution) {
 				// Computing the rotated coordinate according to the orientation of the body
@@ -142,15 +152,15 @@ void LatticeBasedBodyAdjacency::computeBodyCost(double& cost,
 
 		terrain_cost += stance_cost;
 	}
-	terrain_cost /= stance_areas_.size();
+	terrain_cost /= stance_areas.size();
 
 
 	// Getting robot and terrain information
 	RobotAndTerrain info;
-	info.body_action = current_action_;
+	info.body_action = action;
 	info.pose.position = (Eigen::Vector2d) state.head(2);
 	info.pose.orientation = (double) state(2);
-	info.height_map = terrain_->getTerrainHeightMap();
+	info.height_map = &terrain_->getTerrainHeightMap();
 	info.resolution = terrain_->getResolution(true);
 
 	// Computing the cost of the body features
@@ -173,7 +183,7 @@ bool LatticeBasedBodyAdjacency::isFreeOfObstacle(Vertex state_vertex,
 												 bool body)
 {
 	// Getting the terrain obstacle map
-	ObstacleMap obstacle_map = terrain_->getObstacleMap();
+	const ObstacleMap& obstacle_map = terrain_->getObstacleMap();
 
 	// Converting the vertex to state (x,y,yaw)
 	Eigen::Vector3d state_3d;
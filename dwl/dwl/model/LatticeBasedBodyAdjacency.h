@@ -26,10 +26,10 @@ class LatticeBasedBodyAdjacency : public AdjacencyModel
 
 		/**
 		 * @brief Gets the successors of the current vertex
-		 * @param std::list<Edge>& List of successors
+		 * @param std::vector<Edge>& Successors, which are appended to the buffer
 		 * @param Vertex Current state vertex
 		 */
-		void getSuccessors(std::list<Edge>& successors,
+		void getSuccessors(std::vector<Edge>& successors,
 						   Vertex state_vertex);
 
 
@@ -43,11 +43,16 @@ class LatticeBasedBodyAdjacency : public AdjacencyModel
 							 Vertex vertex_id);
 
 		/**
-		 * @brief Computes the body cost of a current vertex
-		 * @param Eigen::Vector3d Current robot state (x,y,yaw)
+		 * @brief Computes the body cost of a current vertex. This function is thread-safe
+		 * @param double& Body cost
+		 * @param const Eigen::Vector3d& Current robot state (x,y,yaw)
+		 * @param const Eigen::Vector3d& Body action that reaches the state
+		 * @param const SearchAreaMap& Stance areas of the body action
 		 */
 		void computeBodyCost(double& cost,
-							 Eigen::Vector3d state);
+							 const Eigen::Vector3d& state,
+							 const Eigen::Vector3d& action,
+							 const SearchAreaMap& stance_areas) const;
 
 		/**
 		 * @brief Indicates if the free of obstacle
@@ -66,15 +71,9 @@ class LatticeBasedBodyAdjacency : public AdjacencyModel
 		 */
 		bool isStanceAdjacency();
 
-		/** @brief Current action of the body */
-		Eigen::Vector3d current_action_;
-
 		/** @brief Indicates it was requested a stance or terrain adjacency */
 		bool is_stance_adjacency_;
 
-		/** @brief Map of search areas */
-		SearchAreaMap stance_areas_;
-
 		/** @brief Number of top cost for computing the stance cost */
 		int number_top_cost_;
 };
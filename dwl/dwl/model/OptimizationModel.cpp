@@ -8,9 +8,11 @@ namespace model
 {
 
 OptimizationModel::OptimizationModel() : solution_(NULL), state_dimension_(0),
-		constraint_dimension_(0), nonzero_jacobian_(0), nonzero_hessian_(0), gradient_(true),
-		jacobian_(true), hessian_(true), bounds_(false), soft_constraints_(false),
-		first_time_(true), cost_function_(this), num_diff_mode_(Eigen::Central), epsilon_(1E-06),
+		constraint_dimension_(0), nonzero_jacobian_(0), nonzero_hessian_(0), warm_start_(false),
+		gradient_(true), jacobian_(true), hessian_(true), bounds_(false), soft_constraints_(false),
+		first_time_(true), num_diff_mode_(Eigen::Central), gradient_threads_(1),
+		gradient_pool_(NULL), gradient_decision_dim_(0), gradient_constraint_dim_(0),
+		epsilon_(1E-06),
 		soft_properties_(SoftConstraintProperties(10000., 0., 0.))
 {
 
@@ -19,7 +21,8 @@ OptimizationModel::OptimizationModel() : solution_(NULL), state_dimension_(0),
 
 OptimizationModel::~OptimizationModel()
 {
-
+	clearGradientModels();
+	delete gradient_pool_;
 }
 
 void OptimizationModel::init(bool only_soft_constraints)
@@ -28,6 +31,35 @@ void OptimizationModel::init(bool only_soft_constraints)
 }
 
 
+OptimizationModel* OptimizationModel::clone() const
+{
+	return NULL;
+}
+
+
+void OptimizationModel::setNumericalDifferentiation(enum Eigen::NumericalDiffMode mode,
+													double epsilon)
+{
+	num_diff_mode_ = mode;
+	epsilon_ = epsilon;
+
+	// The steps are adapted again in the next gradient evaluation
+	step_scales_.resize(0);
+	soft_step_scales_.resize(0);
+}
+
+
+void OptimizationModel::setNumberOfGradientThreads(unsigned int num_threads)
+{
+	if (num_threads == 0)
+		gradient_threads_ = 1;
+	else
+		gradient_threads_ = num_threads;
+
+	clearGradientModels();
+}
+
+
 void OptimizationModel::setDimensionOfState(unsigned int dimension)
 {
 	state_dimension_ = dimension;
@@ -64,6 +96,12 @@ void OptimizationModel::defineAsSoftConstraint()
 }
 
 
+void OptimizationModel::setWarmStart(bool enable)
+{
+	warm_start_ = enable;
+}
+
+
 void OptimizationModel::getStartingPoint(double* decision, int decision_dim)
 {
 	printf(YELLOW "Warning: there is not defined the warm point, default in the origin\n" COLOR_RESET);
@@ -74,6 +112,23 @@ void OptimizationModel::getStartingPoint(double* decision, int decision_dim)
 }
 
 
+bool OptimizationModel::getStartingMultipliers(double* bound_lower_mult, double* bound_upper_mult,
+											   int decision_dim,
+											   double* constraint_mult, int constraint_dim)
+{
+	return false;
+}
+
+
+void OptimizationModel::setSolution(const double* decision,
+									const double* bound_lower_mult, const double* bound_upper_mult,
+									int decision_dim,
+									const double* constraint_mult, int constraint_dim)
+{
+
+}
+
+
 void OptimizationModel::evaluateBounds(double* decision_lbound, int decision_dim1,
 									   double* decision_ubound, int decision_dim2,
 									   double* constraint_lbound, int constraint_dim1,
@@ -112,29 +167,8 @@ void OptimizationModel::evaluateCostGradient(double* gradient, int grad_dim,
 	// Indicates that the gradient is computed using numerical differenciation
 	gradient_ = false;
 
-	// Eigen interfacing to raw buffers
-	Eigen::Map<Eigen::VectorXd> full_gradient(gradient, grad_dim);
-	const Eigen::Map<const Eigen::VectorXd> decision_var(decision, decision_dim);
-
-	Eigen::MatrixXd grad(1, decision_dim);
-
-	switch (num_diff_mode_) {
-		case Eigen::Forward: {
-			Eigen::NumericalDiff<CostFunction,Eigen::Forward> num_diff(cost_function_, epsilon_);
-			num_diff.df(decision_var, grad);
-			break;
-		} case Eigen::Central: {
-			Eigen::NumericalDiff<CostFunction,Eigen::Central> num_diff(cost_function_, epsilon_);
-			num_diff.df(decision_var, grad);
-			break;
-		} default: {
-			Eigen::NumericalDiff<CostFunction,Eigen::Central> num_diff(cost_function_, epsilon_);
-			num_diff.df(decision_var, grad);
-			break;
-		}
-	}
-
-	full_gradient = grad;
+	computeFiniteDifferences(gradient, decision, decision_dim, false,
+							 step_scales_, curvatures_);
 }
 
 
@@ -225,6 +259,14 @@ double OptimizationModel::evaluateAsSoftConstraints(
 }
 
 
+void OptimizationModel::evaluateSoftConstraintGradient(double* gradient, int grad_dim,
+													   const double* decision, int decision_dim)
+{
+	computeFiniteDifferences(gradient, decision, decision_dim, true,
+							 soft_step_scales_, soft_curvatures_);
+}
+
+
 
 void OptimizationModel::evaluateConstraintJacobian(double* jacobian_values, int nonzero_dim1,
 												   int* row_entries, int nonzero_dim2,
@@ -247,6 +289,302 @@ void OptimizationModel::evaluateLagrangianHessian(double* hessian_values, int no
 }
 
 
+void OptimizationModel::setJacobianStructure(const std::vector<int>& row_entries,
+											 const std::vector<int>& col_entries)
+{
+	if (row_entries.size() != col_entries.size()) {
+		printf(RED "FATAL: the row and column entries of the Jacobian structure are not"
+				" consistent\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	jacobian_rows_ = row_entries;
+	jacobian_cols_ = col_entries;
+}
+
+
+void OptimizationModel::setHessianStructure(const std::vector<int>& row_entries,
+											const std::vector<int>& col_entries)
+{
+	if (row_entries.size() != col_entries.size()) {
+		printf(RED "FATAL: the row and column entries of the Hessian structure are not"
+				" consistent\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	for (unsigned int i = 0; i < row_entries.size(); i++) {
+		if (col_entries[i] > row_entries[i]) {
+			printf(RED "FATAL: the Hessian structure has to describe the lower triangle\n"
+					COLOR_RESET);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	hessian_rows_ = row_entries;
+	hessian_cols_ = col_entries;
+}
+
+
+void OptimizationModel::detectJacobianStructure(const double* decision, int decision_dim,
+												int constraint_dim,
+												unsigned int num_samples)
+{
+	// Eigen interfacing to raw buffers
+	const Eigen::Map<const Eigen::VectorXd> decision_var(decision, decision_dim);
+
+	// Sampling random points around the decision variables avoids that a nonzero entry
+	// vanishes by chance. Besides the given point, at least one random point is sampled
+	num_samples = std::max(num_samples, 2u);
+	Eigen::MatrixXi nonzero = Eigen::MatrixXi::Zero(constraint_dim, decision_dim);
+	Eigen::VectorXd point(decision_dim), constraint(constraint_dim);
+	Eigen::VectorXd perturbed_constraint(constraint_dim);
+	for (unsigned int s = 0; s < num_samples; s++) {
+		point = decision_var;
+		if (s != 0)
+			point += 0.01 * Eigen::VectorXd::Random(decision_dim).cwiseProduct(
+					decision_var.cwiseAbs() + Eigen::VectorXd::Ones(decision_dim));
+		evaluateConstraints(constraint.data(), constraint_dim, point.data(), decision_dim);
+
+		// Probing each variable with a forward and a smaller backward perturbation, so an entry
+		// isn't missed when the constraint is flat in one direction (e.g. at a kink) or its
+		// change cancels out for one step. Note that the evaluation is deterministic, so any
+		// change of a constraint means that it depends on the variable
+		for (int j = 0; j < decision_dim; j++) {
+			double value = point(j);
+			double step = std::max(epsilon_, epsilon_ * fabs(value)) * 100.;
+			double probes[2] = {step, -0.5 * step};
+			for (unsigned int p = 0; p < 2; p++) {
+				point(j) = value + probes[p];
+				evaluateConstraints(perturbed_constraint.data(), constraint_dim,
+									point.data(), decision_dim);
+
+				for (int i = 0; i < constraint_dim; i++) {
+					if (perturbed_constraint(i) != constraint(i))
+						nonzero(i,j) = 1;
+				}
+			}
+			point(j) = value;
+		}
+	}
+
+	// Setting the detected pattern in row-major order
+	jacobian_rows_.clear();
+	jacobian_cols_.clear();
+	for (int i = 0; i < constraint_dim; i++) {
+		for (int j = 0; j < decision_dim; j++) {
+			if (nonzero(i,j) != 0) {
+				jacobian_rows_.push_back(i);
+				jacobian_cols_.push_back(j);
+			}
+		}
+	}
+}
+
+
+void OptimizationModel::clearGradientModels()
+{
+	for (unsigned int t = 0; t < gradient_models_.size(); t++)
+		delete gradient_models_[t];
+	gradient_models_.clear();
+}
+
+
+void OptimizationModel::syncClone(OptimizationModel* model)
+{
+
+}
+
+
+bool OptimizationModel::initGradientModels(unsigned int decision_dim)
+{
+	// Reusing the copies, since cloning and initializing them is expensive
+	if (gradient_models_.size() == gradient_threads_ &&
+			gradient_decision_dim_ == decision_dim &&
+			gradient_constraint_dim_ == constraint_dimension_)
+		return true;
+
+	// Creating the per-thread copies of the model
+	clearGradientModels();
+	for (unsigned int t = 0; t < gradient_threads_; t++) {
+		OptimizationModel* model = clone();
+		if (model == NULL) {
+			printf(YELLOW "Warning: the optimization model is not clonable, so the gradient will "
+					"be computed serially\n" COLOR_RESET);
+			clearGradientModels();
+			gradient_threads_ = 1;
+			return false;
+		}
+		model->init();
+		gradient_models_.push_back(model);
+	}
+	gradient_decision_dim_ = decision_dim;
+	gradient_constraint_dim_ = constraint_dimension_;
+
+	// Creating the thread pool
+	if (gradient_pool_ == NULL || gradient_pool_->getNumberOfThreads() != gradient_threads_) {
+		delete gradient_pool_;
+		gradient_pool_ = new utils::ThreadPool(gradient_threads_);
+	}
+
+	return true;
+}
+
+
+void OptimizationModel::computeFiniteDifferences(double* gradient,
+												 const double* decision, int decision_dim,
+												 bool soft_cost,
+												 Eigen::VectorXd& step_scales,
+												 Eigen::VectorXd& curvatures)
+{
+	// Eigen interfacing to raw buffers
+	const Eigen::Map<const Eigen::VectorXd> decision_var(decision, decision_dim);
+
+	// The first evaluation starts from the initial relative step, and it adapts the steps
+	bool adapt = (step_scales.size() != decision_dim);
+	if (adapt) {
+		step_scales = Eigen::VectorXd::Constant(decision_dim, epsilon_);
+		curvatures.resize(decision_dim);
+	}
+
+	// Computing the per-variable steps, which are scaled by the magnitude of the variables. Note
+	// that the steps are exactly representable, i.e. (x + h) - x = h
+	Eigen::VectorXd steps(decision_dim);
+	for (int j = 0; j < decision_dim; j++) {
+		double step = step_scales(j) * std::max(fabs(decision_var(j)), 1.);
+		volatile double perturbed = decision_var(j) + step;
+		steps(j) = perturbed - decision_var(j);
+	}
+
+	// The forward differences and the curvatures share the evaluation of the unperturbed
+	// variables
+	double base_cost = 0.;
+	if (num_diff_mode_ == Eigen::Forward || adapt) {
+		if (soft_cost)
+			base_cost = evaluateAsSoftConstraints(decision, decision_dim);
+		else
+			evaluateCosts(base_cost, decision, decision_dim);
+	}
+
+	Eigen::VectorXd* block_curvatures = adapt ? &curvatures : NULL;
+	if (gradient_threads_ > 1 && initGradientModels(decision_dim)) {
+		// The soft properties are copied too, since the copies are created without them
+		for (unsigned int t = 0; t < gradient_threads_; t++) {
+			syncClone(gradient_models_[t]);
+			gradient_models_[t]->soft_properties_ = soft_properties_;
+		}
+
+		// Splitting the variables in more blocks than threads, so the work stealing balances
+		// the evaluations with different computation times
+		unsigned int num_blocks = std::min(4 * gradient_threads_, (unsigned int) decision_dim);
+		unsigned int block_size = (decision_dim + num_blocks - 1) / std::max(num_blocks, 1u);
+		std::vector<Eigen::VectorXd> thread_decisions(gradient_threads_, decision_var);
+		gradient_pool_->parallelFor(num_blocks, [&](unsigned int block, unsigned int thread_id) {
+			unsigned int first = block * block_size;
+			unsigned int last = std::min(first + block_size, (unsigned int) decision_dim);
+			computeGradientBlock(gradient_models_[thread_id], gradient,
+								 thread_decisions[thread_id], steps, base_cost, soft_cost,
+								 block_curvatures, first, last);
+		});
+	} else {
+		Eigen::VectorXd point = decision_var;
+		computeGradientBlock(this, gradient, point, steps, base_cost, soft_cost,
+							 block_curvatures, 0, decision_dim);
+	}
+
+	if (adapt)
+		adaptSteps(decision_var, base_cost, step_scales, curvatures);
+}
+
+
+void OptimizationModel::computeGradientBlock(OptimizationModel* model,
+											 double* gradient,
+											 Eigen::VectorXd& decision_var,
+											 const Eigen::VectorXd& steps,
+											 double base_cost,
+											 bool soft_cost,
+											 Eigen::VectorXd* curvatures,
+											 unsigned int first,
+											 unsigned int last)
+{
+	int decision_dim = decision_var.size();
+	for (unsigned int j = first; j < last; j++) {
+		double value = decision_var(j);
+		double forward_cost, backward_cost;
+		decision_var(j) = value + steps(j);
+		if (soft_cost)
+			forward_cost = model->evaluateAsSoftConstraints(decision_var.data(), decision_dim);
+		else
+			model->evaluateCosts(forward_cost, decision_var.data(), decision_dim);
+		if (num_diff_mode_ == Eigen::Forward && curvatures == NULL)
+			gradient[j] = (forward_cost - base_cost) / steps(j);
+		else {
+			decision_var(j) = value - steps(j);
+			if (soft_cost)
+				backward_cost = model->evaluateAsSoftConstraints(decision_var.data(), decision_dim);
+			else
+				model->evaluateCosts(backward_cost, decision_var.data(), decision_dim);
+			gradient[j] = (forward_cost - backward_cost) / (2 * steps(j));
+			if (curvatures != NULL)
+				(*curvatures)(j) = fabs(forward_cost - 2 * base_cost + backward_cost) /
+						(steps(j) * steps(j));
+		}
+		decision_var(j) = value;
+	}
+}
+
+
+void OptimizationModel::adaptSteps(const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+								   double base_cost,
+								   Eigen::VectorXd& step_scales,
+								   const Eigen::VectorXd& curvatures)
+{
+	// Rounding error of the cost evaluations
+	double cost_error = std::numeric_limits<double>::epsilon() * std::max(fabs(base_cost), 1.);
+
+	// The truncation error of the forward differences depends on the curvature. For the central
+	// ones, the curvature is used as the scale of the third derivative. The adapted steps are
+	// bounded around the initial one, since the curvature is a finite-difference estimate too
+	for (int j = 0; j < decision_var.size(); j++) {
+		double step_scale = 1E+02 * epsilon_;
+		if (curvatures(j) > 0.) {
+			double step;
+			if (num_diff_mode_ == Eigen::Forward)
+				step = 2 * sqrt(cost_error / curvatures(j));
+			else
+				step = cbrt(3 * cost_error / curvatures(j));
+
+			step_scale = step / std::max(fabs(decision_var(j)), 1.);
+		}
+		step_scales(j) = std::min(std::max(step_scale, 1E-02 * epsilon_), 1E+02 * epsilon_);
+	}
+}
+
+
+bool OptimizationModel::getJacobianStructure(std::vector<int>& row_entries,
+											 std::vector<int>& col_entries)
+{
+	if (jacobian_rows_.empty())
+		return false;
+
+	row_entries = jacobian_rows_;
+	col_entries = jacobian_cols_;
+
+	return true;
+}
+
+
+bool OptimizationModel::getHessianStructure(std::vector<int>& row_entries,
+											std::vector<int>& col_entries)
+{
+	if (hessian_rows_.empty())
+		return false;
+
+	row_entries = hessian_rows_;
+	col_entries = hessian_cols_;
+
+	return true;
+}
+
 
 unsigned int OptimizationModel::getDimensionOfState()
 {
@@ -2,6 +2,7 @@
 #define DWL__MODEL__OPTIMIZATION_MODEL__H
 
 #include <dwl/utils/utils.h>
+#include <dwl/utils/ThreadPool.h>
 #include <unsupported/Eigen/NumericalDiff>
 
 #define NO_BOUND 2e19
@@ -99,6 +100,35 @@ class OptimizationModel
 		 * vectors */
 		virtual void init(bool only_soft_constraints = false);
 
+		/**
+		 * @brief Creates an independent copy of the optimization model, which is used for
+		 * evaluating it from different threads (e.g. the offsprings of a CMA-ES generation). The
+		 * copy has to be initialized
+		 * @return OptimizationModel* Copy of the model, or NULL if the model isn't clonable
+		 */
+		virtual OptimizationModel* clone() const;
+
+		/**
+		 * @brief Sets the finite-difference scheme used when the cost gradient isn't implemented.
+		 * The first gradient evaluation uses central differences with the initial relative step,
+		 * and it adapts the step of each variable to its curvature
+		 * @param enum Eigen::NumericalDiffMode Forward or central differences
+		 * @param double Initial relative step, which is scaled by the magnitude of each variable
+		 */
+		void setNumericalDifferentiation(enum Eigen::NumericalDiffMode mode,
+										 double epsilon = 1E-06);
+
+		/**
+		 * @brief Sets the number of threads used for the finite-difference gradient. Each thread
+		 * perturbs a block of variables of its own copy of the model, so the model has to be
+		 * clonable, otherwise the gradient is computed serially. The copies are created in the
+		 * next gradient evaluation and reused while the dimensions don't change. The states set
+		 * after their creation are updated through syncClone(), but the copies have to be
+		 * recreated (i.e. calling this method again) if the model is modified in other ways
+		 * @param unsigned int Number of threads (one means serial computation)
+		 */
+		void setNumberOfGradientThreads(unsigned int num_threads);
+
 		/** @brief Sets the dimension of the decision variables, here called state */
 		void setDimensionOfState(unsigned int dim);
 
@@ -115,6 +145,13 @@ class OptimizationModel
 		 * cost function */
 		void defineAsSoftConstraint();
 
+		/**
+		 * @brief Enables/disables the warm start, i.e. the next optimization starts from the last
+		 * solution. It's set by the solvers that support it (e.g. IpoptNLP::setWarmStart)
+		 * @param bool True for enabling the warm start
+		 */
+		void setWarmStart(bool enable);
+
 		/**
 		 * @brief Sets the weight for computing the soft-constraint, i.e.
 		 * the associated cost
@@ -129,6 +166,35 @@ class OptimizationModel
 		 */
 		virtual void getStartingPoint(double* decision, int decision_dim);
 
+		/**
+		 * @brief Gets the starting multipliers of the problem, which are used for warm-starting
+		 * the solver
+		 * @param double* Initial values for the lower bound multipliers, $z^L$
+		 * @param double* Initial values for the upper bound multipliers, $z^U$
+		 * @param int Number of the decision variables
+		 * @param double* Initial values for the constraint multipliers, $\lambda$
+		 * @param int Number of the constraints
+		 * @return True if the starting multipliers are defined
+		 */
+		virtual bool getStartingMultipliers(double* bound_lower_mult, double* bound_upper_mult,
+											int decision_dim,
+											double* constraint_mult, int constraint_dim);
+
+		/**
+		 * @brief Sets the primal and dual solution computed by the solver, which could be used for
+		 * warm-starting the next optimization
+		 * @param const double* Primal solution, $x_*$
+		 * @param const double* Lower bound multipliers, $z^L_*$
+		 * @param const double* Upper bound multipliers, $z^U_*$
+		 * @param int Number of the decision variables
+		 * @param const double* Constraint multipliers, $\lambda_*$
+		 * @param int Number of the constraints
+		 */
+		virtual void setSolution(const double* decision,
+								 const double* bound_lower_mult, const double* bound_upper_mult,
+								 int decision_dim,
+								 const double* constraint_mult, int constraint_dim);
+
 		/**
 		 * @brief Abstract method for evaluating the bounds of the problem
 		 * @param double* Lower bounds $x^L$ for $x$
@@ -187,6 +253,19 @@ class OptimizationModel
 		 */
 		virtual double evaluateAsSoftConstraints(const double* decision, int decision_dim);
 
+		/**
+		 * @brief Evaluates the gradient of the constraints as soft ones, i.e. the gradient of
+		 * evaluateAsSoftConstraints(). It's computed by finite differences with the same threads
+		 * and copies of the model as the cost gradient
+		 * @param double* Array of values for the gradient of the soft-cost
+		 * @param int Number of decision variables (dimension of $x$)
+		 * @param const double* Array for the decision variables, $x$, at which the gradient is
+		 * evaluated
+		 * @param int Number of decision variables (dimension of $x$)
+		 */
+		virtual void evaluateSoftConstraintGradient(double* gradient, int grad_dim,
+													const double* decision, int decision_dim);
+
 		/**
 		 * @brief Abstract method for evaluating the jacobian of the constraint function given a
 		 * current decision state
@@ -231,6 +310,57 @@ class OptimizationModel
 											   const double* decision, int decision_dim,
 											   bool flag);
 
+		/**
+		 * @brief Sets the sparsity pattern of the constraint Jacobian, which is used when the
+		 * Jacobian values are approximated (e.g. by finite differences)
+		 * @param const std::vector<int>& Row indices of the nonzero values
+		 * @param const std::vector<int>& Column indices of the nonzero values
+		 */
+		void setJacobianStructure(const std::vector<int>& row_entries,
+								  const std::vector<int>& col_entries);
+
+		/**
+		 * @brief Sets the sparsity pattern of the lower triangle of the Lagrangian Hessian, which
+		 * is used when the Hessian values are approximated
+		 * @param const std::vector<int>& Row indices of the nonzero values
+		 * @param const std::vector<int>& Column indices of the nonzero values
+		 */
+		void setHessianStructure(const std::vector<int>& row_entries,
+								 const std::vector<int>& col_entries);
+
+		/**
+		 * @brief Detects the sparsity pattern of the constraint Jacobian by perturbing each
+		 * decision variable forward and backward at the given point and at random points around
+		 * it. An entry is structurally nonzero if its constraint changes in any of these probes.
+		 * Note that a pattern built from the problem structure (e.g. the knots of an optimal
+		 * control problem) is more reliable, and it's used if this method isn't called
+		 * @param const double* Decision variables around which the pattern is detected
+		 * @param int Number of decision variables
+		 * @param int Number of constraints
+		 * @param unsigned int Number of sampled points, including the given one (at least two)
+		 */
+		void detectJacobianStructure(const double* decision, int decision_dim,
+									 int constraint_dim,
+									 unsigned int num_samples = 3);
+
+		/**
+		 * @brief Gets the sparsity pattern of the constraint Jacobian
+		 * @param std::vector<int>& Row indices of the nonzero values
+		 * @param std::vector<int>& Column indices of the nonzero values
+		 * @return True if the pattern is defined, otherwise the Jacobian is assumed dense
+		 */
+		virtual bool getJacobianStructure(std::vector<int>& row_entries,
+										  std::vector<int>& col_entries);
+
+		/**
+		 * @brief Gets the sparsity pattern of the lower triangle of the Lagrangian Hessian
+		 * @param std::vector<int>& Row indices of the nonzero values
+		 * @param std::vector<int>& Column indices of the nonzero values
+		 * @return True if the pattern is defined, otherwise the Hessian is assumed dense
+		 */
+		virtual bool getHessianStructure(std::vector<int>& row_entries,
+										 std::vector<int>& col_entries);
+
 		/** @brief Gets the dimension of the state vector of the optimization problem */
 		unsigned int getDimensionOfState();
 
@@ -250,7 +380,7 @@ class OptimizationModel
 		bool isConstraintJacobianImplemented();
 
 		/** @brief Returns true if the Lagrangian Hessian is implemented */
-		bool isLagrangianHessianImplemented();
+		virtual bool isLagrangianHessianImplemented();
 
 		/** @brief Indicates is the constraint is implemented as soft-constraint */
 		bool isSoftConstraint();
@@ -272,6 +402,30 @@ class OptimizationModel
 		/** @brief Number of nonzero values of the Hessian */
 		unsigned int nonzero_hessian_;
 
+		/** @brief Declared or detected sparsity pattern of the constraint Jacobian */
+		std::vector<int> jacobian_rows_;
+		std::vector<int> jacobian_cols_;
+
+		/** @brief Declared sparsity pattern of the lower triangle of the Lagrangian Hessian */
+		std::vector<int> hessian_rows_;
+		std::vector<int> hessian_cols_;
+
+		/** @brief True if the next optimization starts from the last solution */
+		bool warm_start_;
+
+		/**
+		 * @brief Deletes the per-thread copies used for the finite-difference gradient, which
+		 * have to be deleted when the model is modified
+		 */
+		void clearGradientModels();
+
+		/**
+		 * @brief Updates a copy of the model with the states that could be set after its
+		 * creation, e.g. the initial or desired states. By default there is nothing to update
+		 * @param OptimizationModel* Copy created by clone()
+		 */
+		virtual void syncClone(OptimizationModel* model);
+
 
 	private:
 		/** @brief True if the gradient of the cost function is implemented */
@@ -291,12 +445,89 @@ class OptimizationModel
 
 		bool first_time_;
 
-		/** @brief Cost functor for numerical differentiation */
-		CostFunction cost_function_;
+		/**
+		 * @brief Creates the per-thread copies and the thread pool of the finite-difference
+		 * gradient, or reuses them if the dimensions didn't change
+		 * @param unsigned int Dimension of the decision variables
+		 * @return True if the model could be cloned
+		 */
+		bool initGradientModels(unsigned int decision_dim);
+
+		/**
+		 * @brief Computes the finite-difference gradient of the cost or the soft-cost of the
+		 * constraints. The variables are perturbed in blocks on the per-thread copies of the
+		 * model if there are gradient threads
+		 * @param double* Gradient
+		 * @param const double* Decision variables
+		 * @param int Number of decision variables
+		 * @param bool Differentiates the soft-cost of the constraints instead of the cost
+		 * @param Eigen::VectorXd& Adapted relative steps of the differentiated function
+		 * @param Eigen::VectorXd& Curvatures of the differentiated function
+		 */
+		void computeFiniteDifferences(double* gradient,
+									  const double* decision, int decision_dim,
+									  bool soft_cost,
+									  Eigen::VectorXd& step_scales,
+									  Eigen::VectorXd& curvatures);
+
+		/**
+		 * @brief Adapts the relative step of each variable to its curvature, so the truncation
+		 * error is balanced with the rounding error of the cost
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision variables
+		 * @param double Cost of the unperturbed decision variables
+		 * @param Eigen::VectorXd& Adapted relative steps
+		 * @param const Eigen::VectorXd& Curvatures of the variables
+		 */
+		void adaptSteps(const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+						double base_cost,
+						Eigen::VectorXd& step_scales,
+						const Eigen::VectorXd& curvatures);
+
+		/**
+		 * @brief Computes the finite-difference gradient of a block of variables
+		 * @param OptimizationModel* Model used for the cost evaluations
+		 * @param double* Gradient
+		 * @param Eigen::VectorXd& Decision variables, which are restored after each perturbation
+		 * @param const Eigen::VectorXd& Per-variable steps
+		 * @param double Cost of the unperturbed decision variables (forward differences)
+		 * @param bool Differentiates the soft-cost of the constraints instead of the cost
+		 * @param Eigen::VectorXd* Curvatures of the variables, which are computed with central
+		 * differences if it isn't NULL
+		 * @param unsigned int First variable of the block
+		 * @param unsigned int Last variable of the block (not included)
+		 */
+		void computeGradientBlock(OptimizationModel* model,
+								  double* gradient,
+								  Eigen::VectorXd& decision_var,
+								  const Eigen::VectorXd& steps,
+								  double base_cost,
+								  bool soft_cost,
+								  Eigen::VectorXd* curvatures,
+								  unsigned int first,
+								  unsigned int last);
 
 		/** @brief Numerical differentiation mode */
 		Eigen::NumericalDiffMode num_diff_mode_;
 
+		/** @brief Number of threads of the finite-difference gradient */
+		unsigned int gradient_threads_;
+
+		/** @brief Thread pool and per-thread copies of the finite-difference gradient */
+		utils::ThreadPool* gradient_pool_;
+		std::vector<OptimizationModel*> gradient_models_;
+
+		/** @brief Dimensions of the decision variables and constraints of the copies */
+		unsigned int gradient_decision_dim_;
+		unsigned int gradient_constraint_dim_;
+
+		/** @brief Adapted relative steps and curvatures of the finite-difference gradient */
+		Eigen::VectorXd step_scales_;
+		Eigen::VectorXd curvatures_;
+
+		/** @brief Adapted relative steps and curvatures of the soft-constraint gradient */
+		Eigen::VectorXd soft_step_scales_;
+		Eigen::VectorXd soft_curvatures_;
+
 		/** @brief Machine epsilon constant which gives an upper bound on the relative error
 		    due to rounding in floating point arithmetic */
 		double epsilon_;
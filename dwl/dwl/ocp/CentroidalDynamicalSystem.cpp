@@ -26,6 +26,12 @@ CentroidalDynamicalSystem::~CentroidalDynamicalSystem()
 }
 
 
+CentroidalDynamicalSystem* CentroidalDynamicalSystem::clone() const
+{
+	return new CentroidalDynamicalSystem(*this);
+}
+
+
 void CentroidalDynamicalSystem::initDynamicalSystem()
 {
 	// Getting the end-effector names
@@ -46,7 +52,7 @@ void CentroidalDynamicalSystem::computeDynamicalConstraint(Eigen::VectorXd& cons
 	double step_time = state.time - state_buffer_[0].time;
 
 	// Computing the joint acceleration from velocities
-	Eigen::VectorXd base_acc = (state.base_vel - state_buffer_[0].base_vel) / step_time;
+	rbd::Vector6d base_acc = (state.base_vel - state_buffer_[0].base_vel) / step_time;
 
 
 	// Computing the centroidal dynamics
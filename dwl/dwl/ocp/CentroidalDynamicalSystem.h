@@ -31,6 +31,9 @@ class CentroidalDynamicalSystem : public DynamicalSystem
 		/** @brief Initializes the centroidal dynamical system constraint */
 		void initDynamicalSystem();
 
+		/** @brief Creates a deep copy of the dynamical system */
+		CentroidalDynamicalSystem* clone() const;
+
 		/**
 		 * @brief Computes the centroidal dynamics constraint vector given a certain state
 		 * @param Eigen::VectorXd& Evaluated constraint function
@@ -25,6 +25,12 @@ ConstrainedDynamicalSystem::~ConstrainedDynamicalSystem()
 }
 
 
+ConstrainedDynamicalSystem* ConstrainedDynamicalSystem::clone() const
+{
+	return new ConstrainedDynamicalSystem(*this);
+}
+
+
 void ConstrainedDynamicalSystem::setActiveEndEffectors(const rbd::BodySelector& active_set)
 {
 	active_endeffectors_ = active_set;
@@ -42,15 +48,14 @@ void ConstrainedDynamicalSystem::computeDynamicalConstraint(Eigen::VectorXd& con
 	double step_time = state.time - state_buffer_[0].time;
 
 	// Computing the constrained inverse dynamics to the defined active contacts
-	Eigen::VectorXd estimated_joint_forces;
-	Eigen::VectorXd base_acc = (state.base_vel - state_buffer_[0].base_vel) / step_time;
-	Eigen::VectorXd joint_acc = (state.joint_vel - state_buffer_[0].joint_vel) / step_time;
-	dynamics_.computeConstrainedFloatingBaseInverseDynamics(estimated_joint_forces,
+	rbd::Vector6d base_acc = (state.base_vel - state_buffer_[0].base_vel) / step_time;
+	joint_acc_ = (state.joint_vel - state_buffer_[0].joint_vel) / step_time;
+	dynamics_.computeConstrainedFloatingBaseInverseDynamics(estimated_joint_forces_,
 															state.base_pos, state.joint_pos,
 															state.base_vel, state.joint_vel,
-															base_acc, joint_acc,
+															base_acc, joint_acc_,
 															active_endeffectors_);
-	constraint.segment(0, system_.getJointDoF()) = estimated_joint_forces - state.joint_eff;
+	constraint.segment(0, system_.getJointDoF()) = estimated_joint_forces_ - state.joint_eff;
 
 
 	// This constrained inverse dynamic algorithm could generate joint forces in cases where the
@@ -27,6 +27,9 @@ class ConstrainedDynamicalSystem : public DynamicalSystem
 		/** @brief Destructor function */
 		~ConstrainedDynamicalSystem();
 
+		/** @brief Creates a deep copy of the dynamical system */
+		ConstrainedDynamicalSystem* clone() const;
+
 		/**
 		 * @brief Sets the active end-effectors, i.e. end-effectors in contact
 		 * @param const rbd::BodySelector& Set of active end-effectors
@@ -56,6 +59,10 @@ class ConstrainedDynamicalSystem : public DynamicalSystem
 
 		/** @brief Number of active end-effectors */
 		unsigned int num_actived_endeffectors_;
+
+		/** @brief Joint accelerations and forces, kept for avoiding allocations */
+		Eigen::VectorXd joint_acc_;
+		Eigen::VectorXd estimated_joint_forces_;
 };
 
 } //@namespace ocp
@@ -87,6 +87,13 @@ class Constraint
 		 */
 		virtual void init(bool info = false);
 
+		/**
+		 * @brief Creates a deep copy of the constraint, which is used for evaluating it in
+		 * different threads. By default the constraint is not clonable (returns NULL)
+		 * @return Constraint<TState>* Pointer to the copy of the constraint
+		 */
+		virtual Constraint<TState>* clone() const;
+
 		/**
 		 * @brief Computes the soft-value of the constraint given a certain state
 		 * @param double& Soft-value or the associated cost to the constraint
@@ -127,9 +134,16 @@ class Constraint
 		 */
 		void setLastState(TState& last_state);
 
-		/** @brief Resets the state buffer */
+		/** @brief Resets the state buffer, i.e. there is not a previous state */
 		void resetStateBuffer();
 
+		/**
+		 * @brief Fills the state buffer with copies of a state, so the next last states reuse
+		 * their memory. The buffer is reset afterwards
+		 * @param const TState& Whole-body state that defines the dimensions
+		 */
+		void initStateBuffer(const TState& state);
+
 		/** @brief Gets the dimension of the constraint */
 		unsigned int getConstraintDimension();
 
@@ -156,6 +170,9 @@ class Constraint
 		/** @brief Sets the last state */
 		boost::circular_buffer<TState> state_buffer_;
 
+		/** @brief Number of last states set since the buffer was reset */
+		unsigned int num_last_states_;
+
 		/** @brief A floating-base system definition */
 		model::FloatingBaseSystem system_;
 
@@ -7,7 +7,7 @@ namespace dwl
 namespace ocp
 {
 
-Cost::Cost()
+Cost::Cost() : desired_state_version_(0)
 {
 
 }
@@ -19,6 +19,20 @@ Cost::~Cost()
 }
 
 
+Cost* Cost::clone() const
+{
+	return NULL;
+}
+
+
+bool Cost::computeHessian(WholeBodyState& hessian,
+						  WholeBodyState& duration_hessian,
+						  const WholeBodyState& state)
+{
+	return false;
+}
+
+
 void Cost::setWeights(const WholeBodyState& weights)
 {
 	// Checking the cost variables
@@ -73,6 +87,19 @@ void Cost::setWeights(const WholeBodyState& weights)
 void Cost::setDesiredState(const WholeBodyState& desired_state)
 {
 	desired_state_ = desired_state;
+	++desired_state_version_;
+}
+
+
+const WholeBodyState& Cost::getDesiredState() const
+{
+	return desired_state_;
+}
+
+
+unsigned long int Cost::getDesiredStateVersion() const
+{
+	return desired_state_version_;
 }
 
 
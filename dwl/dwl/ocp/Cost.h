@@ -44,6 +44,13 @@ class Cost
 		/** @brief Destructor function */
 		virtual ~Cost();
 
+		/**
+		 * @brief Creates a deep copy of the cost, which is used for evaluating it in different
+		 * threads. By default the cost is not clonable (returns NULL)
+		 * @return Cost* Pointer to the copy of the cost
+		 */
+		virtual Cost* clone() const;
+
 		/**
 		 * @brief Computes the cost value given a certain state
 		 * @param double& Cost value
@@ -52,6 +59,21 @@ class Cost
 		virtual void compute(double& cost,
 							 const WholeBodyState& state) = 0;
 
+		/**
+		 * @brief Computes the diagonal of the cost Hessian with respect to the whole-body state,
+		 * and the mixed second derivatives with respect to the step duration and the whole-body
+		 * state, and adds them to the given Hessian states. By default the second derivatives
+		 * are not available
+		 * @param WholeBodyState& Diagonal of the Hessian described as whole-body state
+		 * @param WholeBodyState& Mixed second derivatives with the step duration described as
+		 * whole-body state
+		 * @param const WholeBodyState& Whole-body state
+		 * @return True if the second derivatives are available
+		 */
+		virtual bool computeHessian(WholeBodyState& hessian,
+									WholeBodyState& duration_hessian,
+									const WholeBodyState& state);
+
 		/**
 		 * @brief Sets the whole-body state weights which are used by specific cost function
 		 * @param WholeBodyState& Whole-body weights
@@ -64,6 +86,16 @@ class Cost
 		 */
 		void setDesiredState(const WholeBodyState& desired_state);
 
+		/** @brief Gets the desired whole-body state */
+		const WholeBodyState& getDesiredState() const;
+
+		/**
+		 * @brief Gets the version of the desired state, which increases every time that it's set.
+		 * It allows to update the copies of the cost only when it's needed
+		 * @return The desired state version
+		 */
+		unsigned long int getDesiredStateVersion() const;
+
 		/**
 		 * @brief Gets the name of the cost
 		 * @return The name of the cost
@@ -83,6 +115,9 @@ class Cost
 
 		/** @brief Desired whole-body state */
 		WholeBodyState desired_state_;
+
+		/** @brief Version of the desired state */
+		unsigned long int desired_state_version_;
 };
 
 } //@namespace ocp
@@ -8,8 +8,8 @@ namespace ocp
 {
 
 DynamicalSystem::DynamicalSystem() : state_dimension_(0), terminal_constraint_dimension_(0),
-		system_variables_(false), integration_method_(Fixed), step_time_(0.1),
-		is_full_trajectory_optimization_(false)
+		state_version_(0), system_variables_(false), integration_method_(Fixed), step_time_(0.1),
+		transcription_method_(BackwardEuler), is_full_trajectory_optimization_(false)
 {
 
 }
@@ -49,6 +49,12 @@ void DynamicalSystem::initDynamicalSystem()
 }
 
 
+DynamicalSystem* DynamicalSystem::clone() const
+{
+	return NULL;
+}
+
+
 void DynamicalSystem::jointLimitsFromURDF()
 {
 	// Initializing the joint limits
@@ -80,18 +86,16 @@ void DynamicalSystem::compute(Eigen::VectorXd& constraint,
 							  const WholeBodyState& state)
 {
 	// Evaluating the numerical integration
-	Eigen::VectorXd time_constraint;
-	numericalIntegration(time_constraint, state);
+	numericalIntegration(time_constraint_, state);
 
 	// Computing the dynamical constraint
-	Eigen::VectorXd dynamical_constraint;
-	computeDynamicalConstraint(dynamical_constraint, state);
+	computeDynamicalConstraint(dynamical_constraint_, state);
 
 	// Adding both constraints
-	unsigned int dynamical_dim = dynamical_constraint.size();
+	unsigned int dynamical_dim = dynamical_constraint_.size();
 	constraint.resize(system_.getSystemDoF() + dynamical_dim);
-	constraint.segment(0, system_.getSystemDoF()) = time_constraint;
-	constraint.segment(system_.getSystemDoF(), dynamical_dim) = dynamical_constraint;
+	constraint.segment(0, system_.getSystemDoF()) = time_constraint_;
+	constraint.segment(system_.getSystemDoF(), dynamical_dim) = dynamical_constraint_;
 }
 
 
@@ -108,29 +112,58 @@ void DynamicalSystem::computeTerminalConstraint(Eigen::VectorXd& constraint,
 {
 	constraint.resize(system_.getFloatingBaseDoF());
 
-	// Computing the position error
-	Eigen::VectorXd position_error =
-			system_.toGeneralizedJointState(terminal_state_.base_pos, terminal_state_.joint_pos) -
-			system_.toGeneralizedJointState(state.base_pos, state.joint_pos);
+	// Computing the position error. Note that the generalized state of the terminal state is
+	// copied since toGeneralizedJointState() reuses the same vector
+	last_pos_ = system_.toGeneralizedJointState(terminal_state_.base_pos, terminal_state_.joint_pos);
+	pos_ = system_.toGeneralizedJointState(state.base_pos, state.joint_pos);
 
 	// Adding the terminal constraint
-	constraint = position_error.head(system_.getFloatingBaseDoF());
+	constraint = (last_pos_ - pos_).head(system_.getFloatingBaseDoF());
 }
 
 
 void DynamicalSystem::numericalIntegration(Eigen::VectorXd& constraint,
 										   const WholeBodyState& state)
 {
-	// Resizing the constraint vector
-	constraint.resize(system_.getSystemDoF());
-
-	// Transcription of the constrained inverse dynamic equation using Euler-backward integration.
-	// This integration method adds numerical stability
-	Eigen::VectorXd base_int = state_buffer_[0].base_pos - state.base_pos + state.duration * state.base_vel;
-	Eigen::VectorXd joint_int = state_buffer_[0].joint_pos - state.joint_pos + state.duration * state.joint_vel;
+	// Getting the generalized positions and velocities of the last and current knots. Note
+	// that the vectors are members for avoiding memory allocation
+	const WholeBodyState& last_state = state_buffer_[0];
+	last_pos_ = system_.toGeneralizedJointState(last_state.base_pos, last_state.joint_pos);
+	last_vel_ = system_.toGeneralizedJointState(last_state.base_vel, last_state.joint_vel);
+	pos_ = system_.toGeneralizedJointState(state.base_pos, state.joint_pos);
+	vel_ = system_.toGeneralizedJointState(state.base_vel, state.joint_vel);
+	double step_time = state.duration;
 
-	// Adding the time integration constraint
-	constraint = system_.toGeneralizedJointState(base_int, joint_int);
+	// Transcription of the time integration between the last and current knots
+	constraint.resize(system_.getSystemDoF());
+	switch (transcription_method_) {
+		case Trapezoidal:
+			// Trapezoidal collocation, i.e. the velocity is linear between knots
+			constraint = last_pos_ - pos_ + 0.5 * step_time * (last_vel_ + vel_);
+			break;
+		case HermiteSimpson:
+			// Compressed Hermite-Simpson collocation, where the midpoint velocity is computed from
+			// the cubic Hermite interpolation of the velocity
+			last_acc_ = system_.toGeneralizedJointState(last_state.base_acc, last_state.joint_acc);
+			acc_ = system_.toGeneralizedJointState(state.base_acc, state.joint_acc);
+			constraint = last_pos_ - pos_ + 0.5 * step_time * (last_vel_ + vel_) +
+					step_time * step_time / 12 * (last_acc_ - acc_);
+			break;
+		case RungeKutta4:
+			// Shooting from the last knot with the classical Runge-Kutta method, where the
+			// acceleration is linearly interpolated between knots. The stages of the position
+			// are k1 = v, k2 = v + h/2 a, k3 = v + h/4 (a + a') and k4 = v + h/2 (a + a'), so
+			// k1 + 2 k2 + 2 k3 + k4 = 6 v + h (2 a + a')
+			last_acc_ = system_.toGeneralizedJointState(last_state.base_acc, last_state.joint_acc);
+			acc_ = system_.toGeneralizedJointState(state.base_acc, state.joint_acc);
+			constraint = last_pos_ - pos_ + step_time / 6 *
+					(6 * last_vel_ + step_time * (2 * last_acc_ + acc_));
+			break;
+		default:
+			// Euler-backward integration. This integration method adds numerical stability
+			constraint = last_pos_ - pos_ + step_time * vel_;
+			break;
+	}
 }
 
 
@@ -183,6 +216,20 @@ void DynamicalSystem::setStepIntegrationMethod(StepIntegrationMethod method)
 }
 
 
+void DynamicalSystem::setTranscriptionMethod(TranscriptionMethod method)
+{
+	// Hermite-Simpson and Runge-Kutta integrate the knot accelerations
+	if ((method == HermiteSimpson || method == RungeKutta4) && !system_variables_.acceleration) {
+		printf(RED "FATAL: the Hermite-Simpson and Runge-Kutta transcriptions require the "
+				"accelerations as decision variables, which are not defined in the %s dynamical "
+				"system\n" COLOR_RESET, name_.c_str());
+		exit(EXIT_FAILURE);
+	}
+
+	transcription_method_ = method;
+}
+
+
 void DynamicalSystem::setStepIntegrationTime(const double& step_time)
 {
 	step_time_ = step_time;
@@ -212,12 +259,14 @@ void DynamicalSystem::setStateBounds(const WholeBodyState& lower_bound,
 void DynamicalSystem::setInitialState(const WholeBodyState& initial_state)
 {
 	initial_state_ = initial_state;
+	++state_version_;
 }
 
 
 void DynamicalSystem::setTerminalState(const WholeBodyState& terminal_state)
 {
 	terminal_state_ = terminal_state;
+	++state_version_;
 }
 
 
@@ -241,6 +290,12 @@ const WholeBodyState& DynamicalSystem::getTerminalState()
 }
 
 
+unsigned long int DynamicalSystem::getStateVersion() const
+{
+	return state_version_;
+}
+
+
 unsigned int DynamicalSystem::getDimensionOfState()
 {
 	return state_dimension_;
@@ -265,6 +320,12 @@ const double& DynamicalSystem::getFixedStepTime()
 }
 
 
+unsigned int DynamicalSystem::getNumberOfPreviousKnots()
+{
+	return 1;
+}
+
+
 void DynamicalSystem::setFullTrajectoryOptimization()
 {
 	is_full_trajectory_optimization_ = true;
@@ -287,37 +348,38 @@ void DynamicalSystem::toWholeBodyState(WholeBodyState& system_state,
 		++idx;
 	}
 	if (system_variables_.position) {
+		generalized_joint_state_ = generalized_state.segment(idx, system_.getSystemDoF());
 		system_.fromGeneralizedJointState(system_state.base_pos,
 										  system_state.joint_pos,
-										  (Eigen::VectorXd) generalized_state.segment(idx, system_.getSystemDoF()));
+										  generalized_joint_state_);
 		idx += system_.getSystemDoF();
 	}
 	if (system_variables_.velocity) {
+		generalized_joint_state_ = generalized_state.segment(idx, system_.getSystemDoF());
 		system_.fromGeneralizedJointState(system_state.base_vel,
 										  system_state.joint_vel,
-										  (Eigen::VectorXd) generalized_state.segment(idx, system_.getSystemDoF()));
+										  generalized_joint_state_);
 		idx += system_.getSystemDoF();
 	}
 	if (system_variables_.acceleration) {
+		generalized_joint_state_ = generalized_state.segment(idx, system_.getSystemDoF());
 		system_.fromGeneralizedJointState(system_state.base_acc,
 										  system_state.joint_acc,
-										  (Eigen::VectorXd) generalized_state.segment(idx, system_.getSystemDoF()));
+										  generalized_joint_state_);
 		idx += system_.getSystemDoF();
 	}
 	if (system_variables_.effort) {
-		// Defining a fake floating-base system (fixed-base) for converting only joint effort
-		model::FloatingBaseSystem fake_system(false, system_.getJointDoF());
-		fake_system.fromGeneralizedJointState(system_state.base_eff,
-											  system_state.joint_eff,
-											  (Eigen::VectorXd) generalized_state.segment(idx, system_.getJointDoF()));
+		// Converting only joint effort, i.e. as a fixed-base system
+		system_state.base_eff.setZero();
+		system_state.joint_eff = generalized_state.segment(idx, system_.getJointDoF());
 		idx += system_.getJointDoF();
 	}
 	if (system_variables_.contact_pos || system_variables_.contact_vel ||
 			system_variables_.contact_acc || system_variables_.contact_for) {
-		urdf_model::LinkID contact_links = system_.getEndEffectors();
+		const urdf_model::LinkID& contact_links = system_.getEndEffectors();
 		for (urdf_model::LinkID::const_iterator contact_it = contact_links.begin();
 				contact_it != contact_links.end(); contact_it++) {
-			std::string name = contact_it->first;
+			const std::string& name = contact_it->first;
 
 			if (system_variables_.contact_pos) {
 				system_state.contact_pos[name] = generalized_state.segment<3>(idx);
@@ -371,19 +433,16 @@ void DynamicalSystem::fromWholeBodyState(Eigen::VectorXd& generalized_state,
 		idx += system_.getSystemDoF();
 	}
 	if (system_variables_.effort) {
-		// Defining a fake floating-base system (fixed-base) for converting only joint effort
-		model::FloatingBaseSystem fake_system(false, system_.getJointDoF());
-		generalized_state.segment(idx, system_.getJointDoF()) =
-				fake_system.toGeneralizedJointState(system_state.base_eff,
-											 	 	system_state.joint_eff);
+		// Converting only joint effort, i.e. as a fixed-base system
+		generalized_state.segment(idx, system_.getJointDoF()) = system_state.joint_eff;
 		idx += system_.getJointDoF();
 	}
 	if (system_variables_.contact_pos || system_variables_.contact_vel ||
 			system_variables_.contact_acc || system_variables_.contact_for) {
-		urdf_model::LinkID contact_links = system_.getEndEffectors();
+		const urdf_model::LinkID& contact_links = system_.getEndEffectors();
 		for (urdf_model::LinkID::const_iterator contact_it = contact_links.begin();
 				contact_it != contact_links.end(); contact_it++) {
-			std::string name = contact_it->first;
+			const std::string& name = contact_it->first;
 
 			if (system_variables_.contact_pos) {
 				generalized_state.segment<3>(idx) = system_state.contact_pos.at(name);
@@ -398,7 +457,7 @@ void DynamicalSystem::fromWholeBodyState(Eigen::VectorXd& generalized_state,
 				idx += 3;
 			}
 			if (system_variables_.contact_for) {
-				generalized_state.segment<3>(idx) = system_state.contact_eff.at(name).segment<3>(rbd::LZ);
+				generalized_state.segment<3>(idx) = system_state.contact_eff.at(name).segment<3>(rbd::LX);
 				idx += 3;
 			}
 		}
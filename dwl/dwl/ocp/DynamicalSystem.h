@@ -31,6 +31,14 @@ struct WholeBodyVariables
 /** @brief Defines the different methods for step-time integration */
 enum StepIntegrationMethod {Fixed, Variable};
 
+/**
+ * @brief Defines the different transcription methods of the time integration between
+ * consecutive knots. Backward Euler and trapezoidal collocation only use the positions and
+ * velocities, whereas Hermite-Simpson collocation and Runge-Kutta (4th order) multiple shooting
+ * also use the accelerations, so they require them as decision variables
+ */
+enum TranscriptionMethod {BackwardEuler, Trapezoidal, HermiteSimpson, RungeKutta4};
+
 /**
  * @class DynamicalSystem
  * @brief This abstract class defines common methods for implementing dynamical system constraint.
@@ -56,6 +64,13 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		/** @brief Initializes the dynamical system properties */
 		virtual void initDynamicalSystem();
 
+		/**
+		 * @brief Creates a deep copy of the dynamical system, which is used for evaluating it in
+		 * different threads. By default the dynamical system is not clonable (returns NULL)
+		 * @return DynamicalSystem* Pointer to the copy of the dynamical system
+		 */
+		virtual DynamicalSystem* clone() const;
+
 		/** @brief Reads and sets the joint limit from an URDF model */
 		void jointLimitsFromURDF();
 
@@ -88,7 +103,8 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		/**
 		 * @brief Computes the constraint from the time integration. Additionally, it's updated
 		 * the time value in case of fixed-step integration, i.e. optimization without time as a
-		 * decision variable. Note that there are different numerical integration methods
+		 * decision variable. Note that there are different transcription methods, and the step
+		 * time is defined by the step integration method
 		 * @param Eigen::VectorXd& Evaluated the dynamical constraint function
 		 * @param const WholeBodyState& Whole-body state
 		 */
@@ -148,6 +164,14 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		 */
 		void setStepIntegrationMethod(StepIntegrationMethod method);
 
+		/**
+		 * @brief Sets the transcription method of the time integration. The default value is
+		 * backward Euler. Hermite-Simpson and Runge-Kutta are only available if the accelerations
+		 * are decision variables
+		 * @param TranscriptionMethod Transcription method
+		 */
+		void setTranscriptionMethod(TranscriptionMethod method);
+
 		/**
 		 * @brief Sets the fixed-step integration time
 		 * @param const double& Fixed-step integration time
@@ -174,6 +198,13 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		/** @brief Gets the terminal whole-body state of the dynamical constraint */
 		const WholeBodyState& getTerminalState();
 
+		/**
+		 * @brief Gets the version of the initial and terminal states, which increases every time
+		 * that they are set. It allows to update the copies of the system only when it's needed
+		 * @return The state version
+		 */
+		unsigned long int getStateVersion() const;
+
 		/** @brief Gets the dimension of the dynamical state */
 		unsigned int getDimensionOfState();
 
@@ -186,6 +217,13 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		/** @brief Gets the fixed-step time of integration */
 		const double& getFixedStepTime();
 
+		/**
+		 * @brief Gets the number of previous knots that are coupled with the current one by
+		 * the transcription, i.e. the number of last states used by the time integration. All
+		 * the transcription methods only use the previous knot
+		 */
+		unsigned int getNumberOfPreviousKnots();
+
 		/** @brief Sets the problem as full-trajectory optimization, which means to add
 		 * a the terminal constraint to the optimization problem */
 		void setFullTrajectoryOptimization();
@@ -226,6 +264,9 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		/** @brief Terminal whole-body state */
 		WholeBodyState terminal_state_;
 
+		/** @brief Version of the initial and terminal states */
+		unsigned long int state_version_;
+
 		/** @brief Lower whole-body state bounds */
 		WholeBodyState lower_state_bound_;
 
@@ -241,6 +282,20 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		/** @brief Fixed-step time value [in seconds] */
 		double step_time_;
 
+		/** @brief Transcription method of the time integration */
+		TranscriptionMethod transcription_method_;
+
+		/** @brief Time integration and dynamical constraints, kept for avoiding allocations */
+		Eigen::VectorXd time_constraint_;
+		Eigen::VectorXd dynamical_constraint_;
+
+		/** @brief Generalized states of the last and current knots used by the transcription */
+		Eigen::VectorXd last_pos_, last_vel_, last_acc_;
+		Eigen::VectorXd pos_, vel_, acc_;
+
+		/** @brief Generalized joint state used for converting the decision variables */
+		Eigen::VectorXd generalized_joint_state_;
+
 
 	private:
 		/** @brief Computes the state dimension of the dynamical constraint */
@@ -26,6 +26,12 @@ FullDynamicalSystem::~FullDynamicalSystem()
 }
 
 
+FullDynamicalSystem* FullDynamicalSystem::clone() const
+{
+	return new FullDynamicalSystem(*this);
+}
+
+
 void FullDynamicalSystem::initDynamicalSystem()
 {
 	// Getting the end-effector names
@@ -50,20 +56,20 @@ void FullDynamicalSystem::computeDynamicalConstraint(Eigen::VectorXd& constraint
 	double step_time = state.time - state_buffer_[0].time;
 
 	// Computing the joint acceleration from velocities
-	Eigen::VectorXd base_acc = (state.base_vel - state_buffer_[0].base_vel) / step_time;
-	Eigen::VectorXd joint_acc = (state.joint_vel - state_buffer_[0].joint_vel) / step_time;
+	rbd::Vector6d base_acc = (state.base_vel - state_buffer_[0].base_vel) / step_time;
+	joint_acc_ = (state.joint_vel - state_buffer_[0].joint_vel) / step_time;
 
 	// Computing the full inverse dynamics. In real-cases, the floating-base effort (state.base_eff)
 	// is always equals to zero, which implicates that we are imposing that the base_wrench equals
 	// to null vector. TODO Another implementation could be posed as floating-base inverse dynamics
 	rbd::Vector6d estimated_base_wrench;
-	Eigen::VectorXd estimated_joint_forces;
-	dynamics_.computeInverseDynamics(estimated_base_wrench, estimated_joint_forces,
+	dynamics_.computeInverseDynamics(estimated_base_wrench, estimated_joint_forces_,
 									 state.base_pos, state.joint_pos,
 									 state.base_vel, state.joint_vel,
-									 base_acc, joint_acc, state.contact_eff);
+									 base_acc, joint_acc_, state.contact_eff);
+	estimated_joint_forces_ -= state.joint_eff;
 	constraint = system_.toGeneralizedJointState(estimated_base_wrench - state.base_eff,
-												 estimated_joint_forces - state.joint_eff);
+												 estimated_joint_forces_);
 }
 
 
@@ -28,6 +28,9 @@ class FullDynamicalSystem : public DynamicalSystem
 		/** @brief Initializes the full dynamical system constraint */
 		void initDynamicalSystem();
 
+		/** @brief Creates a deep copy of the dynamical system */
+		FullDynamicalSystem* clone() const;
+
 		/**
 		 * @brief Computes the dynamic constraint vector given a certain state
 		 * @param Eigen::VectorXd& Evaluated constraint function
@@ -48,6 +51,10 @@ class FullDynamicalSystem : public DynamicalSystem
 	private:
 		/** @brief End-effector names */
 		std::vector<std::string> end_effector_names_;
+
+		/** @brief Joint accelerations and forces, kept for avoiding allocations */
+		Eigen::VectorXd joint_acc_;
+		Eigen::VectorXd estimated_joint_forces_;
 };
 
 } //@namespace ocp
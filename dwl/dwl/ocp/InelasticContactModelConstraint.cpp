@@ -20,6 +20,12 @@ InelasticContactModelConstraint::~InelasticContactModelConstraint()
 }
 
 
+InelasticContactModelConstraint* InelasticContactModelConstraint::clone() const
+{
+	return new InelasticContactModelConstraint(*this);
+}
+
+
 void InelasticContactModelConstraint::init(bool info)
 {
 	// Getting the end-effector names
@@ -25,6 +25,9 @@ class InelasticContactModelConstraint : public ComplementaryConstraint
 		 */
 		void init(bool info);
 
+		/** @brief Creates a deep copy of the constraint */
+		InelasticContactModelConstraint* clone() const;
+
 		/**
 		 * @brief Computes the first complement constraint vector given a certain state
 		 * @param Eigen::VectorXd& Evaluated constraint function
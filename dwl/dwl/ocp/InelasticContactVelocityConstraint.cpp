@@ -20,6 +20,12 @@ InelasticContactVelocityConstraint::~InelasticContactVelocityConstraint()
 }
 
 
+InelasticContactVelocityConstraint* InelasticContactVelocityConstraint::clone() const
+{
+	return new InelasticContactVelocityConstraint(*this);
+}
+
+
 void InelasticContactVelocityConstraint::init(bool info)
 {
 	// Getting the end-effector names
@@ -25,6 +25,9 @@ class InelasticContactVelocityConstraint : public ComplementaryConstraint
 		 */
 		void init(bool info);
 
+		/** @brief Creates a deep copy of the constraint */
+		InelasticContactVelocityConstraint* clone() const;
+
 		/**
 		 * @brief Computes the first complement constraint vector given a certain state
 		 * @param Eigen::VectorXd& Evaluated constraint function
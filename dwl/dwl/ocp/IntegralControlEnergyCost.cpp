@@ -19,6 +19,12 @@ IntegralControlEnergyCost::~IntegralControlEnergyCost()
 }
 
 
+IntegralControlEnergyCost* IntegralControlEnergyCost::clone() const
+{
+	return new IntegralControlEnergyCost(*this);
+}
+
+
 void IntegralControlEnergyCost::compute(double& cost,
 										const WholeBodyState& state)
 {
@@ -28,11 +34,24 @@ void IntegralControlEnergyCost::compute(double& cost,
 		exit(EXIT_FAILURE);
 	}
 
-	// Computing the control cost
-	cost = state.joint_eff.transpose() * locomotion_weights_.joint_eff.asDiagonal() *
-			state.joint_eff;
+	// Computing the control cost. The diagonal weighting is computed coefficient-wise, which
+	// doesn't need temporary vectors
+	cost = (locomotion_weights_.joint_eff.array() * state.joint_eff.array().square()).sum();
 	cost *= state.duration;
 }
 
+
+bool IntegralControlEnergyCost::computeHessian(WholeBodyState& hessian,
+											   WholeBodyState& duration_hessian,
+											   const WholeBodyState& state)
+{
+	// The control energy is quadratic in the joint efforts and linear in the step duration
+	hessian.joint_eff += 2 * state.duration * locomotion_weights_.joint_eff;
+	duration_hessian.joint_eff.array() +=
+			2 * locomotion_weights_.joint_eff.array() * state.joint_eff.array();
+
+	return true;
+}
+
 } //@namespace ocp
 } //@namespace dwl
@@ -23,6 +23,9 @@ class IntegralControlEnergyCost : public Cost
 		/** @brief Destructor function */
 		~IntegralControlEnergyCost();
 
+		/** @brief Creates a deep copy of the cost */
+		IntegralControlEnergyCost* clone() const;
+
 		/**
 		 * @brief Computes the control energy cost, i.e. joint efforts energy, given a locomotion
 		 * state. The control energy is defined as quadratic cost function
@@ -31,6 +34,18 @@ class IntegralControlEnergyCost : public Cost
 		 */
 		void compute(double& cost,
 					 const WholeBodyState& state);
+
+		/**
+		 * @brief Computes the diagonal of the control energy Hessian, i.e. 2 * W * duration, and
+		 * its mixed derivatives with the step duration, i.e. 2 * W * u
+		 * @param WholeBodyState& Diagonal of the Hessian described as whole-body state
+		 * @param WholeBodyState& Mixed second derivatives with the step duration
+		 * @param const WholeBodyState& Whole-body state
+		 * @return True since the second derivatives are available
+		 */
+		bool computeHessian(WholeBodyState& hessian,
+							WholeBodyState& duration_hessian,
+							const WholeBodyState& state);
 };
 
 } //@namespace ocp
@@ -7,7 +7,8 @@ namespace dwl
 namespace ocp
 {
 
-LinearDynamicalSystem::LinearDynamicalSystem()
+LinearDynamicalSystem::LinearDynamicalSystem() : num_states_(0), num_inputs_(0),
+		num_outputs_(0), time_variant_(false)
 {
 
 }
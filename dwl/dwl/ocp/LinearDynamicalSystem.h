@@ -47,10 +47,12 @@ class LinearDynamicalSystem : public DynamicalSystem
 		 * LTI model, the function can be just defined to set the values of the model matrices.
 		 * @param Eigen::MatrixXd& State or System matrix
 		 * @param Eigen::MatrixXd& Input matrix
-		 * @return bool Label that indicates if the computation of the matrices is successful
 		 */
 		virtual void computeLinearSystem(Eigen::MatrixXd& A, Eigen::MatrixXd& B) = 0;
 
+		/** @brief Get the states number of the dynamic model */
+		virtual int getStatesNumber() const;
+
 		/** @brief Get the inputs number of the dynamic model */
 		virtual int getInputsNumber() const;
 
@@ -64,10 +66,10 @@ class LinearDynamicalSystem : public DynamicalSystem
 		virtual bool getModelType() const;
 
 		/** @brief Function that returns the current value of the operation points for the states */
-		virtual double* getOperationPointsStates() const;
+		virtual const Eigen::VectorXd& getOperationPointsStates() const;
 
 		/** @brief Function that returns the current value of the operation points for the inputs */
-		virtual double* getOperationPointsInputs() const;
+		virtual const Eigen::VectorXd& getOperationPointsInputs() const;
 
 
 	protected:
@@ -77,6 +79,9 @@ class LinearDynamicalSystem : public DynamicalSystem
 		/** @brief Input matrix of the dynamic model */
 		Eigen::MatrixXd B_;
 
+		/** @brief Number of states of the dynamic model */
+		unsigned int num_states_;
+
 		/** @brief Number of inputs of the dynamic model */
 		unsigned int num_inputs_;
 
@@ -97,27 +102,32 @@ class LinearDynamicalSystem : public DynamicalSystem
 } //@namespace dwl
 
 
-inline int dwl::model::LinearDynamicalSystem::getInputsNumber() const
+inline int dwl::ocp::LinearDynamicalSystem::getStatesNumber() const
+{
+	return num_states_;
+}
+
+inline int dwl::ocp::LinearDynamicalSystem::getInputsNumber() const
 {
 	return num_inputs_;
 }
 
-inline int dwl::model::LinearDynamicalSystem::getOutputsNumber() const
+inline int dwl::ocp::LinearDynamicalSystem::getOutputsNumber() const
 {
 	return num_outputs_;
 }
 
-inline bool dwl::model::LinearDynamicalSystem::getModelType() const
+inline bool dwl::ocp::LinearDynamicalSystem::getModelType() const
 {	
 	return time_variant_;
 }
 
-inline double* dwl::model::LinearDynamicalSystem::getOperationPointsStates() const
+inline const Eigen::VectorXd& dwl::ocp::LinearDynamicalSystem::getOperationPointsStates() const
 {
 	return op_point_states_;
 }
 
-inline double* dwl::model::LinearDynamicalSystem::getOperationPointsInputs() const
+inline const Eigen::VectorXd& dwl::ocp::LinearDynamicalSystem::getOperationPointsInputs() const
 {
 	return op_point_input_;
 }
@@ -9,7 +9,9 @@ namespace ocp
 
 OptimalControl::OptimalControl() : dynamical_system_(NULL),
 		is_added_dynamic_system_(false), is_added_constraint_(false), is_added_cost_(false),
-		terminal_constraint_dimension_(0), horizon_(1)
+		terminal_constraint_dimension_(0), horizon_(1), shifted_point_(false), num_threads_(1),
+		thread_pool_(NULL), knot_parallel_(false), synced_system_version_(0),
+		hessian_approximation_(LimitedMemoryHessian)
 {
 
 }
@@ -17,6 +19,8 @@ OptimalControl::OptimalControl() : dynamical_system_(NULL),
 
 OptimalControl::~OptimalControl()
 {
+	clearKnotParallelism();
+	delete thread_pool_;
 	delete dynamical_system_;
 
 	typedef std::vector<Constraint<WholeBodyState>*>::iterator ConstraintItr;
@@ -60,6 +64,203 @@ void OptimalControl::init(bool only_soft_constraints)
 		for (unsigned int i = 0; i < constraints_.size(); i++)
 			constraints_[i]->defineAsSoftConstraint();
 	}
+
+	// Initializing the number of nonzero values of the Hessian, i.e. its diagonal
+	if (hessian_approximation_ != LimitedMemoryHessian) {
+		nonzero_hessian_ = horizon_ * state_dimension_;
+		initHessian();
+	} else
+		nonzero_hessian_ = 0;
+
+	// Initializing the per-thread copies for the knot-parallel evaluation
+	knot_times_.resize(horizon_);
+	initKnotParallelism();
+
+	// Initializing the evaluation buffers
+	initWorkspaces();
+}
+
+
+OptimalControl* OptimalControl::clone() const
+{
+	if (dynamical_system_ == NULL)
+		return NULL;
+
+	// Copying the dynamical system, constraints and costs, which are owned (and deleted) by the
+	// copy of the problem
+	OptimalControl* optimal_control = new OptimalControl();
+	bool clonable = true;
+	optimal_control->dynamical_system_ = dynamical_system_->clone();
+	optimal_control->is_added_dynamic_system_ = true;
+	clonable &= (optimal_control->dynamical_system_ != NULL);
+	for (unsigned int i = 0; i < constraints_.size(); i++) {
+		Constraint<WholeBodyState>* constraint = constraints_[i]->clone();
+		clonable &= (constraint != NULL);
+		if (constraint != NULL)
+			optimal_control->constraints_.push_back(constraint);
+	}
+	for (unsigned int i = 0; i < costs_.size(); i++) {
+		Cost* cost = costs_[i]->clone();
+		clonable &= (cost != NULL);
+		if (cost != NULL)
+			optimal_control->costs_.push_back(cost);
+	}
+	optimal_control->is_added_constraint_ = !optimal_control->constraints_.empty();
+	optimal_control->is_added_cost_ = !optimal_control->costs_.empty();
+
+	if (!clonable) {
+		delete optimal_control;
+		return NULL;
+	}
+
+	optimal_control->horizon_ = horizon_;
+	optimal_control->hessian_approximation_ = hessian_approximation_;
+	optimal_control->starting_point_ = starting_point_;
+
+	return optimal_control;
+}
+
+
+void OptimalControl::syncClone(model::OptimizationModel* model)
+{
+	// The states are copied in every call, which is cheap compared to the cost evaluations of
+	// a finite-difference gradient
+	OptimalControl* optimal_control = static_cast<OptimalControl*>(model);
+	optimal_control->dynamical_system_->setInitialState(dynamical_system_->getInitialState());
+	optimal_control->dynamical_system_->setTerminalState(dynamical_system_->getTerminalState());
+	for (unsigned int j = 0; j < costs_.size(); j++)
+		optimal_control->costs_[j]->setDesiredState(costs_[j]->getDesiredState());
+}
+
+
+void OptimalControl::evaluateKnotTimes(Eigen::VectorXd& knot_times,
+									   const Eigen::Ref<const Eigen::VectorXd>& decision_var)
+{
+	computeKnotTimes(decision_var);
+	knot_times = knot_times_;
+}
+
+
+void OptimalControl::evaluateConstraintsAtKnot(Eigen::VectorXd& constraint,
+											   const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+											   const Eigen::VectorXd& knot_times,
+											   unsigned int knot)
+{
+	setKnotTimes(knot_times, knot);
+
+	constraint.resize(constraint_dimension_);
+	computeKnotConstraints(constraint, workspaces_[0], dynamical_system_, constraints_,
+						   decision_var, knot);
+}
+
+
+double OptimalControl::evaluateCostAtKnot(const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+										  const Eigen::VectorXd& knot_times,
+										  unsigned int knot)
+{
+	setKnotTimes(knot_times, knot);
+
+	return computeKnotCost(workspaces_[0], dynamical_system_, constraints_, costs_,
+						   decision_var, knot);
+}
+
+
+void OptimalControl::evaluateTerminalConstraint(Eigen::VectorXd& constraint,
+												const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+												const Eigen::VectorXd& knot_times)
+{
+	if (!dynamical_system_->isFullTrajectoryOptimization()) {
+		constraint.resize(0);
+		return;
+	}
+
+	setKnotTimes(knot_times, horizon_ - 1);
+
+	KnotWorkspace& workspace = workspaces_[0];
+	getKnotState(workspace.system_state, workspace, dynamical_system_, decision_var, horizon_ - 1);
+	dynamical_system_->computeTerminalConstraint(constraint, workspace.system_state);
+}
+
+
+bool OptimalControl::getJacobianStructure(std::vector<int>& row_entries,
+										  std::vector<int>& col_entries)
+{
+	// The declared or detected pattern has priority
+	if (OptimizationModel::getJacobianStructure(row_entries, col_entries))
+		return true;
+
+	row_entries.clear();
+	col_entries.clear();
+
+	// The constraints of each knot depend on the decision variables of the coupled knots. In the
+	// variable step-time integration, they also depend on the step time of the earlier knots
+	// since they define the knot time
+	bool variable_step = !dynamical_system_->isFixedStepIntegration();
+	for (unsigned int k = 0; k < horizon_; k++) {
+		unsigned int first_knot = getFirstCoupledKnot(k);
+		for (unsigned int i = 0; i < constraint_dimension_; i++) {
+			unsigned int row = k * constraint_dimension_ + i;
+			if (variable_step) {
+				for (unsigned int l = 0; l < first_knot; l++) {
+					row_entries.push_back(row);
+					col_entries.push_back(l * state_dimension_);
+				}
+			}
+			for (unsigned int col = first_knot * state_dimension_;
+					col < (k + 1) * state_dimension_; col++) {
+				row_entries.push_back(row);
+				col_entries.push_back(col);
+			}
+		}
+	}
+
+	// The terminal constraint only depends on the last knot
+	if (dynamical_system_->isFullTrajectoryOptimization()) {
+		for (unsigned int i = 0; i < terminal_constraint_dimension_; i++) {
+			unsigned int row = horizon_ * constraint_dimension_ + i;
+			for (unsigned int col = (horizon_ - 1) * state_dimension_;
+					col < horizon_ * state_dimension_; col++) {
+				row_entries.push_back(row);
+				col_entries.push_back(col);
+			}
+		}
+	}
+
+	return true;
+}
+
+
+bool OptimalControl::getHessianStructure(std::vector<int>& row_entries,
+										 std::vector<int>& col_entries)
+{
+	// The declared pattern has priority
+	if (OptimizationModel::getHessianStructure(row_entries, col_entries))
+		return true;
+
+	row_entries.clear();
+	col_entries.clear();
+
+	// Each decision variable is coupled with the ones of the previous knots used by the
+	// transcription, and with the step time of the earlier knots
+	bool variable_step = !dynamical_system_->isFixedStepIntegration();
+	for (unsigned int k = 0; k < horizon_; k++) {
+		unsigned int first_knot = getFirstCoupledKnot(k);
+		for (unsigned int i = 0; i < state_dimension_; i++) {
+			unsigned int row = k * state_dimension_ + i;
+			if (variable_step) {
+				for (unsigned int l = 0; l < first_knot; l++) {
+					row_entries.push_back(row);
+					col_entries.push_back(l * state_dimension_);
+				}
+			}
+			for (unsigned int col = first_knot * state_dimension_; col <= row; col++) {
+				row_entries.push_back(row);
+				col_entries.push_back(col);
+			}
+		}
+	}
+
+	return true;
 }
 
 
@@ -67,6 +268,12 @@ void OptimalControl::setStartingTrajectory(WholeBodyTrajectory& initial_trajecto
 {
 	//TODO should convert to the defined horizon and time step integration
 	motion_solution_ = initial_trajectory;
+
+	// The starting trajectory replaces the last solution as warm point
+	starting_point_.resize(0);
+	starting_bound_lower_mult_.resize(0);
+	starting_bound_upper_mult_.resize(0);
+	starting_constraint_mult_.resize(0);
 }
 
 
@@ -75,6 +282,20 @@ void OptimalControl::getStartingPoint(double* decision, int decision_dim)
 	// Eigen interfacing to raw buffers
 	Eigen::Map<Eigen::VectorXd> full_initial_point(decision, decision_dim);
 
+	// Starting from the last solution if the warm start is enabled or the horizon was shifted.
+	// Otherwise the last solution is discarded, so a cold start doesn't reuse it
+	bool last_solution = warm_start_ || shifted_point_;
+	shifted_point_ = false;
+	if (last_solution && starting_point_.size() == decision_dim) {
+		full_initial_point = starting_point_;
+		return;
+	} else if (!last_solution) {
+		starting_point_.resize(0);
+		starting_bound_lower_mult_.resize(0);
+		starting_bound_upper_mult_.resize(0);
+		starting_constraint_mult_.resize(0);
+	}
+
 	if (motion_solution_.size() == 0) {
 		// Getting the initial and ending locomotion state
 		WholeBodyState starting_system_state = dynamical_system_->getInitialState();
@@ -141,6 +362,87 @@ void OptimalControl::getStartingPoint(double* decision, int decision_dim)
 }
 
 
+bool OptimalControl::getStartingMultipliers(double* bound_lower_mult, double* bound_upper_mult,
+											int decision_dim,
+											double* constraint_mult, int constraint_dim)
+{
+	if (starting_bound_lower_mult_.size() != decision_dim ||
+			starting_constraint_mult_.size() != constraint_dim)
+		return false;
+
+	// Eigen interfacing to raw buffers
+	Eigen::Map<Eigen::VectorXd>(bound_lower_mult, decision_dim) = starting_bound_lower_mult_;
+	Eigen::Map<Eigen::VectorXd>(bound_upper_mult, decision_dim) = starting_bound_upper_mult_;
+	Eigen::Map<Eigen::VectorXd>(constraint_mult, constraint_dim) = starting_constraint_mult_;
+
+	return true;
+}
+
+
+void OptimalControl::setSolution(const double* decision,
+								 const double* bound_lower_mult, const double* bound_upper_mult,
+								 int decision_dim,
+								 const double* constraint_mult, int constraint_dim)
+{
+	// Eigen interfacing to raw buffers
+	starting_point_ = Eigen::Map<const Eigen::VectorXd>(decision, decision_dim);
+	starting_bound_lower_mult_ = Eigen::Map<const Eigen::VectorXd>(bound_lower_mult, decision_dim);
+	starting_bound_upper_mult_ = Eigen::Map<const Eigen::VectorXd>(bound_upper_mult, decision_dim);
+	starting_constraint_mult_ = Eigen::Map<const Eigen::VectorXd>(constraint_mult, constraint_dim);
+}
+
+
+bool OptimalControl::shiftHorizon(unsigned int num_knots)
+{
+	if ((unsigned) starting_point_.size() != horizon_ * state_dimension_) {
+		printf(YELLOW "Warning: there is not a solution for shifting the horizon\n" COLOR_RESET);
+		return false;
+	}
+
+	// The next optimization starts from the shifted solution even without warm start
+	shifted_point_ = true;
+	if (num_knots == 0)
+		return true;
+	if (num_knots > horizon_)
+		num_knots = horizon_;
+
+	// Getting the last two knots before shifting them, which are used for extrapolating the tail
+	unsigned int num_joints = dynamical_system_->getFloatingBaseSystem().getJointDoF();
+	WholeBodyState last_state(num_joints), previous_state(num_joints);
+	unsigned int last_knot = horizon_ - 1;
+	dynamical_system_->toWholeBodyState(last_state,
+			starting_point_.segment(last_knot * state_dimension_, state_dimension_));
+	if (horizon_ > 1)
+		dynamical_system_->toWholeBodyState(previous_state,
+				starting_point_.segment((last_knot - 1) * state_dimension_, state_dimension_));
+	else
+		previous_state = last_state;
+
+	// Shifting the primal solution and the multipliers. Note that the terminal constraint
+	// multipliers are kept since they are not related to a knot
+	shiftKnots(starting_point_, state_dimension_, num_knots);
+	if (starting_bound_lower_mult_.size() == starting_point_.size()) {
+		shiftKnots(starting_bound_lower_mult_, state_dimension_, num_knots);
+		shiftKnots(starting_bound_upper_mult_, state_dimension_, num_knots);
+	}
+	if ((unsigned) starting_constraint_mult_.size() >= horizon_ * constraint_dimension_)
+		shiftKnots(starting_constraint_mult_, constraint_dimension_, num_knots);
+
+	// Extrapolating the positions of the tail with the displacement of the last two knots
+	WholeBodyState tail_state = last_state;
+	Eigen::VectorXd tail_point;
+	for (unsigned int k = horizon_ - num_knots; k < horizon_; k++) {
+		tail_state.base_pos += last_state.base_pos - previous_state.base_pos;
+		tail_state.joint_pos += last_state.joint_pos - previous_state.joint_pos;
+
+		dynamical_system_->fromWholeBodyState(tail_point, tail_state);
+		starting_point_.segment(k * state_dimension_, state_dimension_) = tail_point;
+	}
+
+	return true;
+}
+
+
 void OptimalControl::evaluateBounds(double* decision_lbound, int decision_dim1,
 									double* decision_ubound, int decision_dim2,
 									double* constraint_lbound, int constraint_dim1,
@@ -255,26 +557,33 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 		exit(EXIT_FAILURE);
 	}
 
+	// Evaluating the knots in parallel
+	if (knot_parallel_) {
+		evaluateKnotConstraints(full_constraint, decision_var);
+		return;
+	}
+
 	// Getting the initial conditions of the locomotion state
-	WholeBodyState locomotion_initial_cond = dynamical_system_->getInitialState();
+	KnotWorkspace& workspace = workspaces_[0];
+	workspace.initial_state = dynamical_system_->getInitialState();
 
 	// Setting the initial state
 	unsigned int num_constraints = constraints_.size();
 	for (unsigned int j = 0; j < num_constraints + 1; j++) {
 		if (j == 0) // dynamic system constraint
-			dynamical_system_->setLastState(locomotion_initial_cond);
+			dynamical_system_->setLastState(workspace.initial_state);
 		else
-			constraints_[j-1]->setLastState(locomotion_initial_cond);
+			constraints_[j-1]->setLastState(workspace.initial_state);
 	}
 
 	// Computing the active and inactive constraints for a predefined horizon
-	WholeBodyState system_state(dynamical_system_->getFloatingBaseSystem().getJointDoF());
-	Eigen::VectorXd decision_state = Eigen::VectorXd::Zero(state_dimension_);
+	WholeBodyState& system_state = workspace.system_state;
+	system_state.time = 0.;
 	unsigned int index = 0;
 	for (unsigned int k = 0; k < horizon_; k++) {
 		// Converting the decision variable for a certain time to a robot state
-		decision_state = decision_var.segment(k * state_dimension_, state_dimension_);
-		dynamical_system_->toWholeBodyState(system_state, decision_state);
+		workspace.decision_state = decision_var.segment(k * state_dimension_, state_dimension_);
+		dynamical_system_->toWholeBodyState(system_state, workspace.decision_state);
 
 		// Adding the time information in cases that time is not a decision variable
 		if (dynamical_system_->isFixedStepIntegration())
@@ -284,7 +593,7 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 		// Computing the constraints for a certain time
 		if (constraint_dimension_ != 0) {
 			for (unsigned int j = 0; j < num_constraints + 1; j++) {
-				Eigen::VectorXd constraint;
+				Eigen::VectorXd& constraint = workspace.constraints[j];
 				unsigned int current_constraint_dim = 0;
 				if (j == 0) {// dynamic system constraint
 					// Evaluating the dynamical constraint
@@ -293,7 +602,7 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 						dynamical_system_->setLastState(system_state);
 
 						// Checking the constraint dimension
-						current_constraint_dim = dynamical_system_->getConstraintDimension();
+						current_constraint_dim = constraint_dims_[j];
 						if (current_constraint_dim != (unsigned) constraint.size()) {
 							printf(RED "FATAL: the constraint dimension of %s constraint is not consistent\n"
 									COLOR_RESET, dynamical_system_->getName().c_str());
@@ -307,7 +616,7 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 						constraints_[j-1]->setLastState(system_state);
 
 						// Checking the constraint dimension
-						current_constraint_dim = constraints_[j-1]->getConstraintDimension();
+						current_constraint_dim = constraint_dims_[j];
 						if (current_constraint_dim != (unsigned) constraint.size()) {
 							printf(RED "FATAL: the constraint dimension of %s constraint is not consistent\n"
 									COLOR_RESET, constraints_[j-1]->getName().c_str());
@@ -317,7 +626,8 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 				}
 
 				// Setting in the full constraint vector
-				full_constraint.segment(index, current_constraint_dim) = constraint;
+				if (current_constraint_dim != 0)
+					full_constraint.segment(index, current_constraint_dim) = constraint;
 
 				index += current_constraint_dim;
 			}
@@ -326,7 +636,7 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 		// Computing the terminal constraint in case of full trajectory optimization
 		if (dynamical_system_->isFullTrajectoryOptimization()) {
 			if (k == horizon_ - 1) {
-				Eigen::VectorXd constraint;
+				Eigen::VectorXd& constraint = workspace.terminal_constraint;
 				dynamical_system_->computeTerminalConstraint(constraint, system_state);
 
 				// Setting in the full constraint vector
@@ -358,27 +668,35 @@ void OptimalControl::evaluateCosts(double& cost,
 		exit(EXIT_FAILURE);
 	}
 
+	// Evaluating the knots in parallel
+	if (knot_parallel_) {
+		cost = evaluateKnotCosts(decision_var);
+		return;
+	}
+
 	// Initializing the cost value
 	cost = 0;
 
 	// Getting the initial conditions of the locomotion state
-	WholeBodyState locomotion_initial_cond = dynamical_system_->getInitialState();
+	KnotWorkspace& workspace = workspaces_[0];
+	workspace.initial_state = dynamical_system_->getInitialState();
 
 	// Setting the initial state
 	unsigned int num_constraints = constraints_.size();
 	for (unsigned int j = 0; j < num_constraints + 1; j++) {
 		if (j == 0) // dynamic system constraint
-			dynamical_system_->setLastState(locomotion_initial_cond);
+			dynamical_system_->setLastState(workspace.initial_state);
 		else
-			constraints_[j-1]->setLastState(locomotion_initial_cond);
+			constraints_[j-1]->setLastState(workspace.initial_state);
 	}
 
 	// Computing the cost for predefined horizon
-	WholeBodyState system_state(dynamical_system_->getFloatingBaseSystem().getJointDoF());
+	WholeBodyState& system_state = workspace.system_state;
+	system_state.time = 0.;
 	for (unsigned int k = 0; k < horizon_; k++) {
 		// Converting the decision variable for a certain time to a robot state
-		Eigen::VectorXd decision_state = decision_var.segment(k * state_dimension_, state_dimension_);
-		dynamical_system_->toWholeBodyState(system_state, decision_state);
+		workspace.decision_state = decision_var.segment(k * state_dimension_, state_dimension_);
+		dynamical_system_->toWholeBodyState(system_state, workspace.decision_state);
 
 		// Adding the time information in cases that time is not a decision variable
 		if (dynamical_system_->isFixedStepIntegration())
@@ -419,6 +737,67 @@ void OptimalControl::evaluateCosts(double& cost,
 }
 
 
+void OptimalControl::evaluateLagrangianHessian(double* hessian_values, int nonzero_dim1,
+											   int* row_entries, int nonzero_dim2,
+											   int* col_entries, int nonzero_dim3,
+											   double obj_factor,
+											   const double* lagrange, int constraint_dim,
+											   const double* decision, int decision_dim,
+											   bool flag)
+{
+	// Probing call from the solver, which only checks if the Hessian is implemented
+	if ((flag && row_entries == NULL) || (!flag && hessian_values == NULL))
+		return;
+
+	if (nonzero_dim1 != (int) nonzero_hessian_) {
+		printf(RED "FATAL: the number of nonzero values of the Hessian is not consistent\n"
+				COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	// Defining the structure of the Hessian, i.e. its diagonal
+	if (flag) {
+		for (unsigned int i = 0; i < nonzero_hessian_; i++) {
+			row_entries[i] = i;
+			col_entries[i] = i;
+		}
+		return;
+	}
+
+	// Eigen interfacing to raw buffers
+	const Eigen::Map<const Eigen::VectorXd> decision_var(decision, decision_dim);
+	Eigen::Map<Eigen::VectorXd> full_hessian(hessian_values, nonzero_dim1);
+
+	// Computing the Hessian of each knot. The analytic second derivatives of the costs are
+	// diagonal with respect to the whole-body state, and the Hessian is only available with a
+	// fixed step and hard constraints (see initHessian)
+	KnotWorkspace& workspace = workspaces_[0];
+	computeKnotTimes(decision_var);
+	WholeBodyState& system_state = workspace.system_state;
+	WholeBodyState& hessian_state = workspace.hessian_state;
+	WholeBodyState& duration_hessian_state = workspace.duration_hessian_state;
+	unsigned int num_costs = costs_.size();
+	for (unsigned int k = 0; k < horizon_; k++) {
+		getKnotState(system_state, workspace, dynamical_system_, decision_var, k);
+
+		// Computing the Hessian of the cost functions
+		hessian_state = zero_hessian_state_;
+		duration_hessian_state = zero_hessian_state_;
+		for (unsigned int j = 0; j < num_costs; j++)
+			costs_[j]->computeHessian(hessian_state, duration_hessian_state, system_state);
+		dynamical_system_->fromWholeBodyState(workspace.hessian, hessian_state);
+		full_hessian.segment(k * state_dimension_, state_dimension_) =
+				obj_factor * workspace.hessian;
+	}
+}
+
+
+bool OptimalControl::isLagrangianHessianImplemented()
+{
+	return hessian_approximation_ != LimitedMemoryHessian;
+}
+
+
 WholeBodyTrajectory& OptimalControl::evaluateSolution(const Eigen::Ref<const Eigen::VectorXd>& solution)
 {
 	// Getting the state dimension
@@ -644,6 +1023,21 @@ void OptimalControl::setHorizon(unsigned int horizon)
 }
 
 
+void OptimalControl::setNumberOfThreads(unsigned int num_threads)
+{
+	if (num_threads == 0)
+		num_threads_ = 1;
+	else
+		num_threads_ = num_threads;
+}
+
+
+void OptimalControl::setHessianApproximation(enum HessianApproximation approximation)
+{
+	hessian_approximation_ = approximation;
+}
+
+
 DynamicalSystem* OptimalControl::getDynamicalSystem()
 {
 	return dynamical_system_;
@@ -667,5 +1061,460 @@ const unsigned int& OptimalControl::getHorizon()
 	return horizon_;
 }
 
+
+void OptimalControl::initHessian()
+{
+	// Defining the zero Hessian state with the dimensions of the whole-body state
+	const model::FloatingBaseSystem& system = dynamical_system_->getFloatingBaseSystem();
+	zero_hessian_state_ = WholeBodyState(system.getJointDoF());
+	urdf_model::LinkID contacts = system.getEndEffectors();
+	for (urdf_model::LinkID::const_iterator contact_it = contacts.begin();
+			contact_it != contacts.end(); contact_it++) {
+		std::string name = contact_it->first;
+		zero_hessian_state_.contact_pos[name] = Eigen::VectorXd::Zero(3);
+		zero_hessian_state_.contact_vel[name] = Eigen::VectorXd::Zero(3);
+		zero_hessian_state_.contact_acc[name] = Eigen::VectorXd::Zero(3);
+		zero_hessian_state_.contact_eff[name] = rbd::Vector6d::Zero();
+	}
+
+	// Checking that the Lagrangian Hessian is the Hessian of the costs. The soft constraints add
+	// their penalties to the cost, and the variable step makes the dynamics defect bilinear, so
+	// their curvature has to be approximated by the solver
+	if (!dynamical_system_->isFixedStepIntegration()) {
+		printf(RED "FATAL: the Gauss-Newton Hessian is not available with a variable step "
+				"integration, so the Hessian has to be approximated as limited-memory\n"
+				COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+	bool soft_constraint = dynamical_system_->isSoftConstraint();
+	for (unsigned int j = 0; j < constraints_.size(); j++)
+		soft_constraint |= constraints_[j]->isSoftConstraint();
+	if (soft_constraint) {
+		printf(RED "FATAL: the Gauss-Newton Hessian is not available with soft constraints, "
+				"so the Hessian has to be approximated as limited-memory\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	// Checking that the costs have second derivatives, otherwise the Hessian has to be
+	// approximated by the solver
+	WholeBodyState hessian_state = zero_hessian_state_;
+	WholeBodyState duration_hessian_state = zero_hessian_state_;
+	WholeBodyState initial_state = dynamical_system_->getInitialState();
+	for (unsigned int j = 0; j < costs_.size(); j++) {
+		if (!costs_[j]->computeHessian(hessian_state, duration_hessian_state, initial_state)) {
+			printf(RED "FATAL: the %s cost does not have second derivatives, so the Hessian "
+					"has to be approximated as limited-memory\n" COLOR_RESET,
+					costs_[j]->getName().c_str());
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+
+void OptimalControl::initKnotParallelism()
+{
+	// Deleting the previous copies since the problem could have changed
+	clearKnotParallelism();
+	if (num_threads_ <= 1)
+		return;
+
+	// Creating the per-thread copies of the dynamical system, constraints and costs
+	bool clonable = true;
+	unsigned int num_constraints = constraints_.size();
+	unsigned int num_costs = costs_.size();
+	thread_constraints_.resize(num_threads_);
+	thread_costs_.resize(num_threads_);
+	for (unsigned int t = 0; t < num_threads_; t++) {
+		DynamicalSystem* system = dynamical_system_->clone();
+		clonable &= (system != NULL);
+		thread_dynamical_systems_.push_back(system);
+
+		for (unsigned int j = 0; j < num_constraints; j++) {
+			Constraint<WholeBodyState>* constraint = constraints_[j]->clone();
+			clonable &= (constraint != NULL);
+			thread_constraints_[t].push_back(constraint);
+		}
+
+		for (unsigned int j = 0; j < num_costs; j++) {
+			Cost* cost = costs_[j]->clone();
+			clonable &= (cost != NULL);
+			thread_costs_[t].push_back(cost);
+		}
+	}
+
+	if (!clonable) {
+		printf(YELLOW "Warning: the dynamical system, constraints or costs are not clonable, so "
+				"the knots will be evaluated serially\n" COLOR_RESET);
+		clearKnotParallelism();
+		return;
+	}
+
+	// Creating the thread pool
+	if (thread_pool_ == NULL || thread_pool_->getNumberOfThreads() != num_threads_) {
+		delete thread_pool_;
+		thread_pool_ = new utils::ThreadPool(num_threads_);
+	}
+
+	// Recording the state versions of the copies
+	synced_system_version_ = dynamical_system_->getStateVersion();
+	synced_cost_versions_.resize(num_costs);
+	for (unsigned int j = 0; j < num_costs; j++)
+		synced_cost_versions_[j] = costs_[j]->getDesiredStateVersion();
+
+	knot_costs_.resize(horizon_);
+	knot_parallel_ = true;
+}
+
+
+void OptimalControl::clearKnotParallelism()
+{
+	for (unsigned int t = 0; t < thread_dynamical_systems_.size(); t++)
+		delete thread_dynamical_systems_[t];
+	for (unsigned int t = 0; t < thread_constraints_.size(); t++) {
+		for (unsigned int j = 0; j < thread_constraints_[t].size(); j++)
+			delete thread_constraints_[t][j];
+	}
+	for (unsigned int t = 0; t < thread_costs_.size(); t++) {
+		for (unsigned int j = 0; j < thread_costs_[t].size(); j++)
+			delete thread_costs_[t][j];
+	}
+
+	thread_dynamical_systems_.clear();
+	thread_constraints_.clear();
+	thread_costs_.clear();
+	synced_cost_versions_.clear();
+	knot_parallel_ = false;
+}
+
+
+void OptimalControl::syncKnotParallelism()
+{
+	// The initial, terminal and desired states are usually set after the init() call, e.g. before
+	// each receding-horizon optimization
+	if (dynamical_system_->getStateVersion() != synced_system_version_) {
+		for (unsigned int t = 0; t < thread_dynamical_systems_.size(); t++) {
+			thread_dynamical_systems_[t]->setInitialState(dynamical_system_->getInitialState());
+			thread_dynamical_systems_[t]->setTerminalState(dynamical_system_->getTerminalState());
+		}
+		synced_system_version_ = dynamical_system_->getStateVersion();
+	}
+
+	for (unsigned int j = 0; j < synced_cost_versions_.size(); j++) {
+		if (costs_[j]->getDesiredStateVersion() != synced_cost_versions_[j]) {
+			for (unsigned int t = 0; t < thread_costs_.size(); t++)
+				thread_costs_[t][j]->setDesiredState(costs_[j]->getDesiredState());
+			synced_cost_versions_[j] = costs_[j]->getDesiredStateVersion();
+		}
+	}
+}
+
+
+void OptimalControl::initWorkspaces()
+{
+	// Each thread needs its own buffers
+	unsigned int num_workspaces = 1;
+	if (knot_parallel_)
+		num_workspaces = num_threads_;
+
+	// Getting the constraint dimensions, since computing them requires evaluating the bounds
+	unsigned int num_constraints = constraints_.size();
+	constraint_dims_.resize(num_constraints + 1);
+	for (unsigned int j = 0; j < num_constraints + 1; j++) {
+		if (j == 0)
+			constraint_dims_[j] = dynamical_system_->getConstraintDimension();
+		else
+			constraint_dims_[j] = constraints_[j-1]->getConstraintDimension();
+	}
+
+	// Getting the initial state, which defines the dimension of the whole-body states
+	const WholeBodyState& initial_state = dynamical_system_->getInitialState();
+	workspaces_.clear();
+	workspaces_.resize(num_workspaces);
+	for (unsigned int t = 0; t < num_workspaces; t++) {
+		KnotWorkspace& workspace = workspaces_[t];
+		workspace.system_state = initial_state;
+		workspace.decision_state.resize(state_dimension_);
+		workspace.last_states.assign(2, initial_state);
+		workspace.num_last_states = 0;
+		workspace.initial_state = initial_state;
+
+		workspace.constraints.resize(num_constraints + 1);
+		for (unsigned int j = 0; j < num_constraints + 1; j++)
+			workspace.constraints[j].resize(constraint_dims_[j]);
+		if (dynamical_system_->isFullTrajectoryOptimization())
+			workspace.terminal_constraint.resize(terminal_constraint_dimension_);
+
+		workspace.hessian_state = zero_hessian_state_;
+		workspace.duration_hessian_state = zero_hessian_state_;
+		workspace.hessian.resize(state_dimension_);
+	}
+
+	// Filling the state buffers, otherwise the first evaluations allocate their states
+	dynamical_system_->initStateBuffer(initial_state);
+	for (unsigned int j = 0; j < num_constraints; j++)
+		constraints_[j]->initStateBuffer(initial_state);
+	for (unsigned int t = 0; t < thread_dynamical_systems_.size(); t++) {
+		thread_dynamical_systems_[t]->initStateBuffer(initial_state);
+		for (unsigned int j = 0; j < num_constraints; j++)
+			thread_constraints_[t][j]->initStateBuffer(initial_state);
+	}
+
+	// Converting a knot state once, which sizes the conversion buffers of the dynamical systems
+	for (unsigned int t = 0; t < num_workspaces; t++) {
+		KnotWorkspace& workspace = workspaces_[t];
+		DynamicalSystem* system = dynamical_system_;
+		if (knot_parallel_)
+			system = thread_dynamical_systems_[t];
+
+		workspace.decision_state.setZero();
+		system->toWholeBodyState(workspace.system_state, workspace.decision_state);
+	}
+}
+
+
+unsigned int OptimalControl::getFirstCoupledKnot(unsigned int knot)
+{
+	unsigned int num_previous = dynamical_system_->getNumberOfPreviousKnots();
+	if (knot > num_previous)
+		return knot - num_previous;
+	else
+		return 0;
+}
+
+
+void OptimalControl::shiftKnots(Eigen::VectorXd& vector,
+								unsigned int knot_dim,
+								unsigned int num_knots)
+{
+	if (knot_dim == 0)
+		return;
+
+	Eigen::VectorXd last_knot = vector.segment((horizon_ - 1) * knot_dim, knot_dim);
+	for (unsigned int k = 0; k < horizon_; k++) {
+		if (k + num_knots < horizon_)
+			vector.segment(k * knot_dim, knot_dim) = vector.segment((k + num_knots) * knot_dim,
+																	knot_dim);
+		else
+			vector.segment(k * knot_dim, knot_dim) = last_knot;
+	}
+}
+
+
+void OptimalControl::computeKnotTimes(const Eigen::Ref<const Eigen::VectorXd>& decision_var)
+{
+	// Accumulating the step time as the serial evaluation does
+	double time = 0.;
+	for (unsigned int k = 0; k < horizon_; k++) {
+		if (dynamical_system_->isFixedStepIntegration())
+			time += dynamical_system_->getFixedStepTime();
+		else
+			time += decision_var(k * state_dimension_);
+		knot_times_(k) = time;
+	}
+}
+
+
+void OptimalControl::setKnotTimes(const Eigen::VectorXd& knot_times,
+								  unsigned int knot)
+{
+	// Only the times of the knot and its previous knots are used by the evaluation
+	unsigned int first_knot = getFirstCoupledKnot(knot);
+	unsigned int num_knots = knot - first_knot + 1;
+	knot_times_.segment(first_knot, num_knots) = knot_times.segment(first_knot, num_knots);
+}
+
+
+void OptimalControl::getKnotState(WholeBodyState& system_state,
+								  KnotWorkspace& workspace,
+								  DynamicalSystem* dynamical_system,
+								  const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+								  unsigned int knot)
+{
+	// Converting the decision variable for a certain knot to a robot state
+	workspace.decision_state = decision_var.segment(knot * state_dimension_, state_dimension_);
+	dynamical_system->toWholeBodyState(system_state, workspace.decision_state);
+
+	// Adding the time information in cases that time is not a decision variable
+	if (dynamical_system->isFixedStepIntegration())
+		system_state.duration = dynamical_system->getFixedStepTime();
+	system_state.time = knot_times_(knot);
+}
+
+
+void OptimalControl::getKnotLastStates(KnotWorkspace& workspace,
+									   DynamicalSystem* dynamical_system,
+									   const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+									   unsigned int knot)
+{
+	// Getting the previous knots used by the transcription, from the oldest one. The knot before
+	// the first one is the initial state
+	unsigned int num_previous = dynamical_system->getNumberOfPreviousKnots();
+	workspace.num_last_states = 0;
+	for (int i = (int) knot - (int) num_previous; i < (int) knot; i++) {
+		if (i < -1)
+			continue;
+
+		WholeBodyState& last_state = workspace.last_states[workspace.num_last_states];
+		if (i == -1)
+			last_state = dynamical_system->getInitialState();
+		else
+			getKnotState(last_state, workspace, dynamical_system, decision_var, i);
+		++workspace.num_last_states;
+	}
+}
+
+
+void OptimalControl::setKnotLastStates(Constraint<WholeBodyState>* constraint,
+									   KnotWorkspace& workspace)
+{
+	constraint->resetStateBuffer();
+	for (unsigned int i = 0; i < workspace.num_last_states; i++)
+		constraint->setLastState(workspace.last_states[i]);
+}
+
+
+void OptimalControl::evaluateKnotConstraints(Eigen::Ref<Eigen::VectorXd> full_constraint,
+											 const Eigen::Ref<const Eigen::VectorXd>& decision_var)
+{
+	syncKnotParallelism();
+	computeKnotTimes(decision_var);
+
+	// Computing the active and inactive constraints of each knot. Note that each knot writes in
+	// its own segment of the constraint vector, and reads its predecessor from the decision vector.
+	// The task is passed by reference, so its std::function doesn't allocate its captures
+	if (constraint_dimension_ != 0) {
+		auto knot_task = [&](unsigned int k, unsigned int thread_id) {
+			computeKnotConstraints(full_constraint.segment(k * constraint_dimension_,
+														   constraint_dimension_),
+								   workspaces_[thread_id],
+								   thread_dynamical_systems_[thread_id],
+								   thread_constraints_[thread_id],
+								   decision_var, k);
+		};
+		thread_pool_->parallelFor(horizon_, std::ref(knot_task));
+	}
+
+	// Computing the terminal constraint in case of full trajectory optimization
+	if (dynamical_system_->isFullTrajectoryOptimization()) {
+		KnotWorkspace& workspace = workspaces_[0];
+		WholeBodyState& system_state = workspace.system_state;
+		getKnotState(system_state, workspace, dynamical_system_, decision_var, horizon_ - 1);
+
+		Eigen::VectorXd& constraint = workspace.terminal_constraint;
+		dynamical_system_->computeTerminalConstraint(constraint, system_state);
+		full_constraint.segment(horizon_ * constraint_dimension_,
+								terminal_constraint_dimension_) = constraint;
+	}
+}
+
+
+double OptimalControl::evaluateKnotCosts(const Eigen::Ref<const Eigen::VectorXd>& decision_var)
+{
+	syncKnotParallelism();
+	computeKnotTimes(decision_var);
+
+	// Computing the cost of each knot
+	auto knot_task = [&](unsigned int k, unsigned int thread_id) {
+		knot_costs_(k) = computeKnotCost(workspaces_[thread_id],
+										 thread_dynamical_systems_[thread_id],
+										 thread_constraints_[thread_id],
+										 thread_costs_[thread_id],
+										 decision_var, k);
+	};
+	thread_pool_->parallelFor(horizon_, std::ref(knot_task));
+
+	return knot_costs_.sum();
+}
+
+
+void OptimalControl::computeKnotConstraints(Eigen::Ref<Eigen::VectorXd> knot_constraint,
+											KnotWorkspace& workspace,
+											DynamicalSystem* dynamical_system,
+											std::vector<Constraint<WholeBodyState>*>& constraints,
+											const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+											unsigned int knot)
+{
+	// Getting the current and last states of the knot
+	WholeBodyState& system_state = workspace.system_state;
+	getKnotLastStates(workspace, dynamical_system, decision_var, knot);
+	getKnotState(system_state, workspace, dynamical_system, decision_var, knot);
+
+	unsigned int index = 0;
+	unsigned int num_constraints = constraints.size();
+	for (unsigned int j = 0; j < num_constraints + 1; j++) {
+		Eigen::VectorXd& constraint = workspace.constraints[j];
+		unsigned int current_constraint_dim = 0;
+		if (j == 0) {// dynamic system constraint
+			if (!dynamical_system->isSoftConstraint()) {
+				setKnotLastStates(dynamical_system, workspace);
+				dynamical_system->compute(constraint, system_state);
+
+				// Checking the constraint dimension
+				current_constraint_dim = constraint_dims_[j];
+				if (current_constraint_dim != (unsigned) constraint.size()) {
+					printf(RED "FATAL: the constraint dimension of %s constraint is not consistent\n"
+							COLOR_RESET, dynamical_system->getName().c_str());
+					exit(EXIT_FAILURE);
+				}
+			}
+		} else if (!constraints[j-1]->isSoftConstraint()) {
+			setKnotLastStates(constraints[j-1], workspace);
+			constraints[j-1]->compute(constraint, system_state);
+
+			// Checking the constraint dimension
+			current_constraint_dim = constraint_dims_[j];
+			if (current_constraint_dim != (unsigned) constraint.size()) {
+				printf(RED "FATAL: the constraint dimension of %s constraint is not consistent\n"
+						COLOR_RESET, constraints[j-1]->getName().c_str());
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		// Setting in the knot constraint vector
+		if (current_constraint_dim != 0)
+			knot_constraint.segment(index, current_constraint_dim) = constraint;
+		index += current_constraint_dim;
+	}
+}
+
+
+double OptimalControl::computeKnotCost(KnotWorkspace& workspace,
+									   DynamicalSystem* dynamical_system,
+									   std::vector<Constraint<WholeBodyState>*>& constraints,
+									   std::vector<Cost*>& costs,
+									   const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+									   unsigned int knot)
+{
+	// Getting the current and last states of the knot
+	WholeBodyState& system_state = workspace.system_state;
+	getKnotLastStates(workspace, dynamical_system, decision_var, knot);
+	getKnotState(system_state, workspace, dynamical_system, decision_var, knot);
+
+	// Computing the cost functions for a certain knot
+	double knot_cost = 0., simple_cost;
+	unsigned int num_costs = costs.size();
+	for (unsigned int j = 0; j < num_costs; j++) {
+		costs[j]->compute(simple_cost, system_state);
+		knot_cost += simple_cost;
+	}
+
+	// Computing the soft-constraints for a certain knot
+	if (dynamical_system->isSoftConstraint()) {
+		setKnotLastStates(dynamical_system, workspace);
+		dynamical_system->computeSoft(simple_cost, system_state);
+		knot_cost += simple_cost;
+	}
+	unsigned int num_constraints = constraints.size();
+	for (unsigned int j = 0; j < num_constraints; j++) {
+		if (constraints[j]->isSoftConstraint()) {
+			setKnotLastStates(constraints[j], workspace);
+			constraints[j]->computeSoft(simple_cost, system_state);
+			knot_cost += simple_cost;
+		}
+	}
+
+	return knot_cost;
+}
+
 } //@namespace ocp
 } //@namespace dwl
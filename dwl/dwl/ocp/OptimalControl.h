@@ -5,6 +5,7 @@
 #include <dwl/ocp/DynamicalSystem.h>
 #include <dwl/ocp/Constraint.h>
 #include <dwl/ocp/Cost.h>
+#include <dwl/utils/ThreadPool.h>
 
 
 
@@ -14,6 +15,14 @@ namespace dwl
 namespace ocp
 {
 
+/**
+ * @brief Approximations of the Lagrangian Hessian. The Gauss-Newton Hessian is diagonal and it
+ * uses the analytic second derivatives of the costs, i.e. the constraint curvature is neglected.
+ * Thus, it requires a fixed step integration and hard constraints. The limited-memory one is
+ * computed by the solver (L-BFGS)
+ */
+enum HessianApproximation {GaussNewtonHessian, LimitedMemoryHessian};
+
 /**
  * @class OptimalControl
  * @brief An optimal control problem requires information of constraints (dynamical, active or
@@ -34,6 +43,14 @@ class OptimalControl : public model::OptimizationModel
 		 * vectors */
 		void init(bool only_soft_constraints);
 
+		/**
+		 * @brief Creates a copy of the optimal control problem with copies of its dynamical
+		 * system, constraints and costs. The copy evaluates the knots serially
+		 * @return OptimalControl* Copy of the problem, or NULL if any of its dynamical system,
+		 * constraints or costs isn't clonable
+		 */
+		OptimalControl* clone() const;
+
 		/**
 		 * @brief Sets the initial trajectory
 		 * @param WholeBodyTrajectory& Initial whole-body trajectory
@@ -41,12 +58,53 @@ class OptimalControl : public model::OptimizationModel
 		void setStartingTrajectory(WholeBodyTrajectory& initial_trajectory);
 
 		/**
-		 * @brief Gets the starting point of the problem
+		 * @brief Gets the starting point of the problem. It's the last solution after shifting
+		 * the horizon or with warm start, otherwise the last solution is discarded
 		 * @param double* Initial values for the decision variables, $x$
 		 * @param int Number of the decision variables
 		 */
 		void getStartingPoint(double* decision, int decision_dim);
 
+		/**
+		 * @brief Gets the starting multipliers of the problem, i.e. the (shifted) multipliers of
+		 * the last solution
+		 * @param double* Initial values for the lower bound multipliers, $z^L$
+		 * @param double* Initial values for the upper bound multipliers, $z^U$
+		 * @param int Number of the decision variables
+		 * @param double* Initial values for the constraint multipliers, $\lambda$
+		 * @param int Number of the constraints
+		 * @return True if the starting multipliers are defined
+		 */
+		bool getStartingMultipliers(double* bound_lower_mult, double* bound_upper_mult,
+									int decision_dim,
+									double* constraint_mult, int constraint_dim);
+
+		/**
+		 * @brief Sets the primal and dual solution computed by the solver. The next optimization
+		 * starts from this solution
+		 * @param const double* Primal solution, $x_*$
+		 * @param const double* Lower bound multipliers, $z^L_*$
+		 * @param const double* Upper bound multipliers, $z^U_*$
+		 * @param int Number of the decision variables
+		 * @param const double* Constraint multipliers, $\lambda_*$
+		 * @param int Number of the constraints
+		 */
+		void setSolution(const double* decision,
+						 const double* bound_lower_mult, const double* bound_upper_mult,
+						 int decision_dim,
+						 const double* constraint_mult, int constraint_dim);
+
+		/**
+		 * @brief Shifts the last solution by a number of knots for a receding-horizon
+		 * optimization. The primal solution and multipliers of each knot are moved towards the
+		 * beginning of the horizon. The tail positions are linearly extrapolated from the last two
+		 * knots, and the rest of the tail variables and multipliers are held from the last knot.
+		 * The next optimization starts from the shifted solution even without warm start
+		 * @param unsigned int Number of shifted knots
+		 * @return True if there was a solution to shift
+		 */
+		bool shiftHorizon(unsigned int num_knots = 1);
+
 		/**
 		 * @brief Evaluates the bounds of the optimal control problem
 		 * @param double* Lower bounds $x^L$ for $x$
@@ -84,6 +142,102 @@ class OptimalControl : public model::OptimizationModel
 		void evaluateConstraints(double* constraint, int constraint_dim,
 								 const double* decision, int decision_dim);
 
+		/**
+		 * @brief Evaluates the structure (if "flag" is true) or the values of the Lagrangian
+		 * Hessian. The Hessian is diagonal
+		 * @param double* Values of the entries in the Hessian
+		 * @param int Number of nonzero elements in the Hessian
+		 * @param int* Row indices of entries in the Hessian
+		 * @param int Number of nonzero elements in the Hessian
+		 * @param int* Column indices of entries in the Hessian
+		 * @param int Number of nonzero elements in the Hessian
+		 * @param double Factor in front of the objective term in the Hessian, $\sigma_f$
+		 * @param const double* Values for the constraint multipliers, $\lambda$
+		 * @param int Number of constraint variables (dimension of $g(x)$)
+		 * @param const double* Values for the decision variables, $x$
+		 * @param int Number of decision variables (dimension of $x$)
+		 * @param bool True if only the structure is requested
+		 */
+		void evaluateLagrangianHessian(double* hessian_values, int nonzero_dim1,
+									   int* row_entries, int nonzero_dim2,
+									   int* col_entries, int nonzero_dim3,
+									   double obj_factor,
+									   const double* lagrange, int constraint_dim,
+									   const double* decision, int decision_dim,
+									   bool flag);
+
+		/** @brief Returns true if the Lagrangian Hessian is not approximated by the solver */
+		bool isLagrangianHessianImplemented();
+
+		/**
+		 * @brief Evaluates the accumulated time of each knot, which is needed by the evaluations
+		 * of a certain knot. In the variable step-time integration, the step time is the first
+		 * decision variable of each knot
+		 * @param Eigen::VectorXd& Accumulated time of each knot
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector of the horizon
+		 */
+		void evaluateKnotTimes(Eigen::VectorXd& knot_times,
+							   const Eigen::Ref<const Eigen::VectorXd>& decision_var);
+
+		/**
+		 * @brief Evaluates the hard constraints of a certain knot, which depend on the knot and
+		 * the previous knots used by the transcription. This allows solvers to exploit the
+		 * stage-wise structure of the problem. The knot times are given, so the evaluation doesn't
+		 * depend on the horizon length
+		 * @param Eigen::VectorXd& Constraint vector of the knot
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector of the horizon
+		 * @param const Eigen::VectorXd& Accumulated time of each knot
+		 * @param unsigned int Knot index
+		 */
+		void evaluateConstraintsAtKnot(Eigen::VectorXd& constraint,
+									   const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+									   const Eigen::VectorXd& knot_times,
+									   unsigned int knot);
+
+		/**
+		 * @brief Evaluates the cost and soft-constraints of a certain knot
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector of the horizon
+		 * @param const Eigen::VectorXd& Accumulated time of each knot
+		 * @param unsigned int Knot index
+		 * @return double Cost value of the knot
+		 */
+		double evaluateCostAtKnot(const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+								  const Eigen::VectorXd& knot_times,
+								  unsigned int knot);
+
+		/**
+		 * @brief Evaluates the terminal constraint, which only depends on the last knot
+		 * @param Eigen::VectorXd& Terminal constraint vector (empty if it isn't a full-trajectory
+		 * optimization)
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector of the horizon
+		 * @param const Eigen::VectorXd& Accumulated time of each knot
+		 */
+		void evaluateTerminalConstraint(Eigen::VectorXd& constraint,
+										const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+										const Eigen::VectorXd& knot_times);
+
+		/**
+		 * @brief Gets the sparsity pattern of the constraint Jacobian. Unless a pattern is declared
+		 * or detected, it is defined by the knot structure, i.e. the constraints of a knot depend
+		 * on the decision variables of the knot and of the previous knots used by the transcription
+		 * @param std::vector<int>& Row indices of the nonzero values
+		 * @param std::vector<int>& Column indices of the nonzero values
+		 * @return True since the pattern is always defined
+		 */
+		bool getJacobianStructure(std::vector<int>& row_entries,
+								  std::vector<int>& col_entries);
+
+		/**
+		 * @brief Gets the sparsity pattern of the lower triangle of the Lagrangian Hessian. Unless
+		 * a pattern is declared, it couples the decision variables of a knot with the ones of the
+		 * previous knots used by the transcription
+		 * @param std::vector<int>& Row indices of the nonzero values
+		 * @param std::vector<int>& Column indices of the nonzero values
+		 * @return True since the pattern is always defined
+		 */
+		bool getHessianStructure(std::vector<int>& row_entries,
+								 std::vector<int>& col_entries);
+
 		/**
 		 * @brief Evaluates the solution from an optimizer
 		 * @param const Eigen::Ref<const Eigen::VectorXd>& Solution vector
@@ -130,6 +284,24 @@ class OptimalControl : public model::OptimizationModel
 		 */
 		void setHorizon(unsigned int horizon);
 
+		/**
+		 * @brief Sets the number of threads used for evaluating the constraints and costs. With
+		 * more than one thread, the knots are evaluated in parallel, and each knot reads its
+		 * predecessor state directly from the decision vector. This requires that the dynamical
+		 * system, constraints and costs are clonable, otherwise the horizon is evaluated serially.
+		 * The per-thread copies are created in the init() call, and their initial, terminal and
+		 * desired states are updated before each evaluation if they were set afterwards
+		 * @param unsigned int Number of threads (one means serial evaluation)
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
+		/**
+		 * @brief Sets the approximation of the Lagrangian Hessian. It has to be defined before
+		 * initializing the solver, since the solver decides if it approximates the Hessian
+		 * @param enum HessianApproximation Hessian approximation
+		 */
+		void setHessianApproximation(enum HessianApproximation approximation);
+
 		/** @brief Gets the dynamical system constraint */
 		DynamicalSystem* getDynamicalSystem();
 
@@ -144,6 +316,13 @@ class OptimalControl : public model::OptimizationModel
 
 
 	protected:
+		/**
+		 * @brief Updates the initial and terminal states, and the desired states of the costs, of
+		 * a copy of the problem
+		 * @param model::OptimizationModel* Copy created by clone()
+		 */
+		void syncClone(model::OptimizationModel* model);
+
 		/** @brief Dynamical system constraint pointer */
 		DynamicalSystem* dynamical_system_;
 
@@ -170,6 +349,232 @@ class OptimalControl : public model::OptimizationModel
 
 		/** @brief Whole-body solution */
 		WholeBodyTrajectory motion_solution_;
+
+		/** @brief Starting point and multipliers for warm-starting the solver */
+		Eigen::VectorXd starting_point_;
+		Eigen::VectorXd starting_bound_lower_mult_;
+		Eigen::VectorXd starting_bound_upper_mult_;
+		Eigen::VectorXd starting_constraint_mult_;
+
+		/** @brief True if the starting point was shifted for the next optimization */
+		bool shifted_point_;
+
+
+	private:
+		/**
+		 * @brief Initializes the zero Hessian state, and checks that the Hessian is available, i.e.
+		 * fixed step integration, hard constraints and costs with second derivatives
+		 */
+		void initHessian();
+
+		/** @brief Creates the per-thread copies of the dynamical system, constraints and costs */
+		void initKnotParallelism();
+
+		/** @brief Deletes the per-thread copies of the dynamical system, constraints and costs */
+		void clearKnotParallelism();
+
+		/**
+		 * @brief Updates the initial and terminal states, and the desired states of the costs, of
+		 * the per-thread copies if they were set after creating them
+		 */
+		void syncKnotParallelism();
+
+		/**
+		 * @brief Computes the accumulated time of each knot. In the variable step-time
+		 * integration, the step time is the first decision variable of each knot
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector
+		 */
+		void computeKnotTimes(const Eigen::Ref<const Eigen::VectorXd>& decision_var);
+
+		/**
+		 * @brief Sets the given times of a knot and its previous knots used by the transcription
+		 * @param const Eigen::VectorXd& Accumulated time of each knot
+		 * @param unsigned int Knot index
+		 */
+		void setKnotTimes(const Eigen::VectorXd& knot_times,
+						  unsigned int knot);
+
+		/**
+		 * @brief Buffers used for evaluating the knots. They are sized once in init(), so the
+		 * evaluation of the constraints, costs and Hessian doesn't allocate memory
+		 */
+		struct KnotWorkspace
+		{
+			/** @brief Whole-body state of the current knot */
+			WholeBodyState system_state;
+
+			/** @brief Decision variables of the current knot */
+			Eigen::VectorXd decision_state;
+
+			/** @brief Previous states of the knot, from the oldest one */
+			std::vector<WholeBodyState> last_states;
+
+			/** @brief Number of valid previous states */
+			unsigned int num_last_states;
+
+			/** @brief Initial state of the horizon */
+			WholeBodyState initial_state;
+
+			/** @brief Values of the dynamical system constraint and the rest of constraints */
+			std::vector<Eigen::VectorXd> constraints;
+
+			/** @brief Value of the terminal constraint */
+			Eigen::VectorXd terminal_constraint;
+
+			/**
+			 * @brief Hessian diagonal of the current knot. The mixed derivatives with the
+			 * duration are unused, but the cost interface computes them
+			 */
+			WholeBodyState hessian_state;
+			WholeBodyState duration_hessian_state;
+			Eigen::VectorXd hessian;
+		};
+
+		/** @brief Initializes the buffers used for evaluating the knots */
+		void initWorkspaces();
+
+		/**
+		 * @brief Gets the first knot which the decision variables of a certain knot depend on,
+		 * i.e. the first previous knot used by the transcription
+		 * @param unsigned int Knot index
+		 * @return unsigned int First coupled knot
+		 */
+		unsigned int getFirstCoupledKnot(unsigned int knot);
+
+		/**
+		 * @brief Shifts the knot segments of a vector towards its beginning, and holds the last
+		 * knot segment in the tail
+		 * @param Eigen::VectorXd& Vector to shift
+		 * @param unsigned int Dimension of each knot segment
+		 * @param unsigned int Number of shifted knots
+		 */
+		void shiftKnots(Eigen::VectorXd& vector,
+						unsigned int knot_dim,
+						unsigned int num_knots);
+
+		/**
+		 * @brief Gets the whole-body state of a certain knot from the decision vector
+		 * @param WholeBodyState& Whole-body state of the knot
+		 * @param KnotWorkspace& Buffers of the evaluation
+		 * @param DynamicalSystem* Dynamical system used for converting the decision variables
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector
+		 * @param unsigned int Knot index
+		 */
+		void getKnotState(WholeBodyState& system_state,
+						  KnotWorkspace& workspace,
+						  DynamicalSystem* dynamical_system,
+						  const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+						  unsigned int knot);
+
+		/**
+		 * @brief Gets the previous states of a certain knot that are used by the transcription,
+		 * ordered from the oldest one
+		 * @param KnotWorkspace& Buffers of the evaluation, where the previous states are stored
+		 * @param DynamicalSystem* Dynamical system used for converting the decision variables
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector
+		 * @param unsigned int Knot index
+		 */
+		void getKnotLastStates(KnotWorkspace& workspace,
+							   DynamicalSystem* dynamical_system,
+							   const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+							   unsigned int knot);
+
+		/**
+		 * @brief Sets the previous states of a knot to the state buffer of a constraint
+		 * @param Constraint<WholeBodyState>* Constraint
+		 * @param KnotWorkspace& Buffers of the evaluation with the previous states
+		 */
+		void setKnotLastStates(Constraint<WholeBodyState>* constraint,
+							   KnotWorkspace& workspace);
+
+		/**
+		 * @brief Evaluates the constraints of the horizon in parallel, where each knot writes in a
+		 * disjoint segment of the constraint vector
+		 * @param Eigen::Ref<Eigen::VectorXd> Full constraint vector
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector
+		 */
+		void evaluateKnotConstraints(Eigen::Ref<Eigen::VectorXd> full_constraint,
+									 const Eigen::Ref<const Eigen::VectorXd>& decision_var);
+
+		/**
+		 * @brief Evaluates the cost of the horizon in parallel
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector
+		 * @return double Cost value
+		 */
+		double evaluateKnotCosts(const Eigen::Ref<const Eigen::VectorXd>& decision_var);
+
+		/**
+		 * @brief Computes the hard constraints of a certain knot
+		 * @param Eigen::Ref<Eigen::VectorXd> Constraint vector of the knot
+		 * @param KnotWorkspace& Buffers of the evaluation
+		 * @param DynamicalSystem* Dynamical system
+		 * @param std::vector<Constraint<WholeBodyState>*>& Constraints
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector
+		 * @param unsigned int Knot index
+		 */
+		void computeKnotConstraints(Eigen::Ref<Eigen::VectorXd> knot_constraint,
+									KnotWorkspace& workspace,
+									DynamicalSystem* dynamical_system,
+									std::vector<Constraint<WholeBodyState>*>& constraints,
+									const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+									unsigned int knot);
+
+		/**
+		 * @brief Computes the cost and soft-constraints of a certain knot
+		 * @param KnotWorkspace& Buffers of the evaluation
+		 * @param DynamicalSystem* Dynamical system
+		 * @param std::vector<Constraint<WholeBodyState>*>& Constraints
+		 * @param std::vector<Cost*>& Costs
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Decision vector
+		 * @param unsigned int Knot index
+		 * @return double Cost value of the knot
+		 */
+		double computeKnotCost(KnotWorkspace& workspace,
+							   DynamicalSystem* dynamical_system,
+							   std::vector<Constraint<WholeBodyState>*>& constraints,
+							   std::vector<Cost*>& costs,
+							   const Eigen::Ref<const Eigen::VectorXd>& decision_var,
+							   unsigned int knot);
+
+		/** @brief Number of threads used for evaluating the knots */
+		unsigned int num_threads_;
+
+		/** @brief Thread pool for the knot-parallel evaluation */
+		utils::ThreadPool* thread_pool_;
+
+		/** @brief Per-thread copies of the dynamical system */
+		std::vector<DynamicalSystem*> thread_dynamical_systems_;
+
+		/** @brief Per-thread copies of the constraints */
+		std::vector<std::vector<Constraint<WholeBodyState>*> > thread_constraints_;
+
+		/** @brief Per-thread copies of the costs */
+		std::vector<std::vector<Cost*> > thread_costs_;
+
+		/** @brief Indicates if the knots are evaluated in parallel */
+		bool knot_parallel_;
+
+		/** @brief State versions of the dynamical system and costs of the per-thread copies */
+		unsigned long int synced_system_version_;
+		std::vector<unsigned long int> synced_cost_versions_;
+
+		/** @brief Accumulated time of each knot */
+		Eigen::VectorXd knot_times_;
+
+		/** @brief Cost value of each knot */
+		Eigen::VectorXd knot_costs_;
+
+		/** @brief Approximation of the Lagrangian Hessian */
+		enum HessianApproximation hessian_approximation_;
+
+		/** @brief Zero Hessian described as whole-body state, which defines the variable sizes */
+		WholeBodyState zero_hessian_state_;
+
+		/** @brief Dimension of the dynamical system constraint and the rest of constraints */
+		std::vector<unsigned int> constraint_dims_;
+
+		/** @brief Evaluation buffers, one per thread */
+		std::vector<KnotWorkspace> workspaces_;
 };
 
 } //@namespace ocp
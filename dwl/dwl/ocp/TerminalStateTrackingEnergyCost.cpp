@@ -19,6 +19,12 @@ TerminalStateTrackingEnergyCost::~TerminalStateTrackingEnergyCost()
 }
 
 
+TerminalStateTrackingEnergyCost* TerminalStateTrackingEnergyCost::clone() const
+{
+	return new TerminalStateTrackingEnergyCost(*this);
+}
+
+
 void TerminalStateTrackingEnergyCost::compute(double& cost,
 											  const WholeBodyState& state)
 {
@@ -27,8 +33,8 @@ void TerminalStateTrackingEnergyCost::compute(double& cost,
 
 	// Computing the base and joint position-tracking error
 	if (cost_variables_.base_pos) {
-		Eigen::VectorXd base_pos_error = desired_state_.base_pos - state.base_pos;
-		cost += base_pos_error.transpose() * locomotion_weights_.base_pos.asDiagonal() * base_pos_error;
+		cost += (locomotion_weights_.base_pos.array() *
+				(desired_state_.base_pos - state.base_pos).array().square()).sum();
 	}
 	if (cost_variables_.joint_pos) {
 		// Checking the joint position size
@@ -37,14 +43,14 @@ void TerminalStateTrackingEnergyCost::compute(double& cost,
 			exit(EXIT_FAILURE);
 		}
 
-		Eigen::VectorXd joint_pos_error = desired_state_.joint_pos - state.joint_pos;
-		cost += joint_pos_error.transpose() * locomotion_weights_.joint_pos.asDiagonal() * joint_pos_error;
+		cost += (locomotion_weights_.joint_pos.array() *
+				(desired_state_.joint_pos - state.joint_pos).array().square()).sum();
 	}
 
 	// Computing the base and joint velocity-tracking error
 	if (cost_variables_.base_vel) {
-		Eigen::VectorXd base_vel_error = desired_state_.base_vel - state.base_vel;
-		cost += base_vel_error.transpose() * locomotion_weights_.base_vel.asDiagonal() * base_vel_error;
+		cost += (locomotion_weights_.base_vel.array() *
+				(desired_state_.base_vel - state.base_vel).array().square()).sum();
 	}
 	if (cost_variables_.joint_vel) {
 		// Checking the joint velocity size
@@ -53,14 +59,14 @@ void TerminalStateTrackingEnergyCost::compute(double& cost,
 			exit(EXIT_FAILURE);
 		}
 
-		Eigen::VectorXd joint_vel_error = desired_state_.joint_vel - state.joint_vel;
-		cost += joint_vel_error.transpose() * locomotion_weights_.joint_vel.asDiagonal() * joint_vel_error;
+		cost += (locomotion_weights_.joint_vel.array() *
+				(desired_state_.joint_vel - state.joint_vel).array().square()).sum();
 	}
 
 	// Computing the base and joint acceleration-tracking error
 	if (cost_variables_.base_acc) {
-		Eigen::VectorXd base_acc_error = desired_state_.base_acc - state.base_acc;
-		cost += base_acc_error.transpose() * locomotion_weights_.base_acc.asDiagonal() * base_acc_error;
+		cost += (locomotion_weights_.base_acc.array() *
+				(desired_state_.base_acc - state.base_acc).array().square()).sum();
 	}
 	if (cost_variables_.joint_acc) {
 		// Checking the joint acceleration size
@@ -69,10 +75,33 @@ void TerminalStateTrackingEnergyCost::compute(double& cost,
 			exit(EXIT_FAILURE);
 		}
 
-		Eigen::VectorXd joint_acc_error = desired_state_.joint_acc - state.joint_acc;
-		cost += joint_acc_error.transpose() * locomotion_weights_.joint_acc.asDiagonal() * joint_acc_error;
+		cost += (locomotion_weights_.joint_acc.array() *
+				(desired_state_.joint_acc - state.joint_acc).array().square()).sum();
 	}
 }
 
+
+bool TerminalStateTrackingEnergyCost::computeHessian(WholeBodyState& hessian,
+													 WholeBodyState& duration_hessian,
+													 const WholeBodyState& state)
+{
+	// The tracking errors are weighted quadratically
+	double factor = 2.;
+	if (cost_variables_.base_pos)
+		hessian.base_pos += factor * locomotion_weights_.base_pos;
+	if (cost_variables_.joint_pos)
+		hessian.joint_pos += factor * locomotion_weights_.joint_pos;
+	if (cost_variables_.base_vel)
+		hessian.base_vel += factor * locomotion_weights_.base_vel;
+	if (cost_variables_.joint_vel)
+		hessian.joint_vel += factor * locomotion_weights_.joint_vel;
+	if (cost_variables_.base_acc)
+		hessian.base_acc += factor * locomotion_weights_.base_acc;
+	if (cost_variables_.joint_acc)
+		hessian.joint_acc += factor * locomotion_weights_.joint_acc;
+
+	return true;
+}
+
 } //@namespace ocp
 } //@namespace dwl
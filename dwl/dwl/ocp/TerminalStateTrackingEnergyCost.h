@@ -23,6 +23,9 @@ class TerminalStateTrackingEnergyCost : public Cost
 		/** @brief Destructor function */
 		~TerminalStateTrackingEnergyCost();
 
+		/** @brief Creates a deep copy of the cost */
+		TerminalStateTrackingEnergyCost* clone() const;
+
 		/**
 		 * @brief Computes the state-tracking energy cost given a locomotion state. The
 		 * state-tracking energy is defined as quadratic cost function
@@ -31,6 +34,18 @@ class TerminalStateTrackingEnergyCost : public Cost
 		 */
 		void compute(double& cost,
 					 const WholeBodyState& state);
+
+		/**
+		 * @brief Computes the diagonal of the state-tracking energy Hessian, i.e. 2 * W. It
+		 * doesn't depend on the step duration, so there aren't mixed derivatives
+		 * @param WholeBodyState& Diagonal of the Hessian described as whole-body state
+		 * @param WholeBodyState& Mixed second derivatives with the step duration (unchanged)
+		 * @param const WholeBodyState& Whole-body state
+		 * @return True since the second derivatives are available
+		 */
+		bool computeHessian(WholeBodyState& hessian,
+							WholeBodyState& duration_hessian,
+							const WholeBodyState& state);
 };
 
 } //@namespace ocp
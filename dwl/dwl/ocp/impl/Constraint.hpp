@@ -10,7 +10,7 @@ namespace ocp
 
 template <typename TState>
 Constraint<TState>::Constraint() : constraint_dimension_(0), is_soft_(false),
-	soft_properties_(SoftConstraintProperties(10000., 0., 0.))
+	soft_properties_(SoftConstraintProperties(10000., 0., 0.)), num_last_states_(0)
 {
 	state_buffer_.set_capacity(4);
 }
@@ -70,6 +70,13 @@ void Constraint<TState>::init(bool info)
 }
 
 
+template <typename TState>
+Constraint<TState>* Constraint<TState>::clone() const
+{
+	return NULL;
+}
+
+
 template <typename TState>
 void Constraint<TState>::computeSoft(double& constraint_cost,
 									 const TState& state)
@@ -145,17 +152,26 @@ void Constraint<TState>::setSoftProperties(const SoftConstraintProperties& prope
 template <typename TState>
 void Constraint<TState>::setLastState(TState& last_state)
 {
+	// Once the buffer is full, the oldest state is overwritten, so its memory is reused
 	state_buffer_.push_front(last_state);
+	if (num_last_states_ < state_buffer_.capacity())
+		++num_last_states_;
 }
 
 
 template <typename TState>
 void Constraint<TState>::resetStateBuffer()
 {
-	unsigned int buffer_size = state_buffer_.size();
-	WholeBodyState empty_state(state_buffer_[0].joint_pos.size());
-	for (unsigned int i = 0; i < buffer_size; i++)
-		state_buffer_.push_back();
+	// The buffered states are kept for reusing their memory
+	num_last_states_ = 0;
+}
+
+
+template <typename TState>
+void Constraint<TState>::initStateBuffer(const TState& state)
+{
+	state_buffer_.assign(state_buffer_.capacity(), state);
+	num_last_states_ = 0;
 }
 
 
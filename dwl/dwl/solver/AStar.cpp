@@ -7,7 +7,7 @@ namespace dwl
 namespace solver
 {
 
-AStar::AStar() : expansions_(0)
+AStar::AStar()
 {
 	name_ = "A-star";
 }
@@ -36,94 +36,71 @@ bool AStar::compute(Vertex source,
 	}
 
 	// Computing the shortest path
-	findShortestPath(source, target);
-
-	return true;
+	return findShortestPath(source, target);
 }
 
 
-void AStar::findShortestPath(Vertex source,
+bool AStar::findShortestPath(Vertex source,
 							 Vertex target)
 {
-	// Defining the f_cost and g_cost
-	CostMap f_cost;
-	CostMap g_cost;
-
 	// Setting the initial time
 	time_started_ = clock();
 
 	// Number of expansions
 	expansions_ = 0;
 
-	// Defining the set of nodes already evaluated (openset), the set of
-	// tentative nodes to be evaluated (openset), and ordered openset queue
-	std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > openset_queue;
-	std::map<Vertex, bool> openset;
-	std::map<Vertex, bool> closedset;
-
-	// Cost from start along best known path.
-	g_cost[source] = 0;
+	// Clearing the nodes of the previous search but keeping their memory
+	nodes_.clear();
+	openset_.clear();
 
-	// Estimated total cost from start to goal
-	f_cost[source] = g_cost[source] + adjacency_->heuristicCost(source, target);
+	// Adding the start vertex to the openset, where the nodes are ordered by the f cost and
+	// then by the heuristic, i.e. the deepest node is expanded first
+	unsigned int source_slot = nodes_.getSlot(source);
+	nodes_[source_slot].g_cost = 0;
+	nodes_[source_slot].state = OPEN;
+	double heuristic = getHeuristic(source_slot, target);
+	openset_.push(source_slot, SearchKey(heuristic, heuristic));
 
-	// Adding the start vertex to the openset
-	openset_queue.insert(std::pair<Weight, Vertex>(f_cost[source], source));
-	openset[source] = true;
-	double min_f_cost = std::numeric_limits<double>::max();
-	while ((!openset.empty()) && (g_cost[target] < min_f_cost)) {
-		Vertex current = openset_queue.begin()->second;
+	total_cost_ = std::numeric_limits<double>::max();
+	std::vector<Edge> successors;
+	while (!openset_.empty()) {
+		unsigned int current = openset_.pop();
+		Vertex current_vertex = nodes_[current].vertex;
 
 		// Checking if it is getted the target
-		if (adjacency_->isReachedGoal(target, current)) {
-			policy_[target] = current;
-			g_cost[target] = g_cost[current];
-			break;
+		if (adjacency_->isReachedGoal(target, current_vertex)) {
+			setPolicy(current, target);
+			total_cost_ = nodes_[current].g_cost;
+			return true;
 		}
 
-		// Deleting the current vertex to the openset list
-		openset_queue.erase(openset_queue.begin());
-		openset.erase(current);
-
 		// Adding the current vertex to the closedset
-		closedset[current] = true;
+		nodes_[current].state = CLOSED;
+		Weight current_g_cost = nodes_[current].g_cost;
 
 		// Visit each edge exiting in the current vertex
-		std::list<Edge> successors;
-		adjacency_->getSuccessors(successors, current);
-		for (std::list<Edge>::iterator edge_iter = successors.begin();
-						edge_iter != successors.end();
-						edge_iter++)
-		{
-			Vertex neighbor = edge_iter->target;
-			Weight weight = edge_iter->weight;
-
-			if (closedset.count(neighbor) > 0)
+		successors.clear();
+		adjacency_->getSuccessors(successors, current_vertex);
+		for (std::vector<Edge>::iterator edge_iter = successors.begin();
+				edge_iter != successors.end(); edge_iter++) {
+			unsigned int neighbor = nodes_.getSlot(edge_iter->target);
+			if (nodes_[neighbor].state == CLOSED)
 				continue;
 
-			Weight tentative_g_cost = g_cost[current] + weight;
-			if ((openset.count(neighbor) == 0) || (tentative_g_cost < g_cost[neighbor])) {
-				policy_[neighbor] = current;
-				g_cost[neighbor] = tentative_g_cost;
-				f_cost[neighbor] = g_cost[neighbor] + adjacency_->heuristicCost(neighbor, target);
-
-				if (openset.count(neighbor) == 0) {
-					openset[neighbor] = true;
-					openset_queue.insert(std::pair<Weight, Vertex>(f_cost[neighbor], neighbor));
-				}
+			Weight tentative_g_cost = current_g_cost + edge_iter->weight;
+			if (tentative_g_cost < nodes_[neighbor].g_cost) {
+				nodes_[neighbor].g_cost = tentative_g_cost;
+				nodes_[neighbor].parent = current;
+				nodes_[neighbor].state = OPEN;
+				heuristic = getHeuristic(neighbor, target);
+				openset_.push(neighbor, SearchKey(tentative_g_cost + heuristic, heuristic));
 			}
 		}
 		expansions_++;
-
-		// Computing the minimum f cost
-		Vertex current_vertex = openset_queue.begin()->second;
-		double current_f_cost = openset_queue.begin()->first;
-		min_f_cost = current_f_cost + adjacency_->heuristicCost(current_vertex, target);
 	}
 
-	total_cost_ = g_cost[target];
+	return false;
 }
 
 } //@namespace solver
 } //@namespace dwl
-
@@ -47,12 +47,10 @@ class AStar : public SearchTreeSolver
 		 * @brief Computes the minimum cost and previous vertex according to the shortest A* path
 		 * @param Vertex Source vertex
 		 * @param Vertex Target vertex
+		 * @return True if the target was reached
 		 */
-		void findShortestPath(Vertex source,
+		bool findShortestPath(Vertex source,
 							  Vertex target);
-
-		/** @brief number of expansions */
-		int expansions_;
 };
 
 } //@namespace solver
@@ -1,5 +1,4 @@
 #include <dwl/solver/AnytimeRepairingAStar.h>
-#include <time.h>
 
 
 namespace dwl
@@ -9,8 +8,9 @@ namespace solver
 {
 
 AnytimeRepairingAStar::AnytimeRepairingAStar(double initial_inflation) :
-		initial_inflation_(initial_inflation), satisfied_inflation_(1.0),
-		min_f_cost_(std::numeric_limits<double>::max()), expansions_(0)
+		initial_inflation_(initial_inflation), inflation_(initial_inflation),
+		satisfied_inflation_(1.0), inflation_decrement_(0.5), goal_slot_(NO_SLOT), source_(0),
+		target_(0), terrain_version_(0), is_initialized_(false)
 {
 	name_ = "Anytime Repairing A*";
 }
@@ -19,12 +19,13 @@ AnytimeRepairingAStar::AnytimeRepairingAStar(double initial_inflation) :
 AnytimeRepairingAStar::~AnytimeRepairingAStar()
 {
 	policy_.clear();
-	g_cost_.clear();
 }
 
 
 bool AnytimeRepairingAStar::init()
 {
+	is_initialized_ = false;
+
 	return true;
 }
 
@@ -39,106 +40,197 @@ bool AnytimeRepairingAStar::compute(Vertex source,
 		return false;
 	}
 
-	// Defining the set of nodes already evaluated (openset), the set of tentative nodes
-	// to be evaluated (openset), and ordered openset queue
-	SetQueue openset_queue;
-	Set openset, visitedset;
-
-	// Setting the initial time
-	time_started_ = clock();
-
-	satisfied_inflation_ = initial_inflation_;
-	double current_inflation = initial_inflation_;
+	// Setting the deadline with a monotonic wall clock, so the budget isn't affected by other
+	// threads of the process. Budgets larger than a day are considered unlimited
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+	if (computation_time < 86400.)
+		deadline = std::chrono::steady_clock::now() +
+				std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+						std::chrono::duration<double>(computation_time));
 
 	// Number of expansions
 	expansions_ = 0;
 
-	// Getting the allocated time for computing a solution
-	double allocated_time_secs = computation_time * (double) CLOCKS_PER_SEC;
-
-	// Setting the g cost of the start and goal state
-	g_cost_[source] = 0;
-	g_cost_[target] = std::numeric_limits<double>::max();
-
-	// Estimated total cost from start to goal
-	double f_cost = g_cost_[source] +
-			satisfied_inflation_ * adjacency_->heuristicCost(source, target);
+	// Continuing the previous search if the source, target and terrain are the same. The node
+	// costs of the previous search aren't valid if the terrain changed
+	unsigned long int terrain_version = (terrain_ != NULL) ? terrain_->getTerrainVersion() : 0;
+	if (!is_initialized_ || source != source_ || target != target_ ||
+			terrain_version != terrain_version_)
+		startSearch(source, target);
+
+	// Computing a first path with the initial inflation, and then improving it with a decreasing
+	// inflation that reuses the previous search
+	while (satisfied_inflation_ > 1. && improvePath(target, inflation_, deadline)) {
+		bool improved = goal_slot_ != NO_SLOT && nodes_[goal_slot_].g_cost < total_cost_;
+		if (improved) {
+			setPolicy(goal_slot_, target);
+			total_cost_ = nodes_[goal_slot_].g_cost;
+		}
 
-	// Adding the start vertex to the openset
-	openset_queue.insert(std::pair<Weight, Vertex>(f_cost, source));
-	openset[source] = true;
-
-	// Computing the minimum f cost
-	Vertex current_vertex = openset_queue.begin()->second;
-	double current_f_cost = openset_queue.begin()->first;
-	min_f_cost_ = current_f_cost +
-			satisfied_inflation_ * adjacency_->heuristicCost(current_vertex, target);
-
-	while ((satisfied_inflation_ > 1) && ((clock() - time_started_) < allocated_time_secs)) {
-		// Computing a path with reuse of states values
-		if (improvePath(openset_queue, visitedset, target, computation_time)) {
-			// Decreasing the current inflation gain
-			double next_inflation = min_f_cost_ / g_cost_[target];
-			if (current_inflation > next_inflation)
-				current_inflation = next_inflation;
-
-			if (current_inflation < 1)
-				current_inflation = 1;
-			satisfied_inflation_ = current_inflation;
-
-			total_cost_ = g_cost_[target];
+		// Computing the sub-optimality bound of the path, i.e. the ratio between its cost and a
+		// lower bound of the optimal cost. The incumbent is optimal if there isn't any node to
+		// expand
+		double min_cost = std::numeric_limits<double>::max();
+		for (unsigned int slot = 0; slot < nodes_.size(); slot++) {
+			if (nodes_[slot].state == OPEN || nodes_[slot].state == INCONSISTENT)
+				min_cost = std::min(min_cost, nodes_[slot].g_cost + getHeuristic(slot, target));
+		}
+		if (total_cost_ == std::numeric_limits<double>::max())
+			break;
+
+		satisfied_inflation_ = std::max(std::min(inflation_, total_cost_ / min_cost), 1.);
+		if (improved && solution_callback_)
+			solution_callback_(getShortestPath(source, target), total_cost_, satisfied_inflation_);
+
+		if (satisfied_inflation_ <= 1.)
+			break;
+
+		// Decreasing the inflation, and moving the inconsistent nodes to the openset. The
+		// closedset is emptied, and the openset is reordered with the new inflation
+		inflation_ = std::max(std::min(inflation_ - inflation_decrement_, satisfied_inflation_), 1.);
+		for (unsigned int i = 0; i < inconsistentset_.size(); i++)
+			nodes_[inconsistentset_[i]].state = OPEN;
+		inconsistentset_.clear();
+
+		openset_.clear();
+		for (unsigned int slot = 0; slot < nodes_.size(); slot++) {
+			if (nodes_[slot].state == OPEN)
+				openset_.push(slot, computeKey(slot, target, inflation_));
+			else if (nodes_[slot].state == CLOSED)
+				nodes_[slot].state = UNVISITED;
 		}
 	}
 
-	return true;
+	return total_cost_ != std::numeric_limits<double>::max();
 }
 
 
-bool AnytimeRepairingAStar::improvePath(SetQueue& openset_queue,
-										Set& visitedset,
-										Vertex target,
-										double computation_time)
+void AnytimeRepairingAStar::setSolutionCallback(const SolutionCallback& callback)
 {
-	// Setting an empty closed set and inconsistent set
-	Set closedset;
-	SetQueue inconsistentset_queue;
+	solution_callback_ = callback;
+}
 
-	double allocated_time_secs = computation_time * (double) CLOCKS_PER_SEC;
-	while ((!openset_queue.empty()) && ((clock() - time_started_) < allocated_time_secs)
-			&& (g_cost_[target] > min_f_cost_)) {
-		Vertex current = openset_queue.begin()->second;
 
-		// Deleting the current vertex to the openset list
-		openset_queue.erase(openset_queue.begin());
+double AnytimeRepairingAStar::getSuboptimalityBound()
+{
+	return satisfied_inflation_;
+}
 
-		// Adding the current vertex to the closedset
-		closedset[current] = true;
 
-		// Visit each edge exiting in the current vertex
-		std::list<Edge> successors;
-		adjacency_->getSuccessors(successors, current);
-		for (std::list<Edge>::iterator edge_iter = successors.begin();
-				edge_iter != successors.end();
-				edge_iter++)
-		{
-			Vertex neighbor = edge_iter->target;
-			Weight weight = edge_iter->weight;
-
-			if (visitedset.count(neighbor) == 0) {
-				g_cost_[neighbor] = std::numeric_limits<double>::max();
-				visitedset[neighbor] = true;
+void AnytimeRepairingAStar::startSearch(Vertex source,
+										Vertex target)
+{
+	// Keeping the remaining part of the previous path as incumbent solution if the source moved
+	// along it. Its cost is evaluated again from the edges, which also checks that they still
+	// exist
+	double incumbent_cost = std::numeric_limits<double>::max();
+	PreviousVertex incumbent_policy;
+	if (is_initialized_ && target == target_ &&
+			total_cost_ != std::numeric_limits<double>::max()) {
+		std::list<Vertex> path = getShortestPath(source_, target);
+		std::list<Vertex>::iterator path_it = std::find(path.begin(), path.end(), source);
+		if (path_it != path.end()) {
+			incumbent_cost = 0.;
+			std::vector<Edge> successors;
+			for (std::list<Vertex>::iterator next_it = path_it; ++next_it != path.end();
+					path_it = next_it) {
+				successors.clear();
+				adjacency_->getSuccessors(successors, *path_it);
+				unsigned int i = 0;
+				while (i < successors.size() && successors[i].target != *next_it)
+					i++;
+
+				// The last vertex could be the target when the goal is reached within a
+				// tolerance (see AdjacencyModel::isReachedGoal)
+				if (i < successors.size())
+					incumbent_cost += successors[i].weight;
+				else if (*next_it != target) {
+					incumbent_cost = std::numeric_limits<double>::max();
+					break;
+				}
+				incumbent_policy[*next_it] = *path_it;
 			}
+		}
+	}
 
-			Weight tentative_g_cost = g_cost_[current] + weight;
-			if (tentative_g_cost < g_cost_[neighbor]) {
-				policy_[neighbor] = current;
-				g_cost_[neighbor] = tentative_g_cost;
-				double f_cost = g_cost_[neighbor] +
-						satisfied_inflation_ * adjacency_->heuristicCost(neighbor, target);
-				if (closedset.count(neighbor) == 0) {
-					openset_queue.insert(std::pair<Weight, Vertex>(f_cost, neighbor));
-				} else {
-					inconsistentset_queue.insert(std::pair<Weight, Vertex>(f_cost, neighbor));
+	// Clearing the nodes of the previous search but keeping their memory
+	nodes_.clear();
+	openset_.clear();
+	inconsistentset_.clear();
+	goal_slot_ = NO_SLOT;
+	source_ = source;
+	target_ = target;
+	terrain_version_ = (terrain_ != NULL) ? terrain_->getTerrainVersion() : 0;
+	is_initialized_ = true;
+
+	inflation_ = initial_inflation_;
+	satisfied_inflation_ = initial_inflation_;
+	total_cost_ = incumbent_cost;
+	policy_.clear();
+	if (incumbent_cost != std::numeric_limits<double>::max()) {
+		policy_.swap(incumbent_policy);
+		if (solution_callback_)
+			solution_callback_(getShortestPath(source, target), total_cost_, satisfied_inflation_);
+	}
+
+	// Adding the start vertex to the openset
+	unsigned int source_slot = nodes_.getSlot(source);
+	nodes_[source_slot].g_cost = 0;
+	nodes_[source_slot].state = OPEN;
+	openset_.push(source_slot, computeKey(source_slot, target, inflation_));
+}
+
+
+bool AnytimeRepairingAStar::improvePath(Vertex target,
+										double inflation,
+										const std::chrono::steady_clock::time_point& deadline)
+{
+	std::vector<Edge> successors;
+	while (!openset_.empty()) {
+		// Stopping when the best solution can't be improved with the current inflation
+		double solution_cost = total_cost_;
+		if (goal_slot_ != NO_SLOT)
+			solution_cost = std::min(solution_cost, nodes_[goal_slot_].g_cost);
+		if (solution_cost <= openset_.topKey().first)
+			break;
+
+		if (std::chrono::steady_clock::now() >= deadline)
+			return false;
+
+		unsigned int current = openset_.pop();
+		Vertex current_vertex = nodes_[current].vertex;
+		Weight current_g_cost = nodes_[current].g_cost;
+
+		// Adding the current vertex to the closedset
+		nodes_[current].state = CLOSED;
+
+		// Checking if it is getted the target
+		if (adjacency_->isReachedGoal(target, current_vertex) &&
+				(goal_slot_ == NO_SLOT || current_g_cost < nodes_[goal_slot_].g_cost))
+			goal_slot_ = current;
+
+		// Visit each edge exiting in the current vertex
+		successors.clear();
+		adjacency_->getSuccessors(successors, current_vertex);
+		for (std::vector<Edge>::iterator edge_iter = successors.begin();
+				edge_iter != successors.end(); edge_iter++) {
+			unsigned int neighbor = nodes_.getSlot(edge_iter->target);
+			Weight tentative_g_cost = current_g_cost + edge_iter->weight;
+			if (tentative_g_cost < nodes_[neighbor].g_cost) {
+				// Pruning the nodes that can't improve the incumbent solution
+				if (tentative_g_cost + getHeuristic(neighbor, target) >= total_cost_)
+					continue;
+
+				nodes_[neighbor].g_cost = tentative_g_cost;
+				nodes_[neighbor].parent = current;
+
+				// The closed nodes are repaired in the next search
+				if (nodes_[neighbor].state == CLOSED) {
+					nodes_[neighbor].state = INCONSISTENT;
+					inconsistentset_.push_back(neighbor);
+				} else if (nodes_[neighbor].state != INCONSISTENT) {
+					nodes_[neighbor].state = OPEN;
+					openset_.push(neighbor, computeKey(neighbor, target, inflation));
 				}
 			}
 		}
@@ -146,22 +238,16 @@ bool AnytimeRepairingAStar::improvePath(SetQueue& openset_queue,
 		expansions_++;
 	}
 
-	// Setting open set with all over consistent states
-	for (SetQueue::iterator incons_iter = inconsistentset_queue.begin();
-			incons_iter != inconsistentset_queue.end(); incons_iter++)
-	{
-		double f_cost = incons_iter->first;
-		Vertex vertex = incons_iter->second;
-		openset_queue.insert(std::pair<Weight, Vertex>(f_cost, vertex));
-	}
+	return true;
+}
 
-	// Computing the minimum f cost
-	Vertex current_vertex = openset_queue.begin()->second;
-	double current_f_cost = openset_queue.begin()->first;
-	min_f_cost_ = current_f_cost +
-			satisfied_inflation_ * adjacency_->heuristicCost(current_vertex, target);
 
-	return true;
+SearchKey AnytimeRepairingAStar::computeKey(unsigned int slot,
+											Vertex target,
+											double inflation)
+{
+	double heuristic = getHeuristic(slot, target);
+	return SearchKey(nodes_[slot].g_cost + inflation * heuristic, heuristic);
 }
 
 } //@namespace solver
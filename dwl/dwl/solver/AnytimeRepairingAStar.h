@@ -2,6 +2,8 @@
 #define DWL__SOLVER__ANYTIME_REPAIRING_ASTAR__H
 
 #include <dwl/solver/SearchTreeSolver.h>
+#include <chrono>
+#include <functional>
 
 
 namespace dwl
@@ -12,12 +14,21 @@ namespace solver
 
 /**
  * @class AnytimeRepairingAStar
- * @brief Class for solving a shortest-search problem using the ARA* algorithm. This class derives
- * from the SearchTreeSolver class
+ * @brief Class for solving a shortest-search problem using the ARA* algorithm. The search is
+ * kept across calls, so a call that ran out of time is continued by the next one with the same
+ * source, target and terrain version. If the source moves along the current path, its remaining part is kept as
+ * the incumbent solution, and the new search only expands the nodes that could improve it. This
+ * class derives from the SearchTreeSolver class
  */
 class AnytimeRepairingAStar : public SearchTreeSolver
 {
 	public:
+		/**
+		 * @brief Function that receives each improved solution, i.e. the path, its cost and its
+		 * sub-optimality bound
+		 */
+		typedef std::function<void(const std::list<Vertex>&, double, double)> SolutionCallback;
+
 		/** @brief Constructor function */
 		AnytimeRepairingAStar(double initial_inflation = 3.0);
 
@@ -25,7 +36,7 @@ class AnytimeRepairingAStar : public SearchTreeSolver
 		~AnytimeRepairingAStar();
 
 		/**
-		 * @brief Initializes the ARA* algorithm
+		 * @brief Initializes the ARA* algorithm, i.e. discards the previous search
 		 * @return True if ARA* algorithm was initialized
 		 */
 		bool init();
@@ -34,47 +45,87 @@ class AnytimeRepairingAStar : public SearchTreeSolver
 		 * @brief Computes a shortest-path using ARA* algorithm
 		 * @param Vertex Source vertex
 		 * @param Vertex Target vertex
-		 * @param double Allowed time for computing a solution (in seconds)
-		 * @return True if it was computed a solution
+		 * @param double Allowed (wall-clock) time for computing a solution (in seconds)
+		 * @return True if there is a solution, i.e. the best one found so far
 		 */
 		bool compute(Vertex source,
 					 Vertex target,
 					 double computation_time);
 
-		/** @brief Defines a ordered queue according to the less weight */
-		typedef std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > SetQueue;
+		/**
+		 * @brief Sets the function that receives each improved solution
+		 * @param const SolutionCallback& Solution callback
+		 */
+		void setSolutionCallback(const SolutionCallback& callback);
 
-		/** @brief Defines a set of known vertex */
-		typedef std::map<Vertex, bool> Set;
+		/** @brief Gets the sub-optimality bound of the current solution */
+		double getSuboptimalityBound();
 
 
 	private:
 		/**
-		 * @brief Improves the path according to inflation gain
-		 * @param SetQueue& openset_queue Openset queue
-		 * @param Set& visitedset Visited set
+		 * @brief Starts a new search from the source. The remaining part of the previous
+		 * path is kept as incumbent solution if the target is the same and the source is on it.
+		 * Its cost is evaluated again, so the terrain could have changed
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		void startSearch(Vertex source,
+						 Vertex target);
+
+		/**
+		 * @brief Improves the path according to inflation gain, i.e. it expands the openset until
+		 * the target can't be reached with a lower inflated cost
 		 * @param Vertex target Target vertex
-		 * @return True if the path was improved
+		 * @param double Inflation of the heuristic
+		 * @param const std::chrono::steady_clock::time_point& Deadline of the computation
+		 * @return False if the deadline was reached
 		 */
-		bool improvePath(SetQueue& openset_queue,
-						 Set& visitedset,
-						 Vertex target,
-						 double computation_time);
+		bool improvePath(Vertex target,
+						 double inflation,
+						 const std::chrono::steady_clock::time_point& deadline);
+
+		/**
+		 * @brief Computes the priority of a node, i.e. the inflated f cost
+		 * @param unsigned int Slot of the node
+		 * @param Vertex Target vertex
+		 * @param double Inflation of the heuristic
+		 * @return SearchKey Priority of the node
+		 */
+		SearchKey computeKey(unsigned int slot,
+							 Vertex target,
+							 double inflation);
 
 		/** @brief Initial inflation */
 		double initial_inflation_;
 
+		/** @brief Current inflation */
+		double inflation_;
+
 		/** @brief Satisfied inflation */
 		double satisfied_inflation_;
 
-		/** @brief G cost */
-		CostMap g_cost_;
+		/** @brief Decrement of the inflation after each improved path */
+		double inflation_decrement_;
+
+		/** @brief Closed nodes whose cost decreased, which are repaired in the next search */
+		std::vector<unsigned int> inconsistentset_;
+
+		/** @brief Slot of the reached goal */
+		unsigned int goal_slot_;
+
+		/** @brief Source and target of the search */
+		Vertex source_;
+		Vertex target_;
+
+		/** @brief Version of the terrain of the search */
+		unsigned long int terrain_version_;
 
-		/** @brief Minimum f cost */
-		double min_f_cost_;
+		/** @brief Indicates if there is a search to continue */
+		bool is_initialized_;
 
-		/** @brief number of expansions */
-		int expansions_;
+		/** @brief Function that receives each improved solution */
+		SolutionCallback solution_callback_;
 };
 
 } //@namespace solver
@@ -0,0 +1,267 @@
+#include <dwl/solver/DStarLite.h>
+#include <time.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+DStarLite::DStarLite() : source_(0), target_(0), key_modifier_(0.), is_initialized_(false)
+{
+	name_ = "D* Lite";
+}
+
+
+DStarLite::~DStarLite()
+{
+	policy_.clear();
+}
+
+
+bool DStarLite::init()
+{
+	is_initialized_ = false;
+
+	return true;
+}
+
+
+bool DStarLite::compute(Vertex source,
+						Vertex target,
+						double computation_time)
+{
+	if (!is_set_adjacency_model_) {
+		printf(RED "Could not computed the shortest path because "
+				"it is required to defined an adjacency model\n" COLOR_RESET);
+		return false;
+	}
+
+	// Setting the initial time
+	time_started_ = clock();
+
+	// Number of expansions
+	expansions_ = 0;
+
+	// Starting a new search if the target changed, or updating the priority offset if the source
+	// moved
+	if (!is_initialized_ || target != target_)
+		initializeSearch(source, target);
+	else if (source != source_) {
+		key_modifier_ += adjacency_->targetFreeHeuristicCost(source_, source);
+		source_ = source;
+	}
+
+	// Repairing the vertices whose incoming or outgoing edges changed
+	std::vector<Edge> predecessors;
+	for (unsigned int i = 0; i < changed_vertices_.size(); i++) {
+		unsigned int slot = getNode(changed_vertices_[i]);
+		updateLookahead(slot);
+		updateNode(slot);
+
+		predecessors.clear();
+		adjacency_->getPredecessors(predecessors, changed_vertices_[i]);
+		for (unsigned int j = 0; j < predecessors.size(); j++) {
+			unsigned int predecessor = getNode(predecessors[j].target);
+			updateLookahead(predecessor);
+			updateNode(predecessor);
+		}
+	}
+	changed_vertices_.clear();
+
+	// Computing the shortest path
+	if (!computeShortestPath(computation_time))
+		return false;
+
+	return extractPath();
+}
+
+
+void DStarLite::updateVertices(const std::vector<Vertex>& changed_vertices)
+{
+	changed_vertices_.insert(changed_vertices_.end(),
+							 changed_vertices.begin(), changed_vertices.end());
+}
+
+
+void DStarLite::initializeSearch(Vertex source,
+								 Vertex target)
+{
+	// Clearing the nodes of the previous search but keeping their memory
+	nodes_.clear();
+	openset_.clear();
+	lookahead_costs_.clear();
+	changed_vertices_.clear();
+	policy_.clear();
+	total_cost_ = std::numeric_limits<double>::max();
+
+	source_ = source;
+	target_ = target;
+	key_modifier_ = 0.;
+	is_initialized_ = true;
+
+	// Adding the target vertex to the openset
+	unsigned int target_slot = getNode(target);
+	lookahead_costs_[target_slot] = 0.;
+	openset_.push(target_slot, computeKey(target_slot));
+}
+
+
+bool DStarLite::computeShortestPath(double computation_time)
+{
+	double allocated_time_secs = computation_time * (double) CLOCKS_PER_SEC;
+	unsigned int source_slot = getNode(source_);
+	std::vector<Edge> predecessors;
+	while (!openset_.empty() && (openset_.topKey() < computeKey(source_slot) ||
+			lookahead_costs_[source_slot] != nodes_[source_slot].g_cost)) {
+		if ((clock() - time_started_) >= allocated_time_secs)
+			return false;
+
+		// Reordering the node if its priority is outdated, i.e. the source moved since it was
+		// queued
+		unsigned int current = openset_.top();
+		SearchKey new_key = computeKey(current);
+		if (openset_.topKey() < new_key) {
+			openset_.push(current, new_key);
+			continue;
+		}
+
+		Vertex current_vertex = nodes_[current].vertex;
+		predecessors.clear();
+		adjacency_->getPredecessors(predecessors, current_vertex);
+		if (nodes_[current].g_cost > lookahead_costs_[current]) {
+			// The node is overconsistent, so its cost is fixed and propagated to its predecessors
+			Weight current_g_cost = lookahead_costs_[current];
+			nodes_[current].g_cost = current_g_cost;
+			openset_.pop();
+			for (unsigned int i = 0; i < predecessors.size(); i++) {
+				unsigned int predecessor = getNode(predecessors[i].target);
+				if (predecessors[i].target != target_)
+					lookahead_costs_[predecessor] = std::min(lookahead_costs_[predecessor],
+							predecessors[i].weight + current_g_cost);
+				updateNode(predecessor);
+			}
+		} else {
+			// The node is underconsistent, so the predecessors that depended on it are
+			// recomputed
+			Weight old_g_cost = nodes_[current].g_cost;
+			nodes_[current].g_cost = std::numeric_limits<double>::infinity();
+			for (unsigned int i = 0; i < predecessors.size(); i++) {
+				unsigned int predecessor = getNode(predecessors[i].target);
+				if (!(lookahead_costs_[predecessor] < predecessors[i].weight + old_g_cost))
+					updateLookahead(predecessor);
+				updateNode(predecessor);
+			}
+			updateLookahead(current);
+			updateNode(current);
+		}
+
+		expansions_++;
+	}
+
+	return true;
+}
+
+
+bool DStarLite::extractPath()
+{
+	policy_.clear();
+	total_cost_ = std::numeric_limits<double>::max();
+
+	unsigned int source_slot = nodes_.findSlot(source_);
+	if (source_slot == NO_SLOT || nodes_[source_slot].g_cost ==
+			std::numeric_limits<double>::infinity())
+		return false;
+
+	// Following the cheapest successors, which gives the shortest path once the source is
+	// consistent. The number of steps is bounded by the visited nodes in case of cycles of zero
+	// cost
+	std::vector<Edge> successors;
+	Vertex vertex = source_;
+	for (unsigned int step = 0; vertex != target_; step++) {
+		if (step > nodes_.size())
+			return false;
+
+		successors.clear();
+		adjacency_->getSuccessors(successors, vertex);
+		Weight min_cost = std::numeric_limits<double>::infinity();
+		Vertex next_vertex = vertex;
+		for (unsigned int i = 0; i < successors.size(); i++) {
+			unsigned int slot = nodes_.findSlot(successors[i].target);
+			if (slot == NO_SLOT)
+				continue;
+
+			Weight cost = successors[i].weight + nodes_[slot].g_cost;
+			if (cost < min_cost) {
+				min_cost = cost;
+				next_vertex = successors[i].target;
+			}
+		}
+
+		if (min_cost == std::numeric_limits<double>::infinity())
+			return false;
+
+		policy_[next_vertex] = vertex;
+		vertex = next_vertex;
+	}
+	total_cost_ = nodes_[source_slot].g_cost;
+
+	return true;
+}
+
+
+unsigned int DStarLite::getNode(Vertex vertex)
+{
+	unsigned int slot = nodes_.getSlot(vertex);
+	if (slot >= lookahead_costs_.size())
+		lookahead_costs_.resize(slot + 1, std::numeric_limits<double>::infinity());
+
+	return slot;
+}
+
+
+void DStarLite::updateLookahead(unsigned int slot)
+{
+	Vertex vertex = nodes_[slot].vertex;
+	if (vertex == target_)
+		return;
+
+	// Computing the cheapest successor, where the unvisited ones have an infinite cost
+	std::vector<Edge> successors;
+	adjacency_->getSuccessors(successors, vertex);
+	Weight lookahead_cost = std::numeric_limits<double>::infinity();
+	for (unsigned int i = 0; i < successors.size(); i++) {
+		unsigned int successor = nodes_.findSlot(successors[i].target);
+		if (successor != NO_SLOT)
+			lookahead_cost = std::min(lookahead_cost,
+									  successors[i].weight + nodes_[successor].g_cost);
+	}
+	lookahead_costs_[slot] = lookahead_cost;
+}
+
+
+void DStarLite::updateNode(unsigned int slot)
+{
+	if (nodes_[slot].g_cost != lookahead_costs_[slot]) {
+		nodes_[slot].state = OPEN;
+		openset_.push(slot, computeKey(slot));
+	} else {
+		nodes_[slot].state = CLOSED;
+		openset_.remove(slot);
+	}
+}
+
+
+SearchKey DStarLite::computeKey(unsigned int slot)
+{
+	Weight min_cost = std::min(nodes_[slot].g_cost, lookahead_costs_[slot]);
+	// The cost-to-go table depends on the target of the query, so it would be rebuilt for each
+	// node
+	double heuristic = adjacency_->targetFreeHeuristicCost(source_, nodes_[slot].vertex);
+
+	return SearchKey(min_cost + heuristic + key_modifier_, min_cost);
+}
+
+} //@namespace solver
+} //@namespace dwl
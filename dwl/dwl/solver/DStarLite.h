@@ -0,0 +1,125 @@
+#ifndef DWL__SOLVER__DSTAR_LITE__H
+#define DWL__SOLVER__DSTAR_LITE__H
+
+#include <dwl/solver/SearchTreeSolver.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class DStarLite
+ * @brief Class for solving a shortest-search problem using the D* Lite algorithm. It searches
+ * backward from the target, and keeps the search state across calls, so a replanning after the
+ * source moves or some edge costs change only repairs the affected part of the tree. The
+ * predecessors are given by the adjacency model (see AdjacencyModel::getPredecessors), and the
+ * heuristic by AdjacencyModel::targetFreeHeuristicCost since it estimates the cost from the source
+ * to each expanded vertex. This class derives from the SearchTreeSolver class
+ */
+class DStarLite : public SearchTreeSolver
+{
+	public:
+		/** @brief Constructor function */
+		DStarLite();
+
+		/** @brief Destructor function */
+		~DStarLite();
+
+		/**
+		 * @brief Initializes the D* Lite algorithm, i.e. discards the previous search
+		 * @return True if D* Lite algorithm was initialized
+		 */
+		bool init();
+
+		/**
+		 * @brief Computes a shortest-path using D* Lite algorithm. The previous search is reused
+		 * if the target is the same, otherwise a new search is started. Note that the target
+		 * is the root of the search, so it has to be reached exactly
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 * @param double Allowed time for computing a solution (in seconds)
+		 * @return True if it was computed a solution
+		 */
+		bool compute(Vertex source,
+					 Vertex target,
+					 double computation_time);
+
+		/**
+		 * @brief Reports the vertices whose edge costs changed (e.g. after a terrain update),
+		 * which are repaired in the next computation. The new costs of the incoming and outgoing
+		 * edges of these vertices are read from the adjacency model
+		 * @param const std::vector<Vertex>& Changed vertices
+		 */
+		void updateVertices(const std::vector<Vertex>& changed_vertices);
+
+
+	private:
+		/** @brief Starts a new search from the target */
+		void initializeSearch(Vertex source,
+							  Vertex target);
+
+		/**
+		 * @brief Expands the openset until the source is consistent and none queued node could
+		 * reduce its cost
+		 * @param double Allowed time for computing a solution (in seconds)
+		 * @return True if the source reaches the target
+		 */
+		bool computeShortestPath(double computation_time);
+
+		/**
+		 * @brief Sets the policy by following the cheapest successors from the source
+		 * @return True if the path reaches the target
+		 */
+		bool extractPath();
+
+		/**
+		 * @brief Gets the slot of a vertex, which is created if the vertex wasn't visited
+		 * @param Vertex Vertex
+		 * @return unsigned int Slot index
+		 */
+		unsigned int getNode(Vertex vertex);
+
+		/**
+		 * @brief Recomputes the one-step lookahead cost (rhs) of a node from its successors
+		 * @param unsigned int Slot of the node
+		 */
+		void updateLookahead(unsigned int slot);
+
+		/**
+		 * @brief Queues a node if it's inconsistent, or removes it from the openset otherwise
+		 * @param unsigned int Slot of the node
+		 */
+		void updateNode(unsigned int slot);
+
+		/**
+		 * @brief Computes the priority of a node
+		 * @param unsigned int Slot of the node
+		 * @return SearchKey Priority of the node
+		 */
+		SearchKey computeKey(unsigned int slot);
+
+		/** @brief One-step lookahead costs (rhs) of the nodes, indexed by slot */
+		std::vector<Weight> lookahead_costs_;
+
+		/** @brief Vertices whose edge costs changed since the last computation */
+		std::vector<Vertex> changed_vertices_;
+
+		/** @brief Source and target of the search */
+		Vertex source_;
+		Vertex target_;
+
+		/** @brief Accumulated heuristic of the source movements, which keeps the queued
+		 * priorities as lower bounds without reordering the openset */
+		double key_modifier_;
+
+		/** @brief Indicates if there is a search to reuse */
+		bool is_initialized_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
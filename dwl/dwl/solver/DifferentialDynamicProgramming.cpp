@@ -0,0 +1,575 @@
+#include <dwl/solver/DifferentialDynamicProgramming.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+DifferentialDynamicProgramming::DifferentialDynamicProgramming() : oc_model_(NULL), horizon_(0),
+		num_previous_knots_(1), knot_dimension_(0), knot_constraint_dimension_(0),
+		decision_dimension_(0), constraint_dimension_(0), variable_step_(false), penalty_(10.),
+		regularization_(1e-6), max_iter_(100), convergence_tol_(1e-6), constr_viol_tol_(1e-4),
+		initial_penalty_(10.), fd_step_(1e-6), hessian_step_(1e-4)
+{
+	name_ = "DifferentialDynamicProgramming";
+}
+
+
+DifferentialDynamicProgramming::~DifferentialDynamicProgramming()
+{
+
+}
+
+
+void DifferentialDynamicProgramming::setFromConfigFile(std::string filename)
+{
+	// Yaml reader
+	YamlWrapper yaml_reader(filename);
+
+	// Parsing the configuration file
+	std::string ddp_ns = "ddp";
+	printf(BLUE "Reading the configuration parameters from the %s namespace.\n" COLOR_RESET,
+			ddp_ns.c_str());
+
+	// Getting the different nodes
+	YamlNamespace termination_ns = {ddp_ns, "termination"};
+	YamlNamespace lagrangian_ns = {ddp_ns, "augmented_lagrangian"};
+
+	// Termination parameters
+	// Reading and setting up the allowed number of iteration
+	int max_iter;
+	if (yaml_reader.read(max_iter, "max_iter", termination_ns))
+		setMaxIteration(max_iter);
+
+	// Reading and setting up the convergence tolerance
+	double tol;
+	if (yaml_reader.read(tol, "tol", termination_ns))
+		setConvergenceTolerance(tol);
+
+	// Reading and setting up the desired threshold for the constraint violation
+	double constr_viol_tol;
+	if (yaml_reader.read(constr_viol_tol, "constr_viol_tol", termination_ns))
+		setConstraintViolationTolerance(constr_viol_tol);
+
+	// Augmented Lagrangian parameters
+	// Reading and setting up the initial penalty
+	double initial_penalty;
+	if (yaml_reader.read(initial_penalty, "initial_penalty", lagrangian_ns))
+		setInitialPenalty(initial_penalty);
+}
+
+
+void DifferentialDynamicProgramming::setMaxIteration(int max_iter)
+{
+	max_iter_ = max_iter;
+}
+
+
+void DifferentialDynamicProgramming::setConvergenceTolerance(double tolerance)
+{
+	convergence_tol_ = tolerance;
+}
+
+
+void DifferentialDynamicProgramming::setConstraintViolationTolerance(double tolerance)
+{
+	constr_viol_tol_ = tolerance;
+}
+
+
+void DifferentialDynamicProgramming::setInitialPenalty(double penalty)
+{
+	initial_penalty_ = penalty;
+}
+
+
+bool DifferentialDynamicProgramming::init()
+{
+	// The Riccati recursion requires the stage-wise structure of an optimal control problem
+	oc_model_ = dynamic_cast<ocp::OptimalControl*>(model_);
+	if (oc_model_ == NULL) {
+		printf(RED "FATAL: the DDP solver requires an optimal control model\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+	oc_model_->init(false);
+
+	// Getting the dimensions of the problem
+	ocp::DynamicalSystem* dynamical_system = oc_model_->getDynamicalSystem();
+	horizon_ = oc_model_->getHorizon();
+	knot_dimension_ = oc_model_->getDimensionOfState();
+	knot_constraint_dimension_ = oc_model_->getDimensionOfConstraints();
+	num_previous_knots_ = dynamical_system->getNumberOfPreviousKnots();
+	variable_step_ = !dynamical_system->isFixedStepIntegration();
+	unsigned int terminal_dimension = 0;
+	if (dynamical_system->isFullTrajectoryOptimization())
+		terminal_dimension = dynamical_system->getTerminalConstraintDimension();
+	decision_dimension_ = horizon_ * knot_dimension_;
+	constraint_dimension_ = horizon_ * knot_constraint_dimension_ + terminal_dimension;
+
+	// Getting the bounds of the problem
+	decision_.resize(decision_dimension_);
+	decision_lower_bound_.resize(decision_dimension_);
+	decision_upper_bound_.resize(decision_dimension_);
+	constraint_lower_bound_.resize(constraint_dimension_);
+	constraint_upper_bound_.resize(constraint_dimension_);
+	oc_model_->evaluateBounds(decision_lower_bound_.data(), decision_dimension_,
+							  decision_upper_bound_.data(), decision_dimension_,
+							  constraint_lower_bound_.data(), constraint_dimension_,
+							  constraint_upper_bound_.data(), constraint_dimension_);
+	multipliers_ = Eigen::VectorXd::Zero(constraint_dimension_);
+	knot_times_.resize(horizon_);
+	perturbed_times_.resize(horizon_);
+
+	// Initializing the gains and derivatives of each knot
+	unsigned int state_dimension = num_previous_knots_ * knot_dimension_;
+	feedforward_.assign(horizon_, Eigen::VectorXd::Zero(knot_dimension_));
+	feedback_.assign(horizon_, Eigen::MatrixXd::Zero(knot_dimension_, state_dimension));
+	knot_gradients_.resize(horizon_);
+	knot_hessians_.resize(horizon_);
+
+	return true;
+}
+
+
+bool DifferentialDynamicProgramming::compute(double allocated_time_secs)
+{
+	if (oc_model_ == NULL) {
+		printf(RED "FATAL: the DDP solver was not initialized\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	// Setting the initial time
+	std::chrono::steady_clock::time_point started_time = std::chrono::steady_clock::now();
+
+	// Getting the starting point and multipliers, which are the shifted last solution in
+	// receding-horizon optimization
+	Eigen::VectorXd bound_lower_mult(decision_dimension_);
+	Eigen::VectorXd bound_upper_mult(decision_dimension_);
+	oc_model_->getStartingPoint(decision_.data(), decision_dimension_);
+	if (!oc_model_->getStartingMultipliers(bound_lower_mult.data(), bound_upper_mult.data(),
+										   decision_dimension_,
+										   multipliers_.data(), constraint_dimension_))
+		multipliers_.setZero();
+	decision_ = decision_.cwiseMax(decision_lower_bound_).cwiseMin(decision_upper_bound_);
+
+	// Computing the augmented Lagrangian iterations
+	penalty_ = initial_penalty_;
+	regularization_ = 1e-6;
+	double merit = evaluateMerit(decision_);
+	double last_violation = computeConstraintViolation(decision_);
+	bool solved = false;
+	Eigen::VectorXd new_decision;
+	for (int iter = 0; max_iter_ == -1 || iter < max_iter_; iter++) {
+		// Checking the allocated time
+		double duration_secs = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - started_time).count();
+		if (duration_secs > allocated_time_secs)
+			break;
+
+		// Computing the Riccati recursion. The regularization is increased until the Hessian
+		// of the controls is positive definite
+		computeDerivatives();
+		while (!backwardPass()) {
+			regularization_ *= 10.;
+			if (regularization_ > 1e10)
+				break;
+		}
+		if (regularization_ > 1e10) {
+			printf(YELLOW "Warning: the Riccati recursion could not be regularized\n" COLOR_RESET);
+			break;
+		}
+
+		// Computing a backtracking line search of the forward pass
+		bool accepted = false;
+		double new_merit = merit;
+		for (double step_length = 1.; step_length > 1e-4; step_length *= 0.5) {
+			forwardPass(new_decision, step_length);
+			new_merit = evaluateMerit(new_decision);
+			if (new_merit < merit) {
+				accepted = true;
+				break;
+			}
+		}
+
+		// Computing the maximum feedforward step
+		double max_step = 0.;
+		for (unsigned int k = 0; k < horizon_; k++)
+			max_step = std::max(max_step, feedforward_[k].lpNorm<Eigen::Infinity>());
+
+		double reduction = 0.;
+		if (accepted) {
+			reduction = merit - new_merit;
+			decision_ = new_decision;
+			merit = new_merit;
+			regularization_ = std::max(regularization_ / 10., 1e-9);
+		} else
+			regularization_ *= 10.;
+
+		// Updating the multipliers and penalty when the Riccati iterations have converged
+		bool converged = (accepted && reduction < convergence_tol_ * (1. + fabs(merit))) ||
+				max_step < convergence_tol_ || (!accepted && regularization_ > 1e10);
+		if (converged) {
+			double violation = computeConstraintViolation(decision_);
+			if (violation <= constr_viol_tol_) {
+				solved = true;
+				break;
+			}
+
+			// Updating the multipliers with the first-order rule
+			if (constraint_dimension_ != 0) {
+				Eigen::VectorXd constraint(constraint_dimension_), active_penalty;
+				oc_model_->evaluateConstraints(constraint.data(), constraint_dimension_,
+											   decision_.data(), decision_dimension_);
+				computeMultiplierEstimation(multipliers_, active_penalty, constraint, 0);
+			}
+
+			// Increasing the penalty if the violation was not reduced enough
+			if (violation > 0.25 * last_violation)
+				penalty_ *= 10.;
+			last_violation = violation;
+			regularization_ = std::min(regularization_, 1e-6);
+			merit = evaluateMerit(decision_);
+		}
+	}
+
+	if (solved) {
+		solution_ = decision_;
+
+		// Setting the solution to the model for warm-starting the next optimization
+		bound_lower_mult.setZero();
+		bound_upper_mult.setZero();
+		oc_model_->setSolution(decision_.data(),
+							   bound_lower_mult.data(), bound_upper_mult.data(),
+							   decision_dimension_,
+							   multipliers_.data(), constraint_dimension_);
+	} else
+		printf("\n\n*** The problem FAILED!\n");
+
+	return solved;
+}
+
+
+void DifferentialDynamicProgramming::computeDerivatives()
+{
+	// Computing the knot times once per iteration, so each knot evaluation doesn't depend on
+	// the horizon length
+	oc_model_->evaluateKnotTimes(knot_times_, decision_);
+	perturbed_times_ = knot_times_;
+
+	for (unsigned int k = 0; k < horizon_; k++)
+		computeKnotDerivatives(knot_gradients_[k], knot_hessians_[k], k);
+}
+
+
+void DifferentialDynamicProgramming::computeKnotDerivatives(Eigen::VectorXd& gradient,
+															Eigen::MatrixXd& hessian,
+															unsigned int knot)
+{
+	// The local variables are the previous knots used by the transcription (i.e. the state of
+	// the Riccati recursion), followed by the knot itself (i.e. the control). Note that the
+	// knots before the horizon are not decision variables, so their derivatives are zero
+	unsigned int dimension = (num_previous_knots_ + 1) * knot_dimension_;
+	gradient = Eigen::VectorXd::Zero(dimension);
+	hessian = Eigen::MatrixXd::Zero(dimension, dimension);
+	std::vector<unsigned int> cols, indexes;
+	for (unsigned int b = 0; b < num_previous_knots_ + 1; b++) {
+		int coupled_knot = (int) knot - (int) num_previous_knots_ + (int) b;
+		if (coupled_knot < 0)
+			continue;
+
+		for (unsigned int i = 0; i < knot_dimension_; i++) {
+			cols.push_back(b * knot_dimension_ + i);
+			indexes.push_back(coupled_knot * knot_dimension_ + i);
+		}
+	}
+
+	// Computing the nominal cost and constraints of the knot
+	Eigen::VectorXd constraint;
+	computeKnotConstraints(constraint, decision_, knot_times_, knot);
+	double cost = oc_model_->evaluateCostAtKnot(decision_, knot_times_, knot);
+
+	// Computing the gradient and constraint Jacobian by central finite differences
+	unsigned int num_variables = cols.size();
+	Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(constraint.size(), dimension);
+	Eigen::VectorXd point = decision_;
+	Eigen::VectorXd forward_constraint, backward_constraint;
+	for (unsigned int v = 0; v < num_variables; v++) {
+		unsigned int col = cols[v], idx = indexes[v];
+		double step = fd_step_ * std::max(1., fabs(decision_(idx)));
+
+		perturbVariable(point, idx, step, knot);
+		computeKnotConstraints(forward_constraint, point, perturbed_times_, knot);
+		double forward_cost = oc_model_->evaluateCostAtKnot(point, perturbed_times_, knot);
+		restoreVariables(point, knot);
+
+		perturbVariable(point, idx, -step, knot);
+		computeKnotConstraints(backward_constraint, point, perturbed_times_, knot);
+		double backward_cost = oc_model_->evaluateCostAtKnot(point, perturbed_times_, knot);
+		restoreVariables(point, knot);
+
+		jacobian.col(col) = (forward_constraint - backward_constraint) / (2 * step);
+		gradient(col) = (forward_cost - backward_cost) / (2 * step);
+	}
+
+	// Computing the cost Hessian, including the cross terms between the variables, by forward
+	// finite differences, i.e. (f(x+h_i+h_j) - f(x+h_i) - f(x+h_j) + f(x)) / (h_i h_j)
+	Eigen::VectorXd steps(num_variables), shifted_costs(num_variables);
+	for (unsigned int v = 0; v < num_variables; v++) {
+		steps(v) = hessian_step_ * std::max(1., fabs(decision_(indexes[v])));
+		perturbVariable(point, indexes[v], steps(v), knot);
+		shifted_costs(v) = oc_model_->evaluateCostAtKnot(point, perturbed_times_, knot);
+		restoreVariables(point, knot);
+	}
+	for (unsigned int v = 0; v < num_variables; v++) {
+		for (unsigned int w = 0; w <= v; w++) {
+			perturbVariable(point, indexes[v], steps(v), knot);
+			perturbVariable(point, indexes[w], steps(w), knot);
+			double shifted_cost = oc_model_->evaluateCostAtKnot(point, perturbed_times_, knot);
+			restoreVariables(point, knot);
+
+			double value = (shifted_cost - shifted_costs(v) - shifted_costs(w) + cost) /
+					(steps(v) * steps(w));
+			hessian(cols[v],cols[w]) = value;
+			hessian(cols[w],cols[v]) = value;
+		}
+	}
+
+	// Projecting the cost Hessian onto the positive semidefinite matrices, which keeps the
+	// cross terms and avoids the negative curvature in the Riccati recursion
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_solver(hessian);
+	hessian = eigen_solver.eigenvectors() *
+			eigen_solver.eigenvalues().cwiseMax(0.).asDiagonal() *
+			eigen_solver.eigenvectors().transpose();
+
+	// Adding the augmented Lagrangian terms of the constraints. Note that the terminal
+	// constraint follows the constraints of the last knot in the full constraint vector
+	if (constraint.size() != 0) {
+		Eigen::VectorXd estimation, active_penalty;
+		computeMultiplierEstimation(estimation, active_penalty, constraint,
+									knot * knot_constraint_dimension_);
+		gradient += jacobian.transpose() * estimation;
+		hessian += jacobian.transpose() * active_penalty.asDiagonal() * jacobian;
+	}
+}
+
+
+void DifferentialDynamicProgramming::computeKnotConstraints(Eigen::VectorXd& constraint,
+															const Eigen::VectorXd& decision,
+															const Eigen::VectorXd& knot_times,
+															unsigned int knot)
+{
+	oc_model_->evaluateConstraintsAtKnot(constraint, decision, knot_times, knot);
+
+	// Appending the terminal constraint to the last knot
+	if (knot == horizon_ - 1 && oc_model_->getDynamicalSystem()->isFullTrajectoryOptimization()) {
+		Eigen::VectorXd terminal_constraint;
+		oc_model_->evaluateTerminalConstraint(terminal_constraint, decision, knot_times);
+
+		unsigned int knot_dimension = constraint.size();
+		constraint.conservativeResize(knot_dimension + terminal_constraint.size());
+		constraint.tail(terminal_constraint.size()) = terminal_constraint;
+	}
+}
+
+
+void DifferentialDynamicProgramming::perturbVariable(Eigen::VectorXd& point,
+													 unsigned int idx,
+													 double perturbation,
+													 unsigned int knot)
+{
+	point(idx) += perturbation;
+
+	// The step time of a knot shifts the accumulated time of the next knots
+	if (variable_step_ && idx % knot_dimension_ == 0) {
+		unsigned int perturbed_knot = idx / knot_dimension_;
+		perturbed_times_.segment(perturbed_knot, knot - perturbed_knot + 1).array() +=
+				perturbation;
+	}
+}
+
+
+void DifferentialDynamicProgramming::restoreVariables(Eigen::VectorXd& point,
+													  unsigned int knot)
+{
+	unsigned int first_knot = 0;
+	if (knot > num_previous_knots_)
+		first_knot = knot - num_previous_knots_;
+	unsigned int num_knots = knot - first_knot + 1;
+
+	point.segment(first_knot * knot_dimension_, num_knots * knot_dimension_) =
+			decision_.segment(first_knot * knot_dimension_, num_knots * knot_dimension_);
+	perturbed_times_.segment(first_knot, num_knots) = knot_times_.segment(first_knot, num_knots);
+}
+
+
+bool DifferentialDynamicProgramming::backwardPass()
+{
+	// The state of the recursion is given by the previous knots, so the next state is the last
+	// part of the local variables [x_k, u_k], i.e. the dynamics is a shift of the knots
+	unsigned int state_dimension = num_previous_knots_ * knot_dimension_;
+	Eigen::VectorXd value_gradient = Eigen::VectorXd::Zero(state_dimension);
+	Eigen::MatrixXd value_hessian = Eigen::MatrixXd::Zero(state_dimension, state_dimension);
+	for (int k = horizon_ - 1; k >= 0; k--) {
+		// Computing the quadratic approximation of the action-value function
+		Eigen::VectorXd Q_w = knot_gradients_[k];
+		Eigen::MatrixXd Q_ww = knot_hessians_[k];
+		Q_w.tail(state_dimension) += value_gradient;
+		Q_ww.bottomRightCorner(state_dimension, state_dimension) += value_hessian;
+
+		Eigen::VectorXd Q_x = Q_w.head(state_dimension);
+		Eigen::VectorXd Q_u = Q_w.tail(knot_dimension_);
+		Eigen::MatrixXd Q_xx = Q_ww.topLeftCorner(state_dimension, state_dimension);
+		Eigen::MatrixXd Q_uu = Q_ww.bottomRightCorner(knot_dimension_, knot_dimension_);
+		Eigen::MatrixXd Q_ux = Q_ww.bottomLeftCorner(knot_dimension_, state_dimension);
+
+		// Getting the free controls, i.e. the ones that are not at a bound and pushed outside
+		Eigen::VectorXd& feedforward = feedforward_[k];
+		Eigen::MatrixXd& feedback = feedback_[k];
+		feedforward.setZero();
+		feedback.setZero();
+		std::vector<unsigned int> free_controls;
+		for (unsigned int i = 0; i < knot_dimension_; i++) {
+			unsigned int idx = k * knot_dimension_ + i;
+			bool lower_active = decision_(idx) <= decision_lower_bound_(idx) && Q_u(i) > 0.;
+			bool upper_active = decision_(idx) >= decision_upper_bound_(idx) && Q_u(i) < 0.;
+			if (!lower_active && !upper_active)
+				free_controls.push_back(i);
+		}
+
+		// Computing the gains of the free controls
+		unsigned int num_free = free_controls.size();
+		if (num_free != 0) {
+			Eigen::MatrixXd Q_uu_free(num_free, num_free);
+			Eigen::MatrixXd rhs(num_free, 1 + state_dimension);
+			for (unsigned int i = 0; i < num_free; i++) {
+				for (unsigned int j = 0; j < num_free; j++)
+					Q_uu_free(i,j) = Q_uu(free_controls[i], free_controls[j]);
+				Q_uu_free(i,i) += regularization_;
+				rhs(i,0) = Q_u(free_controls[i]);
+				rhs.block(i, 1, 1, state_dimension) = Q_ux.row(free_controls[i]);
+			}
+
+			Eigen::LLT<Eigen::MatrixXd> llt(Q_uu_free);
+			if (llt.info() != Eigen::Success)
+				return false;
+
+			Eigen::MatrixXd gains = -llt.solve(rhs);
+			for (unsigned int i = 0; i < num_free; i++) {
+				feedforward(free_controls[i]) = gains(i,0);
+				feedback.row(free_controls[i]) = gains.block(i, 1, 1, state_dimension);
+			}
+		}
+
+		// Computing the quadratic approximation of the value function
+		value_gradient = Q_x + feedback.transpose() * Q_uu * feedforward +
+				feedback.transpose() * Q_u + Q_ux.transpose() * feedforward;
+		value_hessian = Q_xx + feedback.transpose() * Q_uu * feedback +
+				feedback.transpose() * Q_ux + Q_ux.transpose() * feedback;
+		value_hessian = 0.5 * (value_hessian + value_hessian.transpose());
+	}
+
+	return true;
+}
+
+
+void DifferentialDynamicProgramming::forwardPass(Eigen::VectorXd& new_decision,
+												 double step_length)
+{
+	unsigned int state_dimension = num_previous_knots_ * knot_dimension_;
+	Eigen::VectorXd state_deviation(state_dimension);
+	new_decision = decision_;
+	for (unsigned int k = 0; k < horizon_; k++) {
+		// Computing the deviation of the previous knots
+		state_deviation.setZero();
+		for (unsigned int b = 0; b < num_previous_knots_; b++) {
+			int previous_knot = (int) k - (int) num_previous_knots_ + (int) b;
+			if (previous_knot < 0)
+				continue;
+
+			unsigned int idx = previous_knot * knot_dimension_;
+			state_deviation.segment(b * knot_dimension_, knot_dimension_) =
+					new_decision.segment(idx, knot_dimension_) -
+					decision_.segment(idx, knot_dimension_);
+		}
+
+		// Applying the gains and projecting onto the bounds
+		unsigned int idx = k * knot_dimension_;
+		new_decision.segment(idx, knot_dimension_) = (decision_.segment(idx, knot_dimension_) +
+				step_length * feedforward_[k] + feedback_[k] * state_deviation).cwiseMax(
+						decision_lower_bound_.segment(idx, knot_dimension_)).cwiseMin(
+								decision_upper_bound_.segment(idx, knot_dimension_));
+	}
+}
+
+
+double DifferentialDynamicProgramming::evaluateMerit(const Eigen::VectorXd& decision)
+{
+	double merit;
+	oc_model_->evaluateCosts(merit, decision.data(), decision_dimension_);
+
+	// Adding the augmented Lagrangian of the hard constraints, i.e.
+	// rho/2 |c + lambda/rho - P(c + lambda/rho)|^2 - |lambda|^2/(2 rho)
+	if (constraint_dimension_ != 0) {
+		Eigen::VectorXd constraint(constraint_dimension_);
+		oc_model_->evaluateConstraints(constraint.data(), constraint_dimension_,
+									   decision.data(), decision_dimension_);
+
+		for (unsigned int i = 0; i < constraint_dimension_; i++) {
+			double shifted = constraint(i) + multipliers_(i) / penalty_;
+			double projected = std::min(std::max(shifted, constraint_lower_bound_(i)),
+										constraint_upper_bound_(i));
+			merit += 0.5 * penalty_ * (shifted - projected) * (shifted - projected) -
+					0.5 * multipliers_(i) * multipliers_(i) / penalty_;
+		}
+	}
+
+	return merit;
+}
+
+
+void DifferentialDynamicProgramming::computeMultiplierEstimation(Eigen::VectorXd& estimation,
+																 Eigen::VectorXd& active_penalty,
+																 const Eigen::VectorXd& constraint,
+																 unsigned int index)
+{
+	unsigned int dimension = constraint.size();
+	estimation.resize(dimension);
+	active_penalty.resize(dimension);
+	for (unsigned int i = 0; i < dimension; i++) {
+		double lower_bound = constraint_lower_bound_(index + i);
+		double upper_bound = constraint_upper_bound_(index + i);
+		double shifted = constraint(i) + multipliers_(index + i) / penalty_;
+		double projected = std::min(std::max(shifted, lower_bound), upper_bound);
+
+		// The equality constraints are always active
+		estimation(i) = penalty_ * (shifted - projected);
+		if (lower_bound == upper_bound || shifted < lower_bound || shifted > upper_bound)
+			active_penalty(i) = penalty_;
+		else
+			active_penalty(i) = 0.;
+	}
+}
+
+
+double DifferentialDynamicProgramming::computeConstraintViolation(const Eigen::VectorXd& decision)
+{
+	if (constraint_dimension_ == 0)
+		return 0.;
+
+	Eigen::VectorXd constraint(constraint_dimension_);
+	oc_model_->evaluateConstraints(constraint.data(), constraint_dimension_,
+								   decision.data(), decision_dimension_);
+
+	double violation = 0.;
+	for (unsigned int i = 0; i < constraint_dimension_; i++) {
+		violation = std::max(violation, constraint_lower_bound_(i) - constraint(i));
+		violation = std::max(violation, constraint(i) - constraint_upper_bound_(i));
+	}
+
+	return violation;
+}
+
+} //@namespace solver
+} //@namespace dwl
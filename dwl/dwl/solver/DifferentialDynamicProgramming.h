@@ -0,0 +1,251 @@
+#ifndef DWL__SOLVER__DIFFERENTIAL_DYNAMIC_PROGRAMMING__H
+#define DWL__SOLVER__DIFFERENTIAL_DYNAMIC_PROGRAMMING__H
+
+#include <dwl/solver/OptimizationSolver.h>
+#include <dwl/ocp/OptimalControl.h>
+#include <chrono>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class DifferentialDynamicProgramming
+ * @brief Solves optimal control problems through an iterative LQR (Gauss-Newton DDP) with
+ * augmented Lagrangian. The knot decision variables are the controls of the Riccati recursion,
+ * and its state is given by the previous knots used by the transcription, so the dynamics is a
+ * shift of the knots. This exploits the stage-wise structure of the problem, i.e. the computation
+ * scales linearly with the horizon. The hard constraints are handled by an augmented Lagrangian,
+ * and the bounds of the decision variables by projection in the forward pass. The derivatives of
+ * each knot are computed by finite differences of the knot cost and constraints, where the cost
+ * Hessian (with its cross terms) is projected onto the positive semidefinite matrices
+ */
+class DifferentialDynamicProgramming : public OptimizationSolver
+{
+	public:
+		/** @brief Constructor function */
+		DifferentialDynamicProgramming();
+
+		/** @brief Destructor function */
+		~DifferentialDynamicProgramming();
+
+		/**
+		 * @brief Sets the DDP configuration parameters from a yaml file
+		 * @param std::string Filename
+		 */
+		void setFromConfigFile(std::string filename);
+
+		/**
+		 * @brief Sets the maximum allocated number of iterations
+		 * @param int Maximum number of iterations
+		 */
+		void setMaxIteration(int max_iter);
+
+		/**
+		 * @brief Sets the convergence tolerance of the Riccati iterations, i.e. of the feedforward
+		 * step and relative cost reduction
+		 * @param double Convergence tolerance
+		 */
+		void setConvergenceTolerance(double tolerance);
+
+		/**
+		 * @brief Sets the constraint violation tolerance
+		 * @param double Tolerance value
+		 */
+		void setConstraintViolationTolerance(double tolerance);
+
+		/**
+		 * @brief Sets the initial penalty of the augmented Lagrangian
+		 * @param double Penalty value
+		 */
+		void setInitialPenalty(double penalty);
+
+		/**
+		 * @brief Initialization of the DDP solver
+		 * @return True if was initialized
+		 */
+		bool init();
+
+		/**
+		 * @brief Computes a solution of the optimal control problem given a computation time.
+		 * It starts from the starting point and multipliers of the model, so the shifted last
+		 * solution is used as warm start
+		 * @param double Allocated computation time in seconds
+		 * @return True if it was computed a solution
+		 */
+		bool compute(double allocated_time_secs = std::numeric_limits<double>::max());
+
+
+	private:
+		/** @brief Computes the quadratic approximation of every knot */
+		void computeDerivatives();
+
+		/**
+		 * @brief Computes the quadratic approximation of the augmented Lagrangian of a knot
+		 * w.r.t. the coupled knots, i.e. the previous knots and the knot itself
+		 * @param Eigen::VectorXd& Gradient
+		 * @param Eigen::MatrixXd& Gauss-Newton Hessian
+		 * @param unsigned int Knot index
+		 */
+		void computeKnotDerivatives(Eigen::VectorXd& gradient,
+									Eigen::MatrixXd& hessian,
+									unsigned int knot);
+
+		/**
+		 * @brief Computes the hard constraints of a knot, and the terminal constraint in the last
+		 * knot
+		 * @param Eigen::VectorXd& Constraint vector
+		 * @param const Eigen::VectorXd& Decision vector
+		 * @param const Eigen::VectorXd& Accumulated time of each knot
+		 * @param unsigned int Knot index
+		 */
+		void computeKnotConstraints(Eigen::VectorXd& constraint,
+									const Eigen::VectorXd& decision,
+									const Eigen::VectorXd& knot_times,
+									unsigned int knot);
+
+		/**
+		 * @brief Perturbs a decision variable coupled with a knot. The perturbation of a step
+		 * time also shifts the time of the next knots until the given one
+		 * @param Eigen::VectorXd& Perturbed decision vector
+		 * @param unsigned int Index of the decision variable
+		 * @param double Perturbation
+		 * @param unsigned int Knot index
+		 */
+		void perturbVariable(Eigen::VectorXd& point,
+							 unsigned int idx,
+							 double perturbation,
+							 unsigned int knot);
+
+		/**
+		 * @brief Restores the decision variables and times coupled with a knot
+		 * @param Eigen::VectorXd& Perturbed decision vector
+		 * @param unsigned int Knot index
+		 */
+		void restoreVariables(Eigen::VectorXd& point,
+							  unsigned int knot);
+
+		/**
+		 * @brief Computes the Riccati recursion, i.e. the feedforward and feedback gains
+		 * @return True if the recursion succeeded with the current regularization
+		 */
+		bool backwardPass();
+
+		/**
+		 * @brief Rolls out the gains with a certain step length, and projects the decision
+		 * variables onto their bounds
+		 * @param Eigen::VectorXd& New decision vector
+		 * @param double Step length
+		 */
+		void forwardPass(Eigen::VectorXd& new_decision,
+						 double step_length);
+
+		/**
+		 * @brief Evaluates the augmented Lagrangian of the problem
+		 * @param const Eigen::VectorXd& Decision vector
+		 * @return double Merit value
+		 */
+		double evaluateMerit(const Eigen::VectorXd& decision);
+
+		/**
+		 * @brief Computes the augmented Lagrangian multipliers of a set of constraints, i.e.
+		 * $\hat{\lambda} = \rho (c + \lambda / \rho - \Pi(c + \lambda / \rho))$ where $\Pi$ is
+		 * the projection onto the constraint bounds
+		 * @param Eigen::VectorXd& Multiplier estimation
+		 * @param Eigen::VectorXd& Active penalties (zero in inactive inequalities)
+		 * @param const Eigen::VectorXd& Constraint values
+		 * @param unsigned int Index of the first constraint in the full constraint vector
+		 */
+		void computeMultiplierEstimation(Eigen::VectorXd& estimation,
+										 Eigen::VectorXd& active_penalty,
+										 const Eigen::VectorXd& constraint,
+										 unsigned int index);
+
+		/**
+		 * @brief Computes the maximum violation of the hard constraints
+		 * @param const Eigen::VectorXd& Decision vector
+		 * @return double Maximum violation
+		 */
+		double computeConstraintViolation(const Eigen::VectorXd& decision);
+
+		/** @brief Optimal control model */
+		ocp::OptimalControl* oc_model_;
+
+		/** @brief Number of knots */
+		unsigned int horizon_;
+
+		/** @brief Number of previous knots used by the transcription */
+		unsigned int num_previous_knots_;
+
+		/** @brief Dimension of the decision variables of each knot */
+		unsigned int knot_dimension_;
+
+		/** @brief Dimension of the hard constraints of each knot */
+		unsigned int knot_constraint_dimension_;
+
+		/** @brief Dimension of the decision and constraint vectors of the horizon */
+		unsigned int decision_dimension_;
+		unsigned int constraint_dimension_;
+
+		/** @brief Current decision vector */
+		Eigen::VectorXd decision_;
+
+		/**
+		 * @brief Accumulated time of each knot of the current decision vector, which is computed
+		 * once per iteration, and its perturbed copy
+		 */
+		Eigen::VectorXd knot_times_;
+		Eigen::VectorXd perturbed_times_;
+
+		/** @brief Indicates if the step time is the first decision variable of each knot */
+		bool variable_step_;
+
+		/** @brief Bounds of the decision variables */
+		Eigen::VectorXd decision_lower_bound_;
+		Eigen::VectorXd decision_upper_bound_;
+
+		/** @brief Bounds of the constraints */
+		Eigen::VectorXd constraint_lower_bound_;
+		Eigen::VectorXd constraint_upper_bound_;
+
+		/** @brief Multipliers of the constraints */
+		Eigen::VectorXd multipliers_;
+
+		/** @brief Penalty of the augmented Lagrangian */
+		double penalty_;
+
+		/** @brief Feedforward and feedback gains of each knot */
+		std::vector<Eigen::VectorXd> feedforward_;
+		std::vector<Eigen::MatrixXd> feedback_;
+
+		/** @brief Gradient and Gauss-Newton Hessian of each knot w.r.t. its coupled knots */
+		std::vector<Eigen::VectorXd> knot_gradients_;
+		std::vector<Eigen::MatrixXd> knot_hessians_;
+
+		/** @brief Levenberg-Marquardt regularization of the Riccati recursion */
+		double regularization_;
+
+		/** @brief Maximum number of iterations */
+		int max_iter_;
+
+		/** @brief Convergence tolerance */
+		double convergence_tol_;
+
+		/** @brief Constraint violation tolerance */
+		double constr_viol_tol_;
+
+		/** @brief Initial penalty of the augmented Lagrangian */
+		double initial_penalty_;
+
+		/** @brief Step sizes of the finite differences of the first and second derivatives */
+		double fd_step_;
+		double hessian_step_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
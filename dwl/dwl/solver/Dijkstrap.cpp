@@ -7,7 +7,7 @@ namespace dwl
 namespace solver
 {
 
-Dijkstrap::Dijkstrap() : expansions_(0)
+Dijkstrap::Dijkstrap()
 {
 	name_ = "Dijkstrap";
 }
@@ -44,65 +44,60 @@ bool Dijkstrap::compute(Vertex source,
 	adjacency_->computeAdjacencyMap(adjacency_map, source, target);
 
 	// Computing the shortest path
-	findShortestPath(source, target, adjacency_map);
-
-	return true;
+	return findShortestPath(source, target, adjacency_map);
 }
 
 
-void Dijkstrap::findShortestPath(Vertex source,
+bool Dijkstrap::findShortestPath(Vertex source,
 								 Vertex target,
-								 AdjacencyMap adjacency_map)
+								 AdjacencyMap& adjacency_map)
 {
-	// Defining the minimum cost
-	CostMap min_cost;
-
-	for (AdjacencyMap::iterator vertex_iter = adjacency_map.begin();
-		vertex_iter != adjacency_map.end();
-		vertex_iter++)
-	{
-		Vertex v = vertex_iter->first;
-		min_cost[v] = std::numeric_limits<double>::infinity();
-	}
+	// Number of expansions
+	expansions_ = 0;
 
-	min_cost[source] = 0;
-	std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > vertex_queue;
-	for (AdjacencyMap::iterator vertex_iter = adjacency_map.begin();
-		vertex_iter != adjacency_map.end();
-		vertex_iter++)
-	{
-		Vertex v = vertex_iter->first;
-		vertex_queue.insert(std::pair<Weight, Vertex>(min_cost[v], v));
-	}
+	// Clearing the nodes of the previous search but keeping their memory. The vertices are
+	// queued when they are reached, which avoids to queue the whole adjacency map
+	nodes_.clear();
+	nodes_.reserve(adjacency_map.size());
+	openset_.clear();
+
+	unsigned int source_slot = nodes_.getSlot(source);
+	nodes_[source_slot].g_cost = 0;
+	openset_.push(source_slot, SearchKey(0.));
 
-	while (!vertex_queue.empty()) {
-		Vertex current = vertex_queue.begin()->second;
-		vertex_queue.erase(vertex_queue.begin());
+	total_cost_ = std::numeric_limits<double>::max();
+	while (!openset_.empty()) {
+		unsigned int current = openset_.pop();
+		Vertex current_vertex = nodes_[current].vertex;
+		nodes_[current].state = CLOSED;
 
 		// Checking if it is get the target
-		if (adjacency_->isReachedGoal(target, current)) {
-			policy_[target] = current;
-			min_cost[target] = min_cost[current];
-			break;
+		if (adjacency_->isReachedGoal(target, current_vertex)) {
+			setPolicy(current, target);
+			total_cost_ = nodes_[current].g_cost;
+			return true;
 		}
 
 		// Visit each edge exiting u
-		for (std::list<Edge>::iterator edge_iter = adjacency_map[current].begin();
-			edge_iter != adjacency_map[current].end();
-			edge_iter++)
-		{
-			Vertex neighbor = edge_iter->target;
-			Weight weight = edge_iter->weight;
-			Weight distance_through_current = min_cost[current] + weight;
-			if (distance_through_current < min_cost[neighbor]) {
-				vertex_queue.erase(std::pair<Weight, Vertex>(min_cost[neighbor], neighbor));
-
-				min_cost[neighbor] = distance_through_current;
-				policy_[neighbor] = current;
-				vertex_queue.insert(std::pair<Weight, Vertex>(min_cost[neighbor], neighbor));
+		AdjacencyMap::iterator adjacency_iter = adjacency_map.find(current_vertex);
+		if (adjacency_iter == adjacency_map.end())
+			continue;
+
+		Weight current_cost = nodes_[current].g_cost;
+		for (std::list<Edge>::iterator edge_iter = adjacency_iter->second.begin();
+				edge_iter != adjacency_iter->second.end(); edge_iter++) {
+			unsigned int neighbor = nodes_.getSlot(edge_iter->target);
+			Weight distance_through_current = current_cost + edge_iter->weight;
+			if (distance_through_current < nodes_[neighbor].g_cost) {
+				nodes_[neighbor].g_cost = distance_through_current;
+				nodes_[neighbor].parent = current;
+				openset_.push(neighbor, SearchKey(distance_through_current));
 			}
 		}
+		expansions_++;
 	}
+
+	return false;
 }
 
 } //@namespace solver
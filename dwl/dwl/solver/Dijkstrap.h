@@ -46,14 +46,13 @@ class Dijkstrap : public SearchTreeSolver
 		 * @brief Computes the minimum cost and previous vertex according to the shortest
 		 * Dijkstrap path
 		 * @param Vertex Source vertex
-		 * @param AdjacencyMap Adjacency map
+		 * @param Vertex Target vertex
+		 * @param AdjacencyMap& Adjacency map
+		 * @return True if the target was reached
 		 */
-		void findShortestPath(Vertex source,
+		bool findShortestPath(Vertex source,
 							  Vertex target,
-							  AdjacencyMap adjacency_map);
-
-		/** @brief number of expansions */
-		int expansions_;
+							  AdjacencyMap& adjacency_map);
 };
 
 } //@namespace solver
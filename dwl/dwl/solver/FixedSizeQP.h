@@ -0,0 +1,148 @@
+#ifndef DWL__SOLVER__FIXED_SIZE_QP__H
+#define DWL__SOLVER__FIXED_SIZE_QP__H
+
+#include <dwl/utils/ThreadPool.h>
+#include <Eigen/Dense>
+#include <vector>
+#include <limits>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class FixedSizeQP
+ * @brief Solves small QPs of compile-time dimensions, e.g. the distribution of the base wrench
+ * to the feet, with the dual active-set method of Goldfarb and Idnani (1983: "A numerically
+ * stable dual method for solving strictly convex quadratic programs"). All the matrices are
+ * fixed-size (or bounded by the number of variables), so the solution doesn't allocate memory
+ * and avoids the overhead of the generic QuadraticProgram interface. Many independent
+ * instances can be solved in a batch, optionally with a thread pool. The QP has the form
+ * \f[
+ * 	\min_{\mathbf{x}} \frac{1}{2}\mathbf{x}^T\mathbf{H}\mathbf{x} + \mathbf{x}^T\mathbf{g}
+ * \f]
+ * suject to
+ * \f{eqnarray*}{
+ *	lbG \leq &\mathbf{Gx}& \leq ubG \\
+ *	lb   \leq &\mathbf{x}&  \leq ub
+ * \f}
+ * where the Hessian has to be positive definite, equal bounds define equality constraints and
+ * infinite bounds are ignored
+ */
+template <int NumVariables, int NumConstraints>
+class FixedSizeQP
+{
+	public:
+		typedef Eigen::Matrix<double, NumVariables, NumVariables> HessianMatrix;
+		typedef Eigen::Matrix<double, NumVariables, 1> VariableVector;
+		typedef Eigen::Matrix<double, NumConstraints, NumVariables> ConstraintMatrix;
+		typedef Eigen::Matrix<double, NumConstraints, 1> ConstraintVector;
+
+		/** @brief Data of a QP instance */
+		struct Problem
+		{
+			HessianMatrix hessian;
+			VariableVector gradient;
+			ConstraintMatrix constraint_mat;
+			ConstraintVector lower_constraint;
+			ConstraintVector upper_constraint;
+			VariableVector lower_bound;
+			VariableVector upper_bound;
+
+			EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+		};
+
+		/** @brief Constructor function */
+		FixedSizeQP();
+
+		/** @brief Destructor function */
+		~FixedSizeQP();
+
+		/**
+		 * @brief Sets the maximum number of active-set iterations
+		 * @param unsigned int Maximum number of iterations
+		 */
+		void setMaxIteration(unsigned int max_iter);
+
+		/**
+		 * @brief Sets the tolerance of the constraint violation
+		 * @param double Tolerance
+		 */
+		void setTolerance(double tolerance);
+
+		/**
+		 * @brief Solves a QP instance. This function is thread-safe
+		 * @param VariableVector& Solution
+		 * @param const Problem& QP instance
+		 * @return bool True if the QP was solved
+		 */
+		bool solve(VariableVector& solution,
+				   const Problem& problem) const;
+
+		/**
+		 * @brief Solves a batch of independent QP instances. The Hessian is factorized only once
+		 * if it's shared by all the instances
+		 * @param std::vector<VariableVector>& Solutions
+		 * @param std::vector<bool>& Labels that indicate if each QP was solved
+		 * @param const std::vector<Problem>& QP instances
+		 * @param utils::ThreadPool* Thread pool (NULL for solving them sequentially)
+		 * @return unsigned int Number of solved QPs
+		 */
+		unsigned int solveBatch(std::vector<VariableVector,
+										Eigen::aligned_allocator<VariableVector> >& solutions,
+								std::vector<bool>& success,
+								const std::vector<Problem, Eigen::aligned_allocator<Problem> >& problems,
+								utils::ThreadPool* pool = NULL) const;
+
+
+	private:
+		/**
+		 * @brief Solves a QP instance given the factorization of its Hessian
+		 * @param VariableVector& Solution
+		 * @param const Problem& QP instance
+		 * @param const HessianMatrix& Inverse of the transposed Cholesky factor, i.e. L^-T
+		 * @return bool True if the QP was solved
+		 */
+		bool solve(VariableVector& solution,
+				   const Problem& problem,
+				   const HessianMatrix& inverse_factor) const;
+
+		/** @brief Vector bounded by the number of variables (i.e. the active set size) */
+		typedef Eigen::Matrix<double, Eigen::Dynamic, 1, 0, NumVariables, 1> ActiveVector;
+
+		/**
+		 * @brief Gets a one-sided constraint row, i.e. n^T x >= d, where the rows are ordered as
+		 * the lower and upper sides of each constraint, followed by the ones of each bound
+		 * @param VariableVector& Normal of the row
+		 * @param double& Right-hand side of the row
+		 * @param bool& True if the row is an equality
+		 * @param const Problem& QP instance
+		 * @param unsigned int Row index
+		 * @return bool False if the row doesn't constrain the problem (i.e. infinite bound or
+		 * upper side of an equality)
+		 */
+		bool getRow(VariableVector& normal,
+					double& rhs,
+					bool& equality,
+					const Problem& problem,
+					unsigned int row) const;
+
+		/** @brief Number of one-sided rows */
+		static const unsigned int num_rows_ = 2 * (NumConstraints + NumVariables);
+
+		/** @brief Maximum number of iterations */
+		unsigned int max_iter_;
+
+		/** @brief Tolerance of the constraint violation */
+		double tolerance_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#include <dwl/solver/impl/FixedSizeQP.hpp>
+
+#endif
@@ -12,7 +12,8 @@ IpoptNLP::IpoptNLP() : initialized_(false), print_level_(5),
 		file_print_level_(5), convergence_tol_(1e-7), max_iter_(-1),
 		dual_inf_tol_(1.), constr_viol_tol_(0.0001), compl_viol_tol_(0.0001),
 		acceptable_tol_(1e-6), acceptable_iter_(15), mu_strategy_("adaptive"),
-		jac_approximation_(false), hess_approximation_(false)
+		jac_approximation_(false), hess_approximation_(false), warm_start_(false),
+		num_iterations_(0)
 {
 	name_ = "IpoptNLP";
 }
@@ -47,6 +48,7 @@ void IpoptNLP::setFromConfigFile(std::string filename)
 	YamlNamespace termination_ns = {ipopt_ns, "termination"};
 	YamlNamespace barrier_ns = {ipopt_ns, "barrier"};
 	YamlNamespace derivatives_ns = {ipopt_ns, "derivatives"};
+	YamlNamespace initialization_ns = {ipopt_ns, "initialization"};
 
 	// Output parameters
 	// Reading and setting up the print level
@@ -120,6 +122,12 @@ void IpoptNLP::setFromConfigFile(std::string filename)
 	if (yaml_reader.read(hess_approximation_, "hessian_approximation", derivatives_ns))
 		setHessianApproximation(hess_approximation_);
 
+	// Initialization parameters
+	// Reading and setting up the warm start
+	bool warm_start;
+	if (yaml_reader.read(warm_start, "warm_start", initialization_ns))
+		setWarmStart(warm_start);
+
 	// Re-initialization of the solver if it was initialized
 	if (reinit)
 		init();
@@ -251,6 +259,31 @@ void IpoptNLP::setHessianApproximation(bool enable)
 }
 
 
+void IpoptNLP::setWarmStart(bool enable)
+{
+	warm_start_ = enable;
+
+	// The model only starts from its last solution with warm start (or after shifting it)
+	if (model_ != NULL)
+		model_->setWarmStart(warm_start_);
+
+	if (initialized_) {
+		if (warm_start_) {
+			// The starting point is close to the solution, so it's not pushed away from the bounds
+			// and the barrier parameter starts small
+			app_->Options()->SetStringValue("warm_start_init_point", "yes");
+			app_->Options()->SetNumericValue("warm_start_bound_push", 1e-6);
+			app_->Options()->SetNumericValue("warm_start_slack_bound_push", 1e-6);
+			app_->Options()->SetNumericValue("warm_start_mult_bound_push", 1e-6);
+			app_->Options()->SetNumericValue("mu_init", 1e-6);
+		} else {
+			app_->Options()->SetStringValue("warm_start_init_point", "no");
+			app_->Options()->SetNumericValue("mu_init", 0.1);
+		}
+	}
+}
+
+
 bool IpoptNLP::init()
 {
 	// Setting the optimization model to Ipopt wrapper
@@ -298,7 +331,7 @@ bool IpoptNLP::init()
 		app_->Options()->SetStringValue("hessian_approximation", "limited-memory");
 	}
 
-	app_->Options()->SetStringValue("warm_start_init_point", "yes");
+	setWarmStart(warm_start_);
 
 //	app_->Options()->SetNumericValue("dual_inf_tol", 1000);
 //	app_->Options()->SetNumericValue("constr_viol_tol", 0.1);
@@ -327,11 +360,14 @@ bool IpoptNLP::compute(double allocated_time_secs)
 	// Computing the optimization problem
 	bool solved = false;
 	double current_duration_secs = 0;
+	num_iterations_ = 0;
 	while (!solved && (current_duration_secs < allocated_time_secs)) {
 		// Setting the allowed time for this optimization loop
 		double new_allocated_time_secs = allocated_time_secs - current_duration_secs;
 		app_->Options()->SetNumericValue("max_cpu_time", new_allocated_time_secs);
 		status = app_->OptimizeTNLP(nlp_ptr_);
+		if (Ipopt::IsValid(app_->Statistics()))
+			num_iterations_ += app_->Statistics()->IterationCount();
 
 		if (status == Ipopt::Solve_Succeeded || status == Ipopt::Solved_To_Acceptable_Level)
 			solved = true;
@@ -351,5 +387,11 @@ bool IpoptNLP::compute(double allocated_time_secs)
 	return solved;
 }
 
+
+int IpoptNLP::getNumberOfIterations() const
+{
+	return num_iterations_;
+}
+
 } //@namespace solver
 } //@namespace dwl
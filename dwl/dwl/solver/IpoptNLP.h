@@ -113,6 +113,13 @@ class IpoptNLP : public OptimizationSolver
 		 */
 		void setHessianApproximation(bool enable);
 
+		/**
+		 * @brief Enables/disables the warm start, i.e. the optimization starts from the primal and
+		 * dual variables defined by the optimization model (e.g. the shifted last solution)
+		 * @param bool True for enabling the warm start
+		 */
+		void setWarmStart(bool enable);
+
 		/**
 		 * @brief Initialization of the NLP solver using Ipopt
 		 * @return True if was initialized
@@ -126,6 +133,12 @@ class IpoptNLP : public OptimizationSolver
 		 */
 		bool compute(double allocated_time_secs = std::numeric_limits<double>::max());
 
+		/**
+		 * @brief Gets the number of Ipopt iterations of the last computation
+		 * @return Number of iterations
+		 */
+		int getNumberOfIterations() const;
+
 
 	private:
 		/** @brief Ipopt wrapper */
@@ -184,6 +197,12 @@ class IpoptNLP : public OptimizationSolver
 
 		/** @brief True enables the numerical computationg using limited-memory */
 		bool hess_approximation_;
+
+		/** @brief True enables the warm start of the primal and dual variables */
+		bool warm_start_;
+
+		/** @brief Number of Ipopt iterations of the last computation */
+		int num_iterations_;
 };
 
 } //@namespace solver
@@ -7,7 +7,8 @@ namespace dwl
 namespace solver
 {
 
-IpoptWrapper::IpoptWrapper() : opt_model_(NULL), jacobian_(false), hessian_(false)
+IpoptWrapper::IpoptWrapper() : opt_model_(NULL), jacobian_(false), hessian_(false),
+		sparse_jacobian_(false), sparse_hessian_(false)
 {
 
 }
@@ -37,10 +38,22 @@ bool IpoptWrapper::get_nlp_info(Index& n, Index& m, Index& nnz_jac_g,
 	// Getting the dimension of constraints for every knots
 	m = opt_model_->getDimensionOfConstraints();
 
-	// Getting the number of nonzero values of the Jacobian
+	// Getting the number of nonzero values of the Jacobian. If the Jacobian is approximated, the
+	// declared sparsity pattern of the model is used, otherwise it's assumed dense
 	unsigned int nnz_jac = opt_model_->getNumberOfNonzeroJacobian();
 	jacobian_ = opt_model_->isConstraintJacobianImplemented();
-	if (nnz_jac == 0 || !jacobian_) // Assume that the Jacobian is dense
+	sparse_jacobian_ = false;
+	if (!jacobian_) {
+		sparse_jacobian_ = opt_model_->getJacobianStructure(jacobian_rows_, jacobian_cols_);
+		if (sparse_jacobian_ && !isValidStructure(jacobian_rows_, jacobian_cols_, m, n)) {
+			printf(YELLOW "Warning: the Jacobian structure is not consistent with the problem"
+					" dimensions, so it's assumed dense\n" COLOR_RESET);
+			sparse_jacobian_ = false;
+		}
+	}
+	if (sparse_jacobian_)
+		nnz_jac_g = jacobian_rows_.size();
+	else if (nnz_jac == 0 || !jacobian_)
 		nnz_jac_g = n * m;
 	else
 		nnz_jac_g = nnz_jac;
@@ -48,7 +61,18 @@ bool IpoptWrapper::get_nlp_info(Index& n, Index& m, Index& nnz_jac_g,
 	// Getting the number of nonzero values of the Hessian
 	unsigned int nnz_hess = opt_model_->getNumberOfNonzeroHessian();
 	hessian_ = opt_model_->isLagrangianHessianImplemented();
-	if (nnz_hess == 0 || !hessian_) // Assume that the Hessian is dense
+	sparse_hessian_ = false;
+	if (!hessian_) {
+		sparse_hessian_ = opt_model_->getHessianStructure(hessian_rows_, hessian_cols_);
+		if (sparse_hessian_ && !isValidStructure(hessian_rows_, hessian_cols_, n, n)) {
+			printf(YELLOW "Warning: the Hessian structure is not consistent with the problem"
+					" dimensions, so it's assumed dense\n" COLOR_RESET);
+			sparse_hessian_ = false;
+		}
+	}
+	if (sparse_hessian_)
+		nnz_h_lag = hessian_rows_.size();
+	else if (nnz_hess == 0 || !hessian_)
 		nnz_h_lag = n * (n + 1) * 0.5;
 	else
 		nnz_h_lag = nnz_hess;
@@ -75,10 +99,19 @@ bool IpoptWrapper::get_starting_point(Index n, bool init_x, Number* x,
 									  bool init_z, Number* z_L, Number* z_U,
 									  Index m, bool init_lambda, Number* lambda)
 {
-	// Here, we assume we only have starting values for x, if you code your own NLP, you can
-	// provide starting values for the dual variables if you wish to use a warmstart option
+	// Getting the starting values of the primal variables
 	opt_model_->getStartingPoint(x, n);
 
+	// Getting the starting values of the dual variables, which are requested in the warm start.
+	// Without them, the multipliers are initialized as in a cold start
+	if (init_z && init_lambda) {
+		if (!opt_model_->getStartingMultipliers(z_L, z_U, n, lambda, m)) {
+			Eigen::Map<Eigen::VectorXd>(z_L, n).setOnes();
+			Eigen::Map<Eigen::VectorXd>(z_U, n).setOnes();
+			Eigen::Map<Eigen::VectorXd>(lambda, m).setZero();
+		}
+	}
+
 	return true;
 }
 
@@ -120,7 +153,13 @@ bool IpoptWrapper::eval_jac_g(Index n, const Number* x, bool new_x,
 	}
 
 	if (!jacobian_) {
-		if (flag) {
+		if (flag && sparse_jacobian_) {
+			// Returns the declared structure of the Jacobian
+			for (Index idx = 0; idx < nele_jac; idx++) {
+				row_entries[idx] = jacobian_rows_[idx];
+				col_entries[idx] = jacobian_cols_[idx];
+			}
+		} else if (flag) {
 			// Returns the structure of the Jacobian assuming it's dense
 			int idx = 0;
 			for (int i = 0; i < m; ++i) {
@@ -153,7 +192,13 @@ bool IpoptWrapper::eval_h(Index n, const Number* x, bool new_x, Number obj_facto
 	}
 
 	if (!hessian_) {
-		if (flag) {
+		if (flag && sparse_hessian_) {
+			// Returns the declared structure of the lower left triangle
+			for (Index idx = 0; idx < nele_hess; idx++) {
+				row_entries[idx] = hessian_rows_[idx];
+				col_entries[idx] = hessian_cols_[idx];
+			}
+		} else if (flag) {
 			// Returns the structure. This is a symmetric matrix, fill the lower left
 			// triangle only. Assume the Hessian is dense
 			Index idx = 0;
@@ -213,6 +258,26 @@ void IpoptWrapper::finalize_solution(Ipopt::SolverReturn status,
 
 	// Evaluating the solution
 	solution_ = solution;
+
+	// Setting the primal and dual solution to the model for warm-starting the next optimization
+	opt_model_->setSolution(x, z_L, z_U, n, lambda, m);
+}
+
+
+bool IpoptWrapper::isValidStructure(const std::vector<int>& row_entries,
+									const std::vector<int>& col_entries,
+									Index num_rows, Index num_cols)
+{
+	if (row_entries.size() != col_entries.size())
+		return false;
+
+	for (unsigned int i = 0; i < row_entries.size(); i++) {
+		if (row_entries[i] < 0 || row_entries[i] >= num_rows ||
+				col_entries[i] < 0 || col_entries[i] >= num_cols)
+			return false;
+	}
+
+	return true;
 }
 
 
@@ -198,6 +198,18 @@ class IpoptWrapper : public Ipopt::TNLP
 		IpoptWrapper(const IpoptWrapper&);
 		IpoptWrapper& operator=(const IpoptWrapper&);
 
+		/**
+		 * @brief Checks that the indices of a sparsity pattern are inside the matrix dimensions
+		 * @param const std::vector<int>& Row indices of the nonzero values
+		 * @param const std::vector<int>& Column indices of the nonzero values
+		 * @param Index Number of rows
+		 * @param Index Number of columns
+		 * @return True if the pattern is valid
+		 */
+		bool isValidStructure(const std::vector<int>& row_entries,
+							  const std::vector<int>& col_entries,
+							  Index num_rows, Index num_cols);
+
 		/** @brief Optimizer's model which defines cost functions and constraints */
 		model::OptimizationModel* opt_model_;
 
@@ -209,6 +221,20 @@ class IpoptWrapper : public Ipopt::TNLP
 
 		/** @brief True if the Lagrangian Hessian is implemented */
 		bool hessian_;
+
+		/** @brief True if the model declares the sparsity pattern of the approximated Jacobian */
+		bool sparse_jacobian_;
+
+		/** @brief True if the model declares the sparsity pattern of the approximated Hessian */
+		bool sparse_hessian_;
+
+		/** @brief Declared sparsity pattern of the approximated Jacobian */
+		std::vector<int> jacobian_rows_;
+		std::vector<int> jacobian_cols_;
+
+		/** @brief Declared sparsity pattern of the lower triangle of the approximated Hessian */
+		std::vector<int> hessian_rows_;
+		std::vector<int> hessian_cols_;
 };
 
 } //@namespace solver
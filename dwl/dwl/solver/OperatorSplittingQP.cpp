@@ -0,0 +1,370 @@
+#include <dwl/solver/OperatorSplittingQP.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+OperatorSplittingQP::OperatorSplittingQP() : setup_(false), rho_(0.1), sigma_(1e-6),
+		alpha_(1.6), abs_tol_(1e-4), rel_tol_(1e-4), max_iter_(4000), check_interval_(5),
+		warm_start_(true)
+{
+
+}
+
+
+OperatorSplittingQP::~OperatorSplittingQP()
+{
+
+}
+
+
+bool OperatorSplittingQP::init(unsigned int num_variables,
+							   unsigned int num_constraints)
+{
+	// Initializing the number of variables and constraints
+	variables_ = num_variables;
+	constraints_ = num_constraints;
+
+	// Initializing the primal and dual variables
+	x_ = Eigen::VectorXd::Zero(variables_);
+	z_ = Eigen::VectorXd::Zero(constraints_ + variables_);
+	y_ = Eigen::VectorXd::Zero(constraints_ + variables_);
+	initialized_solver_ = true;
+
+	return true;
+}
+
+
+bool OperatorSplittingQP::compute(const Eigen::MatrixXd& hessian,
+								  const Eigen::VectorXd& gradient,
+								  const Eigen::MatrixXd& constraint_mat,
+								  const Eigen::VectorXd& lower_bound,
+								  const Eigen::VectorXd& upper_bound,
+								  const Eigen::VectorXd& lower_constraint,
+								  const Eigen::VectorXd& upper_constraint,
+								  double cputime)
+{
+	Eigen::SparseMatrix<double> sparse_hessian = hessian.sparseView();
+	Eigen::SparseMatrix<double> sparse_constraint_mat = constraint_mat.sparseView();
+	return computeSparse(sparse_hessian, gradient,
+						 sparse_constraint_mat,
+						 lower_bound, upper_bound,
+						 lower_constraint, upper_constraint,
+						 cputime);
+}
+
+
+bool OperatorSplittingQP::computeSparse(const Eigen::SparseMatrix<double>& hessian,
+										const Eigen::VectorXd& gradient,
+										const Eigen::SparseMatrix<double>& constraint_mat,
+										const Eigen::VectorXd& lower_bound,
+										const Eigen::VectorXd& upper_bound,
+										const Eigen::VectorXd& lower_constraint,
+										const Eigen::VectorXd& upper_constraint,
+										double cputime)
+{
+	// Refactorizing the KKT matrix only if the matrices changed
+	if (!setup_ || !isEqual(hessian, hessian_mat_) || !isEqual(constraint_mat, input_constraint_mat_))
+		setupSparse(hessian, constraint_mat);
+
+	return update(gradient,
+				  lower_bound, upper_bound,
+				  lower_constraint, upper_constraint,
+				  cputime);
+}
+
+
+void OperatorSplittingQP::setup(const Eigen::MatrixXd& hessian,
+								const Eigen::MatrixXd& constraint_mat)
+{
+	Eigen::SparseMatrix<double> sparse_hessian = hessian.sparseView();
+	Eigen::SparseMatrix<double> sparse_constraint_mat = constraint_mat.sparseView();
+	setupSparse(sparse_hessian, sparse_constraint_mat);
+}
+
+
+void OperatorSplittingQP::setupSparse(const Eigen::SparseMatrix<double>& hessian,
+									  const Eigen::SparseMatrix<double>& constraint_mat)
+{
+	if (hessian.rows() != hessian.cols() || constraint_mat.cols() != hessian.rows()) {
+		printf(RED "FATAL: the dimensions of the Hessian and constraint matrices are not"
+				" consistent\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	// Getting the dimensions of the problem
+	variables_ = hessian.rows();
+	constraints_ = constraint_mat.rows();
+	unsigned int num_rows = constraints_ + variables_;
+	hessian_mat_ = hessian;
+	input_constraint_mat_ = constraint_mat;
+
+	// Appending the bounds as identity rows of the constraint matrix
+	std::vector<Eigen::Triplet<double> > constraint_triplets;
+	constraint_triplets.reserve(constraint_mat.nonZeros() + variables_);
+	for (int k = 0; k < constraint_mat.outerSize(); k++)
+		for (Eigen::SparseMatrix<double>::InnerIterator it(constraint_mat, k); it; ++it)
+			constraint_triplets.push_back(Eigen::Triplet<double>(it.row(), it.col(), it.value()));
+	for (unsigned int i = 0; i < variables_; i++)
+		constraint_triplets.push_back(Eigen::Triplet<double>(constraints_ + i, i, 1.));
+	constraint_bound_mat_.resize(num_rows, variables_);
+	constraint_bound_mat_.setFromTriplets(constraint_triplets.begin(), constraint_triplets.end());
+
+	// Building the quasi-definite KKT matrix, i.e.
+	// [H + sigma I, G^T; G, -diag(1/rho)]
+	// where all the constraints starts as inequalities. The step sizes of the equality
+	// constraints are updated given the bounds
+	rho_vec_ = Eigen::VectorXd::Constant(num_rows, rho_);
+	equality_rows_.assign(num_rows, false);
+	std::vector<Eigen::Triplet<double> > kkt_triplets;
+	kkt_triplets.reserve(hessian.nonZeros() + 2 * constraint_bound_mat_.nonZeros() +
+						 variables_ + num_rows);
+	for (int k = 0; k < hessian.outerSize(); k++)
+		for (Eigen::SparseMatrix<double>::InnerIterator it(hessian, k); it; ++it)
+			kkt_triplets.push_back(Eigen::Triplet<double>(it.row(), it.col(), it.value()));
+	for (int k = 0; k < constraint_bound_mat_.outerSize(); k++) {
+		for (Eigen::SparseMatrix<double>::InnerIterator it(constraint_bound_mat_, k); it; ++it) {
+			kkt_triplets.push_back(
+					Eigen::Triplet<double>(variables_ + it.row(), it.col(), it.value()));
+			kkt_triplets.push_back(
+					Eigen::Triplet<double>(it.col(), variables_ + it.row(), it.value()));
+		}
+	}
+	for (unsigned int i = 0; i < variables_; i++)
+		kkt_triplets.push_back(Eigen::Triplet<double>(i, i, sigma_));
+	for (unsigned int i = 0; i < num_rows; i++)
+		kkt_triplets.push_back(Eigen::Triplet<double>(variables_ + i, variables_ + i, -1. / rho_));
+	kkt_mat_.resize(variables_ + num_rows, variables_ + num_rows);
+	kkt_mat_.setFromTriplets(kkt_triplets.begin(), kkt_triplets.end());
+
+	// Factorizing the KKT matrix. Note that the symbolic analysis is kept for the next
+	// numerical factorizations
+	kkt_ldlt_.analyzePattern(kkt_mat_);
+	kkt_ldlt_.factorize(kkt_mat_);
+	if (kkt_ldlt_.info() != Eigen::Success)
+		printf(YELLOW "Warning: the KKT matrix could not be factorized\n" COLOR_RESET);
+
+	// Resizing the buffers of the iterations
+	kkt_rhs_.resize(variables_ + num_rows);
+	kkt_sol_.resize(variables_ + num_rows);
+	z_tilde_.resize(num_rows);
+	if (x_.size() != variables_ || z_.size() != num_rows) {
+		x_ = Eigen::VectorXd::Zero(variables_);
+		z_ = Eigen::VectorXd::Zero(num_rows);
+		y_ = Eigen::VectorXd::Zero(num_rows);
+	}
+
+	setup_ = true;
+}
+
+
+bool OperatorSplittingQP::update(const Eigen::VectorXd& gradient,
+								 const Eigen::VectorXd& lower_bound,
+								 const Eigen::VectorXd& upper_bound,
+								 const Eigen::VectorXd& lower_constraint,
+								 const Eigen::VectorXd& upper_constraint,
+								 double cputime)
+{
+	if (!setup_) {
+		printf(RED "FATAL: the constant matrices of the QP were not setup\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	// Setting the initial time
+	clock_t started_time = clock();
+
+	// Getting the gradient and the bounds of the constraints and variables
+	unsigned int num_rows = constraints_ + variables_;
+	gradient_ = gradient;
+	lower_.resize(num_rows);
+	upper_.resize(num_rows);
+	lower_.head(constraints_) = lower_constraint;
+	upper_.head(constraints_) = upper_constraint;
+	lower_.tail(variables_) = lower_bound;
+	upper_.tail(variables_) = upper_bound;
+	updateStepSizes();
+
+	// Starting from the last solution if warm start is enabled
+	if (!warm_start_) {
+		x_.setZero();
+		z_.setZero();
+		y_.setZero();
+	}
+
+	// Computing the ADMM iterations
+	bool converged = false;
+	unsigned int iter;
+	Eigen::VectorXd constraint_value(num_rows), hessian_value(variables_),
+			dual_value(variables_);
+	for (iter = 1; iter <= max_iter_; iter++) {
+		// Solving the KKT system
+		kkt_rhs_.head(variables_) = sigma_ * x_ - gradient_;
+		kkt_rhs_.tail(num_rows) = z_ - y_.cwiseQuotient(rho_vec_);
+		kkt_sol_ = kkt_ldlt_.solve(kkt_rhs_);
+
+		// Updating the primal, slack and dual variables with relaxation
+		z_tilde_ = z_ + (kkt_sol_.tail(num_rows) - y_).cwiseQuotient(rho_vec_);
+		x_ = alpha_ * kkt_sol_.head(variables_) + (1 - alpha_) * x_;
+		z_tilde_ = alpha_ * z_tilde_ + (1 - alpha_) * z_;
+		z_ = (z_tilde_ + y_.cwiseQuotient(rho_vec_)).cwiseMax(lower_).cwiseMin(upper_);
+		y_ += rho_vec_.cwiseProduct(z_tilde_ - z_);
+
+		// Checking the termination conditions
+		if (iter % check_interval_ == 0 || iter == max_iter_) {
+			constraint_value = constraint_bound_mat_ * x_;
+			hessian_value = hessian_mat_ * x_;
+			dual_value = constraint_bound_mat_.transpose() * y_;
+
+			double primal_residual = (constraint_value - z_).lpNorm<Eigen::Infinity>();
+			double dual_residual =
+					(hessian_value + gradient_ + dual_value).lpNorm<Eigen::Infinity>();
+			double primal_tol = abs_tol_ + rel_tol_ *
+					std::max(constraint_value.lpNorm<Eigen::Infinity>(),
+							 z_.lpNorm<Eigen::Infinity>());
+			double dual_tol = abs_tol_ + rel_tol_ *
+					std::max(std::max(hessian_value.lpNorm<Eigen::Infinity>(),
+									  dual_value.lpNorm<Eigen::Infinity>()),
+							 gradient_.lpNorm<Eigen::Infinity>());
+			if (primal_residual <= primal_tol && dual_residual <= dual_tol) {
+				converged = true;
+				break;
+			}
+
+			// Adapting the step size in order to balance the primal and dual residuals
+			double primal_scale = std::max(constraint_value.lpNorm<Eigen::Infinity>(),
+										   z_.lpNorm<Eigen::Infinity>());
+			double dual_scale = std::max(std::max(hessian_value.lpNorm<Eigen::Infinity>(),
+												  dual_value.lpNorm<Eigen::Infinity>()),
+										 gradient_.lpNorm<Eigen::Infinity>());
+			double rho_scale = sqrt((primal_residual / (primal_scale + 1e-10)) /
+									(dual_residual / (dual_scale + 1e-10) + 1e-10));
+			rho_scale = std::min(std::max(rho_scale, 1e-3), 1e3);
+			if (iter % (5 * check_interval_) == 0 && (rho_scale > 5. || rho_scale < 0.2))
+				scaleStepSizes(rho_scale);
+
+			// Checking the allocated time
+			double duration_secs = ((double) (clock() - started_time)) / CLOCKS_PER_SEC;
+			if (cputime > 0. && duration_secs > cputime)
+				break;
+		}
+	}
+	solution_ = x_;
+
+	// Recording the statistics of the solution, where the active constraints are the ones with
+	// non-zero multipliers
+	stats_.solve_time = ((double) (clock() - started_time)) / CLOCKS_PER_SEC;
+	stats_.num_iterations = std::min(iter, max_iter_);
+	stats_.num_active_constraints = 0;
+	stats_.num_active_bounds = 0;
+	for (unsigned int i = 0; i < num_rows; i++) {
+		if (fabs(y_(i)) > abs_tol_) {
+			if (i < constraints_)
+				++stats_.num_active_constraints;
+			else
+				++stats_.num_active_bounds;
+		}
+	}
+
+	if (!converged)
+		printf(YELLOW "Warning: the QP did not converge in %d iterations\n" COLOR_RESET,
+				stats_.num_iterations);
+
+	return converged;
+}
+
+
+void OperatorSplittingQP::setTolerance(double abs_tol,
+									   double rel_tol)
+{
+	abs_tol_ = abs_tol;
+	rel_tol_ = rel_tol;
+}
+
+
+void OperatorSplittingQP::setMaxIteration(unsigned int max_iter)
+{
+	max_iter_ = max_iter;
+}
+
+
+void OperatorSplittingQP::setStepSize(double rho)
+{
+	rho_ = rho;
+
+	// Forcing the refactorization with the new step size
+	if (setup_)
+		setupSparse(hessian_mat_, input_constraint_mat_);
+}
+
+
+void OperatorSplittingQP::setWarmStart(bool warm_start)
+{
+	warm_start_ = warm_start;
+}
+
+
+void OperatorSplittingQP::updateStepSizes()
+{
+	// The equality constraints have a higher step size in order to converge faster
+	bool changed = false;
+	unsigned int num_rows = constraints_ + variables_;
+	for (unsigned int i = 0; i < num_rows; i++) {
+		bool equality = (upper_(i) - lower_(i)) < 1e-12;
+		if (equality != equality_rows_[i]) {
+			equality_rows_[i] = equality;
+			rho_vec_(i) = equality ? 1e3 * rho_ : rho_;
+			kkt_mat_.coeffRef(variables_ + i, variables_ + i) = -1. / rho_vec_(i);
+			changed = true;
+		}
+	}
+
+	// Refactorizing the KKT matrix. Note that the structure of the matrix did not change
+	if (changed) {
+		kkt_ldlt_.factorize(kkt_mat_);
+		if (kkt_ldlt_.info() != Eigen::Success)
+			printf(YELLOW "Warning: the KKT matrix could not be factorized\n" COLOR_RESET);
+	}
+}
+
+
+void OperatorSplittingQP::scaleStepSizes(double scale)
+{
+	rho_ *= scale;
+	rho_vec_ *= scale;
+	unsigned int num_rows = constraints_ + variables_;
+	for (unsigned int i = 0; i < num_rows; i++)
+		kkt_mat_.coeffRef(variables_ + i, variables_ + i) = -1. / rho_vec_(i);
+
+	// Refactorizing the KKT matrix. Note that the structure of the matrix did not change
+	kkt_ldlt_.factorize(kkt_mat_);
+	if (kkt_ldlt_.info() != Eigen::Success)
+		printf(YELLOW "Warning: the KKT matrix could not be factorized\n" COLOR_RESET);
+}
+
+
+bool OperatorSplittingQP::isEqual(const Eigen::SparseMatrix<double>& first,
+								  const Eigen::SparseMatrix<double>& second) const
+{
+	if (first.rows() != second.rows() || first.cols() != second.cols() ||
+			first.nonZeros() != second.nonZeros())
+		return false;
+
+	for (int k = 0; k < first.outerSize(); k++) {
+		Eigen::SparseMatrix<double>::InnerIterator first_it(first, k);
+		Eigen::SparseMatrix<double>::InnerIterator second_it(second, k);
+		for (; first_it && second_it; ++first_it, ++second_it) {
+			if (first_it.index() != second_it.index() || first_it.value() != second_it.value())
+				return false;
+		}
+		if (first_it || second_it)
+			return false;
+	}
+
+	return true;
+}
+
+} //@namespace solver
+} //@namespace dwl
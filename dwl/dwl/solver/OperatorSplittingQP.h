@@ -0,0 +1,241 @@
+#ifndef DWL__SOLVER__OPERATOR_SPLITTING_QP__H
+#define DWL__SOLVER__OPERATOR_SPLITTING_QP__H
+
+#include <dwl/solver/QuadraticProgram.h>
+#include <dwl/utils/Macros.h>
+#include <Eigen/SparseCholesky>
+#include <vector>
+#include <time.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class OperatorSplittingQP
+ * @brief Implementation of a sparse QP solver based on the Alternating Direction Method of
+ * Multipliers (ADMM) of Stellato et al. (2017: "OSQP: An Operator Splitting Solver for Quadratic
+ * Programs"). It solves a convex optimization class of the following form
+ * \f[
+ * 	\min_{\mathbf{x}} \frac{1}{2}\mathbf{x}^T\mathbf{H}\mathbf{x} + \mathbf{x}^T\mathbf{g}
+ * \f]
+ * suject to
+ * \f{eqnarray*}{
+ *	lbG \leq &\mathbf{Gx}& \leq ubG \\
+ *	lb   \leq &\mathbf{x}&  \leq ub
+ * \f}
+ * where the bounds are appended as identity rows of the constraint matrix. Each iteration solves
+ * a quasi-definite KKT system with a sparse LDL^T factorization, which is cached across solves
+ * and recomputed only if the matrices or the set of equality constraints change. The primal and
+ * dual variables are kept between solves for warm starting
+ */
+class OperatorSplittingQP : public QuadraticProgram
+{
+	public:
+		/** @brief Constructor function */
+		OperatorSplittingQP();
+
+		/** @brief Destructor function */
+		~OperatorSplittingQP();
+
+		/**
+		 * @brief Initialization of the ADMM solver
+		 * @param unsigned int Number of variables of the QP problem
+	 	 * @param unsigned int Number of constraints of the QP problem
+		 * @return True if was initialized
+		 */
+		bool init(unsigned int num_variables,
+		  	  	  unsigned int num_constraints);
+
+		/**
+	 	 * @brief Function to compute the QP solution of a dense problem. The matrices are
+	 	 * converted to sparse ones
+	 	 * @param const Eigen::MatrixXd& Hessian matrix
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::MatrixXd& Constraint matrix
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param double Maximum CPU-time for computing the optimization (non-positive for
+	 	 * unlimited time)
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		bool compute(const Eigen::MatrixXd& hessian,
+					 const Eigen::VectorXd& gradient,
+					 const Eigen::MatrixXd& constraint_mat,
+					 const Eigen::VectorXd& lower_bound,
+					 const Eigen::VectorXd& upper_bound,
+					 const Eigen::VectorXd& lower_constraint,
+					 const Eigen::VectorXd& upper_constraint,
+					 double cputime);
+
+		/**
+	 	 * @brief Function to compute the QP solution of a sparse problem. The factorization is
+	 	 * reused if the matrices are the same as in the last solve
+	 	 * @param const Eigen::SparseMatrix<double>& Hessian matrix
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::SparseMatrix<double>& Constraint matrix
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param double Maximum CPU-time for computing the optimization (non-positive for
+	 	 * unlimited time)
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		bool computeSparse(const Eigen::SparseMatrix<double>& hessian,
+						   const Eigen::VectorXd& gradient,
+						   const Eigen::SparseMatrix<double>& constraint_mat,
+						   const Eigen::VectorXd& lower_bound,
+						   const Eigen::VectorXd& upper_bound,
+						   const Eigen::VectorXd& lower_constraint,
+						   const Eigen::VectorXd& upper_constraint,
+						   double cputime);
+
+		/**
+		 * @brief Sets up the constant matrices of a sequence of QPs, and factorizes the KKT matrix
+		 * @param const Eigen::MatrixXd& Hessian matrix
+		 * @param const Eigen::MatrixXd& Constraint matrix
+		 */
+		void setup(const Eigen::MatrixXd& hessian,
+				   const Eigen::MatrixXd& constraint_mat);
+
+		/**
+		 * @brief Sets up the constant sparse matrices of a sequence of QPs, and factorizes the
+		 * KKT matrix
+		 * @param const Eigen::SparseMatrix<double>& Hessian matrix
+		 * @param const Eigen::SparseMatrix<double>& Constraint matrix
+		 */
+		void setupSparse(const Eigen::SparseMatrix<double>& hessian,
+						 const Eigen::SparseMatrix<double>& constraint_mat);
+
+		/**
+		 * @brief Computes the QP solution with the matrices defined in setup(), and warm-starts
+		 * from the last primal and dual solution
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param double Maximum CPU-time for computing the optimization (non-positive for
+	 	 * unlimited time)
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		bool update(const Eigen::VectorXd& gradient,
+					const Eigen::VectorXd& lower_bound,
+					const Eigen::VectorXd& upper_bound,
+					const Eigen::VectorXd& lower_constraint,
+					const Eigen::VectorXd& upper_constraint,
+					double cputime);
+
+		/**
+		 * @brief Sets the absolute and relative tolerances of the primal and dual residuals
+		 * @param double Absolute tolerance
+		 * @param double Relative tolerance
+		 */
+		void setTolerance(double abs_tol,
+						  double rel_tol);
+
+		/**
+		 * @brief Sets the maximum number of ADMM iterations
+		 * @param unsigned int Maximum number of iterations
+		 */
+		void setMaxIteration(unsigned int max_iter);
+
+		/**
+		 * @brief Sets the step size of the ADMM
+		 * @param double Step size of the constraints (rho)
+		 */
+		void setStepSize(double rho);
+
+		/**
+		 * @brief Enables or disables the warm start from the last primal and dual solution
+		 * @param bool True for warm-starting
+		 */
+		void setWarmStart(bool warm_start);
+
+
+	private:
+		/**
+		 * @brief Updates the step size of each constraint given the bounds, and refactorizes the
+		 * KKT matrix if the set of equality constraints changed
+		 */
+		void updateStepSizes();
+
+		/**
+		 * @brief Scales the step sizes of the constraints, and refactorizes the KKT matrix
+		 * @param double Scale factor
+		 */
+		void scaleStepSizes(double scale);
+
+		/**
+		 * @brief Checks if two sparse matrices have the same structure and values
+		 * @param const Eigen::SparseMatrix<double>& First matrix
+		 * @param const Eigen::SparseMatrix<double>& Second matrix
+		 * @return bool True if they are equal
+		 */
+		bool isEqual(const Eigen::SparseMatrix<double>& first,
+					 const Eigen::SparseMatrix<double>& second) const;
+
+		/** @brief Hessian and constraint matrices of the last setup */
+		Eigen::SparseMatrix<double> hessian_mat_;
+		Eigen::SparseMatrix<double> input_constraint_mat_;
+
+		/** @brief Constraint matrix with the bounds appended as identity rows */
+		Eigen::SparseMatrix<double> constraint_bound_mat_;
+
+		/** @brief KKT matrix and its cached LDL^T factorization */
+		Eigen::SparseMatrix<double> kkt_mat_;
+		Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> kkt_ldlt_;
+
+		/** @brief Label that indicates if the matrices were setup */
+		bool setup_;
+
+		/** @brief Gradient, and lower and upper bounds of the constraints and bounds */
+		Eigen::VectorXd gradient_;
+		Eigen::VectorXd lower_;
+		Eigen::VectorXd upper_;
+
+		/** @brief Step size of each constraint and labels of the equality constraints */
+		Eigen::VectorXd rho_vec_;
+		std::vector<bool> equality_rows_;
+
+		/** @brief Primal, slack and dual variables, which are kept for warm starting */
+		Eigen::VectorXd x_;
+		Eigen::VectorXd z_;
+		Eigen::VectorXd y_;
+
+		/** @brief Buffers of the ADMM iterations */
+		Eigen::VectorXd kkt_rhs_;
+		Eigen::VectorXd kkt_sol_;
+		Eigen::VectorXd z_tilde_;
+
+		/** @brief Step size of the constraints (rho) and of the variables (sigma) */
+		double rho_;
+		double sigma_;
+
+		/** @brief Relaxation parameter */
+		double alpha_;
+
+		/** @brief Absolute and relative tolerances */
+		double abs_tol_;
+		double rel_tol_;
+
+		/** @brief Maximum number of iterations */
+		unsigned int max_iter_;
+
+		/** @brief Number of iterations between residual checks */
+		unsigned int check_interval_;
+
+		/** @brief Label that indicates if the solver warm-starts */
+		bool warm_start_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
@@ -24,7 +24,8 @@ s.t.
  
  The function will return the cost of the solution written in the x vector or
  std::numeric_limits::infinity() if the problem is infeasible. In the latter case
- the value of the x vector is not correct.
+ the value of the x vector is not correct. The number of iterations is written in
+ num_iterations if it isn't NULL.
  
  References: D. Goldfarb, A. Idnani. A numerically stable dual method for solving
              strictly convex quadratic programs. Mathematical Programming 27 (1983) pp. 1-33.
@@ -262,7 +263,7 @@ inline void delete_constraint(Eigen::MatrixXd& R, Eigen::MatrixXd& J,
 inline double solve_quadprog(Eigen::MatrixXd& G, Eigen::VectorXd& g0,
 							 const Eigen::MatrixXd& CE, const Eigen::VectorXd& ce0,
 							 const Eigen::MatrixXd& CI, const Eigen::VectorXd& ci0,
-							 Eigen::VectorXd& x)
+							 Eigen::VectorXd& x, int* num_iterations = NULL)
 {
 	int i, k, l; /* indices */
 	int ip, me, mi;
@@ -281,7 +282,10 @@ inline double solve_quadprog(Eigen::MatrixXd& G, Eigen::VectorXd& g0,
 	 * and the full step length t2 */
 	Eigen::VectorXi A(m + p), A_old(m + p), iai(m + p);
 	int q;
-	int iq, iter = 0;
+	/* the iterations are counted in the given output, if any */
+	int iq, local_iter;
+	int& iter = (num_iterations != NULL) ? *num_iterations : local_iter;
+	iter = 0;
 	bool iaexcl[m + p];
 
 	me = p; /* number of equality constraints */
@@ -7,7 +7,7 @@ namespace dwl
 namespace solver
 {
 
-QuadProgQP::QuadProgQP()
+QuadProgQP::QuadProgQP() : converted_setup_(false)
 {
 
 }
@@ -22,6 +22,10 @@ QuadProgQP::~QuadProgQP()
 bool QuadProgQP::init(unsigned int num_variables,
 					  unsigned int num_constraints)
 {
+	variables_ = num_variables;
+	constraints_ = num_constraints;
+	initialized_solver_ = true;
+
 	return true;
 }
 
@@ -35,84 +39,223 @@ bool QuadProgQP::compute(const Eigen::MatrixXd& hessian,
 						 const Eigen::VectorXd& upper_constraint,
 						 double cputime)
 {
-	// Getting the number of equality and inequality constraints
+	// The converted constraint matrix is overwritten by this one, so the constant matrix of
+	// setup() has to be converted again in the next update
+	converted_setup_ = false;
+
+	return solve(hessian, gradient,
+				 constraint_mat,
+				 lower_bound, upper_bound,
+				 lower_constraint, upper_constraint,
+				 true);
+}
+
+
+void QuadProgQP::setup(const Eigen::MatrixXd& hessian,
+					   const Eigen::MatrixXd& constraint_mat)
+{
+	QuadraticProgram::setup(hessian, constraint_mat);
+	converted_setup_ = false;
+}
+
+
+bool QuadProgQP::update(const Eigen::VectorXd& gradient,
+						const Eigen::VectorXd& lower_bound,
+						const Eigen::VectorXd& upper_bound,
+						const Eigen::VectorXd& lower_constraint,
+						const Eigen::VectorXd& upper_constraint,
+						double cputime)
+{
+	// The constraint matrix is constant, so its values are converted only once
+	bool success = solve(hessian_, gradient,
+						 constraint_mat_,
+						 lower_bound, upper_bound,
+						 lower_constraint, upper_constraint,
+						 !converted_setup_);
+	converted_setup_ = true;
+
+	return success;
+}
+
+
+bool QuadProgQP::solve(const Eigen::MatrixXd& hessian,
+					   const Eigen::VectorXd& gradient,
+					   const Eigen::MatrixXd& constraint_mat,
+					   const Eigen::VectorXd& lower_bound,
+					   const Eigen::VectorXd& upper_bound,
+					   const Eigen::VectorXd& lower_constraint,
+					   const Eigen::VectorXd& upper_constraint,
+					   bool refresh_matrix)
+{
+	// Setting the initial time
+	clock_t started_time = clock();
+
+	// Classifying the rows. The constraint matrix has to be refreshed if the structure changed
+	unsigned int num_vars = gradient.size();
 	unsigned int num_constraints = lower_constraint.size();
-	unsigned int num_eq_constraints = 0;
-	unsigned int num_ineq_constraints = 0;
-	for (unsigned int i = 0; i < num_constraints; i++) {
-		if ((upper_constraint - lower_constraint).isZero())
-			++num_eq_constraints;
+	if (classifyRows(num_vars, lower_bound, upper_bound, lower_constraint, upper_constraint))
+		refresh_matrix = true;
+
+	// Refreshing the values of the constraint matrix, i.e. CE^T x + ce0 = 0 and
+	// CI^T x + ci0 >= 0. Note that the bound columns are unit vectors, so they only change
+	// with the structure
+	if (refresh_matrix) {
+		for (unsigned int j = 0; j < eq_rows_.size(); j++) {
+			unsigned int row = eq_rows_[j];
+			if (row < num_constraints)
+				eq_constraint_mat_.col(j) = constraint_mat.row(row).transpose();
+		}
+		for (unsigned int j = 0; j < ineq_rows_.size(); j++) {
+			unsigned int row = ineq_rows_[j];
+			if (row < num_constraints)
+				ineq_constraint_mat_.col(j) = ineq_signs_[j] * constraint_mat.row(row).transpose();
+		}
+	}
+
+	// Refreshing the bound vectors, i.e. converting lb = Ax to Ax - lb = 0,
+	// lb <= Ax to Ax - lb >= 0, and Ax <= ub to -Ax + ub >= 0
+	for (unsigned int j = 0; j < eq_rows_.size(); j++) {
+		unsigned int row = eq_rows_[j];
+		if (row < num_constraints)
+			eq_bound_(j) = -lower_constraint(row);
 		else
-			++num_ineq_constraints;
+			eq_bound_(j) = -lower_bound(row - num_constraints);
+	}
+	for (unsigned int j = 0; j < ineq_rows_.size(); j++) {
+		unsigned int row = ineq_rows_[j];
+		if (ineq_signs_[j] > 0.) {
+			if (row < num_constraints)
+				ineq_bound_(j) = -lower_constraint(row);
+			else
+				ineq_bound_(j) = -lower_bound(row - num_constraints);
+		} else {
+			if (row < num_constraints)
+				ineq_bound_(j) = upper_constraint(row);
+			else
+				ineq_bound_(j) = upper_bound(row - num_constraints);
+		}
 	}
 
-	// Getting the number of equality and inequality bounds
-	unsigned int num_bounds = lower_bound.size();
-	unsigned int num_eq_bounds = 0;
-	unsigned int num_ineq_bounds = 0;
-	for (unsigned int i = 0; i < num_constraints; i++) {
-		if ((upper_bound - lower_bound).isZero())
-			++num_eq_bounds;
+	// Solving the QP. Note that QuadProg++ modifies the Hessian and gradient, and the copies
+	// reuse their buffers
+	hessian_copy_ = hessian;
+	gradient_copy_ = gradient;
+	solution_.resize(num_vars);
+	int num_iterations;
+	double cost = solve_quadprog(hessian_copy_, gradient_copy_,
+								 eq_constraint_mat_, eq_bound_,
+								 ineq_constraint_mat_, ineq_bound_,
+								 solution_, &num_iterations);
+
+	// Recording the statistics of the solution
+	stats_.solve_time = ((double) (clock() - started_time)) / CLOCKS_PER_SEC;
+	stats_.num_iterations = num_iterations;
+	stats_.num_active_constraints = 0;
+	stats_.num_active_bounds = 0;
+
+	if (cost == std::numeric_limits<double>::infinity()) {
+		printf(YELLOW "Warning: the quadratic programming is infeasible\n" COLOR_RESET);
+		return false;
+	}
+
+	// Counting the active rows, i.e. the equalities and the inequalities with zero slack
+	for (unsigned int j = 0; j < eq_rows_.size(); j++) {
+		if (eq_rows_[j] < num_constraints)
+			stats_.num_active_constraints++;
 		else
-			++num_ineq_bounds;
+			stats_.num_active_bounds++;
+	}
+	for (unsigned int j = 0; j < ineq_rows_.size(); j++) {
+		double slack = ineq_constraint_mat_.col(j).dot(solution_) + ineq_bound_(j);
+		if (fabs(slack) <= 1e-9 * (1. + fabs(ineq_bound_(j)))) {
+			if (ineq_rows_[j] < num_constraints)
+				stats_.num_active_constraints++;
+			else
+				stats_.num_active_bounds++;
+		}
 	}
 
-	// Computing the constraint in/equality matrix and in/equality bound
-	Eigen::MatrixXd eq_constraint_mat = Eigen::MatrixXd::Zero(num_eq_constraints + num_eq_bounds,
-															  num_eq_constraints + num_eq_bounds);
-	Eigen::MatrixXd ineq_constraint_mat = Eigen::MatrixXd::Zero(num_ineq_constraints + num_ineq_bounds,
-																num_ineq_constraints + num_ineq_bounds);
-	Eigen::VectorXd eq_bound = Eigen::VectorXd::Zero(num_eq_constraints);
-	Eigen::VectorXd ineq_bound = Eigen::VectorXd::Zero(num_ineq_constraints);
-	unsigned int eq_idx = 0;
-	unsigned int ineq_idx = 0;
-	for (unsigned int i = 0; i < num_constraints; i++) {
-		if ((upper_constraint - lower_constraint).isZero()) {
-			// Converting lbA = Ax to Ax -lbA = 0
-			eq_constraint_mat.row(eq_idx) = constraint_mat.row(i);
-			eq_bound(eq_idx) = -lower_constraint(i);
-			++eq_idx;
+	return true;
+}
+
+
+bool QuadProgQP::classifyRows(unsigned int num_variables,
+							  const Eigen::VectorXd& lower_bound,
+							  const Eigen::VectorXd& upper_bound,
+							  const Eigen::VectorXd& lower_constraint,
+							  const Eigen::VectorXd& upper_constraint)
+{
+	// Classifying each row, where the constraints are followed by the bounds. The infinite
+	// bounds don't generate any row
+	unsigned int num_constraints = lower_constraint.size();
+	unsigned int num_bounds = lower_bound.size();
+	unsigned int num_rows = num_constraints + num_bounds;
+	bool changed = (row_types_.size() != num_rows ||
+			eq_constraint_mat_.rows() != (int) num_variables);
+	if (changed)
+		row_types_.resize(num_rows);
+	for (unsigned int i = 0; i < num_rows; i++) {
+		double lower, upper;
+		if (i < num_constraints) {
+			lower = lower_constraint(i);
+			upper = upper_constraint(i);
 		} else {
-			// Converting lbA <= Ax <= ubA to Ax -lbA >= 0 and -Ax + ubA >= 0
-			// Setting the equality bound component
-			ineq_constraint_mat.row(ineq_idx) = constraint_mat.row(i);
-			ineq_bound(ineq_idx) = -lower_constraint(i);
-			++ineq_idx;
-
-			// Setting the inequality bound component
-			ineq_constraint_mat.row(ineq_idx) = -constraint_mat.row(i);
-			ineq_bound(ineq_idx) = upper_constraint(i);
-			++ineq_idx;
+			lower = lower_bound(i - num_constraints);
+			upper = upper_bound(i - num_constraints);
+		}
+
+		int type = Unbounded;
+		if (upper - lower == 0.)
+			type = Equality;
+		else {
+			if (lower > -std::numeric_limits<double>::max())
+				type |= Lower;
+			if (upper < std::numeric_limits<double>::max())
+				type |= Upper;
+		}
+
+		if (type != row_types_[i]) {
+			row_types_[i] = type;
+			changed = true;
 		}
 	}
-	for (unsigned int i = 0; i < num_bounds; i++) {
-		Eigen::VectorXd identity_row = Eigen::VectorXd::Zero(num_bounds);
-		identity_row(i) = 1;
-		if ((upper_bound - lower_bound).isZero()) {
-			// Converting lb = x to Ix - lb = 0
-			eq_constraint_mat.row(eq_idx) = identity_row;
-			eq_bound(eq_idx) = -lower_bound(i);
-			++eq_idx;
-		} else {
-			// Converting lb <= x <= up to Ix - lb >= 0 and -Ix + ub >= 0
-			// Setting the equality bound component
-			ineq_constraint_mat.row(ineq_idx) = identity_row;
-			ineq_bound(ineq_idx) = -lower_bound(i);
-			++ineq_idx;
-
-			// Setting the inequality bound component
-			ineq_constraint_mat.row(ineq_idx) = -identity_row;
-			ineq_bound(ineq_idx) = upper_bound(i);
-			++ineq_idx;
+
+	if (!changed)
+		return false;
+
+	// Rebuilding the structure of the QuadProg++ matrices
+	eq_rows_.clear();
+	ineq_rows_.clear();
+	ineq_signs_.clear();
+	for (unsigned int i = 0; i < num_rows; i++) {
+		if (row_types_[i] == Equality)
+			eq_rows_.push_back(i);
+		else {
+			if (row_types_[i] & Lower) {
+				ineq_rows_.push_back(i);
+				ineq_signs_.push_back(1.);
+			}
+			if (row_types_[i] & Upper) {
+				ineq_rows_.push_back(i);
+				ineq_signs_.push_back(-1.);
+			}
 		}
 	}
 
-	Eigen::MatrixXd copy_hessian = hessian;
-	Eigen::VectorXd copy_gradient = gradient;
-	solve_quadprog(copy_hessian, copy_gradient,
-				   eq_constraint_mat, eq_bound,
-				   ineq_constraint_mat, ineq_bound,
-				   solution_);
+	// Resizing the matrices, which have a row per variable, and setting the unit columns of
+	// the bounds
+	eq_constraint_mat_ = Eigen::MatrixXd::Zero(num_variables, eq_rows_.size());
+	eq_bound_.resize(eq_rows_.size());
+	ineq_constraint_mat_ = Eigen::MatrixXd::Zero(num_variables, ineq_rows_.size());
+	ineq_bound_.resize(ineq_rows_.size());
+	for (unsigned int j = 0; j < eq_rows_.size(); j++) {
+		if (eq_rows_[j] >= num_constraints)
+			eq_constraint_mat_(eq_rows_[j] - num_constraints, j) = 1.;
+	}
+	for (unsigned int j = 0; j < ineq_rows_.size(); j++) {
+		if (ineq_rows_[j] >= num_constraints)
+			ineq_constraint_mat_(ineq_rows_[j] - num_constraints, j) = ineq_signs_[j];
+	}
 
 	return true;
 }
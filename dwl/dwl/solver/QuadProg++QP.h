@@ -3,7 +3,9 @@
 
 #include <dwl/solver/QuadraticProgram.h>
 #include <dwl/solver/QuadProg++.h>
+#include <dwl/utils/Macros.h>
 #include <time.h>
+#include <vector>
 
 
 namespace dwl
@@ -68,6 +70,97 @@ class QuadProgQP : public QuadraticProgram
 					 const Eigen::VectorXd& lower_constraint,
 					 const Eigen::VectorXd& upper_constraint,
 					 double cputime);
+
+		/**
+		 * @brief Sets up the constant matrices of a sequence of QPs. The constraint matrix is
+		 * converted once in the next update
+		 * @param const Eigen::MatrixXd& Hessian matrix
+		 * @param const Eigen::MatrixXd& Constraint matrix
+		 */
+		void setup(const Eigen::MatrixXd& hessian,
+				   const Eigen::MatrixXd& constraint_mat);
+
+		/**
+		 * @brief Computes the QP solution with the matrices defined in setup()
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param double CPU-time for computing the optimization
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		bool update(const Eigen::VectorXd& gradient,
+					const Eigen::VectorXd& lower_bound,
+					const Eigen::VectorXd& upper_bound,
+					const Eigen::VectorXd& lower_constraint,
+					const Eigen::VectorXd& upper_constraint,
+					double cputime);
+
+
+	private:
+		/**
+		 * @brief Converts the problem into the QuadProg++ form and solves it
+	 	 * @param const Eigen::MatrixXd& Hessian matrix
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::MatrixXd& Constraint matrix
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param bool True for refreshing the values of the constraint matrix
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		bool solve(const Eigen::MatrixXd& hessian,
+				   const Eigen::VectorXd& gradient,
+				   const Eigen::MatrixXd& constraint_mat,
+				   const Eigen::VectorXd& lower_bound,
+				   const Eigen::VectorXd& upper_bound,
+				   const Eigen::VectorXd& lower_constraint,
+				   const Eigen::VectorXd& upper_constraint,
+				   bool refresh_matrix);
+
+		/**
+		 * @brief Classifies the constraint and bound rows into equalities, lower and upper
+		 * inequalities, or unbounded rows. If the classification changed, it rebuilds the
+		 * structure of the QuadProg++ matrices
+	 	 * @param unsigned int Number of variables
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+		 * @return bool True if the structure was rebuilt
+		 */
+		bool classifyRows(unsigned int num_variables,
+						  const Eigen::VectorXd& lower_bound,
+						  const Eigen::VectorXd& upper_bound,
+						  const Eigen::VectorXd& lower_constraint,
+						  const Eigen::VectorXd& upper_constraint);
+
+		/** @brief Type of each constraint and bound row, i.e. a bitmask of RowType */
+		enum RowType {Unbounded = 0, Lower = 1, Upper = 2, Equality = 4};
+		std::vector<int> row_types_;
+
+		/**
+		 * @brief Source row and sign of each column of the QuadProg++ matrices. The rows equal
+		 * or higher than the number of constraints are bounds
+		 */
+		std::vector<unsigned int> eq_rows_;
+		std::vector<unsigned int> ineq_rows_;
+		std::vector<double> ineq_signs_;
+
+		/** @brief Cached matrices and vectors in the QuadProg++ form, i.e. CE, ce0, CI and ci0 */
+		Eigen::MatrixXd eq_constraint_mat_;
+		Eigen::VectorXd eq_bound_;
+		Eigen::MatrixXd ineq_constraint_mat_;
+		Eigen::VectorXd ineq_bound_;
+
+		/** @brief Copies of the Hessian and gradient, which are modified by QuadProg++ */
+		Eigen::MatrixXd hessian_copy_;
+		Eigen::VectorXd gradient_copy_;
+
+		/** @brief Label that indicates if the constraint matrix of setup() was converted */
+		bool converted_setup_;
 };
 
 } //@namespace solver
@@ -19,6 +19,54 @@ QuadraticProgram::~QuadraticProgram()
 
 }
 
+
+void QuadraticProgram::setup(const Eigen::MatrixXd& hessian,
+							 const Eigen::MatrixXd& constraint_mat)
+{
+	hessian_ = hessian;
+	constraint_mat_ = constraint_mat;
+}
+
+
+bool QuadraticProgram::computeSparse(const Eigen::SparseMatrix<double>& hessian,
+									 const Eigen::VectorXd& gradient,
+									 const Eigen::SparseMatrix<double>& constraint_mat,
+									 const Eigen::VectorXd& lower_bound,
+									 const Eigen::VectorXd& upper_bound,
+									 const Eigen::VectorXd& lower_constraint,
+									 const Eigen::VectorXd& upper_constraint,
+									 double cputime)
+{
+	return compute(Eigen::MatrixXd(hessian), gradient,
+				   Eigen::MatrixXd(constraint_mat),
+				   lower_bound, upper_bound,
+				   lower_constraint, upper_constraint,
+				   cputime);
+}
+
+
+void QuadraticProgram::setupSparse(const Eigen::SparseMatrix<double>& hessian,
+								   const Eigen::SparseMatrix<double>& constraint_mat)
+{
+	setup(Eigen::MatrixXd(hessian), Eigen::MatrixXd(constraint_mat));
+}
+
+
+bool QuadraticProgram::update(const Eigen::VectorXd& gradient,
+							  const Eigen::VectorXd& lower_bound,
+							  const Eigen::VectorXd& upper_bound,
+							  const Eigen::VectorXd& lower_constraint,
+							  const Eigen::VectorXd& upper_constraint,
+							  double cputime)
+{
+	return compute(hessian_, gradient,
+				   constraint_mat_,
+				   lower_bound, upper_bound,
+				   lower_constraint, upper_constraint,
+				   cputime);
+}
+
+
 Eigen::VectorXd& QuadraticProgram::getOptimalSolution()
 {
 	return solution_;
@@ -36,5 +84,11 @@ unsigned int QuadraticProgram::getNumberOfConstraints() const
 	return constraints_;
 }
 
+
+const QPStatistics& QuadraticProgram::getStatistics() const
+{
+	return stats_;
+}
+
 } //@namespace solver
 } //@namespace dwl
@@ -2,6 +2,7 @@
 #define DWL__SOLVER__QUADRATIC_PROGRAM__H
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 namespace dwl
 {
@@ -9,6 +10,27 @@ namespace dwl
 namespace solver
 {
 
+/**
+ * @struct QPStatistics
+ * @brief Statistics of the last QP solution, i.e. the solve time and the working set
+ */
+struct QPStatistics
+{
+	QPStatistics() : solve_time(0.), num_iterations(0), num_active_bounds(0),
+			num_active_constraints(0) {}
+
+	/** @brief CPU-time of the solution in seconds */
+	double solve_time;
+
+	/** @brief Number of iterations, i.e. working set recalculations in active-set solvers */
+	unsigned int num_iterations;
+
+	/** @brief Number of active bounds and constraints of the solution */
+	unsigned int num_active_bounds;
+	unsigned int num_active_constraints;
+};
+
+
 /**
  * @class QuadraticProgram
  * @brief Abstract class for Quadratic Program (QP) solvers.
@@ -62,6 +84,66 @@ class QuadraticProgram
 							 const Eigen::VectorXd& upper_constraint,
 							 double cputime) = 0;
 				
+		/**
+		 * @brief Sets up the constant matrices of a sequence of QPs, i.e. the Hessian and
+		 * constraint matrix. The next QPs are solved through update(), which changes only the
+		 * gradient and bounds, and so solvers can reuse their factorizations and working set
+		 * @param const Eigen::MatrixXd& Hessian matrix
+		 * @param const Eigen::MatrixXd& Constraint matrix
+		 */
+		virtual void setup(const Eigen::MatrixXd& hessian,
+						   const Eigen::MatrixXd& constraint_mat);
+
+		/**
+	 	 * @brief Function to compute the QP solution of a sparse problem. The default
+	 	 * implementation converts the matrices to dense ones and calls compute(), so sparse
+	 	 * solvers should override it
+	 	 * @param const Eigen::SparseMatrix<double>& Hessian matrix
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::SparseMatrix<double>& Constraint matrix
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param double CPU-time for computing the optimization
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		virtual bool computeSparse(const Eigen::SparseMatrix<double>& hessian,
+								   const Eigen::VectorXd& gradient,
+								   const Eigen::SparseMatrix<double>& constraint_mat,
+								   const Eigen::VectorXd& lower_bound,
+								   const Eigen::VectorXd& upper_bound,
+								   const Eigen::VectorXd& lower_constraint,
+								   const Eigen::VectorXd& upper_constraint,
+								   double cputime);
+
+		/**
+		 * @brief Sets up the constant sparse matrices of a sequence of QPs. The default
+		 * implementation converts the matrices to dense ones and calls setup()
+		 * @param const Eigen::SparseMatrix<double>& Hessian matrix
+		 * @param const Eigen::SparseMatrix<double>& Constraint matrix
+		 */
+		virtual void setupSparse(const Eigen::SparseMatrix<double>& hessian,
+								 const Eigen::SparseMatrix<double>& constraint_mat);
+
+		/**
+		 * @brief Computes the QP solution with the matrices defined in setup(). The default
+		 * implementation calls compute() with the stored matrices
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param double CPU-time for computing the optimization
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		virtual bool update(const Eigen::VectorXd& gradient,
+							const Eigen::VectorXd& lower_bound,
+							const Eigen::VectorXd& upper_bound,
+							const Eigen::VectorXd& lower_constraint,
+							const Eigen::VectorXd& upper_constraint,
+							double cputime);
+
 		/**
 	 	 * @brief Get the vector of optimal or sub-optimal solutions calculated by the
 	 	 * dwl::solver::QuadraticProgram::computeOpt() function (optimality of the function is defined
@@ -82,6 +164,12 @@ class QuadraticProgram
 		 */
 		unsigned int getNumberOfConstraints() const;
 
+		/**
+		 * @brief Gets the statistics of the last QP solution
+		 * @return const QPStatistics& Statistics of the solution
+		 */
+		const QPStatistics& getStatistics() const;
+
 
 	protected:
 		/** @brief Label that indicates if QP solver had been initialized */
@@ -95,6 +183,13 @@ class QuadraticProgram
 
 		/** @brief Solution of the QP problem */
 		Eigen::VectorXd solution_;
+
+		/** @brief Constant Hessian and constraint matrices defined in setup() */
+		Eigen::MatrixXd hessian_;
+		Eigen::MatrixXd constraint_mat_;
+
+		/** @brief Statistics of the last solution */
+		QPStatistics stats_;
 };
 
 } //@namepace solver
@@ -0,0 +1,159 @@
+#include <dwl/solver/QuadraticSurrogate.h>
+#include <algorithm>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+QuadraticSurrogate::QuadraticSurrogate() : archive_size_(0), regularization_(1e-8),
+		trained_(false)
+{
+
+}
+
+
+QuadraticSurrogate::~QuadraticSurrogate()
+{
+
+}
+
+
+void QuadraticSurrogate::setArchiveSize(unsigned int size)
+{
+	archive_size_ = size;
+}
+
+
+void QuadraticSurrogate::reset()
+{
+	points_.clear();
+	values_.clear();
+	trained_ = false;
+}
+
+
+void QuadraticSurrogate::addSample(const Eigen::Ref<const Eigen::VectorXd>& point,
+								   double value)
+{
+	// The archive is restarted if the dimension changed
+	if (!points_.empty() && points_.front().size() != point.size())
+		reset();
+
+	points_.push_back(point);
+	values_.push_back(value);
+
+	// Discarding the oldest evaluations
+	unsigned int archive_size = archive_size_;
+	if (archive_size == 0)
+		archive_size = 2 * getMinimumNumberOfSamples();
+	while (points_.size() > archive_size) {
+		points_.pop_front();
+		values_.pop_front();
+	}
+}
+
+
+bool QuadraticSurrogate::train()
+{
+	unsigned int num_samples = points_.size();
+	if (num_samples == 0 || num_samples < getMinimumNumberOfSamples())
+		return false;
+
+	// Computing the normalization of the points, i.e. their mean and standard deviation
+	unsigned int dim = points_.front().size();
+	center_ = Eigen::VectorXd::Zero(dim);
+	for (unsigned int i = 0; i < num_samples; i++)
+		center_ += points_[i];
+	center_ /= num_samples;
+	scale_ = Eigen::VectorXd::Zero(dim);
+	for (unsigned int i = 0; i < num_samples; i++)
+		scale_ += (points_[i] - center_).cwiseAbs2();
+	scale_ = (scale_ / num_samples).cwiseSqrt();
+	for (unsigned int j = 0; j < dim; j++) {
+		if (scale_(j) < 1e-12)
+			scale_(j) = 1.;
+	}
+
+	// Solving the regularized normal equations of the least squares
+	unsigned int num_features = 2 * dim + 1;
+	Eigen::MatrixXd normal_mat = Eigen::MatrixXd::Zero(num_features, num_features);
+	Eigen::VectorXd normal_vec = Eigen::VectorXd::Zero(num_features);
+	Eigen::VectorXd features(num_features);
+	for (unsigned int i = 0; i < num_samples; i++) {
+		computeFeatures(features, points_[i]);
+		normal_mat.selfadjointView<Eigen::Lower>().rankUpdate(features);
+		normal_vec += values_[i] * features;
+	}
+	normal_mat.diagonal().array() += regularization_ * (1. + normal_mat.diagonal().array());
+
+	Eigen::LDLT<Eigen::MatrixXd> ldlt(normal_mat.selfadjointView<Eigen::Lower>());
+	if (ldlt.info() != Eigen::Success) {
+		trained_ = false;
+		return false;
+	}
+	coefficients_ = ldlt.solve(normal_vec);
+	trained_ = true;
+
+	return true;
+}
+
+
+double QuadraticSurrogate::predict(const Eigen::Ref<const Eigen::VectorXd>& point) const
+{
+	Eigen::VectorXd features(coefficients_.size());
+	computeFeatures(features, point);
+
+	return coefficients_.dot(features);
+}
+
+
+double QuadraticSurrogate::getQuantile(double quantile) const
+{
+	if (values_.empty())
+		return 0.;
+
+	std::vector<double> values(values_.begin(), values_.end());
+	unsigned int idx = (unsigned int) (std::min(std::max(quantile, 0.), 1.) * (values.size() - 1));
+	std::nth_element(values.begin(), values.begin() + idx, values.end());
+
+	return values[idx];
+}
+
+
+bool QuadraticSurrogate::isTrained() const
+{
+	return trained_;
+}
+
+
+unsigned int QuadraticSurrogate::getNumberOfSamples() const
+{
+	return points_.size();
+}
+
+
+unsigned int QuadraticSurrogate::getMinimumNumberOfSamples() const
+{
+	if (points_.empty())
+		return 0;
+
+	// The model needs more evaluations than coefficients
+	return 2 * points_.front().size() + 2;
+}
+
+
+void QuadraticSurrogate::computeFeatures(Eigen::Ref<Eigen::VectorXd> features,
+										 const Eigen::Ref<const Eigen::VectorXd>& point) const
+{
+	unsigned int dim = point.size();
+	Eigen::VectorXd normalized = (point - center_).cwiseQuotient(scale_);
+	features(0) = 1.;
+	features.segment(1, dim) = normalized;
+	features.segment(dim + 1, dim) = normalized.cwiseAbs2();
+}
+
+} //@namespace solver
+} //@namespace dwl
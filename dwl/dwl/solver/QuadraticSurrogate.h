@@ -0,0 +1,114 @@
+#ifndef DWL__SOLVER__QUADRATIC_SURROGATE__H
+#define DWL__SOLVER__QUADRATIC_SURROGATE__H
+
+#include <Eigen/Dense>
+#include <deque>
+#include <vector>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class QuadraticSurrogate
+ * @brief Local quadratic model of an expensive function that is trained on an archive with
+ * its latest exact evaluations, in the spirit of the local meta-models of Kern et al. (2006:
+ * "Local Meta-Models for Optimization Using Evolution Strategies"). The model has a separable
+ * (diagonal) Hessian, i.e. 2n + 1 coefficients, so it can be trained with a few generations of
+ * an evolution strategy. The coefficients are fitted by ridge-regularized least squares on
+ * normalized variables
+ */
+class QuadraticSurrogate
+{
+	public:
+		/** @brief Constructor function */
+		QuadraticSurrogate();
+
+		/** @brief Destructor function */
+		~QuadraticSurrogate();
+
+		/**
+		 * @brief Sets the maximum number of archived evaluations, where the oldest ones are
+		 * discarded
+		 * @param unsigned int Archive size (zero for twice the number of coefficients)
+		 */
+		void setArchiveSize(unsigned int size);
+
+		/** @brief Removes the archived evaluations and the trained model */
+		void reset();
+
+		/**
+		 * @brief Adds an exact evaluation to the archive
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Evaluated point
+		 * @param double Function value
+		 */
+		void addSample(const Eigen::Ref<const Eigen::VectorXd>& point,
+					   double value);
+
+		/**
+		 * @brief Trains the model with the archived evaluations
+		 * @return bool False if there aren't enough evaluations
+		 */
+		bool train();
+
+		/**
+		 * @brief Predicts the function value with the trained model
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Point
+		 * @return double Predicted value
+		 */
+		double predict(const Eigen::Ref<const Eigen::VectorXd>& point) const;
+
+		/**
+		 * @brief Gets a quantile of the archived function values
+		 * @param double Quantile in [0,1]
+		 * @return double Function value
+		 */
+		double getQuantile(double quantile) const;
+
+		/** @brief Returns true if the model was trained */
+		bool isTrained() const;
+
+		/** @brief Gets the number of archived evaluations */
+		unsigned int getNumberOfSamples() const;
+
+		/** @brief Gets the minimum number of archived evaluations for training the model */
+		unsigned int getMinimumNumberOfSamples() const;
+
+
+	private:
+		/**
+		 * @brief Computes the features of a point, i.e. [1, d, d^2] with d the normalized point
+		 * @param Eigen::Ref<Eigen::VectorXd> Features
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Point
+		 */
+		void computeFeatures(Eigen::Ref<Eigen::VectorXd> features,
+							 const Eigen::Ref<const Eigen::VectorXd>& point) const;
+
+		/** @brief Archived points and function values, from the oldest one */
+		std::deque<Eigen::VectorXd> points_;
+		std::deque<double> values_;
+
+		/** @brief Maximum number of archived evaluations */
+		unsigned int archive_size_;
+
+		/** @brief Center and scale used for normalizing the points */
+		Eigen::VectorXd center_;
+		Eigen::VectorXd scale_;
+
+		/** @brief Coefficients of the model, i.e. constant, linear and quadratic terms */
+		Eigen::VectorXd coefficients_;
+
+		/** @brief Ridge regularization of the least squares */
+		double regularization_;
+
+		/** @brief Label that indicates if the model was trained */
+		bool trained_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,123 @@
+#include <dwl/solver/SearchNodeTable.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+SearchNodeTable::SearchNodeTable() : mask_(0)
+{
+	rehash(1024);
+}
+
+
+SearchNodeTable::~SearchNodeTable()
+{
+
+}
+
+
+unsigned int SearchNodeTable::getSlot(Vertex vertex)
+{
+	unsigned int bucket = hash(vertex);
+	while (buckets_[bucket] != NO_SLOT) {
+		unsigned int slot = buckets_[bucket];
+		if (nodes_[slot].vertex == vertex)
+			return slot;
+		bucket = (bucket + 1) & mask_;
+	}
+
+	// Adding the vertex. The hash table is kept at most half full so the probing sequences
+	// remain short
+	unsigned int slot = nodes_.size();
+	nodes_.push_back(SearchNode(vertex));
+	buckets_[bucket] = slot;
+	if (2 * nodes_.size() > buckets_.size())
+		rehash(2 * buckets_.size());
+
+	return slot;
+}
+
+
+unsigned int SearchNodeTable::findSlot(Vertex vertex) const
+{
+	unsigned int bucket = hash(vertex);
+	while (buckets_[bucket] != NO_SLOT) {
+		unsigned int slot = buckets_[bucket];
+		if (nodes_[slot].vertex == vertex)
+			return slot;
+		bucket = (bucket + 1) & mask_;
+	}
+
+	return NO_SLOT;
+}
+
+
+SearchNode& SearchNodeTable::operator[](unsigned int slot)
+{
+	return nodes_[slot];
+}
+
+
+const SearchNode& SearchNodeTable::operator[](unsigned int slot) const
+{
+	return nodes_[slot];
+}
+
+
+unsigned int SearchNodeTable::size() const
+{
+	return nodes_.size();
+}
+
+
+void SearchNodeTable::reserve(unsigned int num_vertices)
+{
+	nodes_.reserve(num_vertices);
+	if (2 * num_vertices > buckets_.size()) {
+		unsigned int num_buckets = buckets_.size();
+		while (2 * num_vertices > num_buckets)
+			num_buckets *= 2;
+		rehash(num_buckets);
+	}
+}
+
+
+void SearchNodeTable::clear()
+{
+	nodes_.clear();
+	std::fill(buckets_.begin(), buckets_.end(), NO_SLOT);
+}
+
+
+unsigned int SearchNodeTable::hash(Vertex vertex) const
+{
+	// Mixing the bits of the vertex (the finalizer of MurmurHash3), since the vertices of
+	// neighboring cells differ only in their lower bits
+	unsigned long long key = vertex;
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+
+	return (unsigned int) key & mask_;
+}
+
+
+void SearchNodeTable::rehash(unsigned int num_buckets)
+{
+	buckets_.assign(num_buckets, NO_SLOT);
+	mask_ = num_buckets - 1;
+	for (unsigned int slot = 0; slot < nodes_.size(); slot++) {
+		unsigned int bucket = hash(nodes_[slot].vertex);
+		while (buckets_[bucket] != NO_SLOT)
+			bucket = (bucket + 1) & mask_;
+		buckets_[bucket] = slot;
+	}
+}
+
+} //@namespace solver
+} //@namespace dwl
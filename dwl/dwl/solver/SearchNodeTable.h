@@ -0,0 +1,105 @@
+#ifndef DWL__SOLVER__SEARCH_NODE_TABLE__H
+#define DWL__SOLVER__SEARCH_NODE_TABLE__H
+
+#include <dwl/utils/utils.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/** @brief Slot index of an unknown node, e.g. the parent of the source */
+const unsigned int NO_SLOT = std::numeric_limits<unsigned int>::max();
+
+/** @brief Defines the search state of a node */
+enum SearchNodeState {UNVISITED, OPEN, CLOSED, INCONSISTENT};
+
+/**
+ * @brief Defines the record of a visited vertex, where the parent is described by its slot index
+ */
+struct SearchNode
+{
+	SearchNode() : vertex(0), g_cost(std::numeric_limits<double>::infinity()),
+			heuristic(-1.), parent(NO_SLOT), state(UNVISITED) {}
+	SearchNode(Vertex _vertex) : vertex(_vertex),
+			g_cost(std::numeric_limits<double>::infinity()), heuristic(-1.), parent(NO_SLOT),
+			state(UNVISITED) {}
+
+	Vertex vertex;
+	Weight g_cost;
+	Weight heuristic; // negative if it isn't computed yet
+	unsigned int parent;
+	enum SearchNodeState state;
+};
+
+/**
+ * @class SearchNodeTable
+ * @brief Maps the vertices visited by a graph search to dense slot indices, and stores their
+ * records contiguously. The vertices are indexed by an open-addressing hash table (with linear
+ * probing), so a search doesn't allocate a tree node per vertex as std::map does. Note that a new
+ * slot could reallocate the records, so references to them shouldn't be kept across getSlot()
+ * calls
+ */
+class SearchNodeTable
+{
+	public:
+		/** @brief Constructor function */
+		SearchNodeTable();
+
+		/** @brief Destructor function */
+		~SearchNodeTable();
+
+		/**
+		 * @brief Gets the slot of a vertex, which is created if the vertex wasn't visited
+		 * @param Vertex Vertex
+		 * @return unsigned int Slot index
+		 */
+		unsigned int getSlot(Vertex vertex);
+
+		/**
+		 * @brief Finds the slot of a vertex
+		 * @param Vertex Vertex
+		 * @return unsigned int Slot index, or NO_SLOT if the vertex wasn't visited
+		 */
+		unsigned int findSlot(Vertex vertex) const;
+
+		/** @brief Gets the record of a slot */
+		SearchNode& operator[](unsigned int slot);
+		const SearchNode& operator[](unsigned int slot) const;
+
+		/** @brief Gets the number of visited vertices */
+		unsigned int size() const;
+
+		/**
+		 * @brief Reserves memory for a number of vertices
+		 * @param unsigned int Number of vertices
+		 */
+		void reserve(unsigned int num_vertices);
+
+		/** @brief Removes the visited vertices but keeps the allocated memory */
+		void clear();
+
+
+	private:
+		/** @brief Computes the bucket of a vertex */
+		unsigned int hash(Vertex vertex) const;
+
+		/** @brief Resizes the hash table, and reinserts the visited vertices */
+		void rehash(unsigned int num_buckets);
+
+		/** @brief Records of the visited vertices */
+		std::vector<SearchNode> nodes_;
+
+		/** @brief Hash table of slot indices, where NO_SLOT is an empty bucket */
+		std::vector<unsigned int> buckets_;
+
+		/** @brief Mask of the number of buckets, which is a power of two */
+		unsigned int mask_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
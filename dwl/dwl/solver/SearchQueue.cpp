@@ -0,0 +1,163 @@
+#include <dwl/solver/SearchQueue.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+SearchQueue::SearchQueue()
+{
+
+}
+
+
+SearchQueue::~SearchQueue()
+{
+
+}
+
+
+void SearchQueue::push(unsigned int slot,
+					   const SearchKey& key)
+{
+	if (slot >= positions_.size())
+		positions_.resize(std::max(slot + 1, 2 * (unsigned int) positions_.size()), NO_SLOT);
+
+	unsigned int position = positions_[slot];
+	if (position == NO_SLOT) {
+		HeapEntry entry;
+		entry.key = key;
+		entry.slot = slot;
+		heap_.push_back(entry);
+		positions_[slot] = heap_.size() - 1;
+		siftUp(heap_.size() - 1);
+	} else {
+		bool decrease = key < heap_[position].key;
+		heap_[position].key = key;
+		if (decrease)
+			siftUp(position);
+		else
+			siftDown(position);
+	}
+}
+
+
+unsigned int SearchQueue::pop()
+{
+	unsigned int slot = heap_.front().slot;
+	remove(slot);
+
+	return slot;
+}
+
+
+void SearchQueue::remove(unsigned int slot)
+{
+	if (!contains(slot))
+		return;
+
+	// Replacing the entry by the last one
+	unsigned int position = positions_[slot];
+	positions_[slot] = NO_SLOT;
+	HeapEntry last = heap_.back();
+	heap_.pop_back();
+	if (position == heap_.size())
+		return;
+
+	bool decrease = last.key < heap_[position].key;
+	heap_[position] = last;
+	positions_[last.slot] = position;
+	if (decrease)
+		siftUp(position);
+	else
+		siftDown(position);
+}
+
+
+unsigned int SearchQueue::top() const
+{
+	return heap_.front().slot;
+}
+
+
+const SearchKey& SearchQueue::topKey() const
+{
+	return heap_.front().key;
+}
+
+
+bool SearchQueue::contains(unsigned int slot) const
+{
+	return slot < positions_.size() && positions_[slot] != NO_SLOT;
+}
+
+
+bool SearchQueue::empty() const
+{
+	return heap_.empty();
+}
+
+
+unsigned int SearchQueue::size() const
+{
+	return heap_.size();
+}
+
+
+void SearchQueue::clear()
+{
+	for (unsigned int i = 0; i < heap_.size(); i++)
+		positions_[heap_[i].slot] = NO_SLOT;
+	heap_.clear();
+}
+
+
+void SearchQueue::siftUp(unsigned int position)
+{
+	HeapEntry entry = heap_[position];
+	while (position > 0) {
+		unsigned int parent = (position - 1) / ARITY;
+		if (!(entry.key < heap_[parent].key))
+			break;
+
+		heap_[position] = heap_[parent];
+		positions_[heap_[position].slot] = position;
+		position = parent;
+	}
+	heap_[position] = entry;
+	positions_[entry.slot] = position;
+}
+
+
+void SearchQueue::siftDown(unsigned int position)
+{
+	HeapEntry entry = heap_[position];
+	unsigned int size = heap_.size();
+	while (true) {
+		// Finding the child with the lowest priority
+		unsigned int first_child = ARITY * position + 1;
+		if (first_child >= size)
+			break;
+
+		unsigned int last_child = std::min(first_child + ARITY, size);
+		unsigned int min_child = first_child;
+		for (unsigned int child = first_child + 1; child < last_child; child++) {
+			if (heap_[child].key < heap_[min_child].key)
+				min_child = child;
+		}
+
+		if (!(heap_[min_child].key < entry.key))
+			break;
+
+		heap_[position] = heap_[min_child];
+		positions_[heap_[position].slot] = position;
+		position = min_child;
+	}
+	heap_[position] = entry;
+	positions_[entry.slot] = position;
+}
+
+} //@namespace solver
+} //@namespace dwl
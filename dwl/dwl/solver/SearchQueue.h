@@ -0,0 +1,119 @@
+#ifndef DWL__SOLVER__SEARCH_QUEUE__H
+#define DWL__SOLVER__SEARCH_QUEUE__H
+
+#include <dwl/solver/SearchNodeTable.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @brief Defines the priority of a node in the search queue. The priorities are compared
+ * lexicographically, e.g. the f cost and then the heuristic for A*
+ */
+struct SearchKey
+{
+	SearchKey() : first(0.), second(0.) {}
+	SearchKey(double _first, double _second = 0.) : first(_first), second(_second) {}
+
+	bool operator<(const SearchKey& other) const
+	{
+		return first < other.first || (first == other.first && second < other.second);
+	}
+
+	double first;
+	double second;
+};
+
+/**
+ * @class SearchQueue
+ * @brief Indexed d-ary min-heap of node slots (see SearchNodeTable). It stores the heap position
+ * of each slot, so the priority of a queued node is updated in place (i.e. decrease-key) and a
+ * node can be removed without searching it. Nodes with the same priority are kept, in contrast
+ * to a std::set ordered only by the weight
+ */
+class SearchQueue
+{
+	public:
+		/** @brief Constructor function */
+		SearchQueue();
+
+		/** @brief Destructor function */
+		~SearchQueue();
+
+		/**
+		 * @brief Inserts a slot, or updates its priority if it's already queued
+		 * @param unsigned int Slot index
+		 * @param const SearchKey& Priority
+		 */
+		void push(unsigned int slot,
+				  const SearchKey& key);
+
+		/**
+		 * @brief Removes the slot with the lowest priority
+		 * @return unsigned int Slot index
+		 */
+		unsigned int pop();
+
+		/**
+		 * @brief Removes a slot if it's queued
+		 * @param unsigned int Slot index
+		 */
+		void remove(unsigned int slot);
+
+		/** @brief Gets the slot with the lowest priority */
+		unsigned int top() const;
+
+		/** @brief Gets the lowest priority */
+		const SearchKey& topKey() const;
+
+		/** @brief Returns true if the slot is queued */
+		bool contains(unsigned int slot) const;
+
+		/** @brief Returns true if there isn't any queued slot */
+		bool empty() const;
+
+		/** @brief Gets the number of queued slots */
+		unsigned int size() const;
+
+		/** @brief Removes the queued slots but keeps the allocated memory */
+		void clear();
+
+
+	private:
+		/** @brief Number of children per heap node */
+		static const unsigned int ARITY = 4;
+
+		/** @brief Entry of the heap */
+		struct HeapEntry
+		{
+			SearchKey key;
+			unsigned int slot;
+		};
+
+		/**
+		 * @brief Moves an entry towards the root until the heap order is restored
+		 * @param unsigned int Heap position
+		 */
+		void siftUp(unsigned int position);
+
+		/**
+		 * @brief Moves an entry towards the leaves until the heap order is restored
+		 * @param unsigned int Heap position
+		 */
+		void siftDown(unsigned int position);
+
+		/** @brief Heap entries */
+		std::vector<HeapEntry> heap_;
+
+		/** @brief Heap position of each slot, where NO_SLOT is a slot that isn't queued */
+		std::vector<unsigned int> positions_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
@@ -7,8 +7,8 @@ namespace dwl
 namespace solver
 {
 
-SearchTreeSolver::SearchTreeSolver() : adjacency_(NULL),
-		total_cost_(std::numeric_limits<double>::max()), time_started_(clock()),
+SearchTreeSolver::SearchTreeSolver() : adjacency_(NULL), terrain_(NULL),
+		expansions_(0), total_cost_(std::numeric_limits<double>::max()), time_started_(clock()),
 		is_set_model_(false), is_set_adjacency_model_(false)
 {
 
@@ -34,6 +34,10 @@ void SearchTreeSolver::reset(robot::Robot* robot,
 	}
 
 	adjacency_->reset(robot, environment);
+	terrain_ = environment;
+
+	// Discarding the previous search since it was computed in another environment
+	init();
 }
 
 
@@ -70,10 +74,42 @@ double SearchTreeSolver::getMinimumCost()
 }
 
 
+unsigned int SearchTreeSolver::getNumberOfExpansions()
+{
+	return expansions_;
+}
+
+
 std::string SearchTreeSolver::getName()
 {
 	return name_;
 }
 
+
+double SearchTreeSolver::getHeuristic(unsigned int slot,
+									  Vertex target)
+{
+	SearchNode& node = nodes_[slot];
+	if (node.heuristic < 0.)
+		node.heuristic = adjacency_->heuristicCost(node.vertex, target);
+
+	return node.heuristic;
+}
+
+
+void SearchTreeSolver::setPolicy(unsigned int slot,
+								 Vertex target)
+{
+	policy_.clear();
+	if (nodes_[slot].vertex != target)
+		policy_[target] = nodes_[slot].vertex;
+
+	while (nodes_[slot].parent != NO_SLOT) {
+		unsigned int parent = nodes_[slot].parent;
+		policy_[nodes_[slot].vertex] = nodes_[parent].vertex;
+		slot = parent;
+	}
+}
+
 } //@namespace solver
 } //@namespace dwl
@@ -3,6 +3,8 @@
 
 #include <dwl/robot/Robot.h>
 #include <dwl/model/AdjacencyModel.h>
+#include <dwl/solver/SearchNodeTable.h>
+#include <dwl/solver/SearchQueue.h>
 #include <dwl/utils/utils.h>
 
 
@@ -33,7 +35,8 @@ class SearchTreeSolver
 		virtual bool init() = 0;
 
 		/**
-		 * @brief Defines the environment information
+		 * @brief Defines the environment information. The search kept across calls by some
+		 * solvers is discarded
 		 * @param Robot* Encapsulated all the robot information
 		 * @param TerrainMap* Encapsulates all the terrain information
 		 */
@@ -70,6 +73,9 @@ class SearchTreeSolver
 		 */
 		double getMinimumCost();
 
+		/** @brief Gets the number of expansions of the last computation */
+		unsigned int getNumberOfExpansions();
+
 		/**
 		 * @brief Gets the name of the solver
 		 * @return The name of the solver
@@ -78,15 +84,44 @@ class SearchTreeSolver
 
 
 	protected:
+		/**
+		 * @brief Gets the heuristic cost of a node, which is computed only once per search
+		 * @param unsigned int Slot of the node
+		 * @param Vertex Target vertex
+		 * @return double Heuristic cost
+		 */
+		double getHeuristic(unsigned int slot,
+							Vertex target);
+
+		/**
+		 * @brief Sets the policy (previous vertices) of the path that finishes in a node
+		 * @param unsigned int Slot of the last node of the path
+		 * @param Vertex Target vertex, whose previous vertex is the last node if they are different
+		 */
+		void setPolicy(unsigned int slot,
+					   Vertex target);
+
 		/** @brief Name of the solver */
 		std::string name_;
 
 		/** @brief Adjacency model of the tree */
 		model::AdjacencyModel* adjacency_;
 
+		/** @brief Terrain of the adjacency model, which is defined in reset() */
+		environment::TerrainMap* terrain_;
+
 		/** @brief Shortest previous vertex */
 		PreviousVertex policy_;
 
+		/** @brief Records of the visited vertices */
+		SearchNodeTable nodes_;
+
+		/** @brief Priority queue of the open nodes */
+		SearchQueue openset_;
+
+		/** @brief Number of expansions */
+		unsigned int expansions_;
+
 		/** @brief Total cost of the path */
 		double total_cost_;
 
@@ -2,6 +2,13 @@
 #define DWL__SOLVER__CMAESSOFAMILY__H
 
 #include <dwl/solver/OptimizationSolver.h>
+#include <dwl/solver/QuadraticSurrogate.h>
+#include <unordered_map>
+#include <deque>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #pragma GCC system_header // This pragma turns off the warning messages in this file
 #pragma message "Turning off the warning messages of libcmaes"
 #include_next <cmaes.h>
@@ -66,11 +73,50 @@ class cmaesSOFamily : public OptimizationSolver
 		void setNumberOfRestarts(int max_restarts);
 
 		/**
-		 * @brief Sets the multi-threading option
+		 * @brief Sets the multi-threading option, i.e. the offsprings of each generation are
+		 * evaluated in parallel. Each thread evaluates its own copy of the optimization model, so
+		 * the model has to be clonable, otherwise the evaluations are serialized
 		 * @param bool True for enabling the multi-threading optimization
 		 */
 		void setMultithreading(bool multithreading);
 
+		/**
+		 * @brief Sets the seed of the random generator, which makes the optimization repeatable
+		 * @param unsigned long Seed (0 for a random one)
+		 */
+		void setRandomSeed(unsigned long seed);
+
+		/**
+		 * @brief Sets the surrogate pre-screening of the offsprings. The offsprings that a local
+		 * quadratic model (trained on the exact evaluations) predicts as non-promising get the
+		 * predicted fitness, and only the rest are evaluated exactly
+		 * @param bool True for enabling the surrogate pre-screening
+		 */
+		void setSurrogate(bool surrogate);
+
+		/**
+		 * @brief Sets the cache of the exact evaluations, i.e. an already evaluated decision
+		 * vector isn't evaluated again
+		 * @param bool True for enabling the cache
+		 */
+		void setEvaluationCache(bool cache);
+
+		/**
+		 * @brief Gets the ratio of exact evaluations to the total number of fitness evaluations
+		 * of the last computation
+		 * @return double Ratio of exact evaluations
+		 */
+		double getExactEvaluationRatio() const;
+
+		/**
+		 * @brief Evaluates the fitness of a decision vector as in the computation, i.e. it could
+		 * be read from the cache or predicted by the surrogate. The cache and the surrogate are
+		 * reset in the init() and compute() calls
+		 * @param const Eigen::VectorXd& Decision vector
+		 * @return double Fitness value
+		 */
+		double evaluateFitness(const Eigen::VectorXd& decision);
+
 		/** @brief Sets the output file for plotting */
 		void setOutputFile(std::string filename);
 
@@ -111,6 +157,27 @@ class cmaesSOFamily : public OptimizationSolver
 		dVec gradientFitnessFunction(const double *x,
 									 const int& n);
 
+		/** @brief Resets the cache, the surrogate and the counters of the evaluations */
+		void resetEvaluations();
+
+		/** @brief Creates the per-thread copies of the optimization model */
+		void initThreadModels();
+
+		/** @brief Deletes the per-thread copies of the optimization model */
+		void clearThreadModels();
+
+		/**
+		 * @brief Takes a free copy of the optimization model, and waits if all of them are in use
+		 * @return model::OptimizationModel* Optimization model
+		 */
+		model::OptimizationModel* acquireModel();
+
+		/**
+		 * @brief Gives back a copy of the optimization model
+		 * @param model::OptimizationModel* Optimization model
+		 */
+		void releaseModel(model::OptimizationModel* model);
+
 		/** @brief Fitness function wrapper */
 		libcmaes::FitFunc fitness_;
 
@@ -161,6 +228,63 @@ class cmaesSOFamily : public OptimizationSolver
 		 */
 		bool multithreading_;
 
+		/** @brief Seed of the random generator */
+		unsigned long seed_;
+
+		/** @brief Per-thread copies of the optimization model */
+		std::vector<model::OptimizationModel*> thread_models_;
+
+		/**
+		 * @brief Models that are not being evaluated. Without per-thread copies, it only contains
+		 * the optimization model, so the evaluations are serialized
+		 */
+		std::vector<model::OptimizationModel*> free_models_;
+		std::mutex models_mutex_;
+		std::condition_variable models_cond_;
+
+		/** @brief Labels that indicate if the surrogate and the cache are used */
+		bool surrogate_;
+		bool cache_;
+
+		/** @brief Surrogate model trained on the exact evaluations */
+		QuadraticSurrogate surrogate_model_;
+
+		/**
+		 * @brief Predictions of the last generation, and the quantile of them that is evaluated
+		 * exactly
+		 */
+		std::deque<double> predictions_;
+		double screening_quantile_;
+
+		/**
+		 * @brief Running mean of the prediction error of the surrogate (relative to the spread
+		 * of the archived values), and its maximum value for screening the offsprings
+		 */
+		double surrogate_error_;
+		double max_surrogate_error_;
+		double value_spread_;
+
+		/**
+		 * @brief Number of exact evaluations between trainings of the surrogate, and the ones
+		 * since the last training
+		 */
+		unsigned int training_interval_;
+		unsigned int new_samples_;
+
+		/** @brief Every how many screened offsprings one is evaluated exactly for validation */
+		unsigned int validation_interval_;
+		unsigned int num_screened_;
+
+		/** @brief Cache of the exact evaluations, indexed by the bytes of the decision vector */
+		std::unordered_map<std::string, double> cache_values_;
+
+		/** @brief Number of fitness and exact evaluations of the last computation */
+		unsigned int num_evaluations_;
+		unsigned int num_exact_evaluations_;
+
+		/** @brief Protects the cache, the surrogate and the counters */
+		std::mutex evaluation_mutex_;
+
 		/** @brief Output file for plotting */
 		std::string output_file_;
 		bool outfile_;
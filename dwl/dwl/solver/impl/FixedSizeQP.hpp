@@ -0,0 +1,314 @@
+#ifndef DWL__SOLVER__FIXED_SIZE_QP__IMPL_H
+#define DWL__SOLVER__FIXED_SIZE_QP__IMPL_H
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+template <int NumVariables, int NumConstraints>
+FixedSizeQP<NumVariables, NumConstraints>::FixedSizeQP() :
+		max_iter_(10 * (NumVariables + NumConstraints)), tolerance_(1e-9)
+{
+
+}
+
+
+template <int NumVariables, int NumConstraints>
+FixedSizeQP<NumVariables, NumConstraints>::~FixedSizeQP()
+{
+
+}
+
+
+template <int NumVariables, int NumConstraints>
+void FixedSizeQP<NumVariables, NumConstraints>::setMaxIteration(unsigned int max_iter)
+{
+	max_iter_ = max_iter;
+}
+
+
+template <int NumVariables, int NumConstraints>
+void FixedSizeQP<NumVariables, NumConstraints>::setTolerance(double tolerance)
+{
+	tolerance_ = tolerance;
+}
+
+
+template <int NumVariables, int NumConstraints>
+bool FixedSizeQP<NumVariables, NumConstraints>::solve(VariableVector& solution,
+													  const Problem& problem) const
+{
+	// Factorizing the Hessian, i.e. H = L L^T
+	Eigen::LLT<HessianMatrix> llt(problem.hessian);
+	if (llt.info() != Eigen::Success)
+		return false;
+
+	return solve(solution, problem,
+				 llt.matrixU().solve(HessianMatrix::Identity()));
+}
+
+
+template <int NumVariables, int NumConstraints>
+bool FixedSizeQP<NumVariables, NumConstraints>::solve(VariableVector& solution,
+													  const Problem& problem,
+													  const HessianMatrix& inverse_factor) const
+{
+	double infinity = std::numeric_limits<double>::infinity();
+
+	// Computing the unconstrained minimum, i.e. x = -L^-T L^-1 g
+	solution.noalias() = -inverse_factor * (inverse_factor.transpose() * problem.gradient);
+
+	// Factorization of the active set, i.e. L^-1 N = Q [R; 0], which is updated with Givens
+	// rotations when a row is added or dropped. It's described by J = L^-T Q and R
+	HessianMatrix J = inverse_factor;
+	HessianMatrix R;
+	VariableVector multipliers;
+	unsigned int active_rows[NumVariables];
+	bool active_equalities[NumVariables];
+	unsigned int num_active = 0;
+	bool active_labels[num_rows_];
+	for (unsigned int k = 0; k < num_rows_; k++)
+		active_labels[k] = false;
+
+	ConstraintVector constraint_values;
+	VariableVector normal, d, z;
+	ActiveVector r;
+	Eigen::JacobiRotation<double> givens;
+	unsigned int iter = 0;
+	while (iter < max_iter_) {
+		// Choosing the row to add, i.e. first the equalities and then the most violated
+		// inequality
+		int new_row = -1;
+		double new_rhs, new_sign = 1.;
+		bool new_equality;
+		double min_slack = -tolerance_;
+		constraint_values.noalias() = problem.constraint_mat * solution;
+		for (unsigned int idx = 0; idx < NumConstraints + NumVariables; idx++) {
+			double value, lower, upper;
+			if (idx < (unsigned int) NumConstraints) {
+				value = constraint_values(idx);
+				lower = problem.lower_constraint(idx);
+				upper = problem.upper_constraint(idx);
+			} else {
+				value = solution(idx - NumConstraints);
+				lower = problem.lower_bound(idx - NumConstraints);
+				upper = problem.upper_bound(idx - NumConstraints);
+			}
+
+			// The sign of the equality is chosen so that it's violated. Note that the infinite
+			// bounds have infinite slacks
+			if (upper - lower == 0.) {
+				if (!active_labels[2 * idx]) {
+					new_row = 2 * idx;
+					new_sign = (value - lower > 0.) ? -1. : 1.;
+					break;
+				}
+			} else {
+				if (!active_labels[2 * idx] && value - lower < min_slack) {
+					new_row = 2 * idx;
+					min_slack = value - lower;
+				}
+				if (!active_labels[2 * idx + 1] && upper - value < min_slack) {
+					new_row = 2 * idx + 1;
+					min_slack = upper - value;
+				}
+			}
+		}
+
+		// The solution is optimal if all the constraints are satisfied
+		if (new_row == -1)
+			return true;
+
+		getRow(normal, new_rhs, new_equality, problem, new_row);
+		normal *= new_sign;
+		new_rhs *= new_sign;
+
+		// Adding the row, which could require to drop others from the active set
+		double new_multiplier = 0.;
+		while (true) {
+			if (++iter > max_iter_)
+				return false;
+
+			// Computing the primal step direction z = H^-1 (n - N r) and the dual one
+			// r = (N^T H^-1 N)^-1 N^T H^-1 n, where d = J^T n
+			unsigned int num_free = NumVariables - num_active;
+			d.noalias() = J.transpose() * normal;
+			z.noalias() = J.rightCols(num_free) * d.tail(num_free);
+			r = R.topLeftCorner(num_active, num_active).template
+					triangularView<Eigen::Upper>().solve(d.head(num_active));
+
+			// Computing the partial step length, i.e. the one that drops an inequality multiplier
+			// to zero
+			double partial_step = infinity;
+			int drop = -1;
+			for (unsigned int j = 0; j < num_active; j++) {
+				if (!active_equalities[j] && r(j) > 0.) {
+					double step = multipliers(j) / r(j);
+					if (step < partial_step) {
+						partial_step = step;
+						drop = j;
+					}
+				}
+			}
+
+			// Computing the full step length, i.e. the one that satisfies the new row
+			double full_step = infinity;
+			double curvature = z.dot(normal);
+			if (fabs(curvature) > std::numeric_limits<double>::epsilon())
+				full_step = -(normal.dot(solution) - new_rhs) / curvature;
+
+			double step = std::min(partial_step, full_step);
+			if (step == infinity)
+				return false; // infeasible problem
+
+			// Taking the primal (if there is a full step) and dual steps
+			if (full_step != infinity)
+				solution += step * z;
+			multipliers.head(num_active) -= step * r;
+			new_multiplier += step;
+
+			if (step == full_step) {
+				// Rotating d so that only its first num_active + 1 entries are non-zero, which
+				// become the new column of R
+				for (unsigned int j = NumVariables - 1; j > num_active; j--) {
+					givens.makeGivens(d(j - 1), d(j));
+					d.applyOnTheLeft(j - 1, j, givens.adjoint());
+					J.applyOnTheRight(j - 1, j, givens);
+				}
+				R.col(num_active).head(num_active + 1) = d.head(num_active + 1);
+				multipliers(num_active) = new_multiplier;
+				active_rows[num_active] = new_row;
+				active_equalities[num_active] = new_equality;
+				active_labels[new_row] = true;
+				num_active++;
+				break;
+			}
+
+			// Dropping the blocking row, and restoring the triangular form of R
+			active_labels[active_rows[drop]] = false;
+			for (unsigned int j = drop; j + 1 < num_active; j++) {
+				R.col(j) = R.col(j + 1);
+				multipliers(j) = multipliers(j + 1);
+				active_rows[j] = active_rows[j + 1];
+				active_equalities[j] = active_equalities[j + 1];
+			}
+			num_active--;
+			for (unsigned int j = drop; j < num_active; j++) {
+				givens.makeGivens(R(j,j), R(j + 1,j));
+				R.applyOnTheLeft(j, j + 1, givens.adjoint());
+				J.applyOnTheRight(j, j + 1, givens);
+				R(j + 1,j) = 0.;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+template <int NumVariables, int NumConstraints>
+unsigned int FixedSizeQP<NumVariables, NumConstraints>::solveBatch(
+		std::vector<VariableVector, Eigen::aligned_allocator<VariableVector> >& solutions,
+		std::vector<bool>& success,
+		const std::vector<Problem, Eigen::aligned_allocator<Problem> >& problems,
+		utils::ThreadPool* pool) const
+{
+	unsigned int num_problems = problems.size();
+	solutions.resize(num_problems);
+	success.resize(num_problems);
+
+	// Checking if the problems share the Hessian, which is then factorized only once
+	bool shared_hessian = true;
+	for (unsigned int i = 1; i < num_problems; i++) {
+		if (problems[i].hessian != problems[0].hessian) {
+			shared_hessian = false;
+			break;
+		}
+	}
+
+	HessianMatrix inverse_factor;
+	if (shared_hessian && num_problems > 0) {
+		Eigen::LLT<HessianMatrix> llt(problems[0].hessian);
+		if (llt.info() != Eigen::Success) {
+			for (unsigned int i = 0; i < num_problems; i++)
+				success[i] = false;
+			return 0;
+		}
+		inverse_factor = llt.matrixU().solve(HessianMatrix::Identity());
+	}
+
+	// Note that std::vector<bool> packs the labels in bits, so the threads write them into a
+	// separated buffer
+	std::vector<char> solved(num_problems);
+	utils::ThreadPool::Task task = [&](unsigned int i, unsigned int) {
+		if (shared_hessian)
+			solved[i] = solve(solutions[i], problems[i], inverse_factor);
+		else
+			solved[i] = solve(solutions[i], problems[i]);
+	};
+	if (pool == NULL) {
+		for (unsigned int i = 0; i < num_problems; i++)
+			task(i, 0);
+	} else
+		pool->parallelFor(num_problems, task);
+
+	unsigned int num_solved = 0;
+	for (unsigned int i = 0; i < num_problems; i++) {
+		success[i] = solved[i];
+		if (solved[i])
+			num_solved++;
+	}
+
+	return num_solved;
+}
+
+
+template <int NumVariables, int NumConstraints>
+bool FixedSizeQP<NumVariables, NumConstraints>::getRow(VariableVector& normal,
+													   double& rhs,
+													   bool& equality,
+													   const Problem& problem,
+													   unsigned int row) const
+{
+	// Getting the lower and upper values of the constraint or bound
+	unsigned int idx = row / 2;
+	bool upper_side = (row % 2 == 1);
+	double lower, upper;
+	if (idx < (unsigned int) NumConstraints) {
+		lower = problem.lower_constraint(idx);
+		upper = problem.upper_constraint(idx);
+		normal = problem.constraint_mat.row(idx).transpose();
+	} else {
+		idx -= NumConstraints;
+		lower = problem.lower_bound(idx);
+		upper = problem.upper_bound(idx);
+		normal.setZero();
+		normal(idx) = 1.;
+	}
+
+	// Equalities are described only by their lower side
+	equality = (upper - lower == 0.);
+	if (equality)
+		rhs = lower;
+	if (equality && upper_side)
+		return false;
+
+	// Converting Gx <= ub to -Gx >= -ub
+	if (!equality) {
+		if (upper_side) {
+			normal = -normal;
+			rhs = -upper;
+		} else
+			rhs = lower;
+	}
+
+	return fabs(rhs) < std::numeric_limits<double>::max();
+}
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
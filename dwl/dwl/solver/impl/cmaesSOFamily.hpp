@@ -1,9 +1,6 @@
 #ifndef DWL__SOLVER__CMAESSOFAMILY__IMPL_H
 #define DWL__SOLVER__CMAESSOFAMILY__IMPL_H
 
-#include <mutex>
-std::mutex fmtx;  // protects fitness function
-
 
 namespace dwl
 {
@@ -16,7 +13,10 @@ cmaesSOFamily<TScaling>::cmaesSOFamily() : cmaes_params_(NULL),
         initialized_(false), print_(false), with_gradient_(false), ftolerance_(1e-12),
 		family_((int) CMAES), sigma_(-1.), lambda_(-1), max_iteration_(-1),
 		max_fevals_(-1), elitism_(0), max_restarts_(0), multithreading_(false),
-		outfile_(false)
+		seed_(0), surrogate_(false), cache_(false), screening_quantile_(0.2),
+		surrogate_error_(0.), max_surrogate_error_(0.2),
+		value_spread_(1.), training_interval_(1), new_samples_(0), validation_interval_(10),
+		num_screened_(0), num_evaluations_(0), num_exact_evaluations_(0), outfile_(false)
 {
 	name_ = "cmaes family";
 }
@@ -25,7 +25,7 @@ cmaesSOFamily<TScaling>::cmaesSOFamily() : cmaes_params_(NULL),
 template<typename TScaling>
 cmaesSOFamily<TScaling>::~cmaesSOFamily()
 {
-
+	clearThreadModels();
 }
 
 
@@ -99,6 +99,14 @@ void cmaesSOFamily<TScaling>::setFromConfigFile(std::string filename)
 	if (yaml_reader.read(multithreading, "multithreads", cmaes_ns))
 		setMultithreading(multithreading);
 
+	// Reading the surrogate and cache options
+	bool surrogate;
+	if (yaml_reader.read(surrogate, "surrogate", cmaes_ns))
+		setSurrogate(surrogate);
+	bool cache;
+	if (yaml_reader.read(cache, "cache", cmaes_ns))
+		setEvaluationCache(cache);
+
 	// Reading the filename
 	bool active;
 	if (yaml_reader.read(active, "activate", ofile_ns)) {
@@ -221,8 +229,44 @@ void cmaesSOFamily<TScaling>::setMultithreading(bool multithreading)
 
 	// Setting up if the parameters pointer was initialized.
 	// Otherwise it will be initialized when init() is called
-	if (initialized_)
+	if (initialized_) {
 		cmaes_params_->set_mt_feval(multithreading_);
+		initThreadModels();
+	}
+}
+
+
+template<typename TScaling>
+void cmaesSOFamily<TScaling>::setRandomSeed(unsigned long seed)
+{
+	seed_ = seed;
+
+	if (initialized_)
+		init(); // Note that this parameter is only set in the init() calls
+}
+
+
+template<typename TScaling>
+void cmaesSOFamily<TScaling>::setSurrogate(bool surrogate)
+{
+	surrogate_ = surrogate;
+}
+
+
+template<typename TScaling>
+void cmaesSOFamily<TScaling>::setEvaluationCache(bool cache)
+{
+	cache_ = cache;
+}
+
+
+template<typename TScaling>
+double cmaesSOFamily<TScaling>::getExactEvaluationRatio() const
+{
+	if (num_evaluations_ == 0)
+		return 1.;
+
+	return (double) num_exact_evaluations_ / num_evaluations_;
 }
 
 
@@ -298,7 +342,7 @@ bool cmaesSOFamily<TScaling>::init()
 	cmaes_params_ =
 			new libcmaes::CMAParameters<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,
 															TScaling>>(x0, sigma_,
-																	   lambda_, 0, gp);
+																	   lambda_, seed_, gp);
 
 	// Setting the previous parameters values
 	initialized_ = true;
@@ -322,6 +366,7 @@ bool cmaesSOFamily<TScaling>::init()
 				 	 	 	 	  this, std::placeholders::_1, std::placeholders::_2);
 		cmaes_params_->set_gradient(with_gradient_);
 	}
+	resetEvaluations();
 
 	return true;
 }
@@ -334,6 +379,14 @@ bool cmaesSOFamily<TScaling>::compute(double allocated_time_secs)
 	model_->getStartingPoint(warm_point_.data(), warm_point_.size());
 	cmaes_params_->set_x0(warm_point_);
 
+	// Re-cloning the copies of the model per thread since its states (e.g. the initial or
+	// desired states) could have changed after the initialization
+	if (multithreading_)
+		initThreadModels();
+
+	// Resetting the cache and the surrogate since the model could have changed
+	resetEvaluations();
+
 	// Computing the solution
 	libcmaes::CMASolutions cmasols;
 	if (with_gradient_)
@@ -352,6 +405,11 @@ bool cmaesSOFamily<TScaling>::compute(double allocated_time_secs)
 		std::cout << std::endl;
 		std::cout << "Optimization took ";
 		std::cout << cmasols.elapsed_time() / 1000.0 << " seconds\n" << std::endl;
+		if (surrogate_ || cache_) {
+			std::cout << "Exact evaluations: " << num_exact_evaluations_ << " of "
+					<< num_evaluations_ << " (ratio " << getExactEvaluationRatio() << ")\n"
+					<< std::endl;
+		}
 	}
 
 	// Evaluation of the solution
@@ -362,19 +420,90 @@ bool cmaesSOFamily<TScaling>::compute(double allocated_time_secs)
 }
 
 
+template<typename TScaling>
+double cmaesSOFamily<TScaling>::evaluateFitness(const Eigen::VectorXd& decision)
+{
+	return fitnessFunction(decision.data(), decision.size());
+}
+
+
 template<typename TScaling>
 double cmaesSOFamily<TScaling>::fitnessFunction(const double* x,
 												const int& n)
 {
-	// Locking the thread for multi-threading cases
-	std::lock_guard<std::mutex> lck(fmtx);
+	Eigen::Map<const Eigen::VectorXd> point(x, n);
+	std::string key;
+	double prediction = 0.;
+	bool predicted = false;
+	{
+		std::lock_guard<std::mutex> lock(evaluation_mutex_);
+		num_evaluations_++;
+
+		// Looking for the decision vector in the cache
+		if (cache_) {
+			key.assign(reinterpret_cast<const char*>(x), n * sizeof(double));
+			std::unordered_map<std::string, double>::const_iterator it = cache_values_.find(key);
+			if (it != cache_values_.end())
+				return it->second;
+		}
+
+		// Pre-screening the offspring, i.e. it gets the predicted fitness if it isn't promising.
+		// Some of them are evaluated exactly for validating the surrogate
+		if (surrogate_ && surrogate_model_.isTrained()) {
+			prediction = surrogate_model_.predict(point);
+			predicted = true;
+
+			// The threshold is a quantile of the predictions of the last generation, so only
+			// the offsprings that are ranked as promising are evaluated exactly
+			predictions_.push_back(prediction);
+			if (predictions_.size() > training_interval_)
+				predictions_.pop_front();
+			std::vector<double> predictions(predictions_.begin(), predictions_.end());
+			unsigned int idx = (unsigned int) (screening_quantile_ * (predictions.size() - 1));
+			std::nth_element(predictions.begin(), predictions.begin() + idx, predictions.end());
+			if (surrogate_error_ < max_surrogate_error_ && prediction > predictions[idx]) {
+				if (++num_screened_ % validation_interval_ != 0)
+					return prediction;
+			}
+		}
+	}
+
+	// Taking a model that isn't evaluated by other thread
+	model::OptimizationModel* model = acquireModel();
 
 	// Numerical evaluation of the cost function
 	double obj_value = 0;
-	model_->evaluateCosts(obj_value, x, n);
+	model->evaluateCosts(obj_value, x, n);
 
 	if (constraint_dim_ > 0) {
-		obj_value += model_->evaluateAsSoftConstraints(x, n);
+		obj_value += model->evaluateAsSoftConstraints(x, n);
+	}
+
+	releaseModel(model);
+
+	{
+		std::lock_guard<std::mutex> lock(evaluation_mutex_);
+		num_exact_evaluations_++;
+		if (cache_)
+			cache_values_[key] = obj_value;
+
+		if (surrogate_) {
+			// Updating the prediction error, and training the surrogate with the new exact
+			// evaluations
+			if (predicted) {
+				double error = fabs(prediction - obj_value) / value_spread_;
+				surrogate_error_ = 0.8 * surrogate_error_ + 0.2 * error;
+			}
+
+			surrogate_model_.addSample(point, obj_value);
+			if (++new_samples_ >= training_interval_) {
+				if (surrogate_model_.train()) {
+					value_spread_ = std::max(surrogate_model_.getQuantile(0.9) -
+							surrogate_model_.getQuantile(0.1), 1e-12);
+				}
+				new_samples_ = 0;
+			}
+		}
 	}
 
 	return obj_value;
@@ -387,12 +516,106 @@ dVec cmaesSOFamily<TScaling>::gradientFitnessFunction(const double *x,
 {
 	dVec gradient(n);
 
-	// Evaluation of the gradient
-	model_->evaluateCostGradient(gradient.data(), n, x, n);
+	// Evaluation of the gradient, which includes the soft-cost of the constraints as the
+	// fitness function
+	model::OptimizationModel* model = acquireModel();
+	model->evaluateCostGradient(gradient.data(), n, x, n);
+	if (constraint_dim_ > 0) {
+		dVec soft_gradient(n);
+		model->evaluateSoftConstraintGradient(soft_gradient.data(), n, x, n);
+		gradient += soft_gradient;
+	}
+	releaseModel(model);
 
 	return gradient;
 }
 
+
+template<typename TScaling>
+void cmaesSOFamily<TScaling>::resetEvaluations()
+{
+	// The surrogate is trained once per generation
+	cache_values_.clear();
+	surrogate_model_.reset();
+	predictions_.clear();
+	surrogate_error_ = 0.;
+	new_samples_ = 0;
+	num_screened_ = 0;
+	num_evaluations_ = 0;
+	num_exact_evaluations_ = 0;
+	unsigned int state_dim = warm_point_.size();
+	if (lambda_ > 0)
+		training_interval_ = lambda_;
+	else
+		training_interval_ = 4 + (unsigned int) (3 * log((double) state_dim));
+}
+
+
+template<typename TScaling>
+void cmaesSOFamily<TScaling>::initThreadModels()
+{
+	// Deleting the previous copies since the model could have changed
+	clearThreadModels();
+
+	// Creating a copy per hardware thread, which is the default number of threads of the
+	// parallel evaluation of libcmaes
+	if (multithreading_) {
+		unsigned int num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+		for (unsigned int t = 0; t < num_threads; t++) {
+			model::OptimizationModel* model = model_->clone();
+			if (model == NULL) {
+				printf(YELLOW "Warning: the optimization model is not clonable, so the fitness "
+						"function will be evaluated serially\n" COLOR_RESET);
+				clearThreadModels();
+				break;
+			}
+
+			model->init(true);
+			thread_models_.push_back(model);
+		}
+	}
+
+	if (thread_models_.empty())
+		free_models_.push_back(model_);
+	else
+		free_models_ = thread_models_;
+}
+
+
+template<typename TScaling>
+void cmaesSOFamily<TScaling>::clearThreadModels()
+{
+	for (unsigned int t = 0; t < thread_models_.size(); t++)
+		delete thread_models_[t];
+
+	thread_models_.clear();
+	free_models_.clear();
+}
+
+
+template<typename TScaling>
+model::OptimizationModel* cmaesSOFamily<TScaling>::acquireModel()
+{
+	std::unique_lock<std::mutex> lock(models_mutex_);
+	models_cond_.wait(lock, [this]() { return !free_models_.empty(); });
+
+	model::OptimizationModel* model = free_models_.back();
+	free_models_.pop_back();
+
+	return model;
+}
+
+
+template<typename TScaling>
+void cmaesSOFamily<TScaling>::releaseModel(model::OptimizationModel* model)
+{
+	{
+		std::lock_guard<std::mutex> lock(models_mutex_);
+		free_models_.push_back(model);
+	}
+	models_cond_.notify_one();
+}
+
 } //@namespace solver
 } //@namespace dwl
 
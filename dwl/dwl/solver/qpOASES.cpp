@@ -9,7 +9,8 @@ namespace dwl
 namespace solver
 {
 
-qpOASES::qpOASES() : solver_(NULL), qpOASES_solution_(NULL), num_wsr_(10)
+qpOASES::qpOASES() : solver_(NULL), constant_solver_(NULL), bound_solver_(NULL),
+		setup_(false), initialized_constant_solver_(false), qpOASES_solution_(NULL), num_wsr_(10)
 {
 
 }
@@ -18,6 +19,9 @@ qpOASES::qpOASES() : solver_(NULL), qpOASES_solution_(NULL), num_wsr_(10)
 qpOASES::~qpOASES()
 {
 	delete solver_;
+	delete constant_solver_;
+	delete bound_solver_;
+	delete [] qpOASES_solution_;
 }
 
 
@@ -29,9 +33,11 @@ bool qpOASES::init(unsigned int num_variables,
 	constraints_ = num_constraints;
 
 	// Initializing the qpOASES solution global variable
+	delete [] qpOASES_solution_;
 	qpOASES_solution_ = new double[variables_];
 
 	// Initializing the SQP solver of qpOASES
+	delete solver_;
 	solver_ = new SQProblem(variables_, constraints_);
 	
 	// Setting the options of the SQP solver
@@ -57,49 +63,113 @@ bool qpOASES::compute(const Eigen::MatrixXd& hessian,
 		 	 	 	  const Eigen::VectorXd& upper_constraint,
 		 	 	 	  double cputime)
 {
-	// Initializing the solution vector
-	solution_ = Eigen::VectorXd::Zero(variables_);
-
-	// Ensuring the hessian matrix is row-major storage
-	Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> hessian_rowmajor = hessian;
-	
-	// Solving first QP
+	// Ensuring the hessian and constraint matrices are row-major storage. Note that the buffers
+	// are reused, so they are allocated only if the dimensions change. They are different from
+	// the ones of setup(), so the constant-matrix QP can be updated after this computation
+	sqp_hessian_rowmajor_ = hessian;
+	sqp_constraint_rowmajor_ = constraint_mat;
+
+	// Solving first QP. Note that qpOASES overwrites the number of working set recalculations
+	// with the performed ones
+	int num_wsr = num_wsr_;
 	returnValue retval;
 	if (!initialized_solver_) {
-		retval = solver_->init(hessian_rowmajor.data(),
+		retval = solver_->init(sqp_hessian_rowmajor_.data(),
 							   gradient.data(),
-							   constraint_mat.data(),
+							   sqp_constraint_rowmajor_.data(),
 							   lower_bound.data(), upper_bound.data(),
 							   lower_constraint.data(), upper_constraint.data(),
-							   num_wsr_, &cputime);
+							   num_wsr, &cputime);
 		if (retval == SUCCESSFUL_RETURN) {
 			printf("qpOASES problem successfully initialized");
 			initialized_solver_ = true;
 		}
 	} else
-		retval = solver_->hotstart(hessian_rowmajor.data(),
+		retval = solver_->hotstart(sqp_hessian_rowmajor_.data(),
 				   	   	   	   	   gradient.data(),
-				   	   	   	   	   constraint_mat.data(),
+				   	   	   	   	   sqp_constraint_rowmajor_.data(),
 				   	   	   	   	   lower_bound.data(), upper_bound.data(),
 				   	   	   	   	   lower_constraint.data(), upper_constraint.data(),
-				   	   	   	   	   num_wsr_, &cputime);
+				   	   	   	   	   num_wsr, &cputime);
 
-	if (solver_->isInfeasible())
-		printf("Warning: the quadratic programming is infeasible");
-		
-	if (retval == SUCCESSFUL_RETURN) {
-		solver_->getPrimalSolution(qpOASES_solution_);
-		Eigen::Map<Eigen::VectorXd> sol(qpOASES_solution_, variables_, 1);
-		solution_ = sol;
-	} else if (retval == RET_MAX_NWSR_REACHED) {
-		printf("The QP could not solve because the maximun number of WSR was reached");
-		return false;
+	return getSolution(solver_, retval, num_wsr, cputime);
+}
+
+
+void qpOASES::setup(const Eigen::MatrixXd& hessian,
+					const Eigen::MatrixXd& constraint_mat)
+{
+	// Copying once the constant matrices in row-major storage
+	hessian_rowmajor_ = hessian;
+	constraint_rowmajor_ = constraint_mat;
+
+	// Creating a new problem because the matrix factorizations have to be recomputed
+	Options my_options;
+	my_options.setToMPC();
+	delete constant_solver_;
+	delete bound_solver_;
+	constant_solver_ = NULL;
+	bound_solver_ = NULL;
+	if (constraints_ == 0) {
+		bound_solver_ = new QProblemB(variables_);
+		bound_solver_->setOptions(my_options);
 	} else {
-		printf("The QP could not find the solution");
-		return false;
-	}	
-	
-	return true;
+		constant_solver_ = new QProblem(variables_, constraints_);
+		constant_solver_->setOptions(my_options);
+	}
+
+	setup_ = true;
+	initialized_constant_solver_ = false;
+}
+
+
+bool qpOASES::update(const Eigen::VectorXd& gradient,
+					 const Eigen::VectorXd& lower_bound,
+					 const Eigen::VectorXd& upper_bound,
+					 const Eigen::VectorXd& lower_constraint,
+					 const Eigen::VectorXd& upper_constraint,
+					 double cputime)
+{
+	if (!setup_) {
+		printf(RED "FATAL: the constant matrices of the QP were not setup\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	// Solving the QP, which hotstarts from the last working set. Note that qpOASES overwrites
+	// the number of working set recalculations with the performed ones
+	int num_wsr = num_wsr_;
+	returnValue retval;
+	if (constraints_ == 0) {
+		if (!initialized_constant_solver_)
+			retval = bound_solver_->init(hessian_rowmajor_.data(),
+										 gradient.data(),
+										 lower_bound.data(), upper_bound.data(),
+										 num_wsr, &cputime);
+		else
+			retval = bound_solver_->hotstart(gradient.data(),
+											 lower_bound.data(), upper_bound.data(),
+											 num_wsr, &cputime);
+	} else {
+		if (!initialized_constant_solver_)
+			retval = constant_solver_->init(hessian_rowmajor_.data(),
+											gradient.data(),
+											constraint_rowmajor_.data(),
+											lower_bound.data(), upper_bound.data(),
+											lower_constraint.data(), upper_constraint.data(),
+											num_wsr, &cputime);
+		else
+			retval = constant_solver_->hotstart(gradient.data(),
+												lower_bound.data(), upper_bound.data(),
+												lower_constraint.data(), upper_constraint.data(),
+												num_wsr, &cputime);
+	}
+	if (retval == SUCCESSFUL_RETURN)
+		initialized_constant_solver_ = true;
+
+	if (constraints_ == 0)
+		return getSolution(bound_solver_, retval, num_wsr, cputime);
+	else
+		return getSolution(constant_solver_, retval, num_wsr, cputime);
 }
 
 
@@ -110,6 +180,38 @@ void qpOASES::setNumberOfWorkingSetRecalculations(double num_wsr)
 	printf("Setting the number of working set recalculations to %d", num_wsr_);
 }
 
+
+bool qpOASES::getSolution(QProblemB* solver,
+						  returnValue retval,
+						  int num_wsr,
+						  double cputime)
+{
+	// Recording the statistics of the solution
+	stats_.solve_time = cputime;
+	stats_.num_iterations = num_wsr;
+	stats_.num_active_bounds = solver->getNFX();
+	QProblem* constrained_solver = dynamic_cast<QProblem*>(solver);
+	if (constrained_solver != NULL)
+		stats_.num_active_constraints = constrained_solver->getNAC();
+	else
+		stats_.num_active_constraints = 0;
+
+	if (solver->isInfeasible())
+		printf("Warning: the quadratic programming is infeasible");
+
+	if (retval == SUCCESSFUL_RETURN) {
+		solver->getPrimalSolution(qpOASES_solution_);
+		solution_ = Eigen::Map<Eigen::VectorXd>(qpOASES_solution_, variables_, 1);
+	} else if (retval == RET_MAX_NWSR_REACHED) {
+		printf("The QP could not solve because the maximun number of WSR was reached");
+		return false;
+	} else {
+		printf("The QP could not find the solution");
+		return false;
+	}
+
+	return true;
+}
+
 } //@namespace solver
 } //@namespace dwl
-
@@ -2,6 +2,7 @@
 #define DWL__SOLVER__QPOASES__H
 
 #include <dwl/solver/QuadraticProgram.h>
+#include <dwl/utils/Macros.h>
 #include <qpOASES.hpp>
 
 
@@ -69,6 +70,34 @@ class qpOASES : public QuadraticProgram
 					 const Eigen::VectorXd& upper_constraint,
 					 double cputime);
 
+		/**
+		 * @brief Sets up the constant Hessian and constraint matrix. They are copied once in
+		 * row-major order, and the sequence of QPs is solved with QProblem, or QProblemB if there
+		 * are not constraints, which keep the matrix factorizations between hotstarts
+		 * @param const Eigen::MatrixXd& Hessian matrix
+		 * @param const Eigen::MatrixXd& Constraint matrix
+		 */
+		void setup(const Eigen::MatrixXd& hessian,
+				   const Eigen::MatrixXd& constraint_mat);
+
+		/**
+		 * @brief Hotstarts the QP defined in setup() with new gradient and bounds. The number of
+		 * working set recalculations is limited by setNumberOfWorkingSetRecalculations()
+	 	 * @param const Eigen::VectorXd Gradient vector
+	 	 * @param const Eigen::VectorXd Low bound vector
+	 	 * @param const Eigen::VectorXd Upper bound vector
+	 	 * @param const Eigen::VectorXd Low constraint vector
+	 	 * @param const Eigen::VectorXd Upper constraint vector
+	 	 * @param double CPU-time for computing the optimization
+	 	 * @return bool Label that indicates if the computation of the optimization is successful
+		 */
+		bool update(const Eigen::VectorXd& gradient,
+					const Eigen::VectorXd& lower_bound,
+					const Eigen::VectorXd& upper_bound,
+					const Eigen::VectorXd& lower_constraint,
+					const Eigen::VectorXd& upper_constraint,
+					double cputime);
+
 		/**
 		 * @brief Sets the number of working set recalculations used by qpOASES
 		 * @param double Number of working set recalculations
@@ -77,9 +106,41 @@ class qpOASES : public QuadraticProgram
 
 
 	private:
+		/**
+		 * @brief Gets the solution and statistics of a qpOASES return
+		 * @param QProblemB* qpOASES problem object
+		 * @param returnValue Return value of qpOASES
+		 * @param int Number of working set recalculations
+		 * @param double CPU-time of the solution
+		 * @return bool Label that indicates if the optimization is successful
+		 */
+		bool getSolution(QProblemB* solver,
+						 returnValue retval,
+						 int num_wsr,
+						 double cputime);
+
 		/** @brief SQProblem object which is used to solve the quadratic problem */
 		SQProblem* solver_;
 
+		/** @brief QProblem and QProblemB objects which are used to solve the constant-matrix QPs */
+		QProblem* constant_solver_;
+		QProblemB* bound_solver_;
+
+		/** @brief Labels that indicate if the constant-matrix QP was setup and initialized */
+		bool setup_;
+		bool initialized_constant_solver_;
+
+		/**
+		 * @brief Row-major copies of the constant Hessian and constraint matrices of setup(), which
+		 * are used by the QProblem (or QProblemB) object
+		 */
+		Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> hessian_rowmajor_;
+		Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> constraint_rowmajor_;
+
+		/** @brief Row-major copies of the Hessian and constraint matrices of compute() (SQProblem) */
+		Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> sqp_hessian_rowmajor_;
+		Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> sqp_constraint_rowmajor_;
+
 		/** @brief Optimal solution obtained with the implementation of qpOASES */
 		double* qpOASES_solution_;
 
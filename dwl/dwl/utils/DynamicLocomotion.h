@@ -57,6 +57,20 @@ struct Action3d
 	Weight cost;
 };
 
+/**
+ * @brief Struct that defines a 3d action of a lattice, i.e. the key offsets of the reached
+ * position, the key of the reached yaw, the body action (displacement and yaw rotation) and its
+ * cost
+ */
+struct LatticeAction3d
+{
+	int delta_key_x;
+	int delta_key_y;
+	unsigned short int key_yaw;
+	Eigen::Vector3d action;
+	Weight cost;
+};
+
 /**
  * @brief Struct that defines the search area
  */
@@ -113,11 +127,13 @@ struct ContactSearchRegion
  */
 struct RobotAndTerrain
 {
+	RobotAndTerrain() : height_map(NULL), resolution(0.) {}
+
 	Eigen::Vector3d body_action;
 	Pose3d pose;
 	Contact potential_contact;
 	std::vector<Contact> current_contacts;
-	std::map<Vertex, double> height_map;
+	const std::map<Vertex, double>* height_map; // points to the terrain height map
 	double resolution;
 };
 
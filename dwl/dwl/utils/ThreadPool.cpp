@@ -0,0 +1,131 @@
+#include <dwl/utils/ThreadPool.h>
+
+
+namespace dwl
+{
+
+namespace utils
+{
+
+ThreadPool::ThreadPool(unsigned int num_threads) : task_(NULL), pending_(0), generation_(0),
+		stop_(false)
+{
+	if (num_threads == 0)
+		num_threads = std::thread::hardware_concurrency();
+	if (num_threads == 0)
+		num_threads = 1;
+
+	for (unsigned int i = 0; i < num_threads; i++)
+		queues_.push_back(new WorkQueue());
+	for (unsigned int i = 0; i < num_threads; i++)
+		workers_.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+}
+
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	start_cv_.notify_all();
+
+	for (unsigned int i = 0; i < workers_.size(); i++)
+		workers_[i].join();
+	for (unsigned int i = 0; i < queues_.size(); i++)
+		delete queues_[i];
+}
+
+
+void ThreadPool::parallelFor(unsigned int size,
+							 const Task& task)
+{
+	if (size == 0)
+		return;
+
+	// The task has to be visible before any iteration is, since a worker of the previous loop
+	// could still be looking for iterations
+	task_ = &task;
+	pending_ = size;
+
+	// Distributing contiguous chunks of iterations among the workers
+	unsigned int num_threads = queues_.size();
+	for (unsigned int i = 0; i < num_threads; i++) {
+		std::lock_guard<std::mutex> lock(queues_[i]->mutex);
+		queues_[i]->begin = (unsigned long) i * size / num_threads;
+		queues_[i]->end = (unsigned long) (i + 1) * size / num_threads;
+	}
+
+	// Waking up the workers and waiting until all the iterations are computed
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++generation_;
+	}
+	start_cv_.notify_all();
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_cv_.wait(lock, [this] { return pending_ == 0; });
+}
+
+
+unsigned int ThreadPool::getNumberOfThreads() const
+{
+	return workers_.size();
+}
+
+
+void ThreadPool::workerLoop(unsigned int thread_id)
+{
+	unsigned long generation = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			start_cv_.wait(lock, [&] { return stop_ || generation_ != generation; });
+			if (stop_)
+				return;
+			generation = generation_;
+		}
+
+		unsigned int index;
+		while (popIteration(thread_id, index)) {
+			(*task_)(index, thread_id);
+
+			// The last finished iteration wakes up the calling thread
+			if (pending_.fetch_sub(1) == 1) {
+				std::lock_guard<std::mutex> lock(mutex_);
+				done_cv_.notify_all();
+			}
+		}
+	}
+}
+
+
+bool ThreadPool::popIteration(unsigned int thread_id,
+							  unsigned int& index)
+{
+	// Popping from the front of its own queue
+	{
+		WorkQueue& queue = *queues_[thread_id];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.begin < queue.end) {
+			index = queue.begin++;
+			return true;
+		}
+	}
+
+	// Stealing from the back of the queues of the other workers
+	unsigned int num_threads = queues_.size();
+	for (unsigned int i = 1; i < num_threads; i++) {
+		WorkQueue& queue = *queues_[(thread_id + i) % num_threads];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.begin < queue.end) {
+			index = --queue.end;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} //@namespace utils
+} //@namespace dwl
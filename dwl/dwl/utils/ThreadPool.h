@@ -0,0 +1,114 @@
+#ifndef DWL__UTILS__THREAD_POOL__H
+#define DWL__UTILS__THREAD_POOL__H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+
+namespace dwl
+{
+
+namespace utils
+{
+
+/**
+ * @class ThreadPool
+ * @brief A fixed set of worker threads that computes parallel loops through work stealing. Each
+ * worker owns a queue with a contiguous chunk of the loop iterations. When a worker runs out of
+ * iterations, it steals them from the back of the queue of another worker. The calling thread
+ * blocks until every iteration is computed. Note that nested calls to parallelFor (i.e. from
+ * a task) are not supported
+ */
+class ThreadPool
+{
+	public:
+		/**
+		 * @brief Task of a parallel loop
+		 * @param unsigned int Iteration index
+		 * @param unsigned int Identifier of the worker thread, in [0, getNumberOfThreads())
+		 */
+		typedef std::function<void(unsigned int, unsigned int)> Task;
+
+		/**
+		 * @brief Constructor function
+		 * @param unsigned int Number of worker threads. Zero uses the hardware concurrency
+		 */
+		ThreadPool(unsigned int num_threads = 0);
+
+		/** @brief Destructor function */
+		~ThreadPool();
+
+		/**
+		 * @brief Computes the task for every iteration in [0, size) and waits until all of them
+		 * are finished
+		 * @param unsigned int Number of iterations
+		 * @param const Task& Task to compute per iteration
+		 */
+		void parallelFor(unsigned int size,
+						 const Task& task);
+
+		/** @brief Gets the number of worker threads */
+		unsigned int getNumberOfThreads() const;
+
+
+	private:
+		/**
+		 * @brief Queue of pending iterations owned by a worker. Its iterations are the contiguous
+		 * range [begin, end), so popping and stealing them doesn't allocate
+		 */
+		struct WorkQueue
+		{
+			WorkQueue() : begin(0), end(0) {}
+
+			std::mutex mutex;
+			unsigned int begin;
+			unsigned int end;
+		};
+
+		/**
+		 * @brief Main loop of the worker threads
+		 * @param unsigned int Worker identifier
+		 */
+		void workerLoop(unsigned int thread_id);
+
+		/**
+		 * @brief Pops an iteration from the worker queue, or steals it from another worker
+		 * @param unsigned int Worker identifier
+		 * @param unsigned int& Iteration index
+		 * @return True if there was a pending iteration
+		 */
+		bool popIteration(unsigned int thread_id,
+						  unsigned int& index);
+
+		/** @brief Worker threads */
+		std::vector<std::thread> workers_;
+
+		/** @brief Per-worker queues of iterations */
+		std::vector<WorkQueue*> queues_;
+
+		/** @brief Current task */
+		const Task* task_;
+
+		/** @brief Number of iterations that are not finished yet */
+		std::atomic<unsigned int> pending_;
+
+		/** @brief Generation of the current parallel loop, used for waking up the workers */
+		unsigned long generation_;
+
+		/** @brief Indicates that the workers have to finish */
+		bool stop_;
+
+		/** @brief Synchronization of the start and end of the parallel loops */
+		std::mutex mutex_;
+		std::condition_variable start_cv_;
+		std::condition_variable done_cv_;
+};
+
+} //@namespace utils
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,112 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/solver/AStar.h>
+#include <dwl/model/GridBasedBodyAdjacency.h>
+
+
+
+const double resolution = 0.04;
+
+
+/**
+ * @brief Synthetic body feature with an expensive cost, which is evaluated concurrently for the
+ * successors of an expansion. The override specifiers check that it matches the const interface
+ * of the features
+ */
+class RippleFeature : public dwl::environment::Feature
+{
+	public:
+		RippleFeature()
+		{
+			name_ = "Ripple";
+		}
+
+		void computeCost(double& cost_value,
+						 const dwl::RobotAndTerrain& info) const override
+		{
+			cost_value = 0.;
+			for (unsigned int k = 0; k < 200; k++)
+				cost_value += fabs(sin(info.pose.position(0) * k + info.pose.position(1))) * 1e-3;
+		}
+};
+
+
+/** @brief Sets a random terrain with a costly wall, which has a gap in the upper part */
+void setTerrain(dwl::environment::TerrainMap& terrain)
+{
+	terrain.setResolution(resolution, true);
+	terrain.setStateResolution(resolution, M_PI / 16);
+
+	dwl::TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	srand(2);
+	for (double x = -0.5; x < 1.5; x += resolution) {
+		for (double y = -0.5; y < 1.5; y += resolution) {
+			dwl::TerrainCell cell;
+			terrain.getTerrainSpaceModel().coordToKeyChecked(cell.key,
+					Eigen::Vector3d(x + resolution / 2, y + resolution / 2, 0.));
+			cell.cost = 1. + 3. * rand() / RAND_MAX;
+			if (x > 0.4 && x < 0.7 && y < 1.1)
+				cell.cost = 40.;
+			terrain_data.data.push_back(cell);
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+}
+
+
+/** @brief Computes the body path with A* given a number of threads of the adjacency model */
+void computeBodyPath(double& cost,
+					 unsigned int& expansions,
+					 std::list<dwl::Vertex>& path,
+					 dwl::robot::Robot& robot,
+					 dwl::environment::TerrainMap& terrain,
+					 unsigned int num_threads)
+{
+	dwl::model::GridBasedBodyAdjacency* adjacency = new dwl::model::GridBasedBodyAdjacency();
+	adjacency->addFeature(new RippleFeature());
+	adjacency->setNumberOfThreads(num_threads);
+
+	// A negligible cost-to-go gain makes the search expand most of the terrain, instead of
+	// going greedily to the target
+	adjacency->setCostToGoHeuristic(true, 1e-9);
+
+	dwl::solver::AStar solver;
+	solver.setAdjacencyModel(adjacency);
+	solver.reset(&robot, &terrain);
+	BOOST_REQUIRE(solver.init());
+
+	dwl::Vertex source, target;
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	space_model.stateToVertex(source, Eigen::Vector3d(-0.3, -0.3, 0.));
+	space_model.stateToVertex(target, Eigen::Vector3d(1.3, 0.2, 0.));
+	BOOST_REQUIRE(solver.compute(source, target, std::numeric_limits<double>::max()));
+
+	cost = solver.getMinimumCost();
+	expansions = solver.getNumberOfExpansions();
+	path = solver.getShortestPath(source, target);
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_successors) // specify a test case for the parallel successor costs
+{
+	dwl::robot::Robot robot;
+	robot.read(DWL_SOURCE_DIR"/config/hyq.yarf");
+	dwl::environment::TerrainMap terrain;
+	setTerrain(terrain);
+
+	// The successor costs are the same with one and four threads, so the search is the same
+	double serial_cost, parallel_cost;
+	unsigned int serial_expansions, parallel_expansions;
+	std::list<dwl::Vertex> serial_path, parallel_path;
+	computeBodyPath(serial_cost, serial_expansions, serial_path, robot, terrain, 1);
+	computeBodyPath(parallel_cost, parallel_expansions, parallel_path, robot, terrain, 4);
+
+	BOOST_CHECK_EQUAL(serial_cost, parallel_cost);
+	BOOST_CHECK_EQUAL(serial_expansions, parallel_expansions);
+	BOOST_CHECK(serial_path == parallel_path);
+}
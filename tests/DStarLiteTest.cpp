@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/solver/AStar.h>
+#include <dwl/solver/DStarLite.h>
+#include <model/TerrainGridAdjacency.cpp>
+
+
+
+const double resolution = 0.04;
+const unsigned short int grid_size = 20;
+
+
+/** @brief Gets the cell of a terrain key */
+dwl::TerrainCell terrainCell(unsigned short int x,
+							 unsigned short int y,
+							 double cost)
+{
+	dwl::TerrainCell cell;
+	cell.key = dwl::Key(x, y, 0);
+	cell.cost = cost;
+	return cell;
+}
+
+
+/**
+ * @brief Sets a grid of cells with a wall of costly cells in the middle column, which has a gap
+ * in the upper row
+ */
+void setTerrain(dwl::environment::TerrainMap& terrain)
+{
+	dwl::TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	for (unsigned short int x = 0; x < grid_size; x++) {
+		for (unsigned short int y = 0; y < grid_size; y++) {
+			double cost = 1. + 0.1 * ((x * 7 + y * 3) % 5);
+			if (x == grid_size / 2 && y < grid_size - 2)
+				cost = 100.;
+			terrain_data.data.push_back(terrainCell(x, y, cost));
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+	terrain.setStateResolution(resolution, M_PI / 200);
+}
+
+
+/** @brief Gets the state vertex of a terrain key */
+dwl::Vertex stateVertex(dwl::environment::TerrainMap& terrain,
+						unsigned short int x,
+						unsigned short int y)
+{
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	Eigen::Vector3d state;
+	space_model.keyToCoord(state(0), x, true);
+	space_model.keyToCoord(state(1), y, true);
+	state(2) = 0.;
+
+	dwl::Vertex vertex;
+	space_model.stateToVertex(vertex, state);
+	return vertex;
+}
+
+
+/** @brief Computes the minimum cost of A* with the cost-to-go heuristic */
+double computeAStarCost(dwl::environment::TerrainMap& terrain,
+						dwl::Vertex source,
+						dwl::Vertex target)
+{
+	dwl::model::TerrainGridAdjacency* adjacency = new dwl::model::TerrainGridAdjacency();
+	adjacency->setCostToGoHeuristic(true);
+
+	dwl::solver::AStar solver;
+	solver.setAdjacencyModel(adjacency);
+	solver.reset(NULL, &terrain);
+	BOOST_REQUIRE(solver.compute(source, target, std::numeric_limits<double>::max()));
+
+	return solver.getMinimumCost();
+}
+
+
+BOOST_AUTO_TEST_CASE(replanning) // specify a test case for the replanning of D* Lite
+{
+	dwl::environment::TerrainMap terrain;
+	setTerrain(terrain);
+
+	// D* Lite with the cost-to-go heuristic, which doesn't read the table per target
+	dwl::model::TerrainGridAdjacency* adjacency = new dwl::model::TerrainGridAdjacency();
+	adjacency->setCostToGoHeuristic(true);
+	dwl::solver::DStarLite solver;
+	solver.setAdjacencyModel(adjacency);
+	solver.reset(NULL, &terrain);
+
+	dwl::Vertex source = stateVertex(terrain, 2, 3);
+	dwl::Vertex target = stateVertex(terrain, grid_size - 3, 4);
+	BOOST_REQUIRE(solver.compute(source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_CLOSE(solver.getMinimumCost(), computeAStarCost(terrain, source, target), 1e-9);
+
+	// Closing the gap of the wall and moving the source, which is repaired by D* Lite
+	std::vector<dwl::Vertex> changed_vertices;
+	for (unsigned short int y = grid_size - 2; y < grid_size; y++) {
+		terrain.addCellToTerrainMap(terrainCell(grid_size / 2, y, 100.));
+		changed_vertices.push_back(stateVertex(terrain, grid_size / 2, y));
+	}
+	solver.updateVertices(changed_vertices);
+
+	source = stateVertex(terrain, 3, 4);
+	BOOST_REQUIRE(solver.compute(source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_CLOSE(solver.getMinimumCost(), computeAStarCost(terrain, source, target), 1e-9);
+	BOOST_CHECK_EQUAL(adjacency->num_heuristic_queries_, 0);
+}
@@ -0,0 +1,69 @@
+#include <dwl/ocp/OptimalControl.h>
+#include <dwl/solver/DifferentialDynamicProgramming.h>
+#include <model/DoubleIntegratorDynamicalSystem.cpp>
+#include <model/DoubleIntegratorCost.cpp>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+
+
+/**
+ * @brief Solves the linear-quadratic problem of the double integrator from its KKT system, i.e.
+ * the equality-constrained QP whose solution is the Riccati one
+ */
+Eigen::VectorXd solveKKT(unsigned int horizon,
+						 double step_time)
+{
+	unsigned int num_vars = 3 * horizon;
+	unsigned int num_constraints = 2 * horizon;
+	Eigen::MatrixXd kkt = Eigen::MatrixXd::Zero(num_vars + num_constraints,
+												num_vars + num_constraints);
+	Eigen::VectorXd rhs = Eigen::VectorXd::Zero(num_vars + num_constraints);
+	for (unsigned int k = 0; k < horizon; k++) {
+		// Hessian of the cost
+		kkt(3 * k, 3 * k) = 2.;
+		kkt(3 * k + 1, 3 * k + 1) = 2.;
+		kkt(3 * k + 2, 3 * k + 2) = 0.2;
+
+		// Dynamics, i.e. p_k - p_{k-1} - dt v_k = 0 and v_k - v_{k-1} - dt a_k = 0
+		Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2, num_vars);
+		A(0, 3 * k) = 1.;
+		A(0, 3 * k + 1) = -step_time;
+		A(1, 3 * k + 1) = 1.;
+		A(1, 3 * k + 2) = -step_time;
+		if (k > 0) {
+			A(0, 3 * (k - 1)) = -1.;
+			A(1, 3 * (k - 1) + 1) = -1.;
+		} else
+			rhs(num_vars) = 1.; // initial position
+		kkt.block(num_vars + 2 * k, 0, 2, num_vars) = A;
+		kkt.block(0, num_vars + 2 * k, num_vars, 2) = A.transpose();
+	}
+
+	return kkt.fullPivLu().solve(rhs).head(num_vars);
+}
+
+
+BOOST_AUTO_TEST_CASE(linear_quadratic_problem) // specify a test case for the Riccati solution
+{
+	unsigned int horizon = 20;
+	dwl::ocp::OptimalControl optimal_control;
+	dwl::ocp::DynamicalSystem* dynamical_system = new dwl::model::DoubleIntegratorDynamicalSystem();
+	optimal_control.addDynamicalSystem(dynamical_system);
+	optimal_control.addCost(new dwl::model::DoubleIntegratorCost());
+	optimal_control.setHorizon(horizon);
+
+	dwl::solver::DifferentialDynamicProgramming solver;
+	solver.setOptimizationModel(&optimal_control);
+	solver.setMaxIteration(200);
+	solver.setConvergenceTolerance(1e-10);
+	solver.setConstraintViolationTolerance(1e-8);
+	solver.init();
+	BOOST_REQUIRE(solver.compute());
+
+	Eigen::VectorXd solution = solver.getSolution();
+	Eigen::VectorXd kkt_solution = solveKKT(horizon, dynamical_system->getFixedStepTime());
+	BOOST_REQUIRE_EQUAL(solution.size(), kkt_solution.size());
+	BOOST_CHECK_SMALL((solution - kkt_solution).lpNorm<Eigen::Infinity>(), 1e-4);
+}
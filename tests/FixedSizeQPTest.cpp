@@ -0,0 +1,112 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/solver/FixedSizeQP.h>
+#include <dwl/solver/QuadProg++QP.h>
+
+
+
+typedef dwl::solver::FixedSizeQP<4,3> SmallQP;
+typedef std::vector<SmallQP::Problem, Eigen::aligned_allocator<SmallQP::Problem> > ProblemVector;
+typedef std::vector<SmallQP::VariableVector,
+					Eigen::aligned_allocator<SmallQP::VariableVector> > SolutionVector;
+
+
+/**
+ * @brief Generates a feasible QP, where the first constraint is an equality, the last one is
+ * one-sided, and the last variable is unbounded
+ */
+void generateQP(SmallQP::Problem& problem)
+{
+	SmallQP::HessianMatrix factor = SmallQP::HessianMatrix::Random();
+	problem.hessian = factor * factor.transpose() + SmallQP::HessianMatrix::Identity();
+	problem.gradient = 5. * SmallQP::VariableVector::Random();
+	problem.constraint_mat = SmallQP::ConstraintMatrix::Random();
+
+	// The bounds are defined around a feasible point
+	SmallQP::VariableVector point = 0.5 * SmallQP::VariableVector::Random();
+	SmallQP::ConstraintVector value = problem.constraint_mat * point;
+	problem.lower_constraint = value - 0.2 * SmallQP::ConstraintVector::Ones();
+	problem.upper_constraint = value + 0.2 * SmallQP::ConstraintVector::Ones();
+	problem.lower_constraint(0) = problem.upper_constraint(0) = value(0);
+	problem.upper_constraint(2) = std::numeric_limits<double>::infinity();
+	problem.lower_bound = SmallQP::VariableVector::Constant(-1.);
+	problem.upper_bound = SmallQP::VariableVector::Constant(1.);
+	problem.lower_bound(3) = -std::numeric_limits<double>::infinity();
+	problem.upper_bound(3) = std::numeric_limits<double>::infinity();
+}
+
+
+/** @brief Solves the QP with QuadProg++ */
+Eigen::VectorXd solveWithQuadProg(const SmallQP::Problem& problem)
+{
+	dwl::solver::QuadProgQP solver;
+	solver.init(4, 3);
+	BOOST_REQUIRE(solver.compute(problem.hessian, problem.gradient, problem.constraint_mat,
+								 problem.lower_bound, problem.upper_bound,
+								 problem.lower_constraint, problem.upper_constraint, 0.));
+
+	return solver.getOptimalSolution();
+}
+
+
+BOOST_AUTO_TEST_CASE(random_problems) // specify a test case for comparing with QuadProg++
+{
+	srand(1);
+	SmallQP qp;
+	SmallQP::Problem problem;
+	SmallQP::VariableVector solution;
+	double max_error = 0.;
+	for (unsigned int i = 0; i < 2000; i++) {
+		generateQP(problem);
+		BOOST_REQUIRE(qp.solve(solution, problem));
+		max_error = std::max(max_error,
+							 (solution - solveWithQuadProg(problem)).lpNorm<Eigen::Infinity>());
+	}
+	BOOST_CHECK_SMALL(max_error, 1e-12);
+}
+
+
+BOOST_AUTO_TEST_CASE(batch_problems) // specify a test case for the batch solution
+{
+	srand(2);
+	SmallQP qp;
+	ProblemVector problems(50);
+	for (unsigned int i = 0; i < problems.size(); i++)
+		generateQP(problems[i]);
+
+	// Solving the batch with a thread pool, and with a shared Hessian
+	dwl::utils::ThreadPool pool(2);
+	SolutionVector solutions;
+	std::vector<bool> success;
+	BOOST_REQUIRE_EQUAL(qp.solveBatch(solutions, success, problems, &pool), problems.size());
+
+	ProblemVector shared_problems = problems;
+	for (unsigned int i = 1; i < shared_problems.size(); i++)
+		shared_problems[i].hessian = shared_problems[0].hessian;
+	SolutionVector shared_solutions;
+	BOOST_REQUIRE_EQUAL(qp.solveBatch(shared_solutions, success, shared_problems),
+						problems.size());
+
+	for (unsigned int i = 0; i < problems.size(); i++) {
+		BOOST_CHECK_SMALL((solutions[i] - solveWithQuadProg(problems[i])).norm(), 1e-12);
+		BOOST_CHECK_SMALL((shared_solutions[i] -
+				solveWithQuadProg(shared_problems[i])).norm(), 1e-12);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(infeasible_problem) // specify a test case for an infeasible QP
+{
+	srand(3);
+	SmallQP qp;
+	SmallQP::Problem problem;
+	generateQP(problem);
+
+	// The first variable can't be above its upper bound
+	problem.lower_bound(0) = 2.;
+	SmallQP::VariableVector solution;
+	BOOST_CHECK(!qp.solve(solution, problem));
+}
@@ -0,0 +1,169 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/ocp/OptimalControl.h>
+#include <dwl/solver/IpoptNLP.h>
+#include <model/HS071DynamicalSystem.cpp>
+#include <model/HS071Cost.cpp>
+
+
+
+/** @brief Solution of a knot of the HS071 problem */
+Eigen::VectorXd hs071Solution()
+{
+	Eigen::VectorXd solution(4);
+	solution << 1.0, 4.74299963, 3.82114998, 1.37940829;
+	return solution;
+}
+
+
+/** @brief Adds the HS071 problem to the optimal control */
+void addHS071Problem(dwl::ocp::OptimalControl& optimal_control,
+					 unsigned int horizon)
+{
+	optimal_control.addDynamicalSystem(new dwl::model::HS071DynamicalSystem());
+	optimal_control.addCost(new dwl::model::HS071Cost());
+	optimal_control.setHorizon(horizon);
+	optimal_control.init(false);
+}
+
+
+/** @brief Gets the starting point of the optimal control */
+Eigen::VectorXd getStartingPoint(dwl::ocp::OptimalControl& optimal_control,
+								 unsigned int decision_dim)
+{
+	Eigen::VectorXd starting_point(decision_dim);
+	optimal_control.getStartingPoint(starting_point.data(), decision_dim);
+	return starting_point;
+}
+
+
+/**
+ * @brief Sets the solution of the HS071 problem with a displacement per knot, so the shifted
+ * knots and the extrapolated tail are distinguishable
+ */
+Eigen::VectorXd setHS071Solution(dwl::ocp::OptimalControl& optimal_control,
+								 unsigned int horizon)
+{
+	unsigned int decision_dim = 4 * horizon;
+	unsigned int constraint_dim = 2 * horizon;
+	Eigen::VectorXd solution(decision_dim);
+	for (unsigned int k = 0; k < horizon; k++)
+		solution.segment(4 * k, 4) = hs071Solution() + Eigen::VectorXd::Constant(4, 0.1 * k);
+	Eigen::VectorXd bound_mult = Eigen::VectorXd::Ones(decision_dim);
+	Eigen::VectorXd constraint_mult = Eigen::VectorXd::Ones(constraint_dim);
+
+	optimal_control.setSolution(solution.data(),
+								bound_mult.data(), bound_mult.data(), decision_dim,
+								constraint_mult.data(), constraint_dim);
+	return solution;
+}
+
+
+BOOST_AUTO_TEST_CASE(cold_start) // specify a test case for discarding the last solution
+{
+	dwl::ocp::OptimalControl optimal_control;
+	addHS071Problem(optimal_control, 3);
+	Eigen::VectorXd default_point = getStartingPoint(optimal_control, 12);
+
+	// Without warm start, the last solution isn't used and neither are its multipliers
+	setHS071Solution(optimal_control, 3);
+	BOOST_CHECK_SMALL((getStartingPoint(optimal_control, 12) - default_point).norm(), 1e-12);
+
+	Eigen::VectorXd bound_lower_mult(12), bound_upper_mult(12), constraint_mult(6);
+	BOOST_CHECK(!optimal_control.getStartingMultipliers(bound_lower_mult.data(),
+														bound_upper_mult.data(), 12,
+														constraint_mult.data(), 6));
+
+	// The horizon isn't shifted after discarding the solution
+	BOOST_CHECK(!optimal_control.shiftHorizon(1));
+}
+
+
+BOOST_AUTO_TEST_CASE(warm_start_point) // specify a test case for reusing the last solution
+{
+	dwl::ocp::OptimalControl optimal_control;
+	addHS071Problem(optimal_control, 3);
+	optimal_control.setWarmStart(true);
+
+	// With warm start, every optimization starts from the last solution
+	Eigen::VectorXd solution = setHS071Solution(optimal_control, 3);
+	BOOST_CHECK_SMALL((getStartingPoint(optimal_control, 12) - solution).norm(), 1e-12);
+	BOOST_CHECK_SMALL((getStartingPoint(optimal_control, 12) - solution).norm(), 1e-12);
+}
+
+
+BOOST_AUTO_TEST_CASE(shifted_point) // specify a test case for the shifted starting point
+{
+	dwl::ocp::OptimalControl optimal_control;
+	addHS071Problem(optimal_control, 3);
+	Eigen::VectorXd default_point = getStartingPoint(optimal_control, 12);
+
+	// The knots are moved towards the beginning and the tail is extrapolated from the last two
+	// knots. The shifted point is used once even without warm start
+	Eigen::VectorXd solution = setHS071Solution(optimal_control, 3);
+	BOOST_REQUIRE(optimal_control.shiftHorizon(1));
+	Eigen::VectorXd shifted_point = getStartingPoint(optimal_control, 12);
+	BOOST_CHECK_SMALL((shifted_point.head(8) - solution.tail(8)).norm(), 1e-12);
+	Eigen::VectorXd tail = 2 * solution.tail(4) - solution.segment(4, 4);
+	BOOST_CHECK_SMALL((shifted_point.tail(4) - tail).norm(), 1e-12);
+
+	// The next optimization starts from the default point again
+	BOOST_CHECK_SMALL((getStartingPoint(optimal_control, 12) - default_point).norm(), 1e-12);
+}
+
+
+BOOST_AUTO_TEST_CASE(warm_start) // specify a test case for the warm start of Ipopt
+{
+	dwl::ocp::OptimalControl optimal_control;
+	optimal_control.addDynamicalSystem(new dwl::model::HS071DynamicalSystem());
+	optimal_control.addCost(new dwl::model::HS071Cost());
+
+	dwl::solver::IpoptNLP solver;
+	solver.setOptimizationModel(&optimal_control);
+	solver.setPrintLevel(0);
+	solver.setWarmStart(true);
+	BOOST_REQUIRE(solver.init());
+
+	// The first solve starts from the default point, and the second one from the primal and dual
+	// solution of the first one
+	BOOST_REQUIRE(solver.compute());
+	Eigen::VectorXd cold_solution = solver.getSolution();
+	int cold_iterations = solver.getNumberOfIterations();
+	BOOST_REQUIRE(solver.compute());
+	Eigen::VectorXd warm_solution = solver.getSolution();
+	int warm_iterations = solver.getNumberOfIterations();
+
+	BOOST_REQUIRE_EQUAL(warm_solution.size(), 4);
+	BOOST_CHECK_SMALL((cold_solution - hs071Solution()).norm(), 1e-6);
+	BOOST_CHECK_SMALL((warm_solution - hs071Solution()).norm(), 1e-6);
+	BOOST_CHECK_LT(warm_iterations, cold_iterations);
+
+	// Starting from the shifted solution. The single knot is held, so it's also a warm start
+	BOOST_REQUIRE(optimal_control.shiftHorizon(1));
+	BOOST_REQUIRE(solver.compute());
+	BOOST_CHECK_SMALL((solver.getSolution() - hs071Solution()).norm(), 1e-6);
+	BOOST_CHECK_LT(solver.getNumberOfIterations(), cold_iterations);
+}
+
+
+BOOST_AUTO_TEST_CASE(repeated_cold_start) // specify a test case for the cold start of Ipopt
+{
+	dwl::ocp::OptimalControl optimal_control;
+	optimal_control.addDynamicalSystem(new dwl::model::HS071DynamicalSystem());
+	optimal_control.addCost(new dwl::model::HS071Cost());
+
+	dwl::solver::IpoptNLP solver;
+	solver.setOptimizationModel(&optimal_control);
+	solver.setPrintLevel(0);
+	BOOST_REQUIRE(solver.init());
+
+	// Both solves start from the default point, so they take the same iterations
+	BOOST_REQUIRE(solver.compute());
+	int first_iterations = solver.getNumberOfIterations();
+	BOOST_REQUIRE(solver.compute());
+	BOOST_CHECK_SMALL((solver.getSolution() - hs071Solution()).norm(), 1e-6);
+	BOOST_CHECK_EQUAL(solver.getNumberOfIterations(), first_iterations);
+}
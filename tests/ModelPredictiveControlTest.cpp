@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/locomotion/ModelPredictiveControl.h>
+#include <dwl/solver/QuadProg++QP.h>
+#include <model/DoubleIntegratorLinearSystem.cpp>
+
+
+
+/**
+ * @brief Sets up the MPC of the double integrator, whose inputs are bounded by |u| <= 1. The
+ * velocity constraint |v| <= max_velocity is added if it is finite
+ */
+void setupMPC(dwl::locomotion::ModelPredictiveControl& mpc,
+			  dwl::model::DoubleIntegratorLinearSystem& model,
+			  dwl::solver::QuadProgQP& solver,
+			  dwl::locomotion::MPCFormulation formulation,
+			  double max_velocity)
+{
+	Eigen::MatrixXd Q = Eigen::Vector2d(10., 1.).asDiagonal();
+	Eigen::MatrixXd P = Eigen::Vector2d(100., 10.).asDiagonal();
+	Eigen::MatrixXd R = Eigen::MatrixXd::Constant(1, 1, 0.1);
+
+	mpc.setFormulation(formulation);
+	mpc.setHorizon(15);
+	mpc.setWeights(Q, P, R);
+	mpc.setInputBounds(Eigen::VectorXd::Constant(1, -1.), Eigen::VectorXd::Constant(1, 1.));
+	if (max_velocity < std::numeric_limits<double>::infinity()) {
+		Eigen::MatrixXd M(1, 2);
+		M << 0., 1.;
+		mpc.setStateConstraints(M,
+								Eigen::VectorXd::Constant(1, -max_velocity),
+								Eigen::VectorXd::Constant(1, max_velocity));
+	}
+	BOOST_REQUIRE(mpc.reset(&model, &solver));
+	BOOST_REQUIRE(mpc.init());
+}
+
+
+/**
+ * @brief Runs the condensed and sparse MPC in closed loop, and checks that both give the same
+ * input sequence of the horizon in each iteration
+ */
+void checkSparseAgainstCondensed(double max_velocity)
+{
+	dwl::model::DoubleIntegratorLinearSystem condensed_model(0.1), sparse_model(0.1);
+	dwl::solver::QuadProgQP condensed_solver, sparse_solver;
+	dwl::locomotion::ModelPredictiveControl condensed_mpc, sparse_mpc;
+	setupMPC(condensed_mpc, condensed_model, condensed_solver,
+			 dwl::locomotion::Condensed, max_velocity);
+	setupMPC(sparse_mpc, sparse_model, sparse_solver,
+			 dwl::locomotion::Sparse, max_velocity);
+
+	Eigen::MatrixXd A, B;
+	condensed_model.computeLinearSystem(A, B);
+	Eigen::VectorXd state = Eigen::Vector2d(1., 0.);
+	Eigen::VectorXd reference = Eigen::Vector2d::Zero();
+	for (unsigned int i = 0; i < 10; i++) {
+		BOOST_REQUIRE(condensed_mpc.update(state, reference));
+		BOOST_REQUIRE(sparse_mpc.update(state, reference));
+
+		// The sparse solution interleaves the inputs with the states, i.e. [u_k, x_{k+1}]
+		const Eigen::VectorXd& condensed_solution = condensed_mpc.getSolution();
+		const Eigen::VectorXd& sparse_solution = sparse_mpc.getSolution();
+		for (unsigned int k = 0; k < condensed_solution.size(); k++)
+			BOOST_CHECK_SMALL(condensed_solution(k) - sparse_solution(3 * k), 1e-8);
+
+		// Applying the control signal to the plant
+		state = A * state + B * condensed_mpc.getControlSignal();
+		if (max_velocity < std::numeric_limits<double>::infinity())
+			BOOST_CHECK(fabs(state(1)) <= max_velocity + 1e-8);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(input_bounded_mpc) // specify a test case for the bounded inputs
+{
+	checkSparseAgainstCondensed(std::numeric_limits<double>::infinity());
+}
+
+
+BOOST_AUTO_TEST_CASE(state_constrained_mpc) // specify a test case for the state constraints
+{
+	checkSparseAgainstCondensed(0.3);
+}
+
+
+BOOST_AUTO_TEST_CASE(time_varying_mpc) // specify a test case for the setup in each update
+{
+	// A time-varying model sets up the QP matrices in every update, so it has to give the same
+	// inputs as the constant matrices of the time-invariant one
+	dwl::model::DoubleIntegratorLinearSystem invariant_model(0.1);
+	dwl::model::DoubleIntegratorLinearSystem condensed_model(0.1, true), sparse_model(0.1, true);
+	dwl::solver::QuadProgQP invariant_solver, condensed_solver, sparse_solver;
+	dwl::locomotion::ModelPredictiveControl invariant_mpc, condensed_mpc, sparse_mpc;
+	setupMPC(invariant_mpc, invariant_model, invariant_solver, dwl::locomotion::Condensed, 0.3);
+	setupMPC(condensed_mpc, condensed_model, condensed_solver, dwl::locomotion::Condensed, 0.3);
+	setupMPC(sparse_mpc, sparse_model, sparse_solver, dwl::locomotion::Sparse, 0.3);
+
+	Eigen::MatrixXd A, B;
+	invariant_model.computeLinearSystem(A, B);
+	Eigen::VectorXd state = Eigen::Vector2d(1., 0.);
+	Eigen::VectorXd reference = Eigen::Vector2d::Zero();
+	for (unsigned int i = 0; i < 5; i++) {
+		BOOST_REQUIRE(invariant_mpc.update(state, reference));
+		BOOST_REQUIRE(condensed_mpc.update(state, reference));
+		BOOST_REQUIRE(sparse_mpc.update(state, reference));
+		BOOST_CHECK_SMALL((invariant_mpc.getControlSignal() -
+				condensed_mpc.getControlSignal()).norm(), 1e-8);
+		BOOST_CHECK_SMALL((invariant_mpc.getControlSignal() -
+				sparse_mpc.getControlSignal()).norm(), 1e-8);
+
+		// The time-varying models are linearized around the measured state
+		BOOST_CHECK(condensed_model.getOperationPointsStates() == state);
+		state = A * state + B * invariant_mpc.getControlSignal();
+	}
+}
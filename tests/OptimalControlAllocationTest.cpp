@@ -0,0 +1,109 @@
+#include <dwl/ocp/OptimalControl.h>
+#include <dwl/ocp/FullDynamicalSystem.h>
+#include <model/HS071DynamicalSystem.cpp>
+#include <model/HS071Cost.cpp>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+
+
+// Counting the heap allocations. Eigen and the standard containers allocate through malloc, so
+// the counter is incremented in the malloc of the test executable
+extern "C" void* __libc_malloc(size_t size);
+
+bool count_allocations = false;
+unsigned int num_allocations = 0;
+
+extern "C" void* malloc(size_t size)
+{
+	if (count_allocations)
+		++num_allocations;
+
+	return __libc_malloc(size);
+}
+
+
+/**
+ * @brief Initializes the problem and counts the allocations of its first evaluation of the
+ * constraints and costs, i.e. without warming up the state buffers
+ */
+unsigned int countEvaluationAllocations(dwl::ocp::OptimalControl& optimal_control,
+										unsigned int horizon,
+										unsigned int num_threads)
+{
+	optimal_control.setHorizon(horizon);
+	optimal_control.setNumberOfThreads(num_threads);
+	optimal_control.init(false);
+
+	unsigned int state_dim = horizon * optimal_control.getDynamicalSystem()->getDimensionOfState();
+	unsigned int constraint_dim =
+			horizon * optimal_control.getDynamicalSystem()->getConstraintDimension();
+	Eigen::VectorXd decision = Eigen::VectorXd::Constant(state_dim, 2.);
+	Eigen::VectorXd constraint(constraint_dim);
+	double cost;
+
+	num_allocations = 0;
+	count_allocations = true;
+	optimal_control.evaluateConstraints(constraint.data(), constraint_dim,
+										decision.data(), state_dim);
+	optimal_control.evaluateCosts(cost, decision.data(), state_dim);
+	count_allocations = false;
+
+	return num_allocations;
+}
+
+
+/** @brief Counts the allocations of the HS071 problem */
+unsigned int countHS071Allocations(unsigned int horizon,
+								   unsigned int num_threads = 1)
+{
+	dwl::ocp::OptimalControl optimal_control;
+	optimal_control.addDynamicalSystem(new dwl::model::HS071DynamicalSystem());
+	optimal_control.addCost(new dwl::model::HS071Cost());
+
+	return countEvaluationAllocations(optimal_control, horizon, num_threads);
+}
+
+
+/**
+ * @brief Counts the allocations of the full dynamics of HyQ. The rigid-body dynamics allocates
+ * in every inverse dynamics call, so only the remaining evaluation is allocation-free
+ */
+unsigned int countFullDynamicsAllocations(unsigned int horizon)
+{
+	dwl::ocp::OptimalControl optimal_control;
+	dwl::ocp::DynamicalSystem* dynamical_system = new dwl::ocp::FullDynamicalSystem();
+	dynamical_system->modelFromURDFFile(DWL_SOURCE_DIR"/sample/hyq.urdf",
+										DWL_SOURCE_DIR"/config/hyq.yarf");
+	optimal_control.addDynamicalSystem(dynamical_system);
+
+	return countEvaluationAllocations(optimal_control, horizon, 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(single_knot_evaluation) // specify a test case for a single knot
+{
+	BOOST_CHECK_EQUAL(countHS071Allocations(1), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(horizon_evaluation) // specify a test case for a multi-knot horizon
+{
+	BOOST_CHECK_EQUAL(countHS071Allocations(5), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(knot_parallel_evaluation) // specify a test case for the per-thread copies
+{
+	BOOST_CHECK_EQUAL(countHS071Allocations(5, 2), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(full_dynamics_evaluation) // specify a test case for a rigid-body system
+{
+	// The allocations of a knot are the ones of its inverse dynamics, so they don't depend on
+	// the horizon
+	unsigned int knot_allocations = countFullDynamicsAllocations(1);
+	BOOST_CHECK_EQUAL(countFullDynamicsAllocations(4), 4 * knot_allocations);
+}
@@ -0,0 +1,63 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/ocp/OptimalControl.h>
+#include <model/DoubleIntegratorDynamicalSystem.cpp>
+#include <model/DoubleIntegratorCost.cpp>
+
+
+
+BOOST_AUTO_TEST_CASE(gauss_newton_hessian) // specify a test case for the cost curvature
+{
+	unsigned int horizon = 4;
+	dwl::ocp::OptimalControl optimal_control;
+	optimal_control.addDynamicalSystem(new dwl::model::DoubleIntegratorDynamicalSystem());
+	optimal_control.addCost(new dwl::model::DoubleIntegratorCost());
+	optimal_control.setHorizon(horizon);
+	optimal_control.setHessianApproximation(dwl::ocp::GaussNewtonHessian);
+	optimal_control.init(false);
+
+	// Checking that the structure is the diagonal
+	unsigned int decision_dim = horizon * optimal_control.getDimensionOfState();
+	unsigned int constraint_dim = horizon * optimal_control.getDimensionOfConstraints();
+	unsigned int nonzeros = optimal_control.getNumberOfNonzeroHessian();
+	BOOST_REQUIRE_EQUAL(nonzeros, decision_dim);
+	std::vector<int> rows(nonzeros), cols(nonzeros);
+	optimal_control.evaluateLagrangianHessian(NULL, nonzeros, rows.data(), nonzeros,
+											  cols.data(), nonzeros, 1., NULL, constraint_dim,
+											  NULL, decision_dim, true);
+	for (unsigned int i = 0; i < nonzeros; i++) {
+		BOOST_CHECK_EQUAL(rows[i], (int) i);
+		BOOST_CHECK_EQUAL(cols[i], (int) i);
+	}
+
+	// Evaluating the Hessian values, which are scaled by the objective factor
+	Eigen::VectorXd decision = Eigen::VectorXd::LinSpaced(decision_dim, -1., 2.);
+	Eigen::VectorXd lagrange = Eigen::VectorXd::Ones(constraint_dim);
+	Eigen::VectorXd values(nonzeros);
+	double obj_factor = 0.5;
+	optimal_control.evaluateLagrangianHessian(values.data(), nonzeros, NULL, nonzeros,
+											  NULL, nonzeros, obj_factor,
+											  lagrange.data(), constraint_dim,
+											  decision.data(), decision_dim, false);
+
+	// Comparing the Hessian with the central finite differences of the cost gradient
+	double step = 1e-3;
+	Eigen::VectorXd forward_gradient(decision_dim), backward_gradient(decision_dim);
+	for (unsigned int i = 0; i < decision_dim; i++) {
+		Eigen::VectorXd perturbed = decision;
+		perturbed(i) += step;
+		optimal_control.evaluateCostGradient(forward_gradient.data(), decision_dim,
+											 perturbed.data(), decision_dim);
+		perturbed(i) -= 2 * step;
+		optimal_control.evaluateCostGradient(backward_gradient.data(), decision_dim,
+											 perturbed.data(), decision_dim);
+		Eigen::VectorXd column = (forward_gradient - backward_gradient) / (2 * step);
+		for (unsigned int j = 0; j < decision_dim; j++) {
+			double hessian = (i == j) ? values(i) / obj_factor : 0.;
+			BOOST_CHECK_SMALL(column(j) - hessian, 1e-4);
+		}
+	}
+}
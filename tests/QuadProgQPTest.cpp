@@ -0,0 +1,189 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/solver/QuadProg++QP.h>
+
+
+
+/** @brief Random QP with constraint rows lbA <= A x <= ubA and bounds lb <= x <= ub */
+struct RandomQP
+{
+	Eigen::MatrixXd hessian;
+	Eigen::VectorXd gradient;
+	Eigen::MatrixXd constraint_mat;
+	Eigen::VectorXd lower_bound, upper_bound;
+	Eigen::VectorXd lower_constraint, upper_constraint;
+};
+
+
+/**
+ * @brief Generates a feasible QP, where the first constraint is an equality and the others are
+ * two-sided inequalities. Every bound is finite, and some inequalities are one-sided
+ */
+RandomQP generateQP(unsigned int num_vars,
+					unsigned int num_constraints)
+{
+	RandomQP qp;
+	Eigen::MatrixXd factor = Eigen::MatrixXd::Random(num_vars, num_vars);
+	qp.hessian = factor * factor.transpose() + Eigen::MatrixXd::Identity(num_vars, num_vars);
+	qp.gradient = 5. * Eigen::VectorXd::Random(num_vars);
+	qp.constraint_mat = Eigen::MatrixXd::Random(num_constraints, num_vars);
+
+	// The bounds are defined around a feasible point
+	Eigen::VectorXd point = 0.5 * Eigen::VectorXd::Random(num_vars);
+	Eigen::VectorXd value = qp.constraint_mat * point;
+	qp.lower_constraint = value - 0.2 * Eigen::VectorXd::Ones(num_constraints);
+	qp.upper_constraint = value + 0.2 * Eigen::VectorXd::Ones(num_constraints);
+	qp.lower_constraint(0) = qp.upper_constraint(0) = value(0);
+	if (num_constraints > 2)
+		qp.upper_constraint(2) = std::numeric_limits<double>::infinity();
+	qp.lower_bound = Eigen::VectorXd::Constant(num_vars, -1.);
+	qp.upper_bound = Eigen::VectorXd::Constant(num_vars, 1.);
+
+	return qp;
+}
+
+
+/**
+ * @brief Solves the QP by enumerating the active set, i.e. each row is inactive, or active in
+ * its lower or upper side. The solution is the feasible stationary point with the lowest cost
+ */
+double solveByEnumeration(Eigen::VectorXd& solution,
+						  const RandomQP& qp)
+{
+	unsigned int num_vars = qp.gradient.size();
+	unsigned int num_constraints = qp.lower_constraint.size();
+	unsigned int num_rows = num_constraints + num_vars;
+	Eigen::MatrixXd rows(num_rows, num_vars);
+	rows << qp.constraint_mat, Eigen::MatrixXd::Identity(num_vars, num_vars);
+	Eigen::VectorXd lower(num_rows), upper(num_rows);
+	lower << qp.lower_constraint, qp.lower_bound;
+	upper << qp.upper_constraint, qp.upper_bound;
+
+	unsigned int num_sets = 1;
+	for (unsigned int i = 0; i < num_rows; i++)
+		num_sets *= 3;
+
+	double min_cost = std::numeric_limits<double>::infinity();
+	for (unsigned int set = 0; set < num_sets; set++) {
+		// Getting the active rows and their values
+		std::vector<unsigned int> active;
+		std::vector<double> active_value;
+		bool valid = true;
+		unsigned int code = set;
+		for (unsigned int i = 0; i < num_rows; i++, code /= 3) {
+			unsigned int side = code % 3;
+			double value = (side == 1) ? lower(i) : upper(i);
+			if (side == 0)
+				continue;
+			if (fabs(value) == std::numeric_limits<double>::infinity() ||
+					(side == 2 && lower(i) == upper(i))) {
+				valid = false;
+				break;
+			}
+			active.push_back(i);
+			active_value.push_back(value);
+		}
+		if (!valid || active.size() > num_vars)
+			continue;
+
+		// Solving the KKT system of the active rows
+		unsigned int num_active = active.size();
+		Eigen::MatrixXd kkt = Eigen::MatrixXd::Zero(num_vars + num_active, num_vars + num_active);
+		Eigen::VectorXd rhs(num_vars + num_active);
+		kkt.topLeftCorner(num_vars, num_vars) = qp.hessian;
+		rhs.head(num_vars) = -qp.gradient;
+		for (unsigned int j = 0; j < num_active; j++) {
+			kkt.block(num_vars + j, 0, 1, num_vars) = rows.row(active[j]);
+			kkt.block(0, num_vars + j, num_vars, 1) = rows.row(active[j]).transpose();
+			rhs(num_vars + j) = active_value[j];
+		}
+		Eigen::FullPivLU<Eigen::MatrixXd> lu(kkt);
+		if (!lu.isInvertible())
+			continue;
+		Eigen::VectorXd point = lu.solve(rhs).head(num_vars);
+
+		// Keeping the feasible point with the lowest cost
+		Eigen::VectorXd value = rows * point;
+		if (((value - lower).array() < -1e-9).any() || ((value - upper).array() > 1e-9).any())
+			continue;
+		double cost = 0.5 * point.dot(qp.hessian * point) + qp.gradient.dot(point);
+		if (cost < min_cost) {
+			min_cost = cost;
+			solution = point;
+		}
+	}
+
+	return min_cost;
+}
+
+
+BOOST_AUTO_TEST_CASE(mixed_constraint_problems) // specify a test case for random mixed QPs
+{
+	srand(1);
+	for (unsigned int i = 0; i < 50; i++) {
+		RandomQP qp = generateQP(4, 3);
+		dwl::solver::QuadProgQP solver;
+		solver.init(4, 3);
+		BOOST_REQUIRE(solver.compute(qp.hessian, qp.gradient, qp.constraint_mat,
+									 qp.lower_bound, qp.upper_bound,
+									 qp.lower_constraint, qp.upper_constraint, 0.));
+
+		Eigen::VectorXd expected_solution;
+		solveByEnumeration(expected_solution, qp);
+		BOOST_CHECK_SMALL((solver.getOptimalSolution() - expected_solution).norm(), 1e-7);
+
+		// The equality constraint is always active
+		const dwl::solver::QPStatistics& stats = solver.getStatistics();
+		BOOST_CHECK(stats.num_active_constraints >= 1);
+		BOOST_CHECK(stats.num_iterations >= stats.num_active_constraints +
+				stats.num_active_bounds);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(constant_matrix_update) // specify a test case for the setup/update path
+{
+	srand(2);
+	RandomQP qp = generateQP(5, 3);
+	dwl::solver::QuadProgQP solver;
+	solver.init(5, 3);
+	solver.setup(qp.hessian, qp.constraint_mat);
+	for (unsigned int i = 0; i < 10; i++) {
+		// Changing the gradient and the bounds, which could change the types of the rows
+		qp.gradient = 5. * Eigen::VectorXd::Random(5);
+		if (i % 2 == 1)
+			qp.upper_bound(1) = std::numeric_limits<double>::infinity();
+		else
+			qp.upper_bound(1) = 1.;
+		BOOST_REQUIRE(solver.update(qp.gradient,
+									qp.lower_bound, qp.upper_bound,
+									qp.lower_constraint, qp.upper_constraint, 0.));
+
+		Eigen::VectorXd expected_solution;
+		solveByEnumeration(expected_solution, qp);
+		BOOST_CHECK_SMALL((solver.getOptimalSolution() - expected_solution).norm(), 1e-7);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(unbounded_variables) // specify a test case without bound vectors
+{
+	// The QuadProg++ matrices have a row per variable even without bounds
+	srand(3);
+	RandomQP qp = generateQP(4, 3);
+	dwl::solver::QuadProgQP solver;
+	solver.init(4, 3);
+	BOOST_REQUIRE(solver.compute(qp.hessian, qp.gradient, qp.constraint_mat,
+								 Eigen::VectorXd(), Eigen::VectorXd(),
+								 qp.lower_constraint, qp.upper_constraint, 0.));
+
+	qp.lower_bound.setConstant(-std::numeric_limits<double>::infinity());
+	qp.upper_bound.setConstant(std::numeric_limits<double>::infinity());
+	Eigen::VectorXd expected_solution;
+	solveByEnumeration(expected_solution, qp);
+	BOOST_CHECK_SMALL((solver.getOptimalSolution() - expected_solution).norm(), 1e-7);
+	BOOST_CHECK_EQUAL(solver.getStatistics().num_active_bounds, 0);
+}
@@ -0,0 +1,61 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+#include <dwl/solver/QuadraticSurrogate.h>
+
+
+
+/** @brief Separable quadratic of three variables */
+double computeQuadratic(const Eigen::VectorXd& point)
+{
+	Eigen::Vector3d linear(1., -2., 0.5);
+	Eigen::Vector3d quadratic(3., 0.5, 1.);
+	return 2. + linear.dot(point) + quadratic.dot(point.cwiseAbs2());
+}
+
+
+BOOST_AUTO_TEST_CASE(known_quadratic) // specify a test case for fitting a separable quadratic
+{
+	srand(1);
+	dwl::solver::QuadraticSurrogate surrogate;
+
+	// The model needs more evaluations than coefficients, i.e. 2n + 2
+	for (unsigned int i = 0; i < 7; i++) {
+		Eigen::VectorXd point = Eigen::VectorXd::Random(3);
+		surrogate.addSample(point, computeQuadratic(point));
+	}
+	BOOST_CHECK_EQUAL(surrogate.getMinimumNumberOfSamples(), 8);
+	BOOST_CHECK(!surrogate.train());
+	BOOST_CHECK(!surrogate.isTrained());
+
+	for (unsigned int i = 0; i < 5; i++) {
+		Eigen::VectorXd point = Eigen::VectorXd::Random(3);
+		surrogate.addSample(point, computeQuadratic(point));
+	}
+	BOOST_REQUIRE(surrogate.train());
+
+	// The quadratic is fitted exactly up to the ridge regularization, also outside the samples
+	for (unsigned int i = 0; i < 20; i++) {
+		Eigen::VectorXd point = 2. * Eigen::VectorXd::Random(3);
+		BOOST_CHECK_SMALL(surrogate.predict(point) - computeQuadratic(point), 1e-5);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(archive_size) // specify a test case for discarding the oldest evaluations
+{
+	dwl::solver::QuadraticSurrogate surrogate;
+	surrogate.setArchiveSize(10);
+	for (unsigned int i = 0; i < 15; i++)
+		surrogate.addSample(Eigen::VectorXd::Constant(2, i), i);
+
+	BOOST_CHECK_EQUAL(surrogate.getNumberOfSamples(), 10);
+	BOOST_CHECK_EQUAL(surrogate.getQuantile(0.), 5.);
+	BOOST_CHECK_EQUAL(surrogate.getQuantile(1.), 14.);
+
+	// The archive is restarted if the dimension changes
+	BOOST_REQUIRE(surrogate.train());
+	surrogate.addSample(Eigen::VectorXd::Zero(3), 0.);
+	BOOST_CHECK_EQUAL(surrogate.getNumberOfSamples(), 1);
+	BOOST_CHECK(!surrogate.isTrained());
+}
@@ -0,0 +1,51 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <model/SoftConstraintModel.cpp>
+
+
+
+const unsigned int decision_dim = 40;
+const double weight = 10.;
+
+
+/** @brief Evaluates the soft-constraint gradient given a number of gradient threads */
+Eigen::VectorXd computeGradient(dwl::model::SoftConstraintModel& model,
+								const Eigen::VectorXd& decision,
+								unsigned int num_threads)
+{
+	model.setSoftProperties(dwl::model::SoftConstraintProperties(weight, 0., 0.));
+	model.setNumberOfGradientThreads(num_threads);
+
+	Eigen::VectorXd gradient(decision_dim);
+	model.evaluateSoftConstraintGradient(gradient.data(), decision_dim,
+										 decision.data(), decision_dim);
+	return gradient;
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_gradient) // specify a test case for the soft-constraint gradient
+{
+	srand(1);
+	Eigen::VectorXd decision = 0.5 * (Eigen::VectorXd::Random(decision_dim).array() + 1.);
+
+	dwl::model::SoftConstraintModel serial_model(decision_dim), parallel_model(decision_dim);
+	Eigen::VectorXd serial_gradient = computeGradient(serial_model, decision, 1);
+	Eigen::VectorXd parallel_gradient = computeGradient(parallel_model, decision, 4);
+
+	// The blocks of variables are perturbed in the copies of the model, which use the same soft
+	// properties and steps
+	Eigen::VectorXd gradient = serial_model.computeSoftGradient(decision, weight);
+	BOOST_CHECK_SMALL((serial_gradient - gradient).lpNorm<Eigen::Infinity>(), 1e-6);
+	BOOST_CHECK_EQUAL((parallel_gradient - serial_gradient).lpNorm<Eigen::Infinity>(), 0.);
+
+	// The next evaluations use the adapted steps
+	decision *= 0.9;
+	gradient = serial_model.computeSoftGradient(decision, weight);
+	parallel_gradient.setZero();
+	parallel_model.evaluateSoftConstraintGradient(parallel_gradient.data(), decision_dim,
+												  decision.data(), decision_dim);
+	BOOST_CHECK_SMALL((parallel_gradient - gradient).lpNorm<Eigen::Infinity>(), 1e-6);
+}
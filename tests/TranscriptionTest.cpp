@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <model/FreeJointDynamicalSystem.cpp>
+
+
+
+const double initial_time = 0.3;
+const double step_time = 0.2;
+
+
+/**
+ * @brief Gets the whole-body state of a polynomial joint trajectory, where each column of the
+ * coefficient matrix defines the polynomial of a joint in increasing order
+ */
+dwl::WholeBodyState polynomialState(const Eigen::MatrixXd& coefficients,
+									double time)
+{
+	dwl::WholeBodyState state(coefficients.cols());
+	state.joint_pos.setZero();
+	state.joint_vel.setZero();
+	state.joint_acc.setZero();
+	for (unsigned int k = 0; k < coefficients.rows(); k++) {
+		state.joint_pos += coefficients.row(k).transpose() * pow(time, k);
+		if (k > 0)
+			state.joint_vel += k * coefficients.row(k).transpose() * pow(time, k - 1);
+		if (k > 1)
+			state.joint_acc += k * (k - 1) * coefficients.row(k).transpose() * pow(time, k - 2);
+	}
+	state.duration = step_time;
+
+	return state;
+}
+
+
+/** @brief Computes the defect of the transcription between two knots of the trajectory */
+Eigen::VectorXd computeDefect(dwl::ocp::TranscriptionMethod method,
+							  const Eigen::MatrixXd& coefficients)
+{
+	dwl::model::FreeJointDynamicalSystem system;
+	system.setTranscriptionMethod(method);
+
+	dwl::WholeBodyState last_state = polynomialState(coefficients, initial_time);
+	dwl::WholeBodyState state = polynomialState(coefficients, initial_time + step_time);
+	system.setLastState(last_state);
+
+	Eigen::VectorXd defect;
+	system.numericalIntegration(defect, state);
+	return defect;
+}
+
+
+BOOST_AUTO_TEST_CASE(hermite_simpson) // specify a test case for the Hermite-Simpson collocation
+{
+	// The compressed Hermite-Simpson collocation is exact up to quartic positions
+	Eigen::MatrixXd quartic(5,2);
+	quartic << 0.5, -1.,
+			   1., 2.,
+			   -2., 0.5,
+			   3., -1.5,
+			   -4., 2.5;
+	BOOST_CHECK_SMALL(computeDefect(dwl::ocp::HermiteSimpson, quartic).norm(), 1e-12);
+
+	// The lower-order transcriptions aren't exact on the same trajectory
+	BOOST_CHECK(computeDefect(dwl::ocp::Trapezoidal, quartic).norm() > 1e-4);
+	BOOST_CHECK(computeDefect(dwl::ocp::BackwardEuler, quartic).norm() > 1e-4);
+}
+
+
+BOOST_AUTO_TEST_CASE(runge_kutta) // specify a test case for the Runge-Kutta shooting
+{
+	// The Runge-Kutta shooting with linear accelerations between knots is exact up to cubic
+	// positions
+	Eigen::MatrixXd cubic(4,2);
+	cubic << 0.5, -1.,
+			 1., 2.,
+			 -2., 0.5,
+			 3., -1.5;
+	BOOST_CHECK_SMALL(computeDefect(dwl::ocp::RungeKutta4, cubic).norm(), 1e-12);
+	BOOST_CHECK_SMALL(computeDefect(dwl::ocp::HermiteSimpson, cubic).norm(), 1e-12);
+	BOOST_CHECK(computeDefect(dwl::ocp::Trapezoidal, cubic).norm() > 1e-4);
+}
@@ -0,0 +1,143 @@
+#include <dwl/ocp/OptimalControl.h>
+#include <dwl/solver/cmaesSOFamily.h>
+#include <model/HS071DynamicalSystem.cpp>
+#include <model/HS071Cost.cpp>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+
+
+/** @brief Cost of the distance to the desired joint positions */
+class DesiredPositionCost : public dwl::ocp::Cost
+{
+	public:
+		DesiredPositionCost() {name_ = "Desired position";}
+
+		DesiredPositionCost* clone() const
+		{
+			return new DesiredPositionCost(*this);
+		}
+
+		void compute(double& cost,
+					 const dwl::WholeBodyState& state)
+		{
+			cost = (state.joint_pos - desired_state_.joint_pos).squaredNorm();
+		}
+};
+
+
+/**
+ * @brief Solves the HS071 problem with soft constraints and a fixed seed, so the sequence of
+ * offsprings doesn't depend on the evaluation order
+ */
+Eigen::VectorXd solveHS071(bool multithreading)
+{
+	dwl::ocp::OptimalControl optimal_control;
+	dwl::ocp::DynamicalSystem* dynamical_system = new dwl::model::HS071DynamicalSystem();
+	dynamical_system->defineAsSoftConstraint();
+	dwl::ocp::SoftConstraintProperties properties(10000., 0.1, 0.);
+	dynamical_system->setSoftProperties(properties);
+	optimal_control.addDynamicalSystem(dynamical_system);
+	optimal_control.addCost(new dwl::model::HS071Cost());
+
+	dwl::solver::cmaesSOFamily<> solver;
+	solver.setOptimizationModel(&optimal_control);
+	solver.setFamily(dwl::solver::CMAES);
+	solver.setInitialDistribution(0.85);
+	solver.setNumberOfOffsprings(64);
+	solver.setAllowedNumberofIterations(200);
+	solver.setRandomSeed(1);
+	solver.setMultithreading(multithreading);
+	solver.init();
+	solver.compute(60.);
+
+	return solver.getSolution();
+}
+
+
+BOOST_AUTO_TEST_CASE(multithreading_evaluation) // specify a test case for the parallel fitness
+{
+	Eigen::VectorXd serial_solution = solveHS071(false);
+	Eigen::VectorXd parallel_solution = solveHS071(true);
+
+	BOOST_REQUIRE_EQUAL(serial_solution.size(), parallel_solution.size());
+	BOOST_CHECK_SMALL((serial_solution - parallel_solution).norm(), 1e-12);
+}
+
+
+BOOST_AUTO_TEST_CASE(model_cloning) // specify a test case for the copies of the model
+{
+	dwl::ocp::OptimalControl optimal_control;
+	optimal_control.addDynamicalSystem(new dwl::model::HS071DynamicalSystem());
+	optimal_control.addCost(new dwl::model::HS071Cost());
+	optimal_control.init(true);
+
+	dwl::model::OptimizationModel* copy = optimal_control.clone();
+	BOOST_REQUIRE(copy != NULL);
+	copy->init(true);
+
+	Eigen::VectorXd decision = Eigen::VectorXd::Constant(4, 2.);
+	double cost, copy_cost;
+	optimal_control.evaluateCosts(cost, decision.data(), decision.size());
+	copy->evaluateCosts(copy_cost, decision.data(), decision.size());
+	BOOST_CHECK_EQUAL(cost, copy_cost);
+	BOOST_CHECK_EQUAL(optimal_control.evaluateAsSoftConstraints(decision.data(), decision.size()),
+					  copy->evaluateAsSoftConstraints(decision.data(), decision.size()));
+
+	delete copy;
+}
+
+
+/**
+ * @brief Solves the HS071 constraints with a desired position cost twice, where the desired
+ * position changes between both computations
+ */
+void solveDesiredPositions(Eigen::VectorXd& first_solution,
+						   Eigen::VectorXd& second_solution,
+						   bool multithreading)
+{
+	dwl::ocp::OptimalControl optimal_control;
+	dwl::ocp::DynamicalSystem* dynamical_system = new dwl::model::HS071DynamicalSystem();
+	dynamical_system->defineAsSoftConstraint();
+	dwl::ocp::SoftConstraintProperties properties(10000., 0.1, 0.);
+	dynamical_system->setSoftProperties(properties);
+	optimal_control.addDynamicalSystem(dynamical_system);
+	optimal_control.addCost(new DesiredPositionCost());
+
+	dwl::WholeBodyState desired_state(4);
+	desired_state.joint_pos << 1., 5., 4., 1.;
+	optimal_control.getCosts()[0]->setDesiredState(desired_state);
+
+	dwl::solver::cmaesSOFamily<> solver;
+	solver.setOptimizationModel(&optimal_control);
+	solver.setFamily(dwl::solver::CMAES);
+	solver.setInitialDistribution(0.85);
+	solver.setNumberOfOffsprings(64);
+	solver.setAllowedNumberofIterations(200);
+	solver.setRandomSeed(1);
+	solver.setMultithreading(multithreading);
+	solver.init();
+	solver.compute(60.);
+	first_solution = solver.getSolution();
+
+	// Changing the desired position after the initialization of the solver
+	desired_state.joint_pos << 1.5, 4.5, 3.5, 1.5;
+	optimal_control.getCosts()[0]->setDesiredState(desired_state);
+	solver.compute(60.);
+	second_solution = solver.getSolution();
+}
+
+
+BOOST_AUTO_TEST_CASE(multithreading_state_change) // specify a test case for the model changes
+{
+	Eigen::VectorXd serial_first, serial_second;
+	Eigen::VectorXd parallel_first, parallel_second;
+	solveDesiredPositions(serial_first, serial_second, false);
+	solveDesiredPositions(parallel_first, parallel_second, true);
+
+	BOOST_REQUIRE_EQUAL(serial_second.size(), parallel_second.size());
+	BOOST_CHECK_SMALL((serial_first - parallel_first).norm(), 1e-12);
+	BOOST_CHECK_SMALL((serial_second - parallel_second).norm(), 1e-12);
+	BOOST_CHECK((serial_first - serial_second).norm() > 1e-3);
+}
@@ -0,0 +1,65 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+
+// The test framework is included first because its color enumerators clash with the color
+// macros of dwl
+#include <dwl/solver/cmaesSOFamily.h>
+#include <model/SeparableQuadraticModel.cpp>
+
+
+
+BOOST_AUTO_TEST_CASE(evaluation_cache) // specify a test case for the cache hits and misses
+{
+	dwl::model::SeparableQuadraticModel model;
+	dwl::solver::cmaesSOFamily<> solver;
+	solver.setOptimizationModel(&model);
+	solver.setEvaluationCache(true);
+	solver.setNumberOfOffsprings(8);
+	BOOST_REQUIRE(solver.init());
+
+	// The first evaluation is a miss, and the second one is read from the cache
+	Eigen::VectorXd decision(2);
+	decision << 0.3, -1.2;
+	double value = solver.evaluateFitness(decision);
+	BOOST_CHECK_EQUAL(model.num_evaluations_, 1);
+	BOOST_CHECK_EQUAL(value, model.computeCost(decision));
+	BOOST_CHECK_EQUAL(solver.evaluateFitness(decision), value);
+	BOOST_CHECK_EQUAL(model.num_evaluations_, 1);
+
+	// Any change of the decision vector is a miss
+	decision(0) += 1e-12;
+	BOOST_CHECK_EQUAL(solver.evaluateFitness(decision), model.computeCost(decision));
+	BOOST_CHECK_EQUAL(model.num_evaluations_, 2);
+	BOOST_CHECK_CLOSE(solver.getExactEvaluationRatio(), 2. / 3., 1e-9);
+}
+
+
+BOOST_AUTO_TEST_CASE(surrogate_screening) // specify a test case for the pre-screening
+{
+	dwl::model::SeparableQuadraticModel model;
+	dwl::solver::cmaesSOFamily<> solver;
+	solver.setOptimizationModel(&model);
+	solver.setSurrogate(true);
+	solver.setNumberOfOffsprings(8);
+	BOOST_REQUIRE(solver.init());
+
+	// The surrogate is trained after a generation of exact evaluations
+	srand(1);
+	for (unsigned int i = 0; i < 8; i++)
+		solver.evaluateFitness(2. * Eigen::VectorXd::Random(2));
+	BOOST_CHECK_EQUAL(model.num_evaluations_, 8);
+
+	// A promising offspring is evaluated exactly, which validates the surrogate
+	Eigen::VectorXd promising(2);
+	promising << 1., -0.5;
+	BOOST_CHECK_CLOSE(solver.evaluateFitness(promising), model.computeCost(promising), 1e-9);
+	BOOST_CHECK_EQUAL(model.num_evaluations_, 9);
+
+	// A non-promising offspring gets the prediction of the surrogate, which fits the quadratic
+	Eigen::VectorXd non_promising(2);
+	non_promising << 4., 3.;
+	BOOST_CHECK_CLOSE(solver.evaluateFitness(non_promising),
+					  model.computeCost(non_promising), 1e-4);
+	BOOST_CHECK_EQUAL(model.num_evaluations_, 9);
+	BOOST_CHECK_CLOSE(solver.getExactEvaluationRatio(), 0.9, 1e-9);
+}
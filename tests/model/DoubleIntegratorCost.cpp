@@ -0,0 +1,48 @@
+#ifndef DWL__MODEL__DOUBLE_INTEGRATOR_COST__H
+#define DWL__MODEL__DOUBLE_INTEGRATOR_COST__H
+
+
+#include <dwl/ocp/Cost.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/** @brief Quadratic cost of the state and acceleration of the double integrator */
+class DoubleIntegratorCost : public ocp::Cost
+{
+	public:
+		DoubleIntegratorCost() {name_ = "double integrator";}
+		~DoubleIntegratorCost() {}
+
+		DoubleIntegratorCost* clone() const
+		{
+			return new DoubleIntegratorCost(*this);
+		}
+
+		void compute(double& cost,
+					 const WholeBodyState& state)
+		{
+			cost = state.joint_pos(0) * state.joint_pos(0) +
+					state.joint_pos(1) * state.joint_pos(1) +
+					0.1 * state.joint_pos(2) * state.joint_pos(2);
+		}
+
+		bool computeHessian(WholeBodyState& hessian,
+							WholeBodyState& duration_hessian,
+							const WholeBodyState& state)
+		{
+			hessian.joint_pos(0) += 2.;
+			hessian.joint_pos(1) += 2.;
+			hessian.joint_pos(2) += 0.2;
+			return true;
+		}
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef DWL__MODEL__DOUBLE_INTEGRATOR_DYNAMICAL_SYSTEM__H
+#define DWL__MODEL__DOUBLE_INTEGRATOR_DYNAMICAL_SYSTEM__H
+
+#include <dwl/ocp/DynamicalSystem.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @brief Linear double integrator discretized by backward Euler. The position, velocity and
+ * acceleration of each knot are described as joint positions
+ */
+class DoubleIntegratorDynamicalSystem : public ocp::DynamicalSystem
+{
+	public:
+		DoubleIntegratorDynamicalSystem()
+		{
+			name_ = "double integrator";
+			state_dimension_ = 3;
+			constraint_dimension_ = 2;
+			system_variables_.position = true;
+			system_.setJointDoF(state_dimension_);
+			system_.setSystemDoF(state_dimension_);
+			system_.setTypeOfDynamicSystem(FixedBase);
+
+			WholeBodyState starting_state(state_dimension_);
+			starting_state.joint_pos(0) = 1.0;
+			starting_state.joint_pos(1) = 0.0;
+			starting_state.joint_pos(2) = 0.0;
+			setInitialState(starting_state);
+			setTerminalState(starting_state);
+
+			WholeBodyState lower_state_bound(state_dimension_), upper_state_bound(state_dimension_);
+			lower_state_bound.joint_pos = Eigen::VectorXd::Constant(state_dimension_, -NO_BOUND);
+			upper_state_bound.joint_pos = Eigen::VectorXd::Constant(state_dimension_, NO_BOUND);
+			setStateBounds(lower_state_bound, upper_state_bound);
+		}
+
+		~DoubleIntegratorDynamicalSystem() {}
+
+		DoubleIntegratorDynamicalSystem* clone() const
+		{
+			return new DoubleIntegratorDynamicalSystem(*this);
+		}
+
+		void compute(Eigen::VectorXd& constraint,
+					 const WholeBodyState& state)
+		{
+			const WholeBodyState& last_state = state_buffer_[0];
+			constraint = Eigen::VectorXd::Zero(constraint_dimension_);
+			constraint(0) = state.joint_pos(0) - last_state.joint_pos(0) -
+					state.duration * state.joint_pos(1);
+			constraint(1) = state.joint_pos(1) - last_state.joint_pos(1) -
+					state.duration * state.joint_pos(2);
+		}
+
+		void getBounds(Eigen::VectorXd& lower_bound,
+					   Eigen::VectorXd& upper_bound)
+		{
+			lower_bound = Eigen::VectorXd::Zero(constraint_dimension_);
+			upper_bound = Eigen::VectorXd::Zero(constraint_dimension_);
+		}
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef DWL__MODEL__DOUBLE_INTEGRATOR_LINEAR_SYSTEM__H
+#define DWL__MODEL__DOUBLE_INTEGRATOR_LINEAR_SYSTEM__H
+
+#include <dwl/ocp/LinearDynamicalSystem.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @brief Discrete-time double integrator, i.e. x = [position, velocity] and u = acceleration,
+ * with exact zero-order-hold matrices. It can be declared as time-varying in order to recompute
+ * the matrices in every update of the MPC
+ */
+class DoubleIntegratorLinearSystem : public ocp::LinearDynamicalSystem
+{
+	public:
+		DoubleIntegratorLinearSystem(double step_time,
+									 bool time_variant = false) : step_time_(step_time)
+		{
+			name_ = "double integrator";
+			num_states_ = 2;
+			num_inputs_ = 1;
+			num_outputs_ = 2;
+			time_variant_ = time_variant;
+		}
+
+		~DoubleIntegratorLinearSystem() {}
+
+		void setLinearizationPoints(const Eigen::VectorXd& op_states)
+		{
+			op_point_states_ = op_states;
+		}
+
+		void computeLinearSystem(Eigen::MatrixXd& A, Eigen::MatrixXd& B)
+		{
+			A = Eigen::MatrixXd::Identity(2, 2);
+			A(0, 1) = step_time_;
+			B.resize(2, 1);
+			B(0, 0) = 0.5 * step_time_ * step_time_;
+			B(1, 0) = step_time_;
+		}
+
+
+	private:
+		double step_time_;
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef DWL__MODEL__FREE_JOINT_DYNAMICAL_SYSTEM__H
+#define DWL__MODEL__FREE_JOINT_DYNAMICAL_SYSTEM__H
+
+#include <dwl/ocp/DynamicalSystem.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @brief Fixed-base system of two free joints, i.e. without dynamical constraint. The joint
+ * positions, velocities and accelerations are decision variables, so only the transcription
+ * of the time integration is constrained
+ */
+class FreeJointDynamicalSystem : public ocp::DynamicalSystem
+{
+	public:
+		FreeJointDynamicalSystem()
+		{
+			name_ = "free joint";
+			system_variables_.position = true;
+			system_variables_.velocity = true;
+			system_variables_.acceleration = true;
+			system_.setJointDoF(2);
+			system_.setSystemDoF(2);
+			system_.setTypeOfDynamicSystem(FixedBase);
+		}
+
+		~FreeJointDynamicalSystem() {}
+
+		void computeDynamicalConstraint(Eigen::VectorXd& constraint,
+										const WholeBodyState& state)
+		{
+			constraint.resize(0);
+		}
+
+		void getDynamicalBounds(Eigen::VectorXd& lower_bound,
+								Eigen::VectorXd& upper_bound)
+		{
+			lower_bound.resize(0);
+			upper_bound.resize(0);
+		}
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
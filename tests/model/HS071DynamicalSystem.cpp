@@ -46,6 +46,11 @@ class HS071DynamicalSystem : public ocp::DynamicalSystem
 
 		~HS071DynamicalSystem() {}
 
+		HS071DynamicalSystem* clone() const
+		{
+			return new HS071DynamicalSystem(*this);
+		}
+
 		void compute(Eigen::VectorXd& constraint,
 					 const WholeBodyState& state)
 		{
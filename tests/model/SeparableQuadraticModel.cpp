@@ -0,0 +1,62 @@
+#ifndef DWL__MODEL__SEPARABLE_QUADRATIC_MODEL__H
+#define DWL__MODEL__SEPARABLE_QUADRATIC_MODEL__H
+
+#include <dwl/model/OptimizationModel.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @brief Unconstrained separable quadratic of two variables, which the quadratic surrogate
+ * fits exactly. It counts the evaluations of the cost
+ */
+class SeparableQuadraticModel : public OptimizationModel
+{
+	public:
+		SeparableQuadraticModel() : num_evaluations_(0) {}
+
+		~SeparableQuadraticModel() {}
+
+		void init(bool only_soft_constraints)
+		{
+			state_dimension_ = 2;
+			constraint_dimension_ = 0;
+		}
+
+		void getStartingPoint(double* decision, int decision_dim)
+		{
+			Eigen::Map<Eigen::VectorXd>(decision, decision_dim).setOnes();
+		}
+
+		void evaluateBounds(double* decision_lbound, int decision_dim1,
+							double* decision_ubound, int decision_dim2,
+							double* constraint_lbound, int constraint_dim1,
+							double* constraint_ubound, int constraint_dim2)
+		{
+			Eigen::Map<Eigen::VectorXd>(decision_lbound, decision_dim1).setConstant(-5.);
+			Eigen::Map<Eigen::VectorXd>(decision_ubound, decision_dim2).setConstant(5.);
+		}
+
+		void evaluateCosts(double& cost,
+						   const double* decision, int decision_dim)
+		{
+			num_evaluations_++;
+			cost = computeCost(Eigen::Map<const Eigen::VectorXd>(decision, decision_dim));
+		}
+
+		double computeCost(const Eigen::Ref<const Eigen::VectorXd>& decision) const
+		{
+			return 1. + 0.5 * pow(decision(0) - 1., 2) + 2. * pow(decision(1) + 0.5, 2);
+		}
+
+		unsigned int num_evaluations_;
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef DWL__MODEL__SOFT_CONSTRAINT_MODEL__H
+#define DWL__MODEL__SOFT_CONSTRAINT_MODEL__H
+
+#include <dwl/model/OptimizationModel.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @brief Clonable model with the upper-bounded constraints sum(x) <= 1 and ||x||^2 <= 0.25,
+ * whose soft-cost has an analytical gradient
+ */
+class SoftConstraintModel : public OptimizationModel
+{
+	public:
+		SoftConstraintModel(unsigned int dim)
+		{
+			state_dimension_ = dim;
+			constraint_dimension_ = 2;
+		}
+
+		~SoftConstraintModel() {}
+
+		SoftConstraintModel* clone() const
+		{
+			return new SoftConstraintModel(state_dimension_);
+		}
+
+		void evaluateBounds(double* decision_lbound, int decision_dim1,
+							double* decision_ubound, int decision_dim2,
+							double* constraint_lbound, int constraint_dim1,
+							double* constraint_ubound, int constraint_dim2)
+		{
+			Eigen::Map<Eigen::VectorXd>(decision_lbound, decision_dim1).setConstant(-NO_BOUND);
+			Eigen::Map<Eigen::VectorXd>(decision_ubound, decision_dim2).setConstant(NO_BOUND);
+			constraint_lbound[0] = constraint_lbound[1] = -NO_BOUND;
+			constraint_ubound[0] = 1.;
+			constraint_ubound[1] = 0.25;
+		}
+
+		void evaluateCosts(double& cost,
+						   const double* decision, int decision_dim)
+		{
+			cost = 0.;
+		}
+
+		void evaluateConstraints(double* constraint, int constraint_dim,
+								 const double* decision, int decision_dim)
+		{
+			Eigen::Map<const Eigen::VectorXd> decision_var(decision, decision_dim);
+			constraint[0] = decision_var.sum();
+			constraint[1] = decision_var.squaredNorm();
+		}
+
+		/** @brief Computes the gradient of the weighted norm of the constraint violation */
+		Eigen::VectorXd computeSoftGradient(const Eigen::VectorXd& decision,
+											double weight) const
+		{
+			Eigen::Vector2d violation(decision.sum() - 1., decision.squaredNorm() - 0.25);
+			Eigen::VectorXd violation_gradient =
+					violation(0) * Eigen::VectorXd::Ones(decision.size()) + 2 * violation(1) * decision;
+			return weight / violation.norm() * violation_gradient;
+		}
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
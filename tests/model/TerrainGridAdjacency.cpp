@@ -0,0 +1,68 @@
+#ifndef DWL__MODEL__TERRAIN_GRID_ADJACENCY__H
+#define DWL__MODEL__TERRAIN_GRID_ADJACENCY__H
+
+#include <dwl/model/AdjacencyModel.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * @brief 8-connected grid of the terrain cells with a fixed yaw, where a step costs its length
+ * times the cost of the reached cell, i.e. the cost model of the cost-to-go table. It counts the
+ * queries of the target-dependent heuristic
+ */
+class TerrainGridAdjacency : public AdjacencyModel
+{
+	public:
+		TerrainGridAdjacency() : num_heuristic_queries_(0)
+		{
+			name_ = "terrain grid";
+		}
+
+		~TerrainGridAdjacency() {}
+
+		void getSuccessors(std::vector<Edge>& successors,
+						   Vertex state_vertex)
+		{
+			const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+			Eigen::Vector3d state;
+			space_model.vertexToState(state, state_vertex);
+
+			double resolution = terrain_->getResolution(true);
+			for (int delta_y = -1; delta_y <= 1; delta_y++) {
+				for (int delta_x = -1; delta_x <= 1; delta_x++) {
+					if (delta_x == 0 && delta_y == 0)
+						continue;
+
+					Eigen::Vector3d neighbor_state(state(0) + delta_x * resolution,
+												   state(1) + delta_y * resolution, 0.);
+					Weight cost;
+					if (!terrain_->getTerrainCost(cost, (Eigen::Vector2d) neighbor_state.head(2)))
+						continue;
+
+					Vertex neighbor;
+					space_model.stateToVertex(neighbor, neighbor_state);
+					double step_length = (delta_x != 0 && delta_y != 0) ? M_SQRT2 : 1.;
+					successors.push_back(Edge(neighbor, step_length * resolution * cost));
+				}
+			}
+		}
+
+		double heuristicCost(Vertex source,
+							 Vertex target)
+		{
+			num_heuristic_queries_++;
+			return AdjacencyModel::heuristicCost(source, target);
+		}
+
+		unsigned int num_heuristic_queries_;
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif